@@ -13,6 +13,7 @@
 
 // Includes.
 #include <zlib.h>
+#include <sched.h>
 
 // Namespace vlib.
 namespace vlib {
@@ -40,6 +41,542 @@ enum levels {
 // End namespace compression.
 };
 
+// ---------------------------------------------------------
+// Streaming compression.
+
+// Namespace compression.
+namespace compression {
+
+// Deflater.
+//
+// Notes:
+// - Keeps its "z_stream" across messages, "finish()" ends the current message and resets the stream without reallocating its state.
+// - Input is accepted in chunks, the memory usage is constant apart from the output.
+// - Without a sink the output is collected in "output()", with a sink the output is written into "sink.write(data, len)" through a fixed buffer, the sink can for example be a "vlib::File".
+// - The stream is allocated on the heap since zlib keeps a pointer to it, so the object can be moved.
+//
+/*  @docs
+ *	@chapter: Compression
+ *	@title: Deflater
+ *	@description:
+ *	    Streaming compressor.
+ *	@usage:
+ *	    #include <vlib/compression.h>
+ *	    vlib::File file ("/tmp/logs.gz", vlib::file::mode::write);
+ *	    vlib::compression::Deflater<vlib::File> deflater (file);
+ *	    deflater.write("Hello ");
+ *	    deflater.write("World!");
+ *	    deflater.finish();
+ */
+template <typename Sink = Null>
+struct Deflater {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 	This =		Deflater;
+	using 	Length = 	ullong;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	z_stream*	m_stream = nullptr;
+	Sink*		m_sink = nullptr;
+	char*		m_buff = nullptr;		// the output buffer of the sink.
+	Length		m_buff_len;
+	String		m_output;
+	int			m_level;
+	int			m_window_bits;
+	int			m_mem_level;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Has sink.
+	SICEBOOL has_sink_h() { return !is_Null<Sink>::value; }
+
+	// Initialize the stream.
+	void	init_h() {
+		m_stream = new z_stream {};
+		m_stream->zalloc = Z_NULL;
+		m_stream->zfree = Z_NULL;
+		m_stream->opaque = Z_NULL;
+		if (::deflateInit2(m_stream, m_level, Z_DEFLATED, m_window_bits, m_mem_level, Z_DEFAULT_STRATEGY) != Z_OK) {
+			delete m_stream;
+			m_stream = nullptr;
+			throw DeflateError("Encoutered an error while initializing the deflate stream.");
+		}
+		if constexpr (has_sink_h()) {
+			if (m_buff == nullptr) {
+				m_buff = new char [m_buff_len];
+			}
+		}
+	}
+
+	// Deflate the available input.
+	void	run_h(int flush) {
+		do {
+			Length avail = m_buff_len;
+			if constexpr (has_sink_h()) {
+				m_stream->next_out = reinterpret_cast<Bytef*>(m_buff);
+			} else {
+				avail = m_output.capacity() - m_output.len();
+				if (avail < 256) {
+					m_output.expand(1024);
+					avail = m_output.capacity() - m_output.len();
+				}
+				if (avail > UINT_MAX) { avail = UINT_MAX; }
+				m_stream->next_out = reinterpret_cast<Bytef*>(m_output.data() + m_output.len());
+			}
+			m_stream->avail_out = (uint) avail;
+			if (::deflate(m_stream, flush) == Z_STREAM_ERROR) {
+				throw DeflateError("Encoutered an error while deflating.");
+			}
+			const Length produced = avail - m_stream->avail_out;
+			if constexpr (has_sink_h()) {
+				if (produced > 0) {
+					m_sink->write(m_buff, produced);
+				}
+			} else {
+				m_output.len() += produced;
+			}
+		} while (m_stream->avail_out == 0);
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Constructor.
+	/*  @docs
+	 *	@title: Constructor
+	 *	@description:
+	 *	    Construct a deflater, optionally with a sink.
+	 *	@parameter:
+	 *	    @name: level
+	 *	    @description: The compression level.
+	 *	@parameter:
+	 *	    @name: window_bits
+	 *	    @description: The window bits, `31` for gzip, `15` for zlib and `-15` for raw deflate.
+	 *	@parameter:
+	 *	    @name: mem_level
+	 *	    @description: The memory level [1..9].
+	 *	@parameter:
+	 *	    @name: buffer_len
+	 *	    @description: The length of the output buffer of the sink.
+	 *	@funcs: 2
+	 */
+	Deflater(int level = levels::def, int window_bits = 31, int mem_level = 8) :
+	m_buff_len(0),
+	m_level(level),
+	m_window_bits(window_bits),
+	m_mem_level(mem_level)
+	{ init_h(); }
+	Deflater(Sink& sink, int level = levels::def, int window_bits = 31, int mem_level = 8, Length buffer_len = 64 * 1024) requires (!is_Null<Sink>::value) :
+	m_sink(&sink),
+	m_buff_len(buffer_len),
+	m_level(level),
+	m_window_bits(window_bits),
+	m_mem_level(mem_level)
+	{ init_h(); }
+
+	// Move constructor.
+	Deflater(This&& obj) :
+	m_stream(obj.m_stream),
+	m_sink(obj.m_sink),
+	m_buff(obj.m_buff),
+	m_buff_len(obj.m_buff_len),
+	m_output(move(obj.m_output)),
+	m_level(obj.m_level),
+	m_window_bits(obj.m_window_bits),
+	m_mem_level(obj.m_mem_level)
+	{
+		obj.m_stream = nullptr;
+		obj.m_buff = nullptr;
+	}
+
+	// No copy constructor.
+	Deflater(const This&) = delete;
+
+	// Destructor.
+	~Deflater() {
+		if (m_stream != nullptr) {
+			::deflateEnd(m_stream);
+			delete m_stream;
+		}
+		delete[] m_buff;
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Write.
+	/*  @docs
+	 *	@title: Write
+	 *	@description:
+	 *	    Compress a chunk of input.
+	 *	@funcs: 2
+	 */
+	This&	write(const String& data) {
+		return write(data.data(), data.len());
+	}
+	This&	write(const char* data, Length len) {
+		while (len > 0) {
+			const uint chunk = len > UINT_MAX ? UINT_MAX : (uint) len;
+			m_stream->next_in = reinterpret_cast<z_const Bytef*>((char*) data);
+			m_stream->avail_in = chunk;
+			run_h(Z_NO_FLUSH);
+			data += chunk;
+			len -= chunk;
+		}
+		return *this;
+	}
+
+	// Flush.
+	/*  @docs
+	 *	@title: Flush
+	 *	@description:
+	 *	    Emit all pending output so the receiver can decompress all input written so far, without ending the message.
+	 */
+	This&	flush() {
+		m_stream->avail_in = 0;
+		run_h(Z_SYNC_FLUSH);
+		return *this;
+	}
+
+	// Finish.
+	/*  @docs
+	 *	@title: Finish
+	 *	@description:
+	 *	    End the current message and reset the stream for the next message.
+	 *
+	 *	    Every finished message is a complete gzip member, concatenated members can be decompressed with a single `Inflater`.
+	 */
+	This&	finish() {
+		m_stream->avail_in = 0;
+		run_h(Z_FINISH);
+		::deflateReset(m_stream);
+		return *this;
+	}
+
+	// Reset.
+	/*  @docs
+	 *	@title: Reset
+	 *	@description:
+	 *	    Discard the current message and the collected output.
+	 *
+	 *	    The stream is only reinitialized when the parameters change.
+	 *	@funcs: 2
+	 */
+	This&	reset() {
+		::deflateReset(m_stream);
+		m_output.reset();
+		return *this;
+	}
+	This&	reset(int level, int window_bits = 31, int mem_level = 8) {
+		if (level == m_level && window_bits == m_window_bits && mem_level == m_mem_level) {
+			return reset();
+		}
+		::deflateEnd(m_stream);
+		delete m_stream;
+		m_stream = nullptr;
+		m_level = level;
+		m_window_bits = window_bits;
+		m_mem_level = mem_level;
+		m_output.reset();
+		init_h();
+		return *this;
+	}
+
+	// Output.
+	/*  @docs
+	 *	@title: Output
+	 *	@description:
+	 *	    Get the collected output when no sink is used.
+	 */
+	constexpr
+	String&	output() requires (is_Null<Sink>::value) {
+		return m_output;
+	}
+
+	// Total input length.
+	constexpr
+	Length	total_in() const { return m_stream->total_in; }
+
+	// Total output length.
+	constexpr
+	Length	total_out() const { return m_stream->total_out; }
+
+};
+
+// Inflater.
+//
+// Notes:
+// - Keeps its "z_stream" across messages, the stream is reset automatically when a message ends and more input follows, so concatenated gzip members are decompressed as one stream.
+// - Input is accepted in chunks, for example the chunks of a streamed http body.
+// - Without a sink the output is collected in "output()", with a sink the output is written into "sink.write(data, len)" through a fixed buffer.
+// - An inflater is a valid http body sink, "http::Server<Func, compression::Inflater<>>" decompresses request bodies while they are received.
+//
+/*  @docs
+ *	@chapter: Compression
+ *	@title: Inflater
+ *	@description:
+ *	    Streaming decompressor.
+ *	@usage:
+ *	    #include <vlib/compression.h>
+ *	    vlib::compression::Inflater<> inflater;
+ *	    for (auto& chunk: vlib::File("/tmp/logs.gz").chunks()) {
+ *	        inflater.write(chunk.data, chunk.len);
+ *	    }
+ *	    vlib::String& output = inflater.output();
+ */
+template <typename Sink = Null>
+struct Inflater {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 	This =		Inflater;
+	using 	Length = 	ullong;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	z_stream*	m_stream = nullptr;
+	Sink*		m_sink = nullptr;
+	char*		m_buff = nullptr;		// the output buffer of the sink.
+	Length		m_buff_len;
+	String		m_output;
+	int			m_window_bits;
+	bool		m_finished = false;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Has sink.
+	SICEBOOL has_sink_h() { return !is_Null<Sink>::value; }
+
+	// Initialize the stream.
+	void	init_h() {
+		m_stream = new z_stream {};
+		m_stream->zalloc = Z_NULL;
+		m_stream->zfree = Z_NULL;
+		m_stream->opaque = Z_NULL;
+		m_stream->avail_in = 0;
+		m_stream->next_in = Z_NULL;
+		if (::inflateInit2(m_stream, m_window_bits) != Z_OK) {
+			delete m_stream;
+			m_stream = nullptr;
+			throw InflateError("Encoutered an error while initializing the inflate stream.");
+		}
+		if constexpr (has_sink_h()) {
+			if (m_buff == nullptr) {
+				m_buff = new char [m_buff_len];
+			}
+		}
+	}
+
+	// Inflate the available input.
+	void	run_h() {
+		while (true) {
+			Length avail = m_buff_len;
+			if constexpr (has_sink_h()) {
+				m_stream->next_out = reinterpret_cast<Bytef*>(m_buff);
+			} else {
+				avail = m_output.capacity() - m_output.len();
+				if (avail < 256) {
+					m_output.expand(1024);
+					avail = m_output.capacity() - m_output.len();
+				}
+				if (avail > UINT_MAX) { avail = UINT_MAX; }
+				m_stream->next_out = reinterpret_cast<Bytef*>(m_output.data() + m_output.len());
+			}
+			m_stream->avail_out = (uint) avail;
+			const int status = ::inflate(m_stream, Z_NO_FLUSH);
+			switch (status) {
+				case Z_NEED_DICT:
+				case Z_DATA_ERROR:
+				case Z_MEM_ERROR:
+				case Z_STREAM_ERROR:
+					throw CompressionError("Encoutered an error while decompressing.");
+				default:
+					break;
+			}
+			const Length produced = avail - m_stream->avail_out;
+			if constexpr (has_sink_h()) {
+				if (produced > 0) {
+					m_sink->write(m_buff, produced);
+				}
+			} else {
+				m_output.len() += produced;
+			}
+			if (status == Z_STREAM_END) {
+				m_finished = true;
+				if (m_stream->avail_in == 0) { return ; }
+				::inflateReset(m_stream);
+				m_finished = false;
+				continue;
+			}
+			if (m_stream->avail_out != 0) { return ; }
+		}
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Constructor.
+	/*  @docs
+	 *	@title: Constructor
+	 *	@description:
+	 *	    Construct an inflater, optionally with a sink.
+	 *	@parameter:
+	 *	    @name: window_bits
+	 *	    @description: The window bits, `47` to detect gzip and zlib, `-15` for raw deflate.
+	 *	@parameter:
+	 *	    @name: buffer_len
+	 *	    @description: The length of the output buffer of the sink.
+	 *	@funcs: 2
+	 */
+	Inflater(int window_bits = 47) :
+	m_buff_len(0),
+	m_window_bits(window_bits)
+	{ init_h(); }
+	Inflater(Sink& sink, int window_bits = 47, Length buffer_len = 64 * 1024) requires (!is_Null<Sink>::value) :
+	m_sink(&sink),
+	m_buff_len(buffer_len),
+	m_window_bits(window_bits)
+	{ init_h(); }
+
+	// Move constructor.
+	Inflater(This&& obj) :
+	m_stream(obj.m_stream),
+	m_sink(obj.m_sink),
+	m_buff(obj.m_buff),
+	m_buff_len(obj.m_buff_len),
+	m_output(move(obj.m_output)),
+	m_window_bits(obj.m_window_bits),
+	m_finished(obj.m_finished)
+	{
+		obj.m_stream = nullptr;
+		obj.m_buff = nullptr;
+	}
+
+	// No copy constructor.
+	Inflater(const This&) = delete;
+
+	// Destructor.
+	~Inflater() {
+		if (m_stream != nullptr) {
+			::inflateEnd(m_stream);
+			delete m_stream;
+		}
+		delete[] m_buff;
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Write.
+	/*  @docs
+	 *	@title: Write
+	 *	@description:
+	 *	    Decompress a chunk of input.
+	 *	@funcs: 2
+	 */
+	This&	write(const String& data) {
+		return write(data.data(), data.len());
+	}
+	This&	write(const char* data, Length len) {
+		while (len > 0) {
+			const uint chunk = len > UINT_MAX ? UINT_MAX : (uint) len;
+			m_stream->next_in = reinterpret_cast<z_const Bytef*>((char*) data);
+			m_stream->avail_in = chunk;
+			run_h();
+			data += chunk;
+			len -= chunk;
+		}
+		return *this;
+	}
+
+	// Finished.
+	/*  @docs
+	 *	@title: Finished
+	 *	@description:
+	 *	    Check if the end of a message has been reached.
+	 */
+	constexpr
+	bool	finished() const {
+		return m_finished;
+	}
+
+	// Reset.
+	/*  @docs
+	 *	@title: Reset
+	 *	@description:
+	 *	    Reset the stream for the next message and discard the collected output.
+	 *	@funcs: 2
+	 */
+	This&	reset() {
+		::inflateReset(m_stream);
+		m_output.reset();
+		m_finished = false;
+		return *this;
+	}
+	This&	reset(int window_bits) {
+		if (window_bits == m_window_bits) {
+			return reset();
+		}
+		::inflateEnd(m_stream);
+		delete m_stream;
+		m_stream = nullptr;
+		m_window_bits = window_bits;
+		m_output.reset();
+		m_finished = false;
+		init_h();
+		return *this;
+	}
+
+	// Output.
+	/*  @docs
+	 *	@title: Output
+	 *	@description:
+	 *	    Get the collected output when no sink is used.
+	 */
+	constexpr
+	String&	output() requires (is_Null<Sink>::value) {
+		return m_output;
+	}
+
+	// Total input length.
+	constexpr
+	Length	total_in() const { return m_stream->total_in; }
+
+	// Total output length.
+	constexpr
+	Length	total_out() const { return m_stream->total_out; }
+
+};
+
+// End namespace compression.
+};
+
 // ---------------------------------------------------------
 // Compression struct.
 /*  @docs
@@ -77,6 +614,169 @@ struct Compression {
 	// Static attributes.
 	SICE uint 	m_limit = limits<uint>::max;
 
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// The work of the parallel blocks.
+	// - The outputs are a ring of "window" slots, block "i" is stored in slot "i % window".
+	// - A block is only claimed once the previous block of its slot has been emitted, which bounds the memory to the window.
+	struct Job {
+		const char*		data;
+		Length			len;
+		Length			block_len;
+		ullong			blocks;					// the total number of blocks.
+		ullong			window;					// the number of slots.
+		ullong			next;					// the next block to compress.
+		ullong			emitted;				// the number of emitted blocks.
+		ullong*			done;					// the compressed block plus one per slot.
+		String*			outputs;				// the output per slot.
+		uint*			crcs;					// the crc per slot.
+		int				level;
+		bool			error;
+		bool			stop;
+	};
+
+	// Claim and deflate the next block when its slot is free.
+	// - Every block is raw deflate ending with a sync flush so the blocks can be concatenated, the last block of the data finishes the stream.
+	// - Returns false when no block could be claimed.
+	static
+	bool	deflate_block_h(Job* job, z_stream& stream) {
+		ullong block = __atomic_load_n(&job->next, __ATOMIC_RELAXED);
+		do {
+			if (block >= job->blocks || block >= __atomic_load_n(&job->emitted, __ATOMIC_ACQUIRE) + job->window) {
+				return false;
+			}
+		} while (!__atomic_compare_exchange_n(&job->next, &block, block + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+		const ullong slot = block % job->window;
+		const Length start = block * job->block_len;
+		const Length len = job->len - start < job->block_len ? job->len - start : job->block_len;
+		::deflateReset(&stream);
+		if (start > 0) {
+			const Length dict = start < 32768 ? start : 32768;
+			::deflateSetDictionary(&stream, reinterpret_cast<const Bytef*>(job->data + start - dict), (uint) dict);
+		}
+		String& output = job->outputs[slot];
+		output.reset();
+		output.expand(::deflateBound(&stream, (uLong) len) + 16);
+		stream.next_in = reinterpret_cast<z_const Bytef*>((char*) job->data + start);
+		stream.avail_in = (uint) len;
+		const int flush = block + 1 == job->blocks ? Z_FINISH : Z_SYNC_FLUSH;
+		do {
+			if (output.capacity() - output.len() < 64) {
+				output.expand(1024);
+			}
+			const Length avail = output.capacity() - output.len();
+			stream.next_out = reinterpret_cast<Bytef*>(output.data() + output.len());
+			stream.avail_out = (uint) avail;
+			::deflate(&stream, flush);
+			output.len() += avail - stream.avail_out;
+		} while (stream.avail_out == 0);
+		job->crcs[slot] = (uint) ::crc32(0, reinterpret_cast<const Bytef*>(job->data + start), (uint) len);
+		__atomic_store_n(&job->done[slot], block + 1, __ATOMIC_RELEASE);
+		return true;
+	}
+
+	// Deflate blocks until none are left, run by the worker threads.
+	static
+	void	deflate_blocks_h(Job* job) {
+		z_stream stream {};
+		if (::deflateInit2(&stream, job->level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+			__atomic_store_n(&job->error, true, __ATOMIC_RELAXED);
+			return ;
+		}
+		while (__atomic_load_n(&job->next, __ATOMIC_RELAXED) < job->blocks && !__atomic_load_n(&job->stop, __ATOMIC_RELAXED)) {
+			if (!deflate_block_h(job, stream)) {
+				sched_yield(); // wait until a slot has been emitted.
+			}
+		}
+		::deflateEnd(&stream);
+	}
+
+	// Compress in parallel and emit the gzip or raw deflate stream in order.
+	// - The workers are started once, the calling thread emits the blocks in order and deflates blocks itself while it waits.
+	// - Returns the crc32 of the uncompressed data.
+	template <typename Emit>
+	uint	parallel_h(const char* data, Length len, ullong threads, Length block_len, bool gzip, Emit&& emit) const {
+
+		// Threads and blocks.
+		if (threads == 0) {
+			const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+			threads = cpus > 0 ? (ullong) cpus : 1;
+		}
+		if (block_len < 32768) { block_len = 32768; }
+		if (block_len > UINT_MAX / 2) { block_len = UINT_MAX / 2; }
+		const ullong blocks = (len + block_len - 1) / block_len;
+		if (threads > blocks) { threads = blocks; }
+		const ullong window = threads * 4 < blocks ? threads * 4 : blocks;
+
+		// Header.
+		if (gzip) {
+			const char header[10] = {'\x1f', '\x8b', 8, 0, 0, 0, 0, 0, 0, 3};
+			emit(header, 10);
+		}
+
+		// Start the workers.
+		Array<String> outputs;
+		outputs.fill_r(window, String());
+		Array<uint> crcs;
+		crcs.fill_r(window, 0);
+		Array<ullong> done;
+		done.fill_r(window, 0);
+		Job job { data, len, block_len, blocks, window, 0, 0, done.data(), outputs.data(), crcs.data(), m_level, false, false };
+		z_stream stream {};
+		if (blocks > 0 && ::deflateInit2(&stream, m_level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+			throw DeflateError(deflate_err);
+		}
+		Array<FThread> workers;
+		for (ullong i = 1; i < threads; ++i) {
+			workers.append(FThread());
+			workers.last().start([](Job* job) -> void* {
+				deflate_blocks_h(job);
+				return nullptr;
+			}, &job);
+		}
+		auto stop = [&]() {
+			__atomic_store_n(&job.stop, true, __ATOMIC_RELAXED);
+			for (auto& worker: workers) { worker.join(); }
+			if (blocks > 0) { ::deflateEnd(&stream); }
+		};
+
+		// Emit the blocks in order.
+		uLong crc = ::crc32(0, Z_NULL, 0);
+		try {
+			for (ullong block = 0; block < blocks; ++block) {
+				const ullong slot = block % window;
+				while (__atomic_load_n(&done[slot], __ATOMIC_ACQUIRE) != block + 1) {
+					if (__atomic_load_n(&job.error, __ATOMIC_RELAXED)) {
+						throw DeflateError(deflate_err);
+					}
+					if (!deflate_block_h(&job, stream)) {
+						sched_yield(); // wait for a worker.
+					}
+				}
+				const Length block_size = len - block * block_len < block_len ? len - block * block_len : block_len;
+				emit(outputs[slot].data(), outputs[slot].len());
+				crc = ::crc32_combine(crc, crcs[slot], (z_off_t) block_size);
+				__atomic_store_n(&job.emitted, block + 1, __ATOMIC_RELEASE);
+			}
+		} catch (...) {
+			stop();
+			throw;
+		}
+		stop();
+
+		// Trailer.
+		if (gzip) {
+			char trailer[8];
+			for (int i = 0; i < 4; ++i) {
+				trailer[i] = (char) ((crc >> (8 * i)) & 0xff);
+				trailer[4 + i] = (char) ((len >> (8 * i)) & 0xff);
+			}
+			emit(trailer, 8);
+		}
+		return (uint) crc;
+	}
+
 	// ---------------------------------------------------------
 	// Constructor.
 
@@ -160,50 +860,11 @@ struct Compression {
         // Zero.
         if (len == 0) { return String(); }
 
-        // Init.
-        z_stream deflate_s;
-        deflate_s.zalloc = Z_NULL;
-        deflate_s.zfree = Z_NULL;
-        deflate_s.opaque = Z_NULL;
-        deflate_s.avail_in = 0;
-        deflate_s.next_in = Z_NULL;
-
-        // Init.
-        if (deflateInit2(&deflate_s, m_level, Z_DEFLATED, window_bits, mem_level, Z_DEFAULT_STRATEGY) != Z_OK) {
-            throw DeflateError(deflate_err);
-        }
-
-        // Deflate.
-        ullong _len = len;
-        uint chunk_size = UINT_MAX, chunk = 0;
-        String output;
-        deflate_s.next_in = reinterpret_cast<z_const Bytef*>((char*) data);
-        deflate_s.avail_in = 0;
-        do {
-            
-            // Set avail in.
-            if (deflate_s.avail_in == 0) {
-                chunk = _len > chunk_size ? chunk_size : static_cast<uint>(_len);
-                _len -= chunk;
-                deflate_s.avail_in = chunk;
-            }
-            
-            // Expand.
-            output.expand(chunk);
-            
-            // Set out.
-            deflate_s.avail_out = chunk;
-            deflate_s.next_out = reinterpret_cast<Bytef*>((output.data() + output.len()));
-            
-            // Deflate.
-            deflate(&deflate_s, _len ? Z_FULL_FLUSH : Z_FINISH);
-            
-            // Add length.
-            output.len() += (chunk - deflate_s.avail_out);
-            
-        } while (_len && deflate_s.avail_in == 0);
-        deflateEnd(&deflate_s);
-        return output;
+        // Deflate with the reused stream of the thread.
+        static thread_local compression::Deflater<> deflater (m_level, window_bits, mem_level);
+        deflater.reset(m_level, window_bits, mem_level);
+        deflater.write(data, len).finish();
+        return move(deflater.output());
         
         
         /*
@@ -312,55 +973,12 @@ struct Compression {
         
         // Zero.
         if (len == 0) { return String(); }
-        
-        // Vars.
-        String output;
-        z_stream inflate_s;
-        inflate_s.zalloc = Z_NULL;
-        inflate_s.zfree = Z_NULL;
-        inflate_s.opaque = Z_NULL;
-        inflate_s.avail_in = 0;
-        inflate_s.next_in = Z_NULL;
-
-        // Init.
-        if (inflateInit2(&inflate_s, window_bits) != Z_OK) {
-            throw InflateError(inflate_err);
-        }
 
-        // Deflate.
-        ullong _len = len;
-        uint chunk_size = UINT_MAX, chunk = 0;
-        inflate_s.next_in = reinterpret_cast<z_const Bytef*>((char*) data);
-        inflate_s.avail_in = 0;
-        do {
-            
-            // Set avail in.
-            if (inflate_s.avail_in == 0) {
-                chunk = _len > chunk_size ? chunk_size : static_cast<uint>(_len);
-                _len -= chunk;
-                inflate_s.avail_in = chunk;
-            }
-            
-            // Expand.
-            output.expand(chunk);
-            
-            // Set out.
-            inflate_s.avail_out = chunk;
-            inflate_s.next_out = reinterpret_cast<Bytef*>(output.data() + output.len());
-            
-            // Inflate.
-            int ret = inflate(&inflate_s, _len ? Z_FULL_FLUSH : Z_FINISH);
-            if (ret != Z_STREAM_END && ret != Z_OK && ret != Z_BUF_ERROR) {
-                inflateEnd(&inflate_s);
-                throw CompressionError(decompress_err);
-            }
-            
-            // Set len.
-            output.len() += (chunk - inflate_s.avail_out);
-            
-        } while (inflate_s.avail_out == 0);
-        inflateEnd(&inflate_s);
-        return output;
+        // Inflate with the reused stream of the thread.
+        static thread_local compression::Inflater<> inflater (window_bits);
+        inflater.reset(window_bits);
+        inflater.write(data, len);
+        return move(inflater.output());
         
         /*
         if (len == 0) { return String(); }
@@ -425,6 +1043,75 @@ struct Compression {
         
 	}
 
+	// Compress in parallel.
+    /*  @docs
+	 *	@title: Compress parallel
+	 *	@description:
+	 *	    Compress data to gzip on multiple threads.
+	 *
+	 *	    The data is split into blocks that are deflated concurrently, every block is primed with the last 32KB of the previous block so the ratio stays close to a single stream. The output is a standard gzip stream that can be decompressed with `decompress()`.
+	 *
+	 *	    With a sink the blocks are written into `sink.write(data, len)` in order while the threads compress at most four blocks per thread ahead, so only the output of those blocks is kept in memory.
+	 *	@parameter:
+	 *	    @name: data
+	 *	    @description: The data to compress.
+	 *	@parameter:
+	 *	    @name: threads
+	 *	    @description: The number of threads, `0` for the number of online processors.
+	 *	@parameter:
+	 *	    @name: block_len
+	 *	    @description: The length of a single block.
+	 *	@usage:
+	 *	    vlib::Compression compression;
+	 *	    vlib::File::View view = vlib::File("/tmp/dump.csv").view();
+	 *	    vlib::File output ("/tmp/dump.csv.gz", vlib::file::mode::write);
+	 *	    compression.compress_parallel(output, view.data(), view.len());
+	 *	@funcs: 3
+     */
+    String  compress_parallel(const String& data, ullong threads = 0, Length block_len = 128 * 1024) const {
+        return compress_parallel(data.data(), data.len(), threads, block_len);
+    }
+    String  compress_parallel(const char* data, Length len, ullong threads = 0, Length block_len = 128 * 1024) const {
+        String output;
+        if (len == 0) { return output; }
+        parallel_h(data, len, threads, block_len, true, [&output](const char* arr, Length arr_len) {
+            output.concat_r(arr, arr_len);
+        });
+        return output;
+    }
+    template <typename Sink>
+    void    compress_parallel(Sink& sink, const char* data, Length len, ullong threads = 0, Length block_len = 128 * 1024) const {
+        if (len == 0) { return ; }
+        parallel_h(data, len, threads, block_len, true, [&sink](const char* arr, Length arr_len) {
+            sink.write(arr, arr_len);
+        });
+    }
+
+	// Deflate in parallel.
+    /*  @docs
+	 *	@title: Deflate parallel
+	 *	@description:
+	 *	    Compress data to a raw deflate stream on multiple threads and write it into `sink.write(data, len)`.
+	 *
+	 *	    Equal to `compress_parallel()` without the gzip header and trailer, for containers that store raw deflate data such as zip archives. The data may not be empty.
+	 *	@return:
+	 *	    Returns the CRC-32 of the uncompressed data.
+	 *	@usage:
+	 *	    vlib::Compression compression;
+	 *	    vlib::File::View view = vlib::File("/tmp/dump.csv").view();
+	 *	    vlib::File output ("/tmp/dump.deflate", vlib::file::mode::write);
+	 *	    uint crc = compression.deflate_parallel(output, view.data(), view.len());
+     */
+    template <typename Sink>
+    uint    deflate_parallel(Sink& sink, const char* data, Length len, ullong threads = 0, Length block_len = 128 * 1024) const {
+        if (len == 0) {
+            throw InvalidUsageError("The data to deflate may not be empty.");
+        }
+        return parallel_h(data, len, threads, block_len, false, [&sink](const char* arr, Length arr_len) {
+            sink.write(arr, arr_len);
+        });
+    }
+
 	// Is compressed.
     /*  @docs
      *	@title: Is compressed
@@ -37,6 +37,8 @@ namespace vlib {
  *          - ZIP64 extended information extra field.
  *          - Info-ZIP Unix Extra Field (type 2).
  *      All unsupported extra fields are silently ignored.
+ *
+ *      Use `Zip::Writer` to stream large archives to disk while compressing in parallel, and `Zip::Reader` to read single entries through the central directory without loading the archive.
  *  @usage:
  *      #include <vlib/compression.h>
  *      vlib::Zip zip;
@@ -221,16 +223,22 @@ private:
     // Private functions.
     
     // Compute CRC-32.
+    // - Updated in chunks since zlib takes 32 bit lengths.
     static
     uint32_t calc_crc32(const char* data, ullong len) {
         uLong crc = crc32(0L, Z_NULL, 0);
-        crc = crc32(crc, (uchar*) data, (uint32_t) len);
+        while (len > 0) {
+            const uint32_t chunk = len > UINT32_MAX ? UINT32_MAX : (uint32_t) len;
+            crc = crc32(crc, (uchar*) data, chunk);
+            data += chunk;
+            len -= chunk;
+        }
         return (uint32_t) crc;
     }
 
     // Write local file header for a file entry
-    template <typename Stream> requires (is_File<Stream>::value || is_Stream<Stream>::value)
-    void    write_fheader(Stream& stream, const Entry& entry) const {
+    template <typename Stream> static
+    void    write_fheader(Stream& stream, Entry& entry) {
         
         // Default headers.
         SCE uint16_t        version = 45;
@@ -293,8 +301,8 @@ private:
     }
 
     // Write central directory file header for a file entry
-    template <typename Stream> requires (is_File<Stream>::value || is_Stream<Stream>::value)
-    void    write_cdheader(Stream& stream, const Entry& entry) const {
+    template <typename Stream> static
+    void    write_cdheader(Stream& stream, Entry& entry) {
         
         // Default headers.
         SCE uint16_t        made_version = 0x0345; // 03 unix for file permissions and zip version 45.
@@ -326,23 +334,23 @@ private:
         const uint16_t&     gid = entry.gid;
         
         // Write header.
-        stream.write((typename Stream::Type*) &cd_header_signature, sizeof(cd_header_signature));
-        stream.write((typename Stream::Type*) &made_version, sizeof(made_version));
-        stream.write((typename Stream::Type*) &version, sizeof(version));
-        stream.write((typename Stream::Type*) &general_flag, sizeof(general_flag));
-        stream.write((typename Stream::Type*) &compression_method, sizeof(compression_method));
-        stream.write((typename Stream::Type*) &mod_time, sizeof(mod_time));
-        stream.write((typename Stream::Type*) &mod_date, sizeof(mod_date));
-        stream.write((typename Stream::Type*) &crc, sizeof(crc));
-        stream.write((typename Stream::Type*) &compressed_len, sizeof(compressed_len));
-        stream.write((typename Stream::Type*) &uncompressed_len, sizeof(uncompressed_len));
-        stream.write((typename Stream::Type*) &name_len, sizeof(name_len));
-        stream.write((typename Stream::Type*) &extra_field_len, sizeof(extra_field_len));
-        stream.write((typename Stream::Type*) &comment_len, sizeof(comment_len));
-        stream.write((typename Stream::Type*) &disk, sizeof(disk));
-        stream.write((typename Stream::Type*) &internal_file_attr, sizeof(internal_file_attr));
-        stream.write((typename Stream::Type*) &external_file_attr, sizeof(external_file_attr));
-        stream.write((typename Stream::Type*) &offset, sizeof(offset));
+        stream.write((char*) &cd_header_signature, sizeof(cd_header_signature));
+        stream.write((char*) &made_version, sizeof(made_version));
+        stream.write((char*) &version, sizeof(version));
+        stream.write((char*) &general_flag, sizeof(general_flag));
+        stream.write((char*) &compression_method, sizeof(compression_method));
+        stream.write((char*) &mod_time, sizeof(mod_time));
+        stream.write((char*) &mod_date, sizeof(mod_date));
+        stream.write((char*) &crc, sizeof(crc));
+        stream.write((char*) &compressed_len, sizeof(compressed_len));
+        stream.write((char*) &uncompressed_len, sizeof(uncompressed_len));
+        stream.write((char*) &name_len, sizeof(name_len));
+        stream.write((char*) &extra_field_len, sizeof(extra_field_len));
+        stream.write((char*) &comment_len, sizeof(comment_len));
+        stream.write((char*) &disk, sizeof(disk));
+        stream.write((char*) &internal_file_attr, sizeof(internal_file_attr));
+        stream.write((char*) &external_file_attr, sizeof(external_file_attr));
+        stream.write((char*) &offset, sizeof(offset));
 
         // File name
         stream.write(entry.name.data(), entry.name.len());
@@ -355,61 +363,61 @@ private:
         
         // Zip64 extented info.
         // Should be last.
-        stream.write((typename Stream::Type*) &extf_zip64_signature, sizeof(extf_zip64_signature));
-        stream.write((typename Stream::Type*) &extf_zip64_size, sizeof(extf_zip64_size));
-        stream.write((typename Stream::Type*) &zip64_uncompressed_len, sizeof(zip64_uncompressed_len));
-        stream.write((typename Stream::Type*) &zip64_compressed_len, sizeof(zip64_compressed_len));
-        stream.write((typename Stream::Type*) &zip64_offset, sizeof(zip64_offset));
+        stream.write((char*) &extf_zip64_signature, sizeof(extf_zip64_signature));
+        stream.write((char*) &extf_zip64_size, sizeof(extf_zip64_size));
+        stream.write((char*) &zip64_uncompressed_len, sizeof(zip64_uncompressed_len));
+        stream.write((char*) &zip64_compressed_len, sizeof(zip64_compressed_len));
+        stream.write((char*) &zip64_offset, sizeof(zip64_offset));
         
     }
     
     // Write end of central directory recod.
-    template <typename Stream> requires (is_File<Stream>::value || is_Stream<Stream>::value)
-    void    write_eocd64(Stream& stream) const {
+    template <typename Stream> static
+    void    write_eocd64(Stream& stream, const Archive& archive) {
         
         // Vars.
         SCE uint64_t        remaining_size = 44;
         SCE uint16_t        made_version = 0x0345; // 03 unix for file permissions and zip version 45.
         SCE uint16_t        version = 45;
-        const uint32_t&     disk = m_archive.disk;
-        const uint32_t&     start_disk = m_archive.disk;
-        const uint64_t&     disk_entries = m_archive.entries.len();
-        const uint64_t&     entries = m_archive.entries.len();
-        const uint64_t&     size = m_archive.cd_size;
-        const uint64_t&     offset = m_archive.cd_offset;
+        const uint32_t&     disk = archive.disk;
+        const uint32_t&     start_disk = archive.disk;
+        const uint64_t&     disk_entries = archive.entries.len();
+        const uint64_t&     entries = archive.entries.len();
+        const uint64_t&     size = archive.cd_size;
+        const uint64_t&     offset = archive.cd_offset;
         
         // Write.
-        stream.write((typename Stream::Type*) &eocd64_signature, sizeof(eocd64_signature));
-        stream.write((typename Stream::Type*) &remaining_size, sizeof(remaining_size));
-        stream.write((typename Stream::Type*) &made_version, sizeof(made_version));
-        stream.write((typename Stream::Type*) &version, sizeof(version));
-        stream.write((typename Stream::Type*) &disk, sizeof(disk));
-        stream.write((typename Stream::Type*) &start_disk, sizeof(start_disk));
-        stream.write((typename Stream::Type*) &disk_entries, sizeof(disk_entries));
-        stream.write((typename Stream::Type*) &entries, sizeof(entries));
-        stream.write((typename Stream::Type*) &size, sizeof(size));
-        stream.write((typename Stream::Type*) &offset, sizeof(offset));
+        stream.write((char*) &eocd64_signature, sizeof(eocd64_signature));
+        stream.write((char*) &remaining_size, sizeof(remaining_size));
+        stream.write((char*) &made_version, sizeof(made_version));
+        stream.write((char*) &version, sizeof(version));
+        stream.write((char*) &disk, sizeof(disk));
+        stream.write((char*) &start_disk, sizeof(start_disk));
+        stream.write((char*) &disk_entries, sizeof(disk_entries));
+        stream.write((char*) &entries, sizeof(entries));
+        stream.write((char*) &size, sizeof(size));
+        stream.write((char*) &offset, sizeof(offset));
     }
     
     // Write end of central directory locator.
-    template <typename Stream> requires (is_File<Stream>::value || is_Stream<Stream>::value)
-    void    write_eocl64(Stream& stream) const {
+    template <typename Stream> static
+    void    write_eocl64(Stream& stream, const Archive& archive) {
         
         // Vars.
-        const uint32_t&     disk = m_archive.disk;
-        const uint64_t&     offset = m_archive.eocd_offset;
-        const uint32_t&     disks = m_archive.disk + 1;
+        const uint32_t&     disk = archive.disk;
+        const uint64_t&     offset = archive.eocd_offset;
+        const uint32_t&     disks = archive.disk + 1;
         
         // Write.
-        stream.write((typename Stream::Type*) &eocl64_signature, sizeof(eocl64_signature));
-        stream.write((typename Stream::Type*) &disk, sizeof(disk));
-        stream.write((typename Stream::Type*) &offset, sizeof(offset));
-        stream.write((typename Stream::Type*) &disks, sizeof(disks));
+        stream.write((char*) &eocl64_signature, sizeof(eocl64_signature));
+        stream.write((char*) &disk, sizeof(disk));
+        stream.write((char*) &offset, sizeof(offset));
+        stream.write((char*) &disks, sizeof(disks));
     }
     
     // Write end of central directory record
-    template <typename Stream> requires (is_File<Stream>::value || is_Stream<Stream>::value)
-    void    write_eocd(Stream& stream) const {
+    template <typename Stream> static
+    void    write_eocd(Stream& stream) {
         
         // Vars.
         SCE uint16_t   disk = UINT16_MAX;
@@ -421,21 +429,21 @@ private:
         SCE uint16_t   comment_len = 0;
         
         // Write header.
-        stream.write((typename Stream::Type*) &eocd_signature, sizeof(eocd_signature));
-        stream.write((typename Stream::Type*) &disk, sizeof(disk));
-        stream.write((typename Stream::Type*) &start_central_disk, sizeof(start_central_disk));
-        stream.write((typename Stream::Type*) &disk_entries, sizeof(disk_entries));
-        stream.write((typename Stream::Type*) &entries, sizeof(entries));
-        stream.write((typename Stream::Type*) &size, sizeof(size));
-        stream.write((typename Stream::Type*) &offset, sizeof(offset));
-        stream.write((typename Stream::Type*) &comment_len, sizeof(comment_len));
+        stream.write((char*) &eocd_signature, sizeof(eocd_signature));
+        stream.write((char*) &disk, sizeof(disk));
+        stream.write((char*) &start_central_disk, sizeof(start_central_disk));
+        stream.write((char*) &disk_entries, sizeof(disk_entries));
+        stream.write((char*) &entries, sizeof(entries));
+        stream.write((char*) &size, sizeof(size));
+        stream.write((char*) &offset, sizeof(offset));
+        stream.write((char*) &comment_len, sizeof(comment_len));
         
     }
     
     // Read a local file header.
     // The start parameter should be the start idnex of the signature.
     // Returns the amount of readed bytes.
-    constexpr
+    static constexpr
     ullong  read_fheader(Entry& entry, const char* data, ullong start) {
         
         // Vars.
@@ -501,7 +509,7 @@ private:
     // Read a central directory header.
     // The start parameter should be the start idnex of the signature.
     // Returns the amount of readed bytes.
-    constexpr
+    static constexpr
     ullong  read_cdheader(Entry& entry, const char* data, ullong start) {
         
         // Vars.
@@ -579,7 +587,7 @@ private:
     }
     
     // Read the EOCD64.
-    constexpr
+    static constexpr
     ullong  read_eocd64(Archive& archive, const char* data, ullong start) {
         
         // Vars.
@@ -640,7 +648,7 @@ private:
     }
     
     // Read the EOCL64.
-    constexpr
+    static constexpr
     ullong  read_eocl64(Archive& archive, const char* data, ullong start) {
         
         // Vars.
@@ -666,7 +674,7 @@ private:
     }
     
     // Read the EOCD.
-    constexpr
+    static constexpr
     ullong  read_eocd(Archive& archive, const char* data, ullong start) {
         
         // Vars.
@@ -710,7 +718,7 @@ private:
         
         // Offset.
         offset = *((uint32_t*) &data[pos]);
-        if (size != UINT32_MAX) {
+        if (offset != UINT32_MAX) {
             archive.cd_offset = offset;
         }
         pos += sizeof(uint32_t);
@@ -728,7 +736,7 @@ private:
     
     // Read extra fields.
     // The start parameter indicates the start index of the extra fields.
-    constexpr
+    static constexpr
     void    read_extra_fields(Entry& entry, const char* data, ullong start, uint extra_field_len) {
         
         // Vars.
@@ -818,6 +826,117 @@ private:
         return archive.entries[0];
     }
     
+    // Check if a file extension belongs to an already compressed format.
+    static
+    bool    compressed_extension(const String& extension) {
+		static Array<String> compressed_file_extensions = {
+			"zip", "7z", "rar", "gz", "bz2", "xz", "tar", "tgz", "tbz2", "txz",
+			"jpg", "jpeg", "png", "gif", "bmp", "tif", "tiff", "webp",
+			"mp3", "aac", "wav", "flac", "ogg", "wma",
+			"mp4", "mkv", "avi", "mov", "wmv", "flv", "webm",
+			"pdf", "doc", "docx", "xls", "xlsx", "ppt", "pptx",
+			"exe", "dll", "so", "dylib", "jar",
+			"apk", "ipa", "appx", "appxbundle",
+			"iso", "img", "dmg",
+			"ttf", "otf", "woff", "woff2",
+			"swf", "svg",
+			"db", "dbf", "mdb", "accdb", "sqlite", "xlsb",
+			"ico", "cur",
+			"xml", "json", "csv",
+			"epub", "mobi",
+			"psd", "ai",
+			"log", "bak",
+			"zipx", "lzma", "z", "arj", "lzh", "cab", "hqx", "sit", "sitx", "gz", "tgz",
+			"bz2", "tbz", "tbz2", "xz", "txz", "lz", "tlz", "lzma", "tlzma", "lz4", "tlz4",
+			"lzo", "tlzo", "sz", "tsz", "zst", "tzst", "zstd", "tzstd", "rar", "zoo",
+			"iso", "img", "dmg", "vhd", "vmdk", "vdi", "hdd", "qcow", "qcow2",
+			"ppt", "pptx", "pps", "ppsx", "pot", "potx", "odp", "otp",
+			"xls", "xlsx", "xlm", "xlsm", "xlt", "xltx", "ods", "ots",
+			"doc", "docx", "dot", "dotx", "odt", "ott",
+			"msg", "pst", "eml",
+			"swf", "fla",
+			"max", "obj", "fbx", "3ds", "dae",
+			"svg", "eps", "ai",
+			"cdr", "cmx", "emf", "wmf",
+			"exe", "dll", "sys", "ocx",
+			"ttf", "otf", "fon",
+			"avi", "wmv", "mpg", "mpeg", "mkv", "mp4", "m4v", "flv", "f4v",
+			"vob", "mov", "3gp", "webm", "swf",
+			"m4a", "aac", "mp3", "wav", "wma", "ogg", "flac", "alac", "aiff"
+		};
+        return compressed_file_extensions.contains(extension);
+    }
+    
+    // Create an entry with the metadata of a path.
+    static
+    Entry   metadata(const String& name, Path& path) {
+        
+        // Check existance.
+        if (!path.exists()) {
+            throw FileNotFoundError("File \"", path, "\" does not exist.");
+        }
+        
+        // Permission.
+        struct stat stat_info;
+        if (::lstat(path.c_str(), &stat_info) == -1) {
+            throw ParseError(to_str("Unable to parse path \"", path, "\"."));
+        }
+        
+        // Mod time and mod date.
+        time_t sec = path.mtime() / 1000;
+		struct tm time_info;
+		localtime_r(&sec, &time_info);
+        
+        // Entry.
+        return Entry{
+            .offset = 0, // will be assigned later.
+            .mode = (uint16_t) stat_info.st_mode,
+            .uid = (uint16_t) path.uid(),
+            .gid = (uint16_t) path.gid(),
+            .mod_time = (uint16_t) ((time_info.tm_hour << 11) | (time_info.tm_min << 5)),
+            .mod_date = (uint16_t) (((time_info.tm_year + 1900 - 1980) << 9) | ((time_info.tm_mon + 1) << 5) | time_info.tm_mday),
+            .compression_method = 0,
+            .name = name,
+            .data = String(),
+        };
+    }
+    
+    // Assign the data of an entry, the data is only deflated when that is useful.
+    static
+    void    compress_entry(Entry& entry, String&& data, const String& extension, const Compression& compression) {
+        entry.uncompressed_len = data.len();
+        entry.crc = calc_crc32(data.data(), data.len());
+        if (vlib::is_compressed(data) || entry.uncompressed_len < 256 || compressed_extension(extension)) {
+            entry.data = move(data);
+            entry.compression_method = 0;
+        } else {
+            entry.data = compression.compress(
+                data.data(),
+                data.len(),
+                -15 // window bits should be -15 for raw deflate.
+            );
+            entry.compression_method = 8; // deflate.
+        }
+        entry.compressed_len = entry.data.len();
+    }
+    
+    // Check the CRC-32 of extracted data.
+    static
+    void    check_crc(const Entry& entry, uint32_t crc) {
+        if (entry.crc != 0 && crc != entry.crc) {
+            throw CRCError("Invalid CRC-32 \"", crc, "\", should be \"", entry.crc, "\".");
+        }
+    }
+    
+    // Assign the mtime, permission and owner of an extracted entry.
+    static
+    void    set_metadata(Path& dest, const Entry& entry) {
+        time_t mtime = entry.mtime().value();
+        dest.set_time(mtime, mtime);
+        dest.chmod(entry.permission().value());
+        dest.chown(entry.uid, entry.gid);
+    }
+    
 // Public.
 public:
     
@@ -1006,123 +1125,20 @@ public:
      *  @funcs: 2
      */
 	auto&	add(const String& name, Path& path) {
-		
-		// Already compressed file extensions.
-		static Array<String> compressed_file_extensions = {
-			"zip", "7z", "rar", "gz", "bz2", "xz", "tar", "tgz", "tbz2", "txz",
-			"jpg", "jpeg", "png", "gif", "bmp", "tif", "tiff", "webp",
-			"mp3", "aac", "wav", "flac", "ogg", "wma",
-			"mp4", "mkv", "avi", "mov", "wmv", "flv", "webm",
-			"pdf", "doc", "docx", "xls", "xlsx", "ppt", "pptx",
-			"exe", "dll", "so", "dylib", "jar",
-			"apk", "ipa", "appx", "appxbundle",
-			"iso", "img", "dmg",
-			"ttf", "otf", "woff", "woff2",
-			"swf", "svg",
-			"db", "dbf", "mdb", "accdb", "sqlite", "xlsb",
-			"ico", "cur",
-			"xml", "json", "csv",
-			"epub", "mobi",
-			"psd", "ai",
-			"log", "bak",
-			"zipx", "lzma", "z", "arj", "lzh", "cab", "hqx", "sit", "sitx", "gz", "tgz",
-			"bz2", "tbz", "tbz2", "xz", "txz", "lz", "tlz", "lzma", "tlzma", "lz4", "tlz4",
-			"lzo", "tlzo", "sz", "tsz", "zst", "tzst", "zstd", "tzstd", "rar", "zoo",
-			"iso", "img", "dmg", "vhd", "vmdk", "vdi", "hdd", "qcow", "qcow2",
-			"ppt", "pptx", "pps", "ppsx", "pot", "potx", "odp", "otp",
-			"xls", "xlsx", "xlm", "xlsm", "xlt", "xltx", "ods", "ots",
-			"doc", "docx", "dot", "dotx", "odt", "ott",
-			"msg", "pst", "eml",
-			"swf", "fla",
-			"max", "obj", "fbx", "3ds", "dae",
-			"svg", "eps", "ai",
-			"cdr", "cmx", "emf", "wmf",
-			"exe", "dll", "sys", "ocx",
-			"ttf", "otf", "fon",
-			"avi", "wmv", "mpg", "mpeg", "mkv", "mp4", "m4v", "flv", "f4v",
-			"vob", "mov", "3gp", "webm", "swf",
-			"m4a", "aac", "mp3", "wav", "wma", "ogg", "flac", "alac", "aiff"
-		};
         
 		// Skip directories.
 		if (path.is_dir()) {
 			return *this;
 		}
-		
-        // Check existance.
-        if (!path.exists()) {
-            throw FileNotFoundError("File \"", path, "\" does not exist.");
-        }
-        
-        // UID and GUID.
-        uint16_t uid = path.uid();
-        uint16_t gid = path.gid();
-        
-        // Permission.
-        struct stat stat_info;
-        if (::lstat(path.c_str(), &stat_info) == -1) {
-            throw ParseError(to_str("Unable to parse path \"", path, "\"."));
-        }
-        uint16_t mode = stat_info.st_mode;
         
-        // Mod time and mod date.
-        time_t sec = path.mtime() / 1000;
-		struct tm time_info;
-		localtime_r(&sec, &time_info);
-        uint16_t mod_date = ((time_info.tm_year + 1900 - 1980) << 9) | ((time_info.tm_mon + 1) << 5) | time_info.tm_mday;
-        uint16_t mod_time = (time_info.tm_hour << 11) | (time_info.tm_min << 5);
+        // Metadata.
+        Entry entry = metadata(name, path);
         
         // Data.
-        String compressed;
-        uint64_t uncompressed_len = 0;
-		uint64_t compressed_len = 0;
-		uint16_t compression_method = 0;
-        
-        // CRC.
-        uint32_t crc = 0;
-        
-        // For files.
-        if (!(stat_info.st_mode & S_IFDIR)) {
-            String  data = path.load();
-            uncompressed_len = data.len();
-			crc = calc_crc32(data.data(), data.len());
-			Bool do_not_compress = vlib::is_compressed(data) || uncompressed_len < 256 || compressed_file_extensions.contains(path.extension());
-			
-			// Do not compress.
-			if (do_not_compress) {
-				compressed = move(data);
-				compressed_len = compressed.len();
-				compression_method = 0;
-			}
-			
-			// Compress.
-			else {
-				compressed = m_compression.compress(
-					data.data(),
-					data.len(),
-					-15 // window bits should be -15 for raw deflate.
-				);
-				compressed_len = compressed.len();
-				compression_method = 8; // deflate.
-			}
-        }
-		// "data" is no longer accessable now.
+        compress_entry(entry, path.load(), path.extension(), m_compression);
         
         // Append.
-        m_archive.entries.append(Entry{
-            .offset = 0, // will be assigned later.
-            .mode = mode,
-            .uid = uid,
-            .gid = gid,
-            .mod_time = mod_time,
-            .mod_date = mod_date,
-			.compression_method = compression_method,
-            .compressed_len = compressed_len,
-            .uncompressed_len = uncompressed_len,
-            .crc = (uint32_t) crc,
-            .name = name,
-            .data = compressed,
-        });
+        m_archive.entries.append(move(entry));
         return *this;
     }
 	auto&	add(const String& name, const Path& _path) {
@@ -1175,10 +1191,10 @@ public:
         m_archive.cd_size = m_archive.eocd_offset - m_archive.cd_offset;
         
         // Write zip64 EOCD.
-        write_eocd64(stream);
+        write_eocd64(stream, m_archive);
         
         // Write zip64 EOCL.
-        write_eocl64(stream);
+        write_eocl64(stream, m_archive);
         
         // Write EOCD.
         write_eocd(stream);
@@ -1194,6 +1210,8 @@ public:
      *      Create a zip archive from a source file or directory and write it out to the destination path.
      *
      *      No other functions are required to create a zip archive when using this function.
+     *
+     *      The archive is streamed to the destination with a `Zip::Writer`, so the files are compressed in parallel and the entries do not contain data afterwards.
      *  @type:
      *      Zip&
      *  @parameter:
@@ -1225,46 +1243,32 @@ public:
         reset();
         
         // Vars.
-        Path                source = _source; // Make non const for certain funcs
-        File                file (dest, vlib::file::mode::write);
+        Path source = _source; // Make non const for certain funcs
         
 		// Check source.
 		if (!source.exists()) {
 			throw FileNotFoundError("Source file \"", source, "\" does not exist.");
 		}
-		
-        // Remove and create.
-        if (dest.exists()) {
-            dest.remove();
-        }
         
-        // Open file.
-        file.open();
+        // Stream the archive to the file.
+        Writer writer (dest, 0, m_compression.level());
         
         // Path is a file.
         if (source.is_file()) {
-            add(source.full_name(), source);
+            writer.add(source.full_name(), source);
         }
         
         // Path is a dir.
         else {
             const ullong sub_path_slice = source.len() - source.full_name().len();
             for (auto& path: source.paths(true, exclude, exclude_names)) {
-                add(path.slice(sub_path_slice), path);
+                writer.add(path.slice(sub_path_slice), path);
             }
         }
         
-        // Write the archive.
-        write(file);
-        
-        // Flush to file.
-        file.flush();
-        
-        // Close.
-        file.close();
-		
-		// Set permissions.
-		// Path::chmod(dest.c_str(), 0770);
+        // Write the central directory.
+        writer.close();
+        m_archive.entries = writer.entries();
         
         // Handler.
         return *this;
@@ -1455,35 +1459,22 @@ public:
             
             // Decompress.
             String data;
-            if (entry.compressed_len == 0) {
+            if (entry.compression_method == 0) {
                 data = entry.data;
             } else {
                 data = m_compression.decompress(entry.data.data(), entry.data.len(), -15);
             }
             
             // Check crc.
-            if (entry.crc != 0) {
-                uint32_t crc = calc_crc32(data.data(), data.len());
-                if (crc != entry.crc) {
-                    throw CRCError("Invalid CRC-32 \"", crc, "\", should be \"", entry.crc, "\".");
-                }
-            }
+            check_crc(entry, calc_crc32(data.data(), data.len()));
             
             // Write.
             dest.save(data);
             
         }
         
-        // Set mtime.
-        time_t mtime = entry.mtime().value();
-        dest.set_time(mtime, mtime);
-        
-        // Set permission.
-        ushort permission = entry.permission().value();
-        dest.chmod(permission);
-        
-        // Set uid & gid.
-        dest.chown(entry.uid, entry.gid);
+        // Set mtime, permission, uid & gid.
+        set_metadata(dest, entry);
         
         // Handler.
         return *this;
@@ -1578,19 +1569,14 @@ public:
 			
 			// Decompress.
 			String data;
-			if (entry.compressed_len == 0) {
+			if (entry.compression_method == 0) {
 				data = entry.data;
 			} else {
 				data = m_compression.decompress(entry.data.data(), entry.data.len(), -15);
 			}
 			
 			// Check crc.
-			if (entry.crc != 0) {
-				uint32_t crc = calc_crc32(data.data(), data.len());
-				if (crc != entry.crc) {
-					throw CRCError("Invalid CRC-32 \"", crc, "\", should be \"", entry.crc, "\".");
-				}
-			}
+			check_crc(entry, calc_crc32(data.data(), data.len()));
 			
 			// Store.
 			extracted[entry.name] = move(data);
@@ -1602,6 +1588,623 @@ public:
 		
 	}
     
+    // ---------------------------------------------------------
+    // Streaming.
+    
+    // Streaming archive writer.
+    /*  @docs
+     *  @title: Writer
+     *  @description:
+     *      Create a zip archive by streaming the entries straight to the destination file.
+     *
+     *      Only the metadata of the entries is kept in memory for the central directory. Small files are loaded and deflated in parallel, in windows of at most 64MB, and written in order. Files of at least `parallel_len` bytes are memory mapped and deflated in parallel blocks; the CRC-32 and the ZIP64 lengths of their local header are written once the data has been written.
+     *
+     *      Function `close()` writes the central directory. The destructor calls `close()` and ignores errors.
+     *  @usage:
+     *      vlib::Zip::Writer writer ("/tmp/archive.zip");
+     *      writer.add("file1", "/tmp/dir/file1");
+     *      writer.add("dir/file2", "/tmp/dir/dir/file2");
+     *      writer.close();
+     */
+    struct Writer {
+        
+    // Private.
+    private:
+        
+        // A file of the current window.
+        struct Pending {
+            Entry           entry;
+            Path            path;
+            Exception       error;
+            bool            failed = false;
+        };
+        
+        // The work of a window.
+        struct Job {
+            Pending*            pending;
+            ullong              len;
+            ullong              next;
+            const Compression*  compression;
+        };
+        
+        // Attributes.
+        File            m_file;
+        File::Writer    m_output;
+        Archive         m_archive;
+        Compression     m_compression;
+        ullong          m_threads;
+        ullong          m_parallel_len;
+        Array<Pending>  m_pending;
+        ullong          m_pending_len = 0;
+        bool            m_closed = false;
+        
+        // The maximum file length of a window.
+        SICE ullong     window_len = 64 * 1024 * 1024;
+        
+        // Remove an existing destination, the positional writer does not truncate.
+        static
+        const Path& replace(const Path& dest) {
+            if (dest.exists()) {
+                dest.remove();
+            }
+            return dest;
+        }
+        
+        // Load and compress the pending files until none are left.
+        static
+        void    compress_pending(Job* job) {
+            ullong i;
+            while ((i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->len) {
+                Pending& pending = job->pending[i];
+                try {
+                    compress_entry(pending.entry, pending.path.load(), pending.path.extension(), *job->compression);
+                } catch (Exception& e) {
+                    pending.error = e;
+                    pending.failed = true;
+                }
+            }
+        }
+        
+        // Compress the pending files in parallel and write them in order.
+        void    flush_pending() {
+            if (m_pending.len() == 0) { return ; }
+            Job job { m_pending.data(), m_pending.len(), 0, &m_compression };
+            Array<FThread> workers;
+            for (ullong i = 1; i < m_threads && i < job.len; ++i) {
+                workers.append(FThread());
+                workers.last().start([](Job* job) -> void* {
+                    compress_pending(job);
+                    return nullptr;
+                }, &job);
+            }
+            compress_pending(&job);
+            for (auto& worker: workers) { worker.join(); }
+            for (auto& pending: m_pending) {
+                if (pending.failed) {
+                    throw pending.error;
+                }
+                pending.entry.offset = m_output.offset();
+                write_fheader(m_output, pending.entry);
+                pending.entry.data.reset();
+                m_archive.entries.append(move(pending.entry));
+            }
+            m_pending.reset();
+            m_pending_len = 0;
+        }
+        
+        // Stream a large file, the local header is completed after the data is written.
+        void    write_large(Entry& entry, Path& path) {
+            File::View view (path.c_str());
+            view.advise(vlib::file::sequential);
+            const bool store = compressed_extension(path.extension());
+            entry.offset = m_output.offset();
+            entry.compression_method = store ? 0 : 8;
+            write_fheader(m_output, entry);
+            const ullong start = m_output.offset();
+            if (store) {
+                m_output.write(view.data(), view.len());
+                entry.crc = calc_crc32(view.data(), view.len());
+            } else {
+                entry.crc = m_compression.deflate_parallel(m_output, view.data(), view.len(), m_threads);
+            }
+            entry.uncompressed_len = view.len();
+            entry.compressed_len = m_output.offset() - start;
+            
+            // Complete the local header.
+            // The ZIP64 extra field follows the name and the unix extra field.
+            m_output.flush();
+            const ullong zip64 = entry.offset + 30 + entry.name.len() + 8 + 4;
+            m_file.pwrite((char*) &entry.crc, sizeof(entry.crc), entry.offset + 14);
+            m_file.pwrite((char*) &entry.uncompressed_len, sizeof(entry.uncompressed_len), zip64);
+            m_file.pwrite((char*) &entry.compressed_len, sizeof(entry.compressed_len), zip64 + 8);
+            m_archive.entries.append(move(entry));
+        }
+        
+    // Public.
+    public:
+        
+        // Constructor.
+        /*  @docs
+         *  @title: Constructor
+         *  @description:
+         *      Construct a writer, an existing destination file is replaced.
+         *  @parameter:
+         *      @name: dest
+         *      @description: The destination path of the archive.
+         *  @parameter:
+         *      @name: threads
+         *      @description: The number of threads, `0` for the number of online processors.
+         *  @parameter:
+         *      @name: level
+         *      @description: The compression level.
+         *  @parameter:
+         *      @name: parallel_len
+         *      @description: The file length from which a file is streamed and deflated in parallel blocks.
+         */
+        Writer(const Path& dest, ullong threads = 0, int level = Z_BEST_COMPRESSION, ullong parallel_len = 8 * 1024 * 1024) :
+        m_file(replace(dest), vlib::file::mode::write),
+        m_output(m_file.writer(1024 * 1024, 0)),
+        m_compression(level),
+        m_threads(threads),
+        m_parallel_len(parallel_len)
+        {
+            if (m_threads == 0) {
+                const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+                m_threads = cpus > 0 ? (ullong) cpus : 1;
+            }
+        }
+        
+        // No copy constructor.
+        Writer(const Writer&) = delete;
+        
+        // Destructor.
+        ~Writer() {
+            try { close(); }
+            catch (...) {}
+        }
+        
+        // Get the written entries.
+        /*  @docs
+         *  @title: Entries
+         *  @description:
+         *      Get the entries that have been written, the entries do not contain data.
+         */
+        constexpr const Array<Entry>& entries() const { return m_archive.entries; }
+        
+        // Add a file.
+        /*  @docs
+         *  @title: Add
+         *  @description:
+         *      Add a file to the archive.
+         *
+         *      Directories are skipped, equal to `Zip::add()`.
+         *  @parameter:
+         *      @name: name
+         *      @description: The name of the file, should be the subpath to the absolute dir.
+         *  @parameter:
+         *      @name: path
+         *      @description: The path to the file.
+         *  @usage:
+         *      vlib::Zip::Writer writer ("/tmp/archive.zip");
+         *      writer.add("file1", "/tmp/dir/file1");
+         */
+        Writer& add(const String& name, const Path& _path) {
+            if (m_closed) {
+                throw InvalidUsageError("The archive is already closed.");
+            }
+            Path path = _path;
+            if (path.is_dir()) {
+                return *this;
+            }
+            Entry entry = metadata(name, path);
+            const ullong len = (ullong) path.size();
+            if (len >= m_parallel_len) {
+                flush_pending();
+                write_large(entry, path);
+                return *this;
+            }
+            m_pending.append(Pending{ .entry = move(entry), .path = move(path), .error = Exception(), .failed = false });
+            m_pending_len += len;
+            if (m_pending_len >= window_len || m_pending.len() >= m_threads * 16) {
+                flush_pending();
+            }
+            return *this;
+        }
+        
+        // Close.
+        /*  @docs
+         *  @title: Close
+         *  @description:
+         *      Write the remaining files and the central directory, then close the file.
+         */
+        void    close() {
+            if (m_closed) { return ; }
+            m_closed = true;
+            flush_pending();
+            m_archive.cd_offset = m_output.offset();
+            for (auto& entry: m_archive.entries) {
+                write_cdheader(m_output, entry);
+            }
+            m_archive.eocd_offset = m_output.offset();
+            m_archive.cd_size = m_archive.eocd_offset - m_archive.cd_offset;
+            write_eocd64(m_output, m_archive);
+            write_eocl64(m_output, m_archive);
+            write_eocd(m_output);
+            m_output.close();
+            m_file.close();
+        }
+        
+    };
+    
+    // Random access archive reader.
+    /*  @docs
+     *  @title: Reader
+     *  @description:
+     *      Read a zip archive through its central directory.
+     *
+     *      The archive is memory mapped and only the central directory is parsed when the archive is opened, the entries are indexed by name. An entry is only inflated when it is loaded or extracted, extracted files are streamed to disk.
+     *
+     *      Supports ZIP64 archives and archives with a comment.
+     *  @usage:
+     *      vlib::Zip::Reader reader ("/tmp/archive.zip");
+     *      vlib::String data = reader.load(reader.find("dir/file2"));
+     *      reader.extract("/tmp/file2", reader.find("dir/file2"));
+     *      reader.extract("/tmp/extract");
+     */
+    struct Reader {
+        
+    // Private.
+    private:
+        
+        // Output of an inflated entry.
+        struct Output {
+            File::Writer*   writer;
+            uLong           crc;
+            void    write(const char* data, ullong len) {
+                crc = ::crc32(crc, (const Bytef*) data, (uInt) len);
+                writer->write(data, len);
+            }
+        };
+        
+        // The work of a parallel extraction.
+        struct Job {
+            const Reader*       reader;
+            const ullong*       files;
+            Path*               dests;
+            ullong              len;
+            ullong              next;
+            Exception           error;
+            bool                failed;
+        };
+        
+        // Attributes.
+        File::View              m_view;
+        Archive                 m_archive;
+        Dict<String, ullong>    m_index;
+        
+        // Get the data of an entry from the local file header.
+        const char* entry_data(const Entry& entry) const {
+            const char* data = m_view.data();
+            const ullong len = m_view.len();
+            if (entry.offset + 30 > len || *((uint32_t*) &data[entry.offset]) != header_signature) {
+                throw ParseError(to_str("Invalid local file header of entry \"", entry.name, "\"."));
+            }
+            const ullong start = entry.offset + 30 + *((uint16_t*) &data[entry.offset + 26]) + *((uint16_t*) &data[entry.offset + 28]);
+            if (start + entry.compressed_len > len) {
+                throw ParseError(to_str("The data of entry \"", entry.name, "\" exceeds the archive."));
+            }
+            return data + start;
+        }
+        
+        // Extract files until none are left.
+        static
+        void    extract_files(Job* job) {
+            ullong i;
+            while ((i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED)) < job->len) {
+                try {
+                    job->reader->extract(job->dests[i], job->reader->m_archive.entries[job->files[i]]);
+                } catch (Exception& e) {
+                    if (!__atomic_exchange_n(&job->failed, true, __ATOMIC_ACQ_REL)) {
+                        job->error = e;
+                    }
+                    return ;
+                }
+            }
+        }
+        
+    // Public.
+    public:
+        
+        // Default constructor.
+        Reader() = default;
+        
+        // Constructor from path.
+        /*  @docs
+         *  @title: Constructor
+         *  @description:
+         *      Construct a reader and open an archive.
+         *  @parameter:
+         *      @name: path
+         *      @description: The path to the archive.
+         */
+        Reader(const Path& path) {
+            open(path);
+        }
+        
+        // Get the entries.
+        /*  @docs
+         *  @title: Entries
+         *  @description:
+         *      Get the entries of the central directory, the entries do not contain data.
+         */
+        constexpr const Array<Entry>& entries() const { return m_archive.entries; }
+        
+        // Open.
+        /*  @docs
+         *  @title: Open
+         *  @description:
+         *      Open an archive and read its central directory.
+         *
+         *      Throws a `ParseError` when the file is not a valid zip archive.
+         *  @parameter:
+         *      @name: path
+         *      @description: The path to the archive.
+         */
+        Reader& open(const Path& path) {
+            close();
+            m_view.open(path.c_str());
+            const char* data = m_view.data();
+            const ullong len = m_view.len();
+            
+            // Find the end of central directory record, it is followed by a comment of at most 64KB.
+            if (len < 22) {
+                throw ParseError(to_str("File \"", path, "\" is not a zip archive."));
+            }
+            ullong pos = len - 22;
+            const ullong min = pos > UINT16_MAX ? pos - UINT16_MAX : 0;
+            while (*((uint32_t*) &data[pos]) != eocd_signature) {
+                if (pos == min) {
+                    throw ParseError(to_str("File \"", path, "\" is not a zip archive."));
+                }
+                --pos;
+            }
+            read_eocd(m_archive, data, pos);
+            
+            // ZIP64 end of central directory.
+            if (pos >= 20 && *((uint32_t*) &data[pos - 20]) == eocl64_signature) {
+                read_eocl64(m_archive, data, pos - 20);
+                if (m_archive.eocd_offset + 56 > len || *((uint32_t*) &data[m_archive.eocd_offset]) != eocd64_signature) {
+                    throw ParseError(to_str("Invalid ZIP64 end of central directory in \"", path, "\"."));
+                }
+                read_eocd64(m_archive, data, m_archive.eocd_offset);
+            }
+            
+            // Central directory.
+            if (m_archive.cd_offset + m_archive.cd_size > len) {
+                throw ParseError(to_str("Invalid central directory in \"", path, "\"."));
+            }
+            const ullong end = m_archive.cd_offset + m_archive.cd_size;
+            pos = m_archive.cd_offset;
+            m_index.enable_index();
+            while (pos + 46 <= end && *((uint32_t*) &data[pos]) == cd_header_signature) {
+                Entry entry;
+                pos += read_cdheader(entry, data, pos) + 1;
+                m_index.value(entry.name) = m_archive.entries.len();
+                m_archive.entries.append(move(entry));
+            }
+            return *this;
+        }
+        
+        // Close.
+        /*  @docs
+         *  @title: Close
+         *  @description:
+         *      Close the archive, called automatically in the destructor.
+         */
+        void    close() {
+            m_view.close();
+            m_archive = {};
+            m_index.reset();
+        }
+        
+        // Check if an entry exists.
+        /*  @docs
+         *  @title: Contains
+         *  @description:
+         *      Check if the archive contains an entry.
+         *  @parameter:
+         *      @name: name
+         *      @description: The name of the entry.
+         */
+        bool    contains(const String& name) const {
+            return m_index.find(name) != NPos::npos;
+        }
+        
+        // Find an entry by name.
+        /*  @docs
+         *  @title: Find
+         *  @description:
+         *      Find an entry by name using the index.
+         *
+         *      Throws an `EntryNotFoundError` when the entry is not found.
+         *  @parameter:
+         *      @name: name
+         *      @description: The name of the entry.
+         */
+        const Entry& find(const String& name) const {
+            const ullong i = m_index.find(name);
+            if (i == NPos::npos) {
+                throw EntryNotFoundError(entry_not_found_err);
+            }
+            return m_archive.entries[m_index.value(i)];
+        }
+        
+        // Load an entry.
+        /*  @docs
+         *  @title: Load
+         *  @description:
+         *      Load the uncompressed data of an entry.
+         *  @parameter:
+         *      @name: entry
+         *      @description: The entry, for example from `find()`.
+         *  @usage:
+         *      vlib::Zip::Reader reader ("/tmp/archive.zip");
+         *      vlib::String data = reader.load(reader.find("dir/file2"));
+         */
+        String  load(const Entry& entry) const {
+            if (entry.is_dir()) {
+                return String();
+            }
+            const char* data = entry_data(entry);
+            String output;
+            switch (entry.compression_method) {
+                case 0:
+                    output = String(data, entry.compressed_len);
+                    break;
+                case 8:
+                    output = Compression().decompress(data, entry.compressed_len, -15);
+                    break;
+                default:
+                    throw CompressionError(to_str("Unsupported compression method \"", entry.compression_method, "\"."));
+            }
+            check_crc(entry, calc_crc32(output.data(), output.len()));
+            return output;
+        }
+        
+        // Extract an entry.
+        /*  @docs
+         *  @title: Extract
+         *  @description:
+         *      Extract a single entry, the data is inflated straight to the destination file.
+         *  @parameter:
+         *      @name: dest
+         *      @description: The destination path to where the entry will be written to.
+         *  @parameter:
+         *      @name: entry
+         *      @description: The entry, for example from `find()`.
+         *  @usage:
+         *      vlib::Zip::Reader reader ("/tmp/archive.zip");
+         *      reader.extract("/tmp/file2", reader.find("dir/file2"));
+         *  @funcs: 2
+         */
+        void    extract(Path& dest, const Entry& entry) const {
+            if (entry.is_dir()) {
+                dest.mkdir();
+            } else {
+                if (entry.compression_method != 0 && entry.compression_method != 8) {
+                    throw CompressionError(to_str("Unsupported compression method \"", entry.compression_method, "\"."));
+                }
+                const char* data = entry_data(entry);
+                if (dest.exists()) {
+                    dest.remove();
+                }
+                dest.touch(); // the writer only creates the file on the first write.
+                File file (dest, vlib::file::mode::write);
+                File::Writer writer = file.writer(1024 * 1024, 0);
+                uint32_t crc;
+                if (entry.compression_method == 0) {
+                    writer.write(data, entry.compressed_len);
+                    crc = calc_crc32(data, entry.compressed_len);
+                } else {
+                    Output output { &writer, ::crc32(0L, Z_NULL, 0) };
+                    compression::Inflater<Output> inflater (output, -15);
+                    inflater.write(data, entry.compressed_len);
+                    if (!inflater.finished()) {
+                        throw CompressionError(to_str("The data of entry \"", entry.name, "\" is incomplete."));
+                    }
+                    crc = (uint32_t) output.crc;
+                }
+                writer.close();
+                check_crc(entry, crc);
+            }
+            set_metadata(dest, entry);
+        }
+        void    extract(const Path& _dest, const Entry& entry) const {
+            Path dest = _dest;
+            extract(dest, entry);
+        }
+        
+        // Extract the archive.
+        /*  @docs
+         *  @title: Extract
+         *  @description:
+         *      Extract all entries, the files are extracted in parallel.
+         *
+         *      A `FileAlreadyExists` exception will be thrown if the destination path already exists.
+         *  @parameter:
+         *      @name: dest
+         *      @description: The destination path of the extracted archive.
+         *  @parameter:
+         *      @name: threads
+         *      @description: The number of threads, `0` for the number of online processors.
+         *  @usage:
+         *      vlib::Zip::Reader reader ("/tmp/archive.zip");
+         *      reader.extract("/tmp/extract");
+         */
+        void    extract(const Path& _dest, ullong threads) const {
+            
+            // Create dest dir.
+            Path dest = _dest;
+            if (dest.exists()) {
+                throw FileAlreadyExistsError("Destination path \"", dest, "\" already exists.");
+            }
+            dest.mkdir();
+            m_view.advise(vlib::file::sequential);
+            
+            // Create the directories first so the files can be extracted concurrently.
+            Array<ullong> files, dirs;
+            Array<Path> dests;
+            for (ullong i = 0; i < m_archive.entries.len(); ++i) {
+                const Entry& entry = m_archive.entries[i];
+                
+                // Skip paths that start with "__MACOS/" since macos archives uses this for additional info.
+                if (entry.name.eq_first("__MACOSX/", 8)) {
+                    continue;
+                }
+                Path entry_dest = dest.join(entry.name);
+                if (entry.is_dir()) {
+                    entry_dest.mkdir_p();
+                    dirs.append(i);
+                } else {
+                    entry_dest.base().mkdir_p();
+                    files.append(i);
+                    dests.append(move(entry_dest));
+                }
+            }
+            
+            // Extract the files.
+            if (threads == 0) {
+                const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+                threads = cpus > 0 ? (ullong) cpus : 1;
+            }
+            Job job { this, files.data(), dests.data(), files.len(), 0, {}, false };
+            Array<FThread> workers;
+            for (ullong i = 1; i < threads && i < job.len; ++i) {
+                workers.append(FThread());
+                workers.last().start([](Job* job) -> void* {
+                    extract_files(job);
+                    return nullptr;
+                }, &job);
+            }
+            extract_files(&job);
+            for (auto& worker: workers) { worker.join(); }
+            if (job.failed) {
+                throw job.error;
+            }
+            
+            // Assign the directory metadata last, since extracting the files edits the mtime.
+            for (ullong i = dirs.len(); i-- > 0; ) {
+                const Entry& entry = m_archive.entries[dirs[i]];
+                Path entry_dest = dest.join(entry.name);
+                set_metadata(entry_dest, entry);
+            }
+        }
+        void    extract(const Path& dest) const {
+            extract(dest, 0);
+        }
+        
+    };
+    
 };
 
 // ---------------------------------------------------------
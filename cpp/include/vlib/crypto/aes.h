@@ -19,17 +19,25 @@ namespace vlib {
 //
 // Notes:
 // - The attributes are shared, use "copy()" to make an unique copy.
+// - The cipher context is reused, the key schedule is only set up again when the key or the direction changes.
+// - Linked objects share the cipher context, so they must not be used by multiple threads at the same time, give each thread its own "copy()".
 //
-// @TODO add mode AEAD
 
 #define VLIB_AES_STRUCT_REQUIRES requires ( \
 ( \
-    Mode == crypto::mode::cbc || \
-    Mode == crypto::mode::ctr \
-) && \
+    ( \
+        Mode == crypto::mode::cbc || \
+        Mode == crypto::mode::ctr || \
+        Mode == crypto::mode::gcm \
+    ) && \
+    ( \
+        Key == crypto::key::aes128 || \
+        Key == crypto::key::aes256 \
+    ) \
+) || \
 ( \
-    Key == crypto::key::aes128 || \
-    Key == crypto::key::aes256 \
+    Mode == crypto::mode::chacha20_poly1305 && \
+    Key == crypto::key::chacha20 \
 ) \
 )
 
@@ -38,12 +46,18 @@ namespace vlib {
     @title: AES
     @description:
         AES type used to encrypt and decrypt data.
+ 
+        Modes `gcm` and `chacha20_poly1305` are authenticated (AEAD), the encrypted data then ends with a 16 byte tag and additional data can be authenticated without being encrypted.
+ 
+        Besides `encrypt()` and `decrypt()` the type supports a streaming API with `init_encrypt()`, `update()` and `finalize()` that writes into caller buffers, and `seal()` and `open()` to encrypt and decrypt records into caller buffers without allocations.
     @usage:
         #include <vlib/crypto.h>
         vlib::AES<vlib::crypto::mode::cbc, vlib::crypto::key::aes256> aes;
         vlib::AES256_CBC aes_alias; // alias.
+        vlib::AES256_GCM aes_gcm;
+        vlib::ChaCha20_Poly1305 chacha;
     @note:
-        Type `AES` acts as a shared pointer, use `AES::copy()` to create a copy without a link.
+        Type `AES` acts as a shared pointer, use `AES::copy()` to create a copy without a link. Linked objects share one cipher context and are not thread safe, each thread should use its own copy.
 */
 template <
 	int Mode = 	crypto::mode::cbc,
@@ -59,8 +73,10 @@ public:
     
     static excid_t gen_key_err;
     static excid_t gen_iv_err;
+    static excid_t key_err;
     static excid_t encrypt_err;
     static excid_t decrypt_err;
+    static excid_t auth_err;
 
 	// ---------------------------------------------------------
 	// Aliases.
@@ -76,6 +92,31 @@ public:
 		String				rkey;				// raw key.
         Bool                encode = true;
 		EVP_CIPHER_CTX*		ctx = nullptr;
+		int					direction = -1;		// the direction the context is initialized for, 1 for encryption, 0 for decryption and -1 when not initialized.
+		String				ivs;				// buffer for the ivs of a batch.
+		constexpr
+		attr() :
+		ctx(EVP_CIPHER_CTX_new()) {}
+		constexpr
+		attr(const String& key) :
+		key(key),
+		ctx(EVP_CIPHER_CTX_new()) {}
+		attr(const attr&) = delete;
+		constexpr
+		attr(attr&& obj) :
+		key(move(obj.key)),
+		rkey(move(obj.rkey)),
+		encode(obj.encode),
+		ctx(obj.ctx),
+		direction(obj.direction),
+		ivs(move(obj.ivs))
+		{
+			obj.ctx = nullptr;
+		}
+		constexpr
+		~attr() {
+			if (ctx != nullptr) { EVP_CIPHER_CTX_free(ctx); }
+		}
 	};
 	SPtr<attr>			m_attr;
 
@@ -83,6 +124,9 @@ public:
 	// Static attributes.
 
 	SICE uint 	block_size =	16;
+	SICEBOOL 	is_aead =		Mode == crypto::mode::gcm || Mode == crypto::mode::chacha20_poly1305;
+	SICE uint 	iv_len =		is_aead ? 12 : 16;
+	SICE uint 	tag_len =		is_aead ? 16 : 0;
 
 // Private.
 private:
@@ -139,6 +183,58 @@ private:
     auto    cipher() const requires (Key == crypto::key::aes256 && Mode == crypto::mode::gcm) {
         return EVP_aes_256_gcm();
     }
+    constexpr
+    auto    cipher() const requires (Mode == crypto::mode::chacha20_poly1305) {
+        return EVP_chacha20_poly1305();
+    }
+
+	// Throw the error of the current direction.
+	[[noreturn]]
+	void	throw_h() const {
+		if (m_attr->direction == 1) {
+			throw EncryptError(encrypt_err);
+		}
+		throw DecryptError(decrypt_err);
+	}
+
+	// Initialize the context for a direction and an iv.
+	// - The cipher and key are only set when the direction changes, otherwise only the iv is reset.
+	void	init_h(int direction, const uchar* iv) {
+		if (m_attr->rkey.len() != Key) {
+			throw InvalidUsageError(key_err);
+		}
+		if (m_attr->direction != direction) {
+			m_attr->direction = direction;
+			if (
+				!EVP_CipherInit_ex(m_attr->ctx, cipher(), nullptr, nullptr, nullptr, direction) ||
+				(is_aead && !EVP_CIPHER_CTX_ctrl(m_attr->ctx, EVP_CTRL_AEAD_SET_IVLEN, iv_len, nullptr)) ||
+				!EVP_CipherInit_ex(m_attr->ctx, nullptr, nullptr, (uchar*) m_attr->rkey.data(), iv, direction)
+			) {
+				m_attr->direction = -1;
+				throw_h();
+			}
+		} else if (!EVP_CipherInit_ex(m_attr->ctx, nullptr, nullptr, nullptr, iv, direction)) {
+			throw_h();
+		}
+	}
+
+	// Seal a record of which the iv has already been written to the output.
+	Length	seal_h(char* out, const char* data, Length len, const char* aad_data, Length aad_len) {
+		init_h(1, (uchar*) out);
+		if constexpr (is_aead) {
+			if (aad_len != 0) {
+				aad(aad_data, aad_len);
+			}
+		}
+		Length written = iv_len;
+		written += update(out + written, data, len);
+		written += finalize(out + written);
+		if constexpr (is_aead) {
+			tag(out + written);
+			written += tag_len;
+		}
+		return written;
+	}
 
 // Public.
 public:
@@ -157,7 +253,7 @@ public:
 
 	explicit constexpr
 	AES() :
-	m_attr(attr{.ctx = EVP_CIPHER_CTX_new()}) {}
+	m_attr(attr()) {}
 
 	// Constructor from a key.
     /*  @docs
@@ -174,7 +270,7 @@ public:
 
 	explicit constexpr
 	AES(const String& key) :
-	m_attr(attr{.key = key, .ctx = EVP_CIPHER_CTX_new()})
+	m_attr(attr(key))
 	{
         m_attr->rkey = Hex::decode(key);
 	}
@@ -191,11 +287,8 @@ public:
 
 	// Destructor.
 	constexpr
-	~AES() {
-		if (m_attr.links() == 0 && m_attr->ctx != nullptr) {
-			EVP_CIPHER_CTX_cleanup(m_attr->ctx);
-		}
-	}
+	// - The cipher context is freed by the destructor of the attributes once the last link is destroyed.
+	~AES() {}
 
     // ---------------------------------------------------------
     // Assignment operator.
@@ -255,11 +348,11 @@ public:
 		m_attr->key.reset();
 		m_attr->rkey.reset();
         m_attr->encode = true;
+		m_attr->direction = -1;
 		if (m_attr->ctx != nullptr) {
-			EVP_CIPHER_CTX_cleanup(m_attr->ctx);
-			m_attr->ctx = nullptr;
+			EVP_CIPHER_CTX_reset(m_attr->ctx);
 		}
-		return 0;
+		return *this;
 	}
 
 	// Make a unique copy.
@@ -267,14 +360,13 @@ public:
         @title: Copy
         @description:
             Create a real copy of the object without any links.
+     
+            The copy has its own cipher context.
     */
-	constexpr
-	This	copy() {
-		return m_attr.copy();
-	}
-	constexpr
 	This	copy() const {
-		return m_attr.copy();
+		This obj (m_attr->key);
+		obj.m_attr->encode = m_attr->encode;
+		return obj;
 	}
 
 	// Set the key (encoded).
@@ -292,11 +384,13 @@ public:
 	void    set_key(const String& encoded_key) {
 		m_attr->key.copy(encoded_key);
         m_attr->rkey = Hex::decode(encoded_key);
+		m_attr->direction = -1;
 	}
 	constexpr
 	void    set_key(String&& encoded_key) {
 		m_attr->key.swap(encoded_key);
-        m_attr->rkey = Hex::decode(encoded_key);
+        m_attr->rkey = Hex::decode(m_attr->key);
+		m_attr->direction = -1;
 	}
 
 	// Generate a key.
@@ -313,6 +407,7 @@ public:
             throw GenerateKeyError(gen_key_err);
 		}
         m_attr->key = Hex::encode(m_attr->rkey);
+		m_attr->direction = -1;
 	}
     SICE
     void    generate_key(String& key) {
@@ -325,80 +420,364 @@ public:
         key = Hex::encode(rkey);
     }
 
-	// Encrypt.
+	// ---------------------------------------------------------
+	// Streaming.
+
+	// Initialize an encryption.
     /*  @docs
-        @title: Encrypt
+        @title: Initialize encryption
         @description:
-            Encrypt a string.
+            Start a streaming encryption with an iv of `iv_len` bytes.
+     
+            The iv must be unique for every encryption with the same key, especially for the AEAD modes. Continue with `aad()`, `update()` and `finalize()`.
         @parameter:
-            @name: data
-            @description: The data to encrypt.
+            @name: iv
+            @description: The iv of `AES::iv_len` bytes.
         }
         @usage:
-            vlib::AES<...> aes;
+            vlib::AES256_GCM aes;
             aes.generate_key();
-            vlib::String output = aes.encrypt(output, "Hello World!");
-        @funcs: 2
+            char iv[vlib::AES256_GCM::iv_len], tag[vlib::AES256_GCM::tag_len];
+            ...
+            aes.init_encrypt(iv).aad("header", 6);
+            ullong written = aes.update(out, data, len);
+            written += aes.finalize(out + written);
+            aes.tag(tag);
     */
-    constexpr
-    String  encrypt(const String& data) {
-        return encrypt(data.c_str(), data.len());
-    }
-	constexpr
-    String  encrypt(const char* data, const Length len) {
+	This&	init_encrypt(const char* iv) {
+		init_h(1, (const uchar*) iv);
+		return *this;
+	}
 
-		// Generate IV.
-		uchar* iv = new uchar [block_size];
-		if(!RAND_bytes(iv, block_size)) {
-            throw GenerateIVError(gen_iv_err);
+	// Initialize a decryption.
+    /*  @docs
+        @title: Initialize decryption
+        @description:
+            Start a streaming decryption with the iv that was used for the encryption.
+     
+            For the AEAD modes the tag must be assigned with `set_tag()` before `finalize()`.
+        @parameter:
+            @name: iv
+            @description: The iv of `AES::iv_len` bytes.
+        }
+        @usage:
+            vlib::AES256_GCM aes ("...");
+            aes.init_decrypt(iv).aad("header", 6).set_tag(tag);
+            ullong written = aes.update(out, data, len);
+            written += aes.finalize(out + written);
+    */
+	This&	init_decrypt(const char* iv) {
+		init_h(0, (const uchar*) iv);
+		return *this;
+	}
+
+	// Additional authenticated data.
+    /*  @docs
+        @title: Additional data
+        @description:
+            Authenticate data without encrypting it, only for the AEAD modes.
+     
+            Must be called after the initialization and before the first `update()`.
+        @parameter:
+            @name: data
+            @description: The additional data.
+        }
+        @parameter:
+            @name: len
+            @description: The length of the additional data.
+        }
+    */
+	This&	aad(const char* data, Length len) requires (is_aead) {
+		int written;
+		while (len > 0) {
+			const int chunk = len > INT_MAX ? INT_MAX : (int) len;
+			if (!EVP_CipherUpdate(m_attr->ctx, nullptr, &written, (const uchar*) data, chunk)) {
+				throw_h();
+			}
+			data += chunk;
+			len -= chunk;
+		}
+		return *this;
+	}
+
+	// Update.
+    /*  @docs
+        @title: Update
+        @description:
+            Encrypt or decrypt the next part of the data into a caller buffer.
+     
+            The output buffer must have room for `len + AES::block_size` bytes.
+        @return:
+            Returns the amount of bytes written to the output.
+        @parameter:
+            @name: out
+            @description: The output buffer.
+        }
+        @parameter:
+            @name: data
+            @description: The input data.
+        }
+        @parameter:
+            @name: len
+            @description: The length of the input data.
+        }
+    */
+	Length	update(char* out, const char* data, Length len) {
+		Length total = 0;
+		int written;
+		while (len > 0) {
+			const int chunk = len > INT_MAX - block_size ? INT_MAX - block_size : (int) len;
+			if (!EVP_CipherUpdate(m_attr->ctx, (uchar*) out + total, &written, (const uchar*) data, chunk)) {
+				throw_h();
+			}
+			total += (Length) written;
+			data += chunk;
+			len -= chunk;
 		}
+		return total;
+	}
 
-		// Init encryption.
-		EVP_EncryptInit(
-			m_attr->ctx,
-			cipher(),
-			(uchar*) m_attr->rkey.data(),
-			iv
-		);
+	// Finalize.
+    /*  @docs
+        @title: Finalize
+        @description:
+            Finish the encryption or decryption and write the remaining bytes, for mode `cbc` this is the padding block.
+     
+            The output buffer must have room for `AES::block_size` bytes. When decrypting with an AEAD mode an `DecryptError` is thrown when the data or the additional data is not authentic.
+        @return:
+            Returns the amount of bytes written to the output.
+        @parameter:
+            @name: out
+            @description: The output buffer.
+        }
+    */
+	Length	finalize(char* out) {
+		int written = 0;
+		if (!EVP_CipherFinal_ex(m_attr->ctx, (uchar*) out, &written)) {
+			if (is_aead && m_attr->direction == 0) {
+				throw DecryptError(auth_err);
+			}
+			throw_h();
+		}
+		return (Length) written;
+	}
 
-		// Combined IV.
-		String combined ((char*) iv, block_size);
+	// Get the tag.
+    /*  @docs
+        @title: Tag
+        @description:
+            Write the `AES::tag_len` byte authentication tag of a finalized encryption, only for the AEAD modes.
+        @parameter:
+            @name: out
+            @description: The output buffer.
+        }
+    */
+	This&	tag(char* out) requires (is_aead) {
+		if (!EVP_CIPHER_CTX_ctrl(m_attr->ctx, EVP_CTRL_AEAD_GET_TAG, tag_len, out)) {
+			throw_h();
+		}
+		return *this;
+	}
 
-		Length enc_len = len + (len % block_size);
-		String cipher;
-		cipher.resize(enc_len);
-
-		// Encrypt all the bytes up to but not including the last block
-		if(!EVP_EncryptUpdate(
-			m_attr->ctx,
-			(uchar*) cipher.data(),
-			(int*) &enc_len,
-			(uchar*) data,
-			(int) len
-		)) {
-            throw EncryptError(encrypt_err);
+	// Set the tag.
+    /*  @docs
+        @title: Set tag
+        @description:
+            Assign the `AES::tag_len` byte authentication tag of a decryption, only for the AEAD modes.
+        @parameter:
+            @name: tag
+            @description: The tag that was written by the encryption.
+        }
+    */
+	This&	set_tag(const char* tag) requires (is_aead) {
+		if (!EVP_CIPHER_CTX_ctrl(m_attr->ctx, EVP_CTRL_AEAD_SET_TAG, tag_len, (void*) tag)) {
+			throw_h();
 		}
+		return *this;
+	}
 
-		// Update length with the amount of bytes written
-		cipher.len() = enc_len;
+	// ---------------------------------------------------------
+	// Records.
 
-		// EncryptFinal will cipher the last block + Padding
-		if(!EVP_EncryptFinal_ex(
-			m_attr->ctx,
-			(uchar*) cipher.data() + enc_len,
-			(int*) &enc_len
-		)) {
-            throw EncryptError(encrypt_err);
+	// The length of a sealed record.
+    /*  @docs
+        @title: Sealed length
+        @description:
+            Get the length of a sealed record: the iv, the encrypted data including the padding of mode `cbc`, and the tag of the AEAD modes.
+        @parameter:
+            @name: len
+            @description: The length of the data.
+        }
+    */
+	SICE
+	Length	sealed_len(Length len) {
+		return iv_len + (Mode == crypto::mode::cbc ? (len / block_size + 1) * block_size : len) + tag_len;
+	}
+
+	// Seal a record.
+    /*  @docs
+        @title: Seal
+        @description:
+            Encrypt a record into a caller buffer with a random iv.
+     
+            The record is written as the iv, the encrypted data and the tag for the AEAD modes, which is the format of `encrypt()` without the hex encoding. The output buffer must have room for `sealed_len(len)` bytes.
+     
+            The batch version seals every record into the string with the same index of the outputs, the capacity of the output strings is reused between calls and the ivs of all records are generated at once.
+        @return:
+            Returns the amount of bytes written to the output.
+        @parameter:
+            @name: out
+            @description: The output buffer.
+        }
+        @parameter:
+            @name: data
+            @description: The data to encrypt.
+        }
+        @parameter:
+            @name: len
+            @description: The length of the data.
+        }
+        @parameter:
+            @name: aad
+            @description: The additional authenticated data for the AEAD modes.
+        }
+        @parameter:
+            @name: aad_len
+            @description: The length of the additional data.
+        }
+        @usage:
+            vlib::AES256_GCM aes;
+            aes.generate_key();
+            char out[vlib::AES256_GCM::sealed_len(12)];
+            ullong len = aes.seal(out, "Hello World!", 12);
+     
+            vlib::Array<vlib::String> records = {"Hello", "World"}, sealed;
+            aes.seal(sealed, records);
+        @funcs: 2
+    */
+	Length	seal(char* out, const char* data, Length len, const char* aad = nullptr, Length aad_len = 0) {
+		if (!RAND_bytes((uchar*) out, iv_len)) {
+            throw GenerateIVError(gen_iv_err);
+		}
+		return seal_h(out, data, len, aad, aad_len);
+	}
+	Array<String>&	seal(Array<String>& outputs, const Array<String>& records, const char* aad = nullptr, Length aad_len = 0) {
+		if (records.len() == 0) {
+			outputs.slice_r(0, 0);
+			return outputs;
 		}
+		String& ivs = m_attr->ivs;
+		ivs.resize(records.len() * iv_len);
+		if (!RAND_bytes((uchar*) ivs.data(), (int) (records.len() * iv_len))) {
+            throw GenerateIVError(gen_iv_err);
+		}
+		if (outputs.len() < records.len()) {
+			outputs.fill_r(records.len() - outputs.len(), String());
+		} else {
+			outputs.slice_r(0, records.len());
+		}
+		for (Length i = 0; i < records.len(); ++i) {
+			String& output = outputs[i];
+			output.resize(sealed_len(records[i].len()));
+			memcpy(output.data(), ivs.data() + i * iv_len, iv_len);
+			output.len() = seal_h(output.data(), records[i].data(), records[i].len(), aad, aad_len);
+		}
+		return outputs;
+	}
 
-		// Add padding to length
-		cipher.len() += enc_len;
+	// Open a sealed record.
+    /*  @docs
+        @title: Open
+        @description:
+            Decrypt a record that was created with `seal()` or `encrypt()` without hex encoding into a caller buffer.
+     
+            The output buffer must have room for the length of the record. A `DecryptError` is thrown when the record is invalid or not authentic.
+     
+            The batch version opens every record into the string with the same index of the outputs, the capacity of the output strings is reused between calls.
+        @return:
+            Returns the amount of bytes written to the output.
+        @parameter:
+            @name: out
+            @description: The output buffer.
+        }
+        @parameter:
+            @name: data
+            @description: The sealed record.
+        }
+        @parameter:
+            @name: len
+            @description: The length of the sealed record.
+        }
+        @parameter:
+            @name: aad
+            @description: The additional authenticated data for the AEAD modes.
+        }
+        @parameter:
+            @name: aad_len
+            @description: The length of the additional data.
+        }
+        @usage:
+            vlib::AES256_GCM aes ("...");
+            char out[len];
+            ullong out_len = aes.open(out, sealed, len);
+        @funcs: 2
+    */
+	Length	open(char* out, const char* data, Length len, const char* aad = nullptr, Length aad_len = 0) {
+		if (len < iv_len + tag_len) {
+            throw DecryptError(decrypt_err);
+		}
+		init_h(0, (const uchar*) data);
+		if constexpr (is_aead) {
+			if (aad_len != 0) {
+				this->aad(aad, aad_len);
+			}
+			set_tag(data + len - tag_len);
+		}
+		Length written = update(out, data + iv_len, len - iv_len - tag_len);
+		written += finalize(out + written);
+		return written;
+	}
+	Array<String>&	open(Array<String>& outputs, const Array<String>& records, const char* aad = nullptr, Length aad_len = 0) {
+		if (outputs.len() < records.len()) {
+			outputs.fill_r(records.len() - outputs.len(), String());
+		} else {
+			outputs.slice_r(0, records.len());
+		}
+		for (Length i = 0; i < records.len(); ++i) {
+			String& output = outputs[i];
+			output.resize(records[i].len());
+			output.len() = open(output.data(), records[i].data(), records[i].len(), aad, aad_len);
+		}
+		return outputs;
+	}
 
-		// Append iv.
-		combined.concat_r(cipher);
-		cipher.swap(combined);
+	// ---------------------------------------------------------
+	// Strings.
 
-		// Encode.
+	// Encrypt.
+    /*  @docs
+        @title: Encrypt
+        @description:
+            Encrypt a string.
+     
+            The output contains the iv, the encrypted data and the tag for the AEAD modes. When `encode()` is enabled the output is hex encoded.
+        @parameter:
+            @name: data
+            @description: The data to encrypt.
+        }
+        @usage:
+            vlib::AES<...> aes;
+            aes.generate_key();
+            vlib::String output = aes.encrypt("Hello World!");
+        @funcs: 2
+    */
+    String  encrypt(const String& data) {
+        return encrypt(data.data(), data.len());
+    }
+    String  encrypt(const char* data, const Length len) {
+		String cipher;
+		cipher.resize(sealed_len(len));
+		cipher.len() = seal(cipher.data(), data, len);
         if (m_attr->encode) {
             return Hex::encode(cipher.data(), cipher.len());
         }
@@ -416,63 +795,23 @@ public:
         }
         @usage:
             vlib::AES<...> aes("Some Key");
-            vlib::String output = aes.decrypt("XXX") != 0);
+            vlib::String output = aes.decrypt("XXX");
         @funcs: 2
     */
-    constexpr
     String  decrypt(const String& data) {
-        return decrypt(data.c_str(), data.len());
+        return decrypt(data.data(), data.len());
     }
-	constexpr
     String  decrypt(const char* data, const Length len) {
-        
-		// Decode.
-        String decoded;
+        String output;
         if (m_attr->encode) {
-            decoded = Hex::decode(data, len);
+            String decoded = Hex::decode(data, len);
+            output.resize(decoded.len());
+            output.len() = open(output.data(), decoded.data(), decoded.len());
         } else {
-            decoded.reconstruct(data, len);
+            output.resize(len);
+            output.len() = open(output.data(), data, len);
         }
-
-		// Init encryption.
-		EVP_DecryptInit(
-			m_attr->ctx,
-			cipher(),
-			(uchar*) m_attr->rkey.data(),
-			(uchar*) decoded.data()
-		);
-
-		Length dec_len = 0;
-        String output;
-		output.resize(decoded.len() + block_size);
-
-		// Encrypt all the bytes up to but not including the last block
-		if(!EVP_DecryptUpdate(
-			m_attr->ctx,
-			(uchar*) output.data(),
-			(int*) &dec_len,
-			(uchar*) (decoded.data() + block_size),
-			(int) (decoded.len() - block_size) // does not work with - block_size, not sure why.
-		)) {
-            throw DecryptError(decrypt_err);
-		}
-
-		// Update length with the amount of bytes written
-		output.len() = dec_len;
-		
-		// EncryptFinal will cipher the last block + Padding
-		if(!EVP_DecryptFinal_ex(
-			m_attr->ctx,
-			(uchar*) output.data() + dec_len,
-			(int*) &dec_len
-		)) {
-            throw DecryptError(decrypt_err);
-		}
-
-		// Add padding to length
-		output.len() += dec_len;
 		return output;
-
 	}
 
 };
@@ -483,9 +822,13 @@ excid_t AES<Mode, Key>::gen_key_err = exceptions::add_err("Encountered an error
 template <int Mode, int Key> VLIB_AES_STRUCT_REQUIRES
 excid_t AES<Mode, Key>::gen_iv_err = exceptions::add_err("Encountered an error while generating the iv.");
 template <int Mode, int Key> VLIB_AES_STRUCT_REQUIRES
+excid_t AES<Mode, Key>::key_err = exceptions::add_err("The key is undefined or has an invalid length.");
+template <int Mode, int Key> VLIB_AES_STRUCT_REQUIRES
 excid_t AES<Mode, Key>::encrypt_err = exceptions::add_err("Encountered an error while encrypting.");
 template <int Mode, int Key> VLIB_AES_STRUCT_REQUIRES
 excid_t AES<Mode, Key>::decrypt_err = exceptions::add_err("Encountered an error while decrypting.");
+template <int Mode, int Key> VLIB_AES_STRUCT_REQUIRES
+excid_t AES<Mode, Key>::auth_err = exceptions::add_err("Unable to authenticate the decrypted data.");
 
 // ---------------------------------------------------------
 // Aliases.
@@ -494,6 +837,9 @@ using AES128_CBC = AES<crypto::mode::cbc, crypto::key::aes128>;
 using AES256_CBC = AES<crypto::mode::cbc, crypto::key::aes256>;
 using AES128_CTR = AES<crypto::mode::ctr, crypto::key::aes128>;
 using AES256_CTR = AES<crypto::mode::ctr, crypto::key::aes256>;
+using AES128_GCM = AES<crypto::mode::gcm, crypto::key::aes128>;
+using AES256_GCM = AES<crypto::mode::gcm, crypto::key::aes256>;
+using ChaCha20_Poly1305 = AES<crypto::mode::chacha20_poly1305, crypto::key::chacha20>;
 
 // ---------------------------------------------------------
 // End.
@@ -29,6 +29,7 @@ namespace key {
 enum length {
 	aes128 = 16,
 	aes256 = 32,
+	chacha20 = 32,
 };
 
 }; 		// End namespace key.
@@ -37,6 +37,7 @@ enum modes {
     sha2 =      10,
 	sha256 = 	11,
 	sha512 = 	12,
+	chacha20_poly1305 = 13,
 };
 
 }; 		// End namespace mode.
@@ -26,12 +26,18 @@ namespace vlib {
     @chapter: Crypto
     @title: SHA
     @description:
-        Static SHA256 and SHA512 types.
+        SHA1, SHA256 and SHA512 types.
+ 
+        The static functions hash or sign a single buffer. An instance is an incremental hasher with `update()` and `finalize()`, constructed with a key it computes an HMAC. The batch functions hash many independent messages on multiple threads.
     @usage:
         #include <vlib/crypto.h>
-        vlib::sha<crypto::mode::sha256>::sign(...);
+        vlib::SHA<crypto::mode::sha256>::sign(...);
         vlib::SHA256::sign(...); // alias.
         vlib::SHA512::sign(...); // alias.
+ 
+        vlib::SHA256 sha;
+        sha.update("Hello ").update("World!");
+        vlib::String digest = sha.finalize();
 */
 template <int Mode = crypto::mode::sha256> VLIB_SHA_STRUCT_REQUIRES
 struct SHA {
@@ -47,11 +53,307 @@ public:
     static excid_t alloc_err;
     static excid_t hash_err;
 
+    // ---------------------------------------------------------
+    // Aliases.
+
+    using   This =          SHA;
+    using   Length =        ullong;
+
+    // ---------------------------------------------------------
+    // Static attributes.
+
+    SICE uint   digest_len =    Mode == crypto::mode::sha1 ? 20 : (Mode == crypto::mode::sha256 ? 32 : 64);
+    SICE uint   block_len =     Mode == crypto::mode::sha512 ? 128 : 64;
+
+// Private.
+private:
+
+    // ---------------------------------------------------------
+    // Attributes.
+
+    EVP_MD_CTX*     m_ctx = nullptr;
+    bool            m_hmac = false;
+    uchar           m_ipad[block_len];          // the inner padded key of an hmac.
+    uchar           m_opad[block_len];          // the outer padded key of an hmac.
+
+    // ---------------------------------------------------------
+    // Private functions.
+
+    // Initialize the padded keys of an hmac.
+    void    init_hmac_h(const char* key, Length klen) {
+        uchar hashed[digest_len];
+        if (klen > block_len) {
+            uint len;
+            if (!EVP_Digest(key, klen, hashed, &len, evp(), nullptr)) {
+                throw HashError(hash_err);
+            }
+            key = (const char*) hashed;
+            klen = digest_len;
+        }
+        for (uint i = 0; i < block_len; ++i) {
+            const uchar c = i < klen ? (uchar) key[i] : 0;
+            m_ipad[i] = c ^ 0x36;
+            m_opad[i] = c ^ 0x5c;
+        }
+        m_hmac = true;
+    }
+
+    // Hash or sign a batch of messages on multiple threads.
+    static
+    Array<String> batch_h(const char* key, Length klen, bool hmac, const Array<String>& messages, ullong threads) {
+
+        // The work of the threads.
+        struct Job {
+            const char*             key;
+            Length                  klen;
+            bool                    hmac;
+            const Array<String>*    messages;
+            String*                 outputs;
+            ullong                  next;
+            Exception               error;
+            bool                    failed;
+        };
+        static auto work = [](Job* job) -> void* {
+            SHA sha;
+            if (job->hmac) {
+                sha.init_hmac_h(job->key, job->klen);
+                sha.reset();
+            }
+            constexpr ullong chunk = 64;
+            ullong start;
+            try {
+                while ((start = __atomic_fetch_add(&job->next, chunk, __ATOMIC_RELAXED)) < job->messages->len()) {
+                    const ullong end = start + chunk < job->messages->len() ? start + chunk : job->messages->len();
+                    for (ullong i = start; i < end; ++i) {
+                        const String& message = job->messages->get(i);
+                        sha.update(message.data(), message.len());
+                        String& output = job->outputs[i];
+                        output.resize(digest_len);
+                        output.len() = sha.finalize(output.data());
+                        if (job->hmac) {
+                            output = Hex::encode(output.data(), output.len());
+                        }
+                    }
+                }
+            } catch (Exception& e) {
+                if (!__atomic_exchange_n(&job->failed, true, __ATOMIC_ACQ_REL)) {
+                    job->error = e;
+                }
+            }
+            return nullptr;
+        };
+
+        // Threads, every thread hashes at least 1024 messages.
+        if (threads == 0) {
+            const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+            threads = cpus > 0 ? (ullong) cpus : 1;
+        }
+        if (threads > (messages.len() + 1023) / 1024) {
+            threads = (messages.len() + 1023) / 1024;
+        }
+
+        // Run.
+        Array<String> outputs;
+        outputs.fill_r(messages.len(), String());
+        Job job { key, klen, hmac, &messages, outputs.data(), 0, {}, false };
+        Array<FThread> workers;
+        for (ullong i = 1; i < threads; ++i) {
+            workers.append(FThread());
+            workers.last().start(work, &job);
+        }
+        work(&job);
+        for (auto& worker: workers) { worker.join(); }
+        if (job.failed) {
+            throw job.error;
+        }
+        return outputs;
+    }
+
 // Public.
 public:
 
     // ---------------------------------------------------------
-    // Functions.
+    // Constructors.
+
+    // Default constructor.
+    /*  @docs
+        @title: Constructor
+        @description:
+            Construct an incremental hasher.
+        @usage:
+            vlib::SHA256 sha;
+    */
+    SHA() :
+    m_ctx(EVP_MD_CTX_new())
+    {
+        if (m_ctx == nullptr) {
+            throw AllocError(alloc_err);
+        }
+        reset();
+    }
+
+    // Constructor from a key.
+    /*  @docs
+        @title: Constructor from a key
+        @description:
+            Construct an incremental HMAC with a key.
+        @parameter:
+            @name: key
+            @description: The key, equal to the key of `hmac()`.
+        }
+        @usage:
+            vlib::SHA256 hmac ("Some Key");
+            hmac.update("Hello World!");
+            vlib::String signature = vlib::Hex::encode(hmac.finalize());
+        @funcs: 2
+    */
+    SHA(const String& key) :
+    SHA(key.data(), key.len()) {}
+    SHA(const char* key, Length klen) :
+    m_ctx(EVP_MD_CTX_new())
+    {
+        if (m_ctx == nullptr) {
+            throw AllocError(alloc_err);
+        }
+        init_hmac_h(key, klen);
+        reset();
+    }
+
+    // Move constructor.
+    SHA(This&& obj) :
+    m_ctx(obj.m_ctx),
+    m_hmac(obj.m_hmac)
+    {
+        memcpy(m_ipad, obj.m_ipad, block_len);
+        memcpy(m_opad, obj.m_opad, block_len);
+        obj.m_ctx = nullptr;
+    }
+
+    // No copy constructor.
+    SHA(const This&) = delete;
+
+    // Destructor.
+    ~SHA() {
+        if (m_ctx != nullptr) {
+            EVP_MD_CTX_free(m_ctx);
+        }
+    }
+
+    // ---------------------------------------------------------
+    // Incremental functions.
+
+    // Reset.
+    /*  @docs
+        @title: Reset
+        @description:
+            Start a new hash, the key of an HMAC is kept.
+    */
+    This&   reset() {
+        if (!EVP_DigestInit_ex(m_ctx, evp(), nullptr)) {
+            throw HashError(hash_err);
+        }
+        if (m_hmac && !EVP_DigestUpdate(m_ctx, m_ipad, block_len)) {
+            throw HashError(hash_err);
+        }
+        return *this;
+    }
+
+    // Update.
+    /*  @docs
+        @title: Update
+        @description:
+            Add data to the hash.
+        @parameter:
+            @name: data
+            @description: The data to add.
+        }
+        @usage:
+            vlib::SHA256 sha;
+            sha.update("Hello ").update("World!");
+        @funcs: 3
+    */
+    This&   update(const String& data) {
+        return update(data.data(), data.len());
+    }
+    This&   update(const char* data) {
+        return update(data, vlib::len(data));
+    }
+    This&   update(const char* data, Length len) {
+        if (!EVP_DigestUpdate(m_ctx, data, len)) {
+            throw HashError(hash_err);
+        }
+        return *this;
+    }
+
+    // Update with a file.
+    /*  @docs
+        @title: Update file
+        @description:
+            Add the contents of a file to the hash.
+ 
+            The file is read in chunks with `File::chunks()`, it is never loaded entirely.
+        @parameter:
+            @name: path
+            @description: The path of the file.
+        }
+        @parameter:
+            @name: chunk_len
+            @description: The length of the chunks to read.
+        }
+        @usage:
+            vlib::SHA256 sha;
+            sha.update_file("/tmp/dump.csv");
+            vlib::String digest = sha.finalize();
+    */
+    This&   update_file(const Path& path, Length chunk_len = 1024 * 1024) {
+        File file (path);
+        file.advise(vlib::file::sequential);
+        for (auto& chunk: file.chunks(chunk_len)) {
+            update(chunk.data, chunk.len);
+        }
+        return *this;
+    }
+
+    // Finalize.
+    /*  @docs
+        @title: Finalize
+        @description:
+            Get the raw digest of the added data and reset the hasher.
+ 
+            The buffer version writes `SHA::digest_len` bytes into the output and returns the written length.
+        @usage:
+            vlib::SHA256 sha;
+            sha.update("Hello World!");
+            vlib::String digest = sha.finalize();
+        @funcs: 2
+    */
+    Length  finalize(char* out) {
+        uint len = 0;
+        if (!EVP_DigestFinal_ex(m_ctx, (uchar*) out, &len)) {
+            throw HashError(hash_err);
+        }
+        if (m_hmac) {
+            if (
+                !EVP_DigestInit_ex(m_ctx, evp(), nullptr) ||
+                !EVP_DigestUpdate(m_ctx, m_opad, block_len) ||
+                !EVP_DigestUpdate(m_ctx, out, len) ||
+                !EVP_DigestFinal_ex(m_ctx, (uchar*) out, &len)
+            ) {
+                throw HashError(hash_err);
+            }
+        }
+        reset();
+        return len;
+    }
+    String  finalize() {
+        String digest;
+        digest.resize(digest_len);
+        digest.len() = finalize(digest.data());
+        return digest;
+    }
+
+    // ---------------------------------------------------------
+    // Static functions.
     
     // EVP helper.
     SICE
@@ -130,6 +432,89 @@ public:
 		return output;
 	}
     
+    // Sign data.
+    /*  @docs
+        @title: Sign
+        @description:
+            Sign data with a key, equal to `hmac()`.
+        @usage:
+            vlib::String output = vlib::SHA256::sign("Some Key", "Hello World!");
+        @funcs: 2
+    */
+    SICE
+    String  sign(const String& key, const String& data) {
+        return hmac(key.data(), key.len(), data.data(), data.len());
+    }
+    static inline
+    String  sign(const char* key, ullong klen, const char* data, ullong dlen) {
+        return hmac(key, klen, data, dlen);
+    }
+    
+    // Hash a file.
+    /*  @docs
+        @title: Hash file
+        @description:
+            Get the raw digest of a file without loading the file.
+        @parameter:
+            @name: path
+            @description: The path of the file.
+        }
+        @usage:
+            vlib::String digest = vlib::SHA256::hash_file("/tmp/dump.csv");
+    */
+    static
+    String  hash_file(const Path& path) {
+        return This().update_file(path).finalize();
+    }
+    
+    // Hash a batch.
+    /*  @docs
+        @title: Hash batch
+        @description:
+            Get the raw digests of many independent messages, hashed on multiple threads.
+     
+            Every thread reuses a single context and handles at least 1024 messages, so small batches are hashed on the calling thread.
+        @parameter:
+            @name: messages
+            @description: The messages to hash.
+        }
+        @parameter:
+            @name: threads
+            @description: The maximum number of threads, `0` for the number of online processors.
+        }
+        @usage:
+            vlib::Array<vlib::String> digests = vlib::SHA256::hash({"Hello", "World"});
+    */
+    static
+    Array<String> hash(const Array<String>& messages, ullong threads = 0) {
+        return batch_h(nullptr, 0, false, messages, threads);
+    }
+    
+    // Sign a batch.
+    /*  @docs
+        @title: HMAC batch
+        @description:
+            Sign many independent messages with the same key on multiple threads, the signatures are hex encoded like `hmac()`.
+        @parameter:
+            @name: key
+            @description: The key.
+        }
+        @parameter:
+            @name: messages
+            @description: The messages to sign.
+        }
+        @parameter:
+            @name: threads
+            @description: The maximum number of threads, `0` for the number of online processors.
+        }
+        @usage:
+            vlib::Array<vlib::String> signatures = vlib::SHA256::hmac("Some Key", {"Hello", "World"});
+    */
+    static
+    Array<String> hmac(const String& key, const Array<String>& messages, ullong threads = 0) {
+        return batch_h(key.data(), key.len(), true, messages, threads);
+    }
+    
     // Sign data.
     /*  @docs
      *  @title: HMAC
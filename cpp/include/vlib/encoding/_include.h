@@ -2,5 +2,6 @@
 // Copyright: © 2022 Daan van den Bergh.
 
 // Includes.
+#include "simd.h"
 #include "hex.h"
 #include "base64.h"
@@ -14,7 +14,7 @@
 namespace vlib {
 
 // ---------------------------------------------------------
-// Hex static struct.
+// Base64 static struct.
 /* @docs
     @chapter: Encoding
     @title: Base64
@@ -45,17 +45,211 @@ struct Base64 {
     41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51 };
 
 
+// Private.
+private:
+
+    // ---------------------------------------------------------
+    // Private functions.
+
+    // Decode a block of four characters.
+    SICE
+    void    decode_block_h(uchar* out, const uchar* p) {
+        const int n = B64index[p[0]] << 18 | B64index[p[1]] << 12 | B64index[p[2]] << 6 | B64index[p[3]];
+        out[0] = n >> 16;
+        out[1] = n >> 8 & 0xFF;
+        out[2] = n & 0xFF;
+    }
+
+#if VLIB_SIMD_X86
+
+    // Split three bytes into four 6 bit indices per 32 bit word, see http://0x80.pl/notesen/2016-01-12-sse-base64-encoding.html.
+    __attribute__((target("ssse3,sse4.1"))) static inline
+    __m128i encode_indices_sse_h(__m128i in) {
+        in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+        const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+        const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+        return _mm_or_si128(t0, t1);
+    }
+
+    // Translate 6 bit indices to characters.
+    __attribute__((target("ssse3,sse4.1"))) static inline
+    __m128i encode_chars_sse_h(const __m128i indices) {
+        const __m128i shift = _mm_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+        );
+        __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        offsets = _mm_or_si128(offsets, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        return _mm_add_epi8(indices, _mm_shuffle_epi8(shift, offsets));
+    }
+
+    // Encode blocks of 12 bytes, returns the number of encoded input bytes.
+    __attribute__((target("ssse3,sse4.1"))) static inline
+    Length  encode_sse_h(char* out, const char* input, const Length len) {
+        Length i = 0;
+        for (; i + 16 <= len; i += 12, out += 16) {
+            const __m128i in = _mm_loadu_si128((const __m128i*) (input + i));
+            _mm_storeu_si128((__m128i*) out, encode_chars_sse_h(encode_indices_sse_h(in)));
+        }
+        return i;
+    }
+
+    // Encode blocks of 24 bytes, returns the number of encoded input bytes.
+    __attribute__((target("avx2"))) static inline
+    Length  encode_avx2_h(char* out, const char* input, const Length len) {
+        const __m256i shuffle = _mm256_set_epi8(
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+            10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1
+        );
+        const __m256i shift = _mm256_setr_epi8(
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+            'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+            '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+        );
+        Length i = 0;
+        for (; i + 28 <= len; i += 24, out += 32) {
+
+            // Every 128 bit lane holds 12 input bytes.
+            __m256i in = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*) (input + i))),
+                _mm_loadu_si128((const __m128i*) (input + i + 12)),
+                1
+            );
+            in = _mm256_shuffle_epi8(in, shuffle);
+            const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+            const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+            const __m256i indices = _mm256_or_si256(t0, t1);
+            __m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+            offsets = _mm256_or_si256(offsets, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+            _mm256_storeu_si256((__m256i*) out, _mm256_add_epi8(indices, _mm256_shuffle_epi8(shift, offsets)));
+        }
+        return i;
+    }
+
+    // Decode blocks of 16 characters, returns the number of decoded input characters.
+    // - See http://0x80.pl/notesen/2016-01-17-sse-base64-decoding.html.
+    // - A block with characters outside of the standard alphabet is decoded by the scalar lookup.
+    // - Every block stores 16 bytes of which 12 are valid, the caller guarantees 16 writable bytes.
+    __attribute__((target("ssse3,sse4.1"))) static inline
+    Length  decode_sse_h(char* out, const char* input, const Length len) {
+        const __m128i lut_lo = _mm_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+        );
+        const __m128i lut_hi = _mm_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+        );
+        const __m128i lut_roll = _mm_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+        );
+        const __m128i mask_2f = _mm_set1_epi8(0x2f);
+        Length i = 0;
+        for (; i + 24 <= len; i += 16, out += 12) {
+            __m128i chars = _mm_loadu_si128((const __m128i*) (input + i));
+            const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(chars, 4), mask_2f);
+            const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(chars, mask_2f));
+            const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+            if (!_mm_testz_si128(lo, hi)) {
+                for (Length j = 0; j < 16; j += 4) {
+                    decode_block_h((uchar*) out + j / 4 * 3, (const uchar*) input + i + j);
+                }
+                continue;
+            }
+            const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(chars, mask_2f), hi_nibbles));
+            chars = _mm_add_epi8(chars, roll);
+
+            // Merge the 6 bit values into 24 bit groups and pack them.
+            const __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(chars, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+            _mm_storeu_si128((__m128i*) out, _mm_shuffle_epi8(merged, _mm_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+            )));
+        }
+        return i;
+    }
+
+    // Decode blocks of 32 characters, returns the number of decoded input characters.
+    // - Every block stores 32 bytes of which 24 are valid, the caller guarantees 32 writable bytes.
+    __attribute__((target("avx2"))) static inline
+    Length  decode_avx2_h(char* out, const char* input, const Length len) {
+        const __m256i lut_lo = _mm256_setr_epi8(
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+            0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+        );
+        const __m256i lut_hi = _mm256_setr_epi8(
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+            0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+        );
+        const __m256i lut_roll = _mm256_setr_epi8(
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+            0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+        );
+        const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+        Length i = 0;
+        for (; i + 45 <= len; i += 32, out += 24) {
+            __m256i chars = _mm256_loadu_si256((const __m256i*) (input + i));
+            const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(chars, 4), mask_2f);
+            const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(chars, mask_2f));
+            const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+            if (!_mm256_testz_si256(lo, hi)) {
+                for (Length j = 0; j < 32; j += 4) {
+                    decode_block_h((uchar*) out + j / 4 * 3, (const uchar*) input + i + j);
+                }
+                continue;
+            }
+            const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(chars, mask_2f), hi_nibbles));
+            chars = _mm256_add_epi8(chars, roll);
+            __m256i merged = _mm256_madd_epi16(_mm256_maddubs_epi16(chars, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+            merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+            ));
+            _mm256_storeu_si256((__m256i*) out, _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7)));
+        }
+        return i;
+    }
+
+#endif
+
+// Public.
+public:
+
     // ---------------------------------------------------------
     // Functions.
 
+    // Encoded length.
+    /*  @docs
+        @title: Encoded length
+        @description:
+            Get the length of the encoded output of an input length, including the padding.
+    */
+    SICE
+    Length  encoded_len(const Length len) {
+        return 4 * ((len + 2) / 3);
+    }
+
+    // Decoded length.
+    /*  @docs
+        @title: Decoded length
+        @description:
+            Get the maximum length of the decoded output of an input length.
+    */
+    SICE
+    Length  decoded_len(const Length len) {
+        return (len + 3) / 4 * 3;
+    }
+
     // Encode to base64.
     /*  @docs
         @title: Encode
         @description:
             Encode a string.
+ 
+            The buffer version writes `encoded_len(len)` characters into the output without allocating.
+ 
+            Blocks of 12 or 24 bytes are encoded with SSE4.1 or AVX2, depending on `vlib::encoding::simd()`.
         @parameter:
             @name: output
-            @description: A reference to the output string.
+            @description: The output buffer.
         }
         @parameter:
             @name: input
@@ -63,7 +257,7 @@ struct Base64 {
         }
         @usage:
             vlib::String = vlib::Base64::encode("Hello World!", 12);
-        @funcs: 2
+        @funcs: 3
     */
     SICE
     String     encode(const String& input) {
@@ -71,22 +265,26 @@ struct Base64 {
     }
     SICE
     String     encode(const char* input, const Length len) {
-        unsigned char *out, *pos;
-        const unsigned char *end, *in;
-        size_t olen;
-        olen = 4*((len + 2) / 3); /* 3-byte blocks to 4-byte */
-        if (olen < len) {
-            return String(); /* integer overflow */
-        }
-
-        String outStr;
-        outStr.resize(olen);
-        outStr.len() = olen;
-        out = (unsigned char*)&outStr[0];
-
-        end = (uchar*) input + len;
-        in = (uchar*) input;
-        pos = out;
+        String output;
+        output.resize(encoded_len(len));
+        output.len() = encoded_len(len);
+        encode(output.data(), input, len);
+        return output;
+    }
+    static inline
+    void       encode(char* output, const char* input, const Length len) {
+        Length i = 0;
+#if VLIB_SIMD_X86
+        if (encoding::simd() >= encoding::avx2) {
+            i = encode_avx2_h(output, input, len);
+        }
+        if (encoding::simd() >= encoding::sse41) {
+            i += encode_sse_h(output + i / 3 * 4, input + i, len - i);
+        }
+#endif
+        const uchar* in = (const uchar*) input + i;
+        const uchar* end = (const uchar*) input + len;
+        uchar* pos = (uchar*) output + i / 3 * 4;
         while (end - in >= 3) {
             *pos++ = base64_table[in[0] >> 2];
             *pos++ = base64_table[((in[0] & 0x03) << 4) | (in[1] >> 4)];
@@ -94,7 +292,6 @@ struct Base64 {
             *pos++ = base64_table[in[2] & 0x3f];
             in += 3;
         }
-
         if (end - in) {
             *pos++ = base64_table[in[0] >> 2];
             if (end - in == 1) {
@@ -108,8 +305,6 @@ struct Base64 {
             }
             *pos++ = '=';
         }
-
-        return outStr;
     }
 
     // Decode from base64.
@@ -117,9 +312,13 @@ struct Base64 {
         @title: Decode
         @description:
             Decode a string.
+ 
+            The buffer version writes at most `decoded_len(len)` bytes into the output without allocating and returns the written length.
+ 
+            Blocks of 16 or 32 characters are decoded with SSE4.1 or AVX2, depending on `vlib::encoding::simd()`. Blocks with characters outside of the standard alphabet, such as the url safe `-` and `_`, fall back to the scalar lookup.
         @parameter:
             @name: output
-            @description: A reference to the output string.
+            @description: The output buffer.
         }
         @parameter:
             @name: input
@@ -127,39 +326,48 @@ struct Base64 {
         }
         @usage:
             vlib::String decoded = vlib::Base64::decode("XXX");
-        @funcs: 2
+        @funcs: 3
     */
     SICE
     String     decode(const String& input) {
         return decode(input.data(), input.len());
     }
     SICE
-    String        decode(const char* input, const Length len) {
-        unsigned char* p = (unsigned char*)input;
-        int pad = len > 0 && (len % 4 || p[len - 1] == '=');
-        const size_t L = ((len + 3) / 4 - pad) * 4;
-        String str('\0');
-        str.resize(L / 4 * 3 + pad);
-        str.len() = L / 4 * 3 + pad;
-        for (size_t i = 0, j = 0; i < L; i += 4)
-        {
-            int n = B64index[p[i]] << 18 | B64index[p[i + 1]] << 12 | B64index[p[i + 2]] << 6 | B64index[p[i + 3]];
-            str[j++] = n >> 16;
-            str[j++] = n >> 8 & 0xFF;
-            str[j++] = n & 0xFF;
-        }
-        if (pad)
-        {
-            int n = B64index[p[L]] << 18 | B64index[p[L + 1]] << 12;
-            str[str.len() - 1] = n >> 16;
-
-            if (len > L + 2 && p[L + 2] != '=')
-            {
-                n |= B64index[p[L + 2]] << 6;
-                str.append(n >> 8 & 0xFF);
+    String     decode(const char* input, const Length len) {
+        String output;
+        output.resize(decoded_len(len));
+        output.len() = decode(output.data(), input, len);
+        return output;
+    }
+    static inline
+    Length     decode(char* output, const char* input, Length len) {
+        const uchar* p = (const uchar*) input;
+        uchar* out = (uchar*) output;
+        if (len > 0 && p[len - 1] == '=') { --len; }
+        if (len > 0 && p[len - 1] == '=') { --len; }
+        Length i = 0;
+#if VLIB_SIMD_X86
+        if (encoding::simd() >= encoding::avx2) {
+            i = decode_avx2_h((char*) out, input, len);
+            out += i / 4 * 3;
+        }
+        if (encoding::simd() >= encoding::sse41) {
+            const Length decoded = decode_sse_h((char*) out, input + i, len - i);
+            out += decoded / 4 * 3;
+            i += decoded;
+        }
+#endif
+        for (; i + 4 <= len; i += 4, out += 3) {
+            decode_block_h(out, p + i);
+        }
+        if (len - i >= 2) {
+            const int n = B64index[p[i]] << 18 | B64index[p[i + 1]] << 12 | (len - i == 3 ? B64index[p[i + 2]] << 6 : 0);
+            *out++ = n >> 16;
+            if (len - i == 3) {
+                *out++ = n >> 8 & 0xFF;
             }
         }
-        return str;
+        return out - (uchar*) output;
     }
 
 };
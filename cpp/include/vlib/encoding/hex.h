@@ -32,27 +32,152 @@ struct Hex {
 
 	using 	Length = 		ullong;
 
+	// ---------------------------------------------------------
+	// Attributes.
+
+	constexpr static const char digits[17] = "0123456789ABCDEF";
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// The value of a hex character, lowercase and uppercase letters are both accepted.
+	SICE
+	char 	nibble_h(const char c) {
+		return (c & '@' ? c + 9 : c) & 0xF;
+	}
+
+#if VLIB_SIMD_X86
+
+	// Encode blocks of 16 bytes, returns the number of encoded input bytes.
+	static inline
+	Length 	encode_sse2_h(char* out, const char* input, const Length len) {
+		const __m128i mask = _mm_set1_epi8(0x0F), nine = _mm_set1_epi8(9), zero = _mm_set1_epi8('0'), letters = _mm_set1_epi8('A' - '0' - 10);
+		Length i = 0;
+		for (; i + 16 <= len; i += 16) {
+			const __m128i bytes = _mm_loadu_si128((const __m128i*) (input + i));
+			__m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+			__m128i lo = _mm_and_si128(bytes, mask);
+			hi = _mm_add_epi8(_mm_add_epi8(hi, zero), _mm_and_si128(_mm_cmpgt_epi8(hi, nine), letters));
+			lo = _mm_add_epi8(_mm_add_epi8(lo, zero), _mm_and_si128(_mm_cmpgt_epi8(lo, nine), letters));
+			_mm_storeu_si128((__m128i*) (out + i * 2), _mm_unpacklo_epi8(hi, lo));
+			_mm_storeu_si128((__m128i*) (out + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+		}
+		return i;
+	}
+
+	// Encode blocks of 32 bytes, returns the number of encoded input bytes.
+	__attribute__((target("avx2"))) static inline
+	Length 	encode_avx2_h(char* out, const char* input, const Length len) {
+		const __m256i mask = _mm256_set1_epi8(0x0F), nine = _mm256_set1_epi8(9), zero = _mm256_set1_epi8('0'), letters = _mm256_set1_epi8('A' - '0' - 10);
+		Length i = 0;
+		for (; i + 32 <= len; i += 32) {
+			const __m256i bytes = _mm256_loadu_si256((const __m256i*) (input + i));
+			__m256i hi = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask);
+			__m256i lo = _mm256_and_si256(bytes, mask);
+			hi = _mm256_add_epi8(_mm256_add_epi8(hi, zero), _mm256_and_si256(_mm256_cmpgt_epi8(hi, nine), letters));
+			lo = _mm256_add_epi8(_mm256_add_epi8(lo, zero), _mm256_and_si256(_mm256_cmpgt_epi8(lo, nine), letters));
+
+			// The unpacks work per 128 bit lane, so "a" holds bytes 0-7 and 16-23, "b" holds 8-15 and 24-31.
+			const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+			const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+			_mm256_storeu_si256((__m256i*) (out + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+			_mm256_storeu_si256((__m256i*) (out + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+		}
+		return i;
+	}
+
+	// Decode blocks of 32 characters, returns the number of decoded bytes.
+	static inline
+	Length 	decode_sse2_h(char* out, const char* input, const Length len) {
+		const __m128i mask = _mm_set1_epi8(0x0F), letter = _mm_set1_epi8('@'), nine = _mm_set1_epi8(9), low = _mm_set1_epi16(0x00FF);
+		auto nibbles = [&](const __m128i chars) {
+			const __m128i letters = _mm_cmpeq_epi8(_mm_and_si128(chars, letter), letter);
+			const __m128i values = _mm_and_si128(_mm_add_epi8(chars, _mm_and_si128(letters, nine)), mask);
+			return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(values, low), 4), _mm_srli_epi16(values, 8));
+		};
+		Length i = 0;
+		for (; i + 32 <= len; i += 32) {
+			const __m128i a = nibbles(_mm_loadu_si128((const __m128i*) (input + i)));
+			const __m128i b = nibbles(_mm_loadu_si128((const __m128i*) (input + i + 16)));
+			_mm_storeu_si128((__m128i*) (out + i / 2), _mm_packus_epi16(a, b));
+		}
+		return i / 2;
+	}
+
+	// Decode blocks of 64 characters, returns the number of decoded bytes.
+	__attribute__((target("avx2"))) static inline
+	Length 	decode_avx2_h(char* out, const char* input, const Length len) {
+		const __m256i mask = _mm256_set1_epi8(0x0F), letter = _mm256_set1_epi8('@'), nine = _mm256_set1_epi8(9), low = _mm256_set1_epi16(0x00FF);
+		auto nibbles = [&](const __m256i chars) __attribute__((target("avx2"))) {
+			const __m256i letters = _mm256_cmpeq_epi8(_mm256_and_si256(chars, letter), letter);
+			const __m256i values = _mm256_and_si256(_mm256_add_epi8(chars, _mm256_and_si256(letters, nine)), mask);
+			return _mm256_or_si256(_mm256_slli_epi16(_mm256_and_si256(values, low), 4), _mm256_srli_epi16(values, 8));
+		};
+		Length i = 0;
+		for (; i + 64 <= len; i += 64) {
+			const __m256i a = nibbles(_mm256_loadu_si256((const __m256i*) (input + i)));
+			const __m256i b = nibbles(_mm256_loadu_si256((const __m256i*) (input + i + 32)));
+
+			// The pack works per 128 bit lane, restore the order of the 64 bit quarters.
+			const __m256i packed = _mm256_packus_epi16(a, b);
+			_mm256_storeu_si256((__m256i*) (out + i / 2), _mm256_permute4x64_epi64(packed, _MM_SHUFFLE(3, 1, 2, 0)));
+		}
+		return i / 2;
+	}
+
+#endif
+
+// Public.
+public:
+
 	// ---------------------------------------------------------
 	// Functions.
 
+	// Encoded length.
+	/*  @docs
+		@title: Encoded length
+		@description:
+			Get the length of the encoded output of an input length.
+	*/
+	SICE
+	Length 	encoded_len(const Length len) {
+		return len * 2;
+	}
+
+	// Decoded length.
+	/*  @docs
+		@title: Decoded length
+		@description:
+			Get the length of the decoded output of an input length.
+	*/
+	SICE
+	Length 	decoded_len(const Length len) {
+		return (len + 1) / 2;
+	}
+
 	// Encode to hex.
     /*  @docs
         @title: Encode
         @description:
             Encode a string.
+ 
+            The buffer version writes `encoded_len(len)` characters into the output without allocating.
+ 
+            Blocks of 16 or 32 bytes are encoded with SSE2 or AVX2, depending on `vlib::encoding::simd()`.
         @parameter:
             @name: output
-            @description: A reference to the output string.
+            @description: The output buffer.
         }
         @parameter:
             @name: input
             @description: The input data to encode.
         }
-        @return:
-            Returns `0` upon success, and the error code upon failure (`< 0`).
         @usage:
             vlib::String encoded = vlib::Hex::encode("Hello World!", 12);
-        @funcs: 2
+        @funcs: 3
     */
     SICE
     String  encode(const String& input) {
@@ -61,36 +186,47 @@ struct Hex {
 	SICE
 	String 	encode(const char* input, const Length len) {
         String output;
-		output.resize(len * 2);
-		output.len() = output.capacity();
-		char* arr = output.data();
-		const Length a = 'A' - 1;
-		//const Length a = capital ? 'A' - 1 : 'a' - 1;
-		for (Length i = 0, c = input[0] & 0xFF; i < output.len(); c = input[i / 2] & 0xFF) {
-			arr[i++] = c > 0x9F ? (c / 16 - 9) | a : c / 16 | '0';
-			arr[i++] = (c & 0xF) > 9 ? (c % 16 - 9) | a : c % 16 | '0';
-		}
+		output.resize(encoded_len(len));
+		output.len() = encoded_len(len);
+		encode(output.data(), input, len);
 		return output;
 	}
+	static inline
+	void 	encode(char* output, const char* input, const Length len) {
+		Length i = 0;
+#if VLIB_SIMD_X86
+		if (encoding::simd() >= encoding::avx2) {
+			i = encode_avx2_h(output, input, len);
+		} else if (encoding::simd() >= encoding::sse2) {
+			i = encode_sse2_h(output, input, len);
+		}
+#endif
+		for (; i < len; ++i) {
+			output[i * 2] = digits[(input[i] >> 4) & 0xF];
+			output[i * 2 + 1] = digits[input[i] & 0xF];
+		}
+	}
 
 	// Decode from hex.
     /*  @docs
         @title: Decode
         @description:
             Decode a string.
+ 
+            The buffer version writes `decoded_len(len)` bytes into the output without allocating and returns the written length.
+ 
+            Blocks of 32 or 64 characters are decoded with SSE2 or AVX2, depending on `vlib::encoding::simd()`.
         @parameter:
             @name: output
-            @description: A reference to the output string.
+            @description: The output buffer.
         }
         @parameter:
             @name: input
             @description: The input data to decode.
         }
-        @return:
-            Returns `0` upon success, and the error code upon failure (`< 0`).
         @usage:
             vlib::String decoded = vlib::Hex::decode("XXX");
-        @funcs: 2
+        @funcs: 3
     */
     SICE
     String  decode(const String& input) {
@@ -99,15 +235,28 @@ struct Hex {
 	SICE
 	String  decode(const char* input, const Length len) {
 		String output;
-		output.resize((len + 1) / 2);
-		output.len() = output.capacity();
-		char* arr = output.data();
-		for (Length i = 0, j = 0; i < output.len(); i++, j++) {
-			arr[i] = (input[j] & '@' ? input[j] + 9 : input[j]) << 4; j++; // 4, j++;
-			arr[i] |= (input[j] & '@' ? input[j] + 9 : input[j]) & 0xF;
-		}
+		output.resize(decoded_len(len));
+		output.len() = decode(output.data(), input, len);
 		return output;
 	}
+	static inline
+	Length  decode(char* output, const char* input, const Length len) {
+		Length i = 0;
+#if VLIB_SIMD_X86
+		if (encoding::simd() >= encoding::avx2) {
+			i = decode_avx2_h(output, input, len);
+		} else if (encoding::simd() >= encoding::sse2) {
+			i = decode_sse2_h(output, input, len);
+		}
+#endif
+		for (; i < len / 2; ++i) {
+			output[i] = nibble_h(input[i * 2]) << 4 | nibble_h(input[i * 2 + 1]);
+		}
+		if (len % 2 == 1) {
+			output[i++] = nibble_h(input[len - 1]) << 4;
+		}
+		return i;
+	}
 
 };
 
@@ -0,0 +1,41 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_ENCODING_SIMD_H
+#define VLIB_ENCODING_SIMD_H
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace encoding.
+namespace encoding {
+
+// ---------------------------------------------------------
+// Runtime SIMD dispatch.
+//
+// Notes:
+// - The level is detected by "vlib::cpu::simd()" and shared with the other modules.
+//
+/*  @docs
+	@chapter: Encoding
+	@title: SIMD
+	@description:
+		The instruction set used by the encoders, an alias of `vlib::cpu::simd()`.
+
+		The level can be lowered to force a slower path, for example in tests and benchmarks.
+	@usage:
+		#include <vlib/encoding.h>
+		if (vlib::encoding::simd() >= vlib::encoding::avx2) { ... }
+		vlib::encoding::simd() = vlib::encoding::scalar; // force the scalar path.
+*/
+using cpu::simd_level;
+using cpu::scalar;
+using cpu::sse2;
+using cpu::sse41;
+using cpu::avx2;
+using cpu::simd;
+
+}; 		// End namespace encoding.
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -12,3 +12,4 @@
 #include "response.h"
 #include "client_template.h"
 #include "client.h"
+#include "server.h"
@@ -23,8 +23,12 @@ namespace http {
 //   * The data contains multiple spaces after the key/value header delimiter (":").
 //   * The data contains one or multiple spaces after the header delimiter (CRLF) (":").
 //   * The method string is not comprised of uppercase characters.
+// - The data can also be parsed in place from a receive buffer with "parse(data, len)".
+// - With a sink the body is streamed into "sink.write(data, len)" as it is received instead of being stored in the body.
+//   The data before "discardable()" is no longer required and can be released with "discard()", so a large body is parsed with a fixed memory footprint.
+//   A streamed body is not decompressed.
 
-template <typename Type>
+template <typename Type, typename Sink = Null>
 struct Parser {
 	
 // Private.
@@ -36,6 +40,9 @@ private:
 	// The output response / request.
 	Type* output = NULL;
 	
+	// The body sink.
+	Sink* sink = NULL;
+	
 	// Mode variable.
 	// - 0 for the 1th item of the first line.
 	// - 1 for the 2th item of the first line
@@ -57,6 +64,10 @@ private:
 	ullong 		chunk_len = 0; 				// the chunk length for chunked transmissions.
 	ullong 		chunk_start = 0; 			// the start index of the chunk.
 	ullong 		chunk_end = 0; 				// the actual last index of the chunk, not +1 like with len.
+	ullong		key_start = 0;				// start index of the current header key.
+	ullong		key_end = 0;				// end index of the current header key.
+	ullong		end_index = 0;				// the length of the parsed message once finished.
+	ullong		remaining = 0;				// the body length that is not yet streamed into the sink.
 	
 	// ---------------------------------------------------------
 	// Static attributes.
@@ -66,6 +77,28 @@ private:
 	// ---------------------------------------------------------
 	// Private functions.
 	
+	// Has sink.
+	SICEBOOL has_sink_h() { return !is_Null<Sink>::value; }
+	
+	// Stream the received part of a non chunked body into the sink.
+	// - Returns true when the full body has been streamed.
+	constexpr
+	bool	stream_h() {
+		ullong available = len - body_start;
+		if (available > remaining) { available = remaining; }
+		if (available != 0) {
+			sink->write(data + body_start, available);
+			body_start += available;
+			remaining -= available;
+		}
+		index = body_start;
+		if (remaining == 0) {
+			end_index = body_start;
+			return true;
+		}
+		return false;
+	}
+	
 	// Get a char from the data safely, without causing a segfault.
 	SICE
 	const char&	safe_get(const char*& data, const ullong index, const ullong len) {
@@ -313,23 +346,63 @@ public:
 	constexpr
 	Parser(Type& _output) : output(&_output) {}
 	
+	// Constructor from output response / request and a body sink.
+	constexpr
+	Parser(Type& _output, Sink& _sink) requires (!is_Null<Sink>::value) : output(&_output), sink(&_sink) {}
+	
 	// ---------------------------------------------------------
 	// Functions.
 	
+	// Parsed length.
+	// - The length of the parsed message after "parse()" returned true.
+	// - Any data after this length belongs to the next message on the same connection.
+	constexpr
+	ullong	parsed() const {
+		return end_index;
+	}
+	
+	// Discardable length.
+	// - The length of the data at the start of the received data that is no longer required by the parser.
+	// - Only data of a streamed body is discardable, the headers must remain present until the message has been parsed.
+	constexpr
+	ullong	discardable() const {
+		if constexpr (has_sink_h()) {
+			if (mode == 5) {
+				if (!is_chunked) { return body_start; }
+				const ullong start = chunk_start < index ? chunk_start : index;
+				return start == 0 ? 0 : start - 1; // keep the previous char for the CRLF check.
+			}
+		}
+		return 0;
+	}
+	
+	// Discard.
+	// - Must be called after a discardable length has been removed from the start of the received data.
+	constexpr
+	void	discard(ullong n) {
+		index -= n;
+		if (is_chunked) {
+			chunk_start -= n;
+			chunk_end -= n;
+		} else {
+			body_start -= n;
+		}
+	}
+	
 	// Parse.
 	// - Returns true when the full http request / response has been parsed.
 	// - This function can be called multiple times for seperated data in a single response.
-	// - The first line of the response and the full headers should always be in a single block.
+	// - The data must be the full data received so far, new data should be appended to the previous data.
 	constexpr
 	bool	parse(String& full_data) {
+		return parse(full_data.data(), full_data.len());
+	}
+	constexpr
+	bool	parse(const char* full_data, ullong full_len) {
 		
 		// Reset iteration variables.
-		data = full_data.data();
-		len = full_data.len();
-		
-		// New vars.
-		ullong key_start = 0;
-		ullong key_end = 0;
+		data = full_data;
+		len = full_len;
 		
 		// Iterate.
 		for (; index < len; ++index) {
@@ -399,11 +472,27 @@ public:
 									
 									// No body.
 									else if (content_len == 0) {
+										end_index = index + 1;
 										return true;
 									}
 									
 									// Parse non chunked body.
 									++index;
+									
+									// Stream the body into the sink.
+									if constexpr (has_sink_h()) {
+										body_start = index;
+										remaining = content_len;
+										mode = 5;
+										return stream_h();
+									}
+									
+									// The body has not been received yet.
+									if (index == len) {
+										body_start = index;
+										mode = 5;
+										return false;
+									}
 									if (index != len) {
 										
 										// Set body start.
@@ -413,10 +502,12 @@ public:
 										if (len - body_start >= content_len) {
 											
 											// Assign body.
+											// - Data after the content length belongs to the next message.
 											output->m_body.reconstruct(
 												data + body_start,
-												len - body_start
+												content_len
 											);
+											end_index = body_start + content_len;
 											
 											// Decompress.
 											if (is_compressed(output->m_body)) {
@@ -508,8 +599,9 @@ public:
 						case '\n': {
 							switch (data[index-1]) {
 								case '\r': {
-									String key(data + key_start, key_end - key_start);
-									String value(data + start_index, index - 1 - start_index);
+									// Inspect the header through views, the key and value are copied once into the stored header.
+									const CString key(data + key_start, key_end - key_start);
+									const CString value(data + start_index, index - 1 - start_index);
 									if (
 										output->m_content_type == http::content_type::undefined &&
 										key.eq("Content-Type", 12)
@@ -520,7 +612,7 @@ public:
 										content_len == 0 &&
 										key.eq("Content-Length", 14)
 									) {
-										content_len = value.as<ullong>();
+										content_len = to_num<ullong>(value.data(), value.len());
 									}
 									else if (
 										!is_chunked && key.eq("Transfer-Encoding", 17) &&
@@ -528,7 +620,7 @@ public:
 									) {
 										is_chunked = true;
 									}
-									output->m_headers.append(move(key), move(value));
+									output->m_headers.append(String(key.data(), key.len()), String(value.data(), value.len()));
 									mode = 3;
 									key_start = index + 1;
 									continue;
@@ -548,14 +640,20 @@ public:
 					// Not chunked.
 					if (!is_chunked) {
 						
+						// Stream the body into the sink.
+						if constexpr (has_sink_h()) {
+							return stream_h();
+						}
+						
 						// Check if the full body is present.
 						if (len - body_start >= content_len) {
 							
 							// Assign body.
 							output->m_body.reconstruct(
 								data + body_start,
-								len - body_start
+								content_len
 							);
+							end_index = body_start + content_len;
 							
 							// Decompress.
 							if (is_compressed(output->m_body)) {
@@ -607,6 +705,7 @@ public:
 									case '\r':
 										chunk_len = from_hex(data + chunk_start, index - chunk_start - 1);
 										if (chunk_len == 0) {
+											end_index = index + 1;
 											
 											// Decompress.
 											if (is_compressed(output->m_body)) {
@@ -628,7 +727,11 @@ public:
 					
 					// End of chunk.
 					else if (chunk_len != 0 && index >= chunk_end) {
-						output->m_body.concat_r(data + chunk_start, chunk_len);
+						if constexpr (has_sink_h()) {
+							sink->write(data + chunk_start, chunk_len);
+						} else {
+							output->m_body.concat_r(data + chunk_start, chunk_len);
+						}
 						chunk_start = index + 3;
 						chunk_len = 0;
 						continue;
@@ -643,6 +746,19 @@ public:
 			
 		}
 		
+		// Stream the received part of the current chunk into the sink.
+		// - The last byte of the chunk is kept so the end of the chunk is still detected.
+		if constexpr (has_sink_h()) {
+			if (mode == 5 && is_chunked && chunk_len != 0) {
+				const ullong end = len < chunk_end ? len : chunk_end;
+				if (end > chunk_start) {
+					sink->write(data + chunk_start, end - chunk_start);
+					chunk_len -= end - chunk_start;
+					chunk_start = end;
+				}
+			}
+		}
+		
 		// Not finished parsing.
 		return false;
 		
@@ -533,6 +533,18 @@ public:
 	auto& 	body() const {
 		return m_body;
 	}
+	/*  @docs
+		@title: JSON reader
+		@type: json::Reader
+		@description:
+			Get a pull style json reader over the HTTP body.
+
+			Does not construct a `Json` object, the reader's views point into the body of the request.
+		@note: The request must stay alive while the reader is used.
+	*/
+	json::Reader 	json_reader() const {
+		return json::Reader(m_body.data(), m_body.len());
+	}
 	
 	// Data.
 	/*  @docs
@@ -0,0 +1,325 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_HTTP_SERVER_T_H
+#define VLIB_HTTP_SERVER_T_H
+
+// Only supported on linux.
+#if defined(__linux__)
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace http.
+namespace http {
+
+// ---------------------------------------------------------
+// HTTP server type.
+//
+// Notes:
+// - Serves keep-alive connections on a single thread with "sockets::Reactor".
+// - Every connection keeps its own "http::Parser" that parses the received data in place, pipelined requests are handled in order.
+// - With a sink type every connection keeps its own sink and request bodies are streamed into "sink.write(data, len)" as they are received, the handler is then called as "func(request, sink)" once the body has been streamed.
+//   The sink is reset to a default constructed sink before the next request of the connection.
+//   The streamed data is released from the receive buffer directly, so large uploads are handled with a fixed memory footprint and "max_len" only limits the headers.
+// - An idle connection only holds its connection and parser state, so a single server can hold many idle keep-alive connections.
+// - Use one server per thread, each listening on its own socket bound to the same port.
+//
+/*  @docs
+ *	@chapter: HTTP
+ *	@title: Server
+ *	@description:
+ *		Event driven HTTP server type.
+ *	@note: Only supported on linux.
+ *	@usage:
+ *		#include <vlib/sockets/http.h>
+ *		auto handler = [](vlib::http::Request& request) {
+ *			return vlib::http::Response(vlib::http::version::v1_1, vlib::http::status::success, {}, "Hello World!");
+ *		};
+ *		vlib::Socket<> sock (8000);
+ *		sock.bind();
+ *		sock.listen(SOMAXCONN);
+ *		vlib::http::Server<decltype(handler)> server (handler);
+ *		server.listen(sock.fd());
+ *		server.run();
+ */
+template <typename Func, typename Sink = Null>
+struct Server {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Structs.
+
+	// Connection state.
+	struct State {
+		Request					request;
+		Sink					sink;
+		Parser<Request, Sink>	parser;
+		bool					active = false;		// a request is being parsed.
+	};
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 	This = 			Server;
+	using	Reactor = 		sockets::Reactor<Server, State>;
+	using	Connection = 	typename Reactor::Connection;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	Func		m_func;
+	mtime_t		m_keep_alive;		// the keep-alive timeout in milliseconds.
+	ullong		m_max_len;			// the max length of a single request.
+	ullong		m_requests = 0;
+	Reactor		m_reactor;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Has sink.
+	SICEBOOL has_sink_h() { return !is_Null<Sink>::value; }
+
+	// Initialize the parser.
+	static constexpr
+	void	init_h(State& state) {
+		if constexpr (has_sink_h()) {
+			state.parser = Parser<Request, Sink>(state.request, state.sink);
+		} else {
+			state.parser = Parser<Request, Sink>(state.request);
+		}
+	}
+
+	// Reset the parser and the sink for the next request.
+	static constexpr
+	void	next_h(State& state) {
+		state.request.reset();
+		if constexpr (has_sink_h()) {
+			state.sink = Sink();
+		}
+		init_h(state);
+		state.active = false;
+	}
+
+	// Call the request handler.
+	Response	call_h(State& state) {
+		if constexpr (has_sink_h()) {
+			return m_func(state.request, state.sink);
+		} else {
+			return m_func(state.request);
+		}
+	}
+
+	// Check if a header value equals a lowercase value.
+	static constexpr
+	bool	eq_lower_h(const String& value, const char* lower, ullong len) {
+		if (value.len() != len) { return false; }
+		for (ullong i = 0; i < len; ++i) {
+			char c = value.m_arr[i];
+			if (c >= 'A' && c <= 'Z') { c += 'a' - 'A'; }
+			if (c != lower[i]) { return false; }
+		}
+		return true;
+	}
+
+	// Check if the connection should be kept alive after a request.
+	static constexpr
+	bool	keep_alive_h(const Request& request) {
+		ullong index = request.m_headers.find("Connection", 10);
+		if (index == NPos::npos) {
+			index = request.m_headers.find("connection", 10);
+		}
+		if (index != NPos::npos) {
+			const String& value = request.m_headers.values()[index];
+			if (eq_lower_h(value, "close", 5)) { return false; }
+			if (eq_lower_h(value, "keep-alive", 10)) { return true; }
+		}
+		return request.m_version == version::v1_1;
+	}
+
+	// Send an error response and close the connection.
+	static
+	void	error_h(Reactor& reactor, Connection& conn, int status) {
+		Response response (version::v1_1, status, {{"Connection", "close"}}, "");
+		if (reactor.send(conn, response.data())) {
+			reactor.close_after_send(conn);
+		}
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Constructor.
+	/*  @docs
+	 *	@title: Constructor
+	 *	@description:
+	 *		Construct a server object.
+	 *	@parameter:
+	 *		@name: func
+	 *		@description: The request handler, a function like `http::Response func(http::Request&)` or `http::Response func(http::Request&, Sink&)` when a sink type is used.
+	 *	@parameter:
+	 *		@name: keep_alive
+	 *		@description: The idle keep-alive timeout in milliseconds.
+	 *	@parameter:
+	 *		@name: max_len
+	 *		@description: The max length of a single request in bytes, or the max length of the headers when a sink type is used.
+	 */
+	Server(Func func, mtime_t keep_alive = 60 * 1000, ullong max_len = 8 * 1024 * 1024) :
+	m_func(move(func)),
+	m_keep_alive(keep_alive),
+	m_max_len(max_len),
+	m_reactor(*this) {}
+
+	// ---------------------------------------------------------
+	// Reactor handler functions.
+
+	// On accept.
+	void	on_accept(Reactor& reactor, Connection& conn) {
+		init_h(conn.state);
+		reactor.timeout(conn, m_keep_alive);
+	}
+
+	// On read.
+	void	on_read(Reactor& reactor, Connection& conn) {
+		State& state = conn.state;
+		while (conn.input.len() != 0) {
+
+			// Skip the CRLF between messages.
+			if (!state.active) {
+				const char* data = conn.input.data();
+				ullong skip = 0;
+				while (skip < conn.input.len() && (data[skip] == '\r' || data[skip] == '\n')) {
+					++skip;
+				}
+				conn.input.consume(skip);
+				if (conn.input.len() == 0) { break; }
+				state.active = true;
+			}
+
+			// Parse.
+			bool finished;
+			try {
+				finished = state.parser.parse(conn.input.data(), conn.input.len());
+			} catch (Exception&) {
+				error_h(reactor, conn, status::bad_request);
+				return ;
+			}
+			if (!finished) {
+
+				// Release the streamed body data.
+				if constexpr (has_sink_h()) {
+					const ullong discard = state.parser.discardable();
+					state.parser.discard(discard);
+					conn.input.consume(discard);
+				}
+				if (conn.input.len() > m_max_len) {
+					error_h(reactor, conn, status::payload_too_large);
+					return ;
+				}
+				break;
+			}
+
+			// Respond.
+			++m_requests;
+			const bool keep_alive = keep_alive_h(state.request);
+			try {
+				Response response = call_h(state);
+				if (!reactor.send(conn, response.data())) {
+					return ;
+				}
+			} catch (Exception&) {
+				error_h(reactor, conn, status::internal_server_error);
+				return ;
+			}
+			if (!keep_alive) {
+				reactor.close_after_send(conn);
+				return ;
+			}
+
+			// Remove the parsed request.
+			conn.input.consume(state.parser.parsed());
+			next_h(state);
+		}
+		reactor.timeout(conn, m_keep_alive);
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Listen.
+	/*  @docs
+	 *	@title: Listen
+	 *	@description:
+	 *		Accept connections from a bound and listening socket.
+	 */
+	This&	listen(const Int& fd) {
+		m_reactor.listen(fd);
+		return *this;
+	}
+
+	// Run.
+	/*  @docs
+	 *	@title: Run
+	 *	@description:
+	 *		Run the server until `stop()` is called.
+	 *	@funcs: 2
+	 */
+	void	run() {
+		m_reactor.run();
+	}
+	ullong	run_once(int timeout = -1) {
+		return m_reactor.run_once(timeout);
+	}
+
+	// Stop.
+	/*  @docs
+	 *	@title: Stop
+	 *	@description:
+	 *		Stop the server after the current iteration.
+	 */
+	constexpr
+	void	stop() {
+		m_reactor.stop();
+	}
+
+	// Connections.
+	/*  @docs
+	 *	@title: Connections
+	 *	@description:
+	 *		Get the number of open connections.
+	 */
+	constexpr
+	ullong	connections() const {
+		return m_reactor.len();
+	}
+
+	// Requests.
+	/*  @docs
+	 *	@title: Requests
+	 *	@description:
+	 *		Get the number of handled requests.
+	 */
+	constexpr
+	ullong	requests() const {
+		return m_requests;
+	}
+
+};
+
+// ---------------------------------------------------------
+// End.
+
+}; 		// End namespace http.
+}; 		// End namespace vlib.
+
+#endif 	// End linux.
+#endif 	// End header.
@@ -6,4 +6,6 @@
 #include "type.h"
 #include "protocol.h"
 #include "state.h"
+#include "buffer.h"
 #include "socket.h"
+#include "reactor.h"
@@ -0,0 +1,244 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_SOCKET_BUFFER_H
+#define VLIB_SOCKET_BUFFER_H
+
+// Includes.
+#include <sys/uio.h>
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace sockets.
+namespace sockets {
+
+// ---------------------------------------------------------
+// Receive buffer.
+//
+// Notes:
+// - The unread data is always contiguous, so parsers can consume it in place through "data()" and "len()".
+// - Consumed data is released by moving the read offset, the unread data is only moved to the front when the free space at the end is too small.
+// - A read is a single "readv" into the free space at the end and a second segment on the stack, the buffer only grows when the data does not fit in the free space.
+// - An empty buffer does not allocate, so an idle connection holds no memory.
+//
+/* @docs
+ *  @chapter: Sockets
+ *  @title: Buffer
+ *  @description:
+ *      Reusable receive buffer.
+ *  @usage:
+ *      #include <vlib/sockets/socket.h>
+ *      vlib::sockets::Buffer buffer;
+ *      while (buffer.read(fd) > 0) {
+ *          ullong parsed = parse(buffer.data(), buffer.len());
+ *          buffer.consume(parsed);
+ *      }
+ */
+struct Buffer {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using	This = 		Buffer;
+
+	// ---------------------------------------------------------
+	// Static attributes.
+
+	// The length of the stack segment of a single read.
+	SICE ullong	stack_len = 64 * 1024;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	char*		m_arr = nullptr;
+	ullong		m_start = 0;			// the read offset.
+	ullong		m_end = 0;				// the write offset.
+	ullong		m_capacity = 0;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Make sure there is free space for a length at the end.
+	constexpr
+	void	reserve_h(ullong len) {
+		if (m_capacity - m_end >= len) {
+			return ;
+		}
+		const ullong used = m_end - m_start;
+
+		// Move the unread data to the front.
+		if (m_capacity - used >= len) {
+			memmove(m_arr, m_arr + m_start, used);
+			m_start = 0;
+			m_end = used;
+			return ;
+		}
+
+		// Reallocate.
+		ullong capacity = m_capacity + m_capacity / 2;
+		if (capacity < used + len) { capacity = used + len; }
+		if (capacity < 1024) { capacity = 1024; }
+		char* arr = new char [capacity];
+		if (used != 0) {
+			memcpy(arr, m_arr + m_start, used);
+		}
+		delete[] m_arr;
+		m_arr = arr;
+		m_start = 0;
+		m_end = used;
+		m_capacity = capacity;
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Default constructor.
+	constexpr
+	Buffer() = default;
+
+	// Move constructor.
+	constexpr
+	Buffer(This&& obj) :
+	m_arr(obj.m_arr),
+	m_start(obj.m_start),
+	m_end(obj.m_end),
+	m_capacity(obj.m_capacity)
+	{
+		obj.m_arr = nullptr;
+		obj.m_start = obj.m_end = obj.m_capacity = 0;
+	}
+
+	// No copy constructor.
+	Buffer(const This&) = delete;
+
+	// Destructor.
+	constexpr
+	~Buffer() {
+		delete[] m_arr;
+	}
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	// Unread data.
+	constexpr
+	char*	data() { return m_arr + m_start; }
+	constexpr
+	const char*	data() const { return m_arr + m_start; }
+
+	// Unread length.
+	constexpr
+	ullong	len() const { return m_end - m_start; }
+
+	// Allocated capacity.
+	constexpr
+	ullong	capacity() const { return m_capacity; }
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Consume.
+	/* @docs
+	 *  @title: Consume
+	 *  @description:
+	 *      Release a length of the unread data.
+	 */
+	constexpr
+	This&	consume(ullong len) {
+		if (len >= m_end - m_start) {
+			m_start = m_end = 0;
+		} else {
+			m_start += len;
+		}
+		return *this;
+	}
+
+	// Append.
+	/* @docs
+	 *  @title: Append
+	 *  @description:
+	 *      Append data to the end of the buffer.
+	 */
+	constexpr
+	This&	append(const char* data, ullong len) {
+		reserve_h(len);
+		memcpy(m_arr + m_end, data, len);
+		m_end += len;
+		return *this;
+	}
+
+	// Reset.
+	/* @docs
+	 *  @title: Reset
+	 *  @description:
+	 *      Release all unread data while keeping the allocated memory.
+	 */
+	constexpr
+	This&	reset() {
+		m_start = m_end = 0;
+		return *this;
+	}
+
+	// Destruct.
+	/* @docs
+	 *  @title: Destruct
+	 *  @description:
+	 *      Release all unread data and the allocated memory.
+	 */
+	constexpr
+	This&	destruct() {
+		delete[] m_arr;
+		m_arr = nullptr;
+		m_start = m_end = m_capacity = 0;
+		return *this;
+	}
+
+	// Read.
+	/* @docs
+	 *  @title: Read
+	 *  @description:
+	 *      Read once from a file descriptor with a single `readv` call.
+	 *
+	 *      At most `max` bytes are read, use `0` for the length of the free space plus the stack segment. The buffer is grown beforehand when `max` exceeds the free space plus the stack segment.
+	 *
+	 *      Returns the number of read bytes, `0` when the peer closed the connection or `-1` when an error occured, `errno` is `EAGAIN` when a non-blocking socket has no data.
+	 */
+	llong	read(int fd, ullong max = 0) {
+		char stack[stack_len];
+		if (max == 0) { max = m_capacity - m_end + stack_len; }
+		else if (max > m_capacity - m_end + stack_len) { reserve_h(max - stack_len); }
+		struct iovec iov[2];
+		const ullong free = m_capacity - m_end < max ? m_capacity - m_end : max;
+		iov[0].iov_base = m_arr + m_end;
+		iov[0].iov_len = free;
+		iov[1].iov_base = stack;
+		iov[1].iov_len = max - free < stack_len ? max - free : stack_len;
+		const ssize_t bytes = ::readv(fd, iov, 2);
+		if (bytes <= 0) {
+			return bytes;
+		}
+		if ((ullong) bytes <= free) {
+			m_end += bytes;
+		} else {
+			m_end += free;
+			append(stack, bytes - free);
+		}
+		return bytes;
+	}
+
+};
+
+}; 		// End namespace sockets.
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -0,0 +1,696 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_SOCKET_REACTOR_H
+#define VLIB_SOCKET_REACTOR_H
+
+// Only supported on linux.
+#if defined(__linux__)
+
+// Includes.
+#include <sys/epoll.h>
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace sockets.
+namespace sockets {
+
+// ---------------------------------------------------------
+// Reactor.
+//
+// Notes:
+// - Every connection is registered once in edge triggered mode for both read and write readiness, so no "epoll_ctl" calls are required while serving.
+// - On read readiness the socket is drained until "EAGAIN" into the "sockets::Buffer" input of the connection, the handler is called after every "read_len" received bytes, so a handler that consumes the input in place handles large transfers with a fixed memory footprint.
+// - Sent data is written directly when possible, the remainder is buffered and flushed on write readiness.
+// - The connections are indexed by file descriptor, an idle connection holds no buffers.
+// - Timers are kept in a binary heap with at most one entry per connection, an extended timer is queued again when its entry expires.
+// - A reactor is single threaded, use one reactor per thread each with its own listening socket, the sockets share the port through "SO_REUSEPORT".
+// - A reserved file descriptor is kept open, when the file descriptor limit is reached it is closed to accept and close the pending connections, since the edge triggered listener would otherwise not receive a new event.
+//
+// Handler:
+// - Required "on_read(reactor, connection)", called when new data was received in "connection.input", handled data should be released with "connection.input.consume()".
+// - Optional "on_accept(reactor, connection)", called for a new connection.
+// - Optional "on_write(reactor, connection)", called when all buffered output has been sent.
+// - Optional "on_timeout(reactor, connection)", called when the connection timer expires, by default the connection is closed.
+// - Optional "on_close(reactor, connection)", called before a connection is closed.
+// - Optional "on_tick(reactor)", called every tick interval.
+// - Optional "on_ready(reactor, connection, events)", when defined the reactor does not read or write the connections itself and calls this function with the epoll events instead, "on_read" and "on_write" are then not used.
+//   Used for protocols that perform their own socket I/O, such as a TLS handshake.
+//
+/* @docs
+ *  @chapter: Sockets
+ *  @title: Reactor
+ *  @description:
+ *      Edge triggered epoll event loop that multiplexes many non-blocking connections on a single thread.
+ *  @note: Only supported on linux.
+ *  @usage:
+ *      #include <vlib/sockets/socket.h>
+ *      struct Echo {
+ *          void on_read(auto& reactor, auto& conn) {
+ *              reactor.send(conn, conn.input.data(), conn.input.len());
+ *              conn.input.consume(conn.input.len());
+ *              reactor.timeout(conn, 30 * 1000);
+ *          }
+ *      };
+ *      vlib::Socket<> sock (8000);
+ *      sock.bind();
+ *      sock.listen(SOMAXCONN);
+ *      Echo echo;
+ *      vlib::sockets::Reactor<Echo> reactor (echo);
+ *      reactor.listen(sock.fd());
+ *      reactor.run();
+ */
+template <
+	typename	Handler,
+	typename	State = 		Null,			// per connection user state.
+	uint		read_len = 		64 * 1024		// the max length that is read before the handler is called.
+>
+struct Reactor {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using	This = 		Reactor;
+
+	// ---------------------------------------------------------
+	// Structs.
+
+	// A connection.
+	struct Connection {
+		int			fd = -1;
+		ullong		id = 0;					// unique id, a reused file descriptor gets a new id.
+		Buffer		input;					// received data that is not yet consumed by the handler.
+		String		output;					// data that is not yet sent.
+		ullong		output_pos = 0;			// the sent length of the output.
+		mtime_t		deadline = 0;			// the timer deadline, zero when there is no timer.
+		mtime_t		queued = 0;				// the deadline of the queued timer entry.
+		bool		closing = false;		// close once the output has been sent.
+		State		state;
+	};
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Structs.
+
+	// A timer entry.
+	struct Timer {
+		mtime_t		deadline;
+		int			fd;
+		ullong		id;
+	};
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	Handler*					m_handler;
+	int							m_epoll = -1;
+	int							m_reserve = -1;			// reserved file descriptor, see "reject_h".
+	Array<Connection*>			m_conns;				// indexed by file descriptor.
+	ullong						m_len = 0;
+	ullong						m_next_id = 1;
+	Array<Timer>				m_timers;				// binary min heap.
+	mtime_t						m_tick = 0;
+	mtime_t						m_next_tick = 0;
+	Array<struct epoll_event>	m_events;
+	bool						m_stop = false;
+
+	// ---------------------------------------------------------
+	// Static attributes.
+
+	// The epoll data flag of a listener, the lower 32 bits hold the file descriptor.
+	SICE ullong					listener_flag = 1ULL << 32;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Handler checks.
+	SICEBOOL has_on_accept_h() { return requires (Handler& h, This& r, Connection& c) { h.on_accept(r, c); }; }
+	SICEBOOL has_on_write_h() { return requires (Handler& h, This& r, Connection& c) { h.on_write(r, c); }; }
+	SICEBOOL has_on_timeout_h() { return requires (Handler& h, This& r, Connection& c) { h.on_timeout(r, c); }; }
+	SICEBOOL has_on_close_h() { return requires (Handler& h, This& r, Connection& c) { h.on_close(r, c); }; }
+	SICEBOOL has_on_tick_h() { return requires (Handler& h, This& r) { h.on_tick(r); }; }
+	SICEBOOL has_on_ready_h() { return requires (Handler& h, This& r, Connection& c, uint e) { h.on_ready(r, c, e); }; }
+
+	// Register a file descriptor.
+	void	register_h(int fd, uint events, bool listener = false) {
+		struct epoll_event event {};
+		event.events = events;
+		event.data.u64 = (ullong) (uint) fd | (listener ? listener_flag : 0);
+		if (::epoll_ctl(m_epoll, EPOLL_CTL_ADD, fd, &event) != 0) {
+			throw SocketError(to_str("Unable to register file descriptor ", fd, " [", ::strerror(errno), "]."));
+		}
+	}
+
+	// Get a connection by file descriptor.
+	constexpr
+	Connection*	get_h(int fd) {
+		return (ullong) fd < m_conns.m_len ? m_conns.m_arr[fd] : nullptr;
+	}
+
+	// Accept and close a pending connection with the reserved file descriptor.
+	// - Returns false when there is no pending connection or no reserved file descriptor.
+	bool	reject_h(int listener) {
+		if (m_reserve < 0) { return false; }
+		::close(m_reserve);
+		int fd;
+		while ((fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC)) < 0 && (errno == EINTR || errno == ECONNABORTED)) {}
+		if (fd >= 0) { ::close(fd); }
+		m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+		return fd >= 0;
+	}
+
+	// Accept all pending connections of a listener.
+	void	accept_h(int listener) {
+		ullong rejected = 0;
+		while (true) {
+			const int fd = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+			if (fd < 0) {
+				switch (errno) {
+					case EINTR:
+					case ECONNABORTED:
+						continue;
+					case EMFILE:
+					case ENFILE:
+						if (reject_h(listener)) {
+							++rejected;
+							continue;
+						}
+						if (m_reserve < 0) {
+							print_warning("Unable to accept connections, the file descriptor limit has been reached.");
+						}
+						break;
+					case EAGAIN:
+					default:
+						break;
+				}
+				break;
+			}
+			Connection& conn = add_h(fd);
+			if constexpr (has_on_accept_h()) {
+				m_handler->on_accept(*this, conn);
+			}
+		}
+		if (rejected != 0) {
+			print_warning("Rejected ", rejected, " connection(s), the file descriptor limit has been reached.");
+		}
+	}
+
+	// Add a connection.
+	Connection&	add_h(int fd) {
+		if ((ullong) fd >= m_conns.m_len) {
+			const ullong len = (ullong) fd + 1;
+			m_conns.expand(len - m_conns.m_len);
+			while (m_conns.m_len < len) { m_conns.m_arr[m_conns.m_len++] = nullptr; }
+		}
+		Connection* conn = new Connection();
+		conn->fd = fd;
+		conn->id = m_next_id++;
+		m_conns.m_arr[fd] = conn;
+		++m_len;
+		try {
+			register_h(fd, EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET);
+		} catch (...) {
+			m_conns.m_arr[fd] = nullptr;
+			--m_len;
+			delete conn;
+			::close(fd);
+			throw;
+		}
+		return *conn;
+	}
+
+	// Read until the socket is drained or until the read length has been received.
+	// - Returns false when the peer closed the connection or an error occured.
+	bool	read_h(Connection& conn, ullong& received, bool& drained) {
+		received = 0;
+		drained = false;
+		while (received < read_len) {
+			const llong bytes = conn.input.read(conn.fd, read_len - received);
+			if (bytes > 0) {
+				received += bytes;
+				if (received < read_len) {
+					drained = true; // a short read means the socket is drained.
+					return true;
+				}
+				continue;
+			}
+			else if (bytes == 0) {
+				return false;
+			}
+			switch (errno) {
+				case EINTR:
+					continue;
+				case EAGAIN:
+					drained = true;
+					return true;
+				default:
+					return false;
+			}
+		}
+		return true;
+	}
+
+	// Write the buffered output.
+	// - Returns false when an error occured.
+	bool	flush_h(Connection& conn) {
+		while (conn.output_pos < conn.output.len()) {
+			const ssize_t bytes = ::send(conn.fd, conn.output.data() + conn.output_pos, conn.output.len() - conn.output_pos, MSG_NOSIGNAL);
+			if (bytes >= 0) {
+				conn.output_pos += bytes;
+				continue;
+			}
+			switch (errno) {
+				case EINTR:
+					continue;
+				case EAGAIN:
+					return true;
+				default:
+					return false;
+			}
+		}
+		conn.output.reset();
+		conn.output_pos = 0;
+		return true;
+	}
+
+	// Release the buffers of an idle connection.
+	constexpr
+	void	shrink_h(Connection& conn) {
+		if (conn.input.len() == 0 && conn.input.capacity() > read_len) {
+			conn.input.destruct();
+		}
+		if (conn.output.len() == 0 && conn.output.capacity() > 0) {
+			conn.output.destruct();
+		}
+	}
+
+	// Process the events of a connection.
+	void	process_h(Connection& conn, uint events) {
+		if constexpr (has_on_ready_h()) {
+			m_handler->on_ready(*this, conn, events);
+		} else {
+			io_h(conn, events);
+		}
+	}
+
+	// Read and write a connection.
+	void	io_h(Connection& conn, uint events) {
+		const int fd = conn.fd;
+		const ullong id = conn.id;
+		auto closed = [&]() {
+			Connection* current = get_h(fd);
+			return current == nullptr || current->id != id;
+		};
+
+		// Read.
+		if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+			bool open, drained;
+			ullong received;
+			do {
+				open = read_h(conn, received, drained) && (events & (EPOLLHUP | EPOLLERR)) == 0;
+				if (received != 0) {
+					m_handler->on_read(*this, conn);
+					if (closed()) { return ; }
+				}
+			} while (open && !drained);
+			if (!open || (events & EPOLLRDHUP)) {
+				if (conn.output_pos < conn.output.len() && open) {
+					conn.closing = true; // half closed, send the remaining output first.
+				} else {
+					close(conn);
+					return ;
+				}
+			}
+		}
+
+		// Write.
+		if ((events & EPOLLOUT) && conn.output_pos < conn.output.len()) {
+			if (!flush_h(conn)) {
+				close(conn);
+				return ;
+			}
+			if (conn.output.len() == 0) {
+				if constexpr (has_on_write_h()) {
+					m_handler->on_write(*this, conn);
+					if (closed()) { return ; }
+				}
+			}
+		}
+
+		// Close after the output has been sent.
+		if (conn.closing && conn.output.len() == 0) {
+			close(conn);
+			return ;
+		}
+		shrink_h(conn);
+	}
+
+	// Push and pop timers.
+	void	push_timer_h(const Timer& timer) {
+		m_timers.append(timer);
+		ullong i = m_timers.m_len - 1;
+		while (i > 0) {
+			const ullong parent = (i - 1) / 2;
+			if (m_timers.m_arr[parent].deadline <= m_timers.m_arr[i].deadline) { break; }
+			const Timer tmp = m_timers.m_arr[parent];
+			m_timers.m_arr[parent] = m_timers.m_arr[i];
+			m_timers.m_arr[i] = tmp;
+			i = parent;
+		}
+	}
+	void	pop_timer_h() {
+		m_timers.m_arr[0] = m_timers.m_arr[--m_timers.m_len];
+		ullong i = 0;
+		while (true) {
+			const ullong left = i * 2 + 1, right = left + 1;
+			ullong min = i;
+			if (left < m_timers.m_len && m_timers.m_arr[left].deadline < m_timers.m_arr[min].deadline) { min = left; }
+			if (right < m_timers.m_len && m_timers.m_arr[right].deadline < m_timers.m_arr[min].deadline) { min = right; }
+			if (min == i) { break; }
+			const Timer tmp = m_timers.m_arr[min];
+			m_timers.m_arr[min] = m_timers.m_arr[i];
+			m_timers.m_arr[i] = tmp;
+			i = min;
+		}
+	}
+
+	// Expire the timers.
+	void	expire_h(mtime_t now) {
+		while (m_timers.m_len > 0 && m_timers.m_arr[0].deadline <= now) {
+			const Timer timer = m_timers.m_arr[0];
+			pop_timer_h();
+			Connection* conn = get_h(timer.fd);
+			if (conn == nullptr || conn->id != timer.id || conn->queued != timer.deadline) {
+				continue;
+			}
+			conn->queued = 0;
+			if (conn->deadline == 0) {
+				continue;
+			}
+			else if (conn->deadline > now) {
+				conn->queued = conn->deadline;
+				push_timer_h({conn->deadline, conn->fd, conn->id});
+				continue;
+			}
+			conn->deadline = 0;
+			if constexpr (has_on_timeout_h()) {
+				m_handler->on_timeout(*this, *conn);
+			} else {
+				close(*conn);
+			}
+		}
+		if constexpr (has_on_tick_h()) {
+			if (m_tick > 0 && now >= m_next_tick) {
+				m_next_tick = now + m_tick;
+				m_handler->on_tick(*this);
+			}
+		}
+	}
+
+	// Get the epoll timeout until the next timer.
+	constexpr
+	int		wait_timeout_h(mtime_t now, int timeout) const {
+		mtime_t next = -1;
+		if (m_timers.m_len > 0) {
+			next = m_timers.m_arr[0].deadline > now ? m_timers.m_arr[0].deadline - now : 0;
+		}
+		if (m_tick > 0) {
+			const mtime_t tick = m_next_tick > now ? m_next_tick - now : 0;
+			if (next < 0 || tick < next) { next = tick; }
+		}
+		if (timeout >= 0 && (next < 0 || timeout < next)) { next = timeout; }
+		return (int) next;
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Constructor from a handler.
+	Reactor(Handler& handler, uint max_events = 1024) :
+	m_handler(&handler)
+	{
+		m_epoll = ::epoll_create1(EPOLL_CLOEXEC);
+		if (m_epoll < 0) {
+			throw CreateError(to_str("Failed to create the epoll instance [", ::strerror(errno), "]."));
+		}
+		m_reserve = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+		m_events.resize(max_events);
+		m_events.m_len = max_events;
+	}
+
+	// No copy constructor.
+	Reactor(const This&) = delete;
+
+	// Destructor.
+	// - Closes all connections, the listening sockets are not closed.
+	~Reactor() {
+		for (auto& conn: m_conns) {
+			if (conn != nullptr) {
+				::close(conn->fd);
+				delete conn;
+			}
+		}
+		if (m_reserve >= 0) {
+			::close(m_reserve);
+		}
+		::close(m_epoll);
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Listen.
+	/*  @docs
+	 *  @title: Listen
+	 *  @description:
+	 *      Accept connections from a bound and listening socket.
+	 *
+	 *      The socket is set to non-blocking.
+	 */
+	This&	listen(const Int& fd) {
+		Socket<>::set_blocking(fd, false);
+		register_h(fd.value(), EPOLLIN | EPOLLET, true);
+		return *this;
+	}
+
+	// Add a connection.
+	/*  @docs
+	 *  @title: Add
+	 *  @description:
+	 *      Add an already connected file descriptor.
+	 *
+	 *      The file descriptor is set to non-blocking and is closed by the reactor.
+	 */
+	Connection&	add(const Int& fd) {
+		Socket<>::set_blocking(fd, false);
+		return add_h(fd.value());
+	}
+
+	// Send data.
+	/*  @docs
+	 *  @title: Send
+	 *  @description:
+	 *      Send data over a connection.
+	 *
+	 *      The data is written directly when the socket is writable, the remainder is buffered and sent on write readiness.
+	 *
+	 *      Returns `false` when the connection has been closed because of a send error.
+	 *  @funcs: 2
+	 */
+	bool	send(Connection& conn, const char* data, ullong len) {
+		if (conn.output.len() == 0) {
+			ullong sent = 0;
+			while (sent < len) {
+				const ssize_t bytes = ::send(conn.fd, data + sent, len - sent, MSG_NOSIGNAL);
+				if (bytes >= 0) {
+					sent += bytes;
+					continue;
+				}
+				else if (errno == EINTR) {
+					continue;
+				}
+				else if (errno == EAGAIN) {
+					break;
+				}
+				close(conn);
+				return false;
+			}
+			data += sent;
+			len -= sent;
+		}
+		if (len != 0) {
+			conn.output.concat_r(data, len);
+		}
+		return true;
+	}
+	bool	send(Connection& conn, const String& data) {
+		return send(conn, data.data(), data.len());
+	}
+
+	// Close a connection.
+	/*  @docs
+	 *  @title: Close
+	 *  @description:
+	 *      Close a connection directly, any buffered output is discarded.
+	 *
+	 *      The connection object may not be used afterwards.
+	 */
+	void	close(Connection& conn) {
+		if constexpr (has_on_close_h()) {
+			m_handler->on_close(*this, conn);
+		}
+		const int fd = conn.fd;
+		::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+		::close(fd);
+		m_conns.m_arr[fd] = nullptr;
+		--m_len;
+		delete &conn;
+	}
+
+	// Release a connection.
+	/*  @docs
+	 *  @title: Release
+	 *  @description:
+	 *      Remove a connection from the reactor without closing its file descriptor, any buffered output is discarded.
+	 *
+	 *      Returns the file descriptor, the connection object may not be used afterwards.
+	 */
+	int		release(Connection& conn) {
+		const int fd = conn.fd;
+		::epoll_ctl(m_epoll, EPOLL_CTL_DEL, fd, nullptr);
+		m_conns.m_arr[fd] = nullptr;
+		--m_len;
+		delete &conn;
+		return fd;
+	}
+
+	// Close after sending.
+	/*  @docs
+	 *  @title: Close after sending
+	 *  @description:
+	 *      Close a connection once all buffered output has been sent.
+	 */
+	void	close_after_send(Connection& conn) {
+		if (conn.output.len() == 0) {
+			close(conn);
+		} else {
+			conn.closing = true;
+		}
+	}
+
+	// Set a timer.
+	/*  @docs
+	 *  @title: Timeout
+	 *  @description:
+	 *      Set the timer of a connection in milliseconds, this replaces the previous timer.
+	 *
+	 *      Use `0` to remove the timer.
+	 */
+	void	timeout(Connection& conn, mtime_t msec) {
+		if (msec <= 0) {
+			conn.deadline = 0;
+			return ;
+		}
+		conn.deadline = Date::get_mseconds() + msec;
+		if (conn.queued == 0 || conn.queued > conn.deadline) {
+			conn.queued = conn.deadline;
+			push_timer_h({conn.deadline, conn.fd, conn.id});
+		}
+	}
+
+	// Set the tick interval.
+	/*  @docs
+	 *  @title: Tick
+	 *  @description:
+	 *      Call the `on_tick` function of the handler every interval in milliseconds.
+	 */
+	This&	tick(mtime_t msec) {
+		m_tick = msec;
+		m_next_tick = Date::get_mseconds() + msec;
+		return *this;
+	}
+
+	// Run once.
+	/*  @docs
+	 *  @title: Run once
+	 *  @description:
+	 *      Wait for events once and process them.
+	 *
+	 *      Waits at most `timeout` milliseconds or until the next timer, use `-1` to wait until an event occurs.
+	 *
+	 *      Returns the number of processed events.
+	 */
+	ullong	run_once(int timeout = -1) {
+		int count = ::epoll_wait(m_epoll, m_events.m_arr, (int) m_events.m_len, wait_timeout_h(Date::get_mseconds(), timeout));
+		if (count < 0) {
+			if (errno == EINTR) { return 0; }
+			throw PollError(to_str("Poll error [", ::strerror(errno), "]."));
+		}
+		for (int i = 0; i < count; ++i) {
+			const struct epoll_event& event = m_events.m_arr[i];
+			const int fd = (int) (uint) event.data.u64;
+			if (event.data.u64 & listener_flag) {
+				accept_h(fd);
+				continue;
+			}
+			Connection* conn = get_h(fd);
+			if (conn != nullptr) {
+				process_h(*conn, event.events);
+			}
+		}
+		expire_h(Date::get_mseconds());
+		return (ullong) count;
+	}
+
+	// Run.
+	/*  @docs
+	 *  @title: Run
+	 *  @description:
+	 *      Run the event loop until `stop()` is called.
+	 */
+	void	run() {
+		m_stop = false;
+		while (!m_stop) {
+			run_once(-1);
+		}
+	}
+
+	// Stop.
+	/*  @docs
+	 *  @title: Stop
+	 *  @description:
+	 *      Stop the event loop after the current iteration, may be called from a handler.
+	 */
+	constexpr
+	void	stop() {
+		m_stop = true;
+	}
+
+	// Length.
+	/*  @docs
+	 *  @title: Length
+	 *  @description:
+	 *      Get the number of open connections.
+	 */
+	constexpr
+	ullong	len() const {
+		return m_len;
+	}
+
+};
+
+}; 		// End namespace sockets.
+}; 		// End namespace vlib.
+
+#endif 	// End linux.
+#endif 	// End header.
@@ -916,9 +916,10 @@ public:
 	}
 
 	// Listen to incoming connections.
+	// - Use a larger backlog like "SOMAXCONN" for servers that accept many connections.
 	constexpr
-	void	listen() {
-		if (::listen(m_fd.value(), 3) < 0) {
+	void	listen(const Int& backlog = 3) {
+		if (::listen(m_fd.value(), backlog.value()) < 0) {
 			throw ListenError(to_str("Unable to listen to \"", str(), "\" [", ::strerror(errno), "]."));
 		}
 	}
@@ -1041,6 +1042,7 @@ public:
 	// Receive data from the socket.
 	// - Use -1 to receive with no timeout.
 	// - Use 0 to receive and stop instantly if there is nothing to read.
+	// - Every read is a single "readv" into the free capacity of the string and a stack segment, the string grows geometrically only when the data does not fit.
     template <int l_buff_len = buff_len, typename... Air> SICE
 	ullong  recv(
 		String& 		received,
@@ -1052,15 +1054,37 @@ public:
         // Poll.
 		errno = 0;
 		poll(fd, POLLIN, POLLIN, timeout);
-        long bytes = 0;
         ullong total_bytes = 0;
+        char stack[l_buff_len];
         
         // Read.
-        do {
+        while (true) {
+            if (received.capacity() - received.len() < l_buff_len) {
+                received.resize(received.len() + (received.len() / 2 > l_buff_len ? received.len() / 2 : l_buff_len));
+            }
+            const ullong free = received.capacity() - received.len();
+            ssize_t bytes;
+            if (flags == 0) {
+                struct iovec iov[2];
+                iov[0].iov_base = received.data() + received.len();
+                iov[0].iov_len = free;
+                iov[1].iov_base = stack;
+                iov[1].iov_len = l_buff_len;
+                bytes = ::readv(fd.value(), iov, 2);
+            } else {
+                bytes = ::recv(fd.value(), received.data() + received.len(), free, flags.value());
+            }
+            if (bytes <= 0) {
+                break;
+            }
             total_bytes += bytes;
-            received.len() += bytes;
-            received.resize(received.len() + l_buff_len);
-        } while ((bytes = ::recv(fd.value(), received.data() + received.len(), l_buff_len, flags.value())) > 0);
+            if ((ullong) bytes <= free) {
+                received.len() += bytes;
+            } else {
+                received.len() += free;
+                received.concat_r(stack, bytes - free);
+            }
+        }
         
         // Null terminate.
         if (received.len() > 0) { received.null_terminate(); }
@@ -1072,6 +1096,33 @@ public:
         }
         return total_bytes;
 	}
+	
+	// Receive data from the socket into a receive buffer.
+	// - Reads until the socket has no more data or until the buffer holds "max" unread bytes, use 0 for no limit.
+	// - Use -1 to receive with no timeout.
+	// - Use 0 to receive and stop instantly if there is nothing to read.
+	SICE
+	ullong  recv(
+		Buffer& 		received,
+		const Int& 		fd,
+		const Int& 		timeout = VLIB_SOCK_TIMEOUT,
+		const ullong 	max = 0
+	) {
+		errno = 0;
+		poll(fd, POLLIN, POLLIN, timeout);
+		ullong total_bytes = 0;
+		llong bytes;
+		while (max == 0 || received.len() < max) {
+			if ((bytes = received.read(fd.value(), max == 0 ? 0 : max - received.len())) <= 0) {
+				if (bytes == 0 && total_bytes == 0) {
+					throw SocketClosedError("Socket is closed.");
+				}
+				break;
+			}
+			total_bytes += bytes;
+		}
+		return total_bytes;
+	}
     template <int l_buff_len = buff_len, typename... Air> SICE
     String  recv(
         const Int&         fd,
@@ -1168,12 +1219,74 @@ public:
                 default:
                     full_sent += status;
                     break;
-                    
+
             }
         }
         return full_sent;
     }
-    
+
+    // Send scattered buffers through the socket.
+    // - Every call is a single "sendmsg" over all remaining segments, so a header and a body are sent without joining them.
+    // - At most 64 segments are supported, they are copied to a local array so the array of the caller is not modified.
+    static inline
+    ullong  send(
+        const Int           fd,
+        const struct iovec* iov,
+        const int           count,
+        const Int           timeout,
+        const Int           flags = 0
+    ) {
+        struct iovec segments[64];
+        if (count > (int) (sizeof(segments) / sizeof(struct iovec))) {
+            throw InvalidUsageError("Too many segments.");
+        }
+        ullong len = 0;
+        for (int i = 0; i < count; ++i) {
+            segments[i] = iov[i];
+            len += iov[i].iov_len;
+        }
+        struct msghdr msg {};
+        msg.msg_iov = segments;
+        msg.msg_iovlen = count;
+        ullong full_sent = 0;
+        llong status = 0, attempts = 0;
+        while (full_sent < len) {
+            poll(fd, POLLOUT, POLLOUT, timeout);
+            switch (status = ::sendmsg(fd.value(), &msg, flags.value())) {
+                case -1:
+                    switch (errno) {
+                        case EAGAIN:
+                            continue;
+                        default:
+                            break;
+                    }
+                    throw CloseError(to_str("Unable to send to the socket [", ::strerror(errno), "]."));
+                case 0:
+                    if (attempts == 10) {
+                        throw CloseError(to_str("Unable to send to the socket [", ::strerror(errno), "]."));
+                    }
+                    ++attempts;
+                    break;
+                default:
+                    full_sent += status;
+
+                    // Skip the sent segments.
+                    while (msg.msg_iovlen > 0 && (ullong) status >= msg.msg_iov->iov_len) {
+                        status -= msg.msg_iov->iov_len;
+                        ++msg.msg_iov;
+                        --msg.msg_iovlen;
+                    }
+                    if (status > 0) {
+                        msg.msg_iov->iov_base = (char*) msg.msg_iov->iov_base + status;
+                        msg.msg_iov->iov_len -= status;
+                    }
+                    break;
+
+            }
+        }
+        return full_sent;
+    }
+
     // Send http response.
     template <typename Type> requires (http::is_Request<Type>::value || http::is_Response<Type>::value) SICE
     ullong  send(
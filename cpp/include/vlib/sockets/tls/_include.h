@@ -9,4 +9,5 @@
 #include "version.h"
 #include "wrapper.h"
 #include "server.h"
+#include "acceptor.h"
 #include "client.h"
@@ -0,0 +1,412 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_TLS_ACCEPTOR_H
+#define VLIB_TLS_ACCEPTOR_H
+
+// Only supported on linux.
+#if defined(__linux__)
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace tls.
+namespace tls {
+
+// ---------------------------------------------------------
+// Handshake metrics.
+//
+// Notes:
+// - The latencies are measured from the accept of the connection until the handshake has finished, in microseconds.
+// - The latency histogram has a bucket per power of two microseconds, percentiles are the upper bound of the bucket.
+// - Use one metrics object per acceptor, merge them with "concat_r()" to get the metrics of multiple threads.
+//
+/*  @docs
+ *	@chapter: TLS
+ *	@title: Metrics
+ *	@description:
+ *		TLS handshake metrics.
+ *	@usage:
+ *		const vlib::tls::Metrics& metrics = acceptor.metrics();
+ *		print(metrics.per_sec(), " handshakes/sec, p99 ", metrics.percentile(0.99), "ms.");
+ */
+struct Metrics {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 	This = 		Metrics;
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	ullong		handshakes = 0;				// finished handshakes.
+	ullong		failures = 0;				// failed handshakes.
+	ullong		timeouts = 0;				// timed out handshakes.
+	ullong		latency_total = 0;			// the summed latency in microseconds.
+	ullong		latency_max = 0;			// the max latency in microseconds.
+	ullong		buckets[32] = {};			// the latency histogram.
+	mtime_t		start = Date::get_mseconds();	// the start of the measurement.
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Add a finished handshake.
+	constexpr
+	This&	add(ullong latency) {
+		++handshakes;
+		latency_total += latency;
+		if (latency > latency_max) { latency_max = latency; }
+		uint bucket = 0;
+		while (bucket < 31 && (1ULL << bucket) < latency) { ++bucket; }
+		++buckets[bucket];
+		return *this;
+	}
+
+	// Handshakes per second.
+	/*  @docs
+	 *	@title: Per second
+	 *	@description:
+	 *		Get the average number of finished handshakes per second since the start of the measurement.
+	 */
+	double	per_sec() const {
+		const mtime_t elapsed = Date::get_mseconds() - start;
+		return elapsed <= 0 ? 0 : (double) handshakes * 1000.0 / (double) elapsed;
+	}
+
+	// Average latency.
+	/*  @docs
+	 *	@title: Latency
+	 *	@description:
+	 *		Get the average handshake latency in milliseconds.
+	 */
+	constexpr
+	double	latency() const {
+		return handshakes == 0 ? 0 : (double) latency_total / (double) handshakes / 1000.0;
+	}
+
+	// Latency percentile.
+	/*  @docs
+	 *	@title: Percentile
+	 *	@description:
+	 *		Get a handshake latency percentile in milliseconds, for example `0.99` for the 99th percentile.
+	 */
+	constexpr
+	double	percentile(double p) const {
+		if (handshakes == 0) { return 0; }
+		const ullong rank = (ullong) (p * (double) handshakes);
+		ullong count = 0;
+		for (uint i = 0; i < 32; ++i) {
+			count += buckets[i];
+			if (count > rank) {
+				const ullong bound = 1ULL << i;
+				return (double) (bound < latency_max ? bound : latency_max) / 1000.0;
+			}
+		}
+		return (double) latency_max / 1000.0;
+	}
+
+	// Merge.
+	/*  @docs
+	 *	@title: Concat
+	 *	@description:
+	 *		Add the metrics of another acceptor.
+	 */
+	constexpr
+	This&	concat_r(const This& obj) {
+		handshakes += obj.handshakes;
+		failures += obj.failures;
+		timeouts += obj.timeouts;
+		latency_total += obj.latency_total;
+		if (obj.latency_max > latency_max) { latency_max = obj.latency_max; }
+		for (uint i = 0; i < 32; ++i) { buckets[i] += obj.buckets[i]; }
+		if (obj.start < start) { start = obj.start; }
+		return *this;
+	}
+
+	// Reset.
+	/*  @docs
+	 *	@title: Reset
+	 *	@description:
+	 *		Reset the metrics and restart the measurement.
+	 */
+	This&	reset() {
+		*this = This();
+		return *this;
+	}
+
+};
+
+// ---------------------------------------------------------
+// TLS acceptor.
+//
+// Notes:
+// - Performs the TLS handshakes of accepted connections concurrently on a "sockets::Reactor", a slow or stalled client only holds its own connection.
+// - Every handshake is driven by readiness events with "SSL_accept" on a non-blocking socket, a handshake that does not finish within the timeout is closed.
+// - A finished client is removed from the event loop and passed to the handler, which takes ownership of the client and must close it with "tls::Server::close()".
+// - Use one acceptor per thread, each listening on its own socket bound to the same port, to spread the handshakes over multiple cores.
+//
+/*  @docs
+ *	@chapter: TLS
+ *	@title: Acceptor
+ *	@description:
+ *		Non-blocking TLS handshake pipeline.
+ *	@note: Only supported on linux.
+ *	@usage:
+ *		#include <vlib/sockets/tls.h>
+ *		vlib::tls::Server<> server (8000, "cert.pem", "key.pem");
+ *		server.bind();
+ *		server.listen();
+ *		auto handler = [](SSL* client) {
+ *			vlib::tls::Server<>::send(client, "Hello World!");
+ *			vlib::tls::Server<>::close(client);
+ *		};
+ *		vlib::tls::Acceptor<decltype(handler)> acceptor (server.ctx(), handler);
+ *		acceptor.listen(server.sock().fd());
+ *		acceptor.run();
+ */
+template <typename Func>
+struct Acceptor {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Structs.
+
+	// Handshake state.
+	struct State {
+		SSL*		ssl = nullptr;
+		ullong		start = 0;			// the accept time in microseconds.
+	};
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 	This = 			Acceptor;
+	using	Client = 		SSL*;
+	using	Reactor = 		sockets::Reactor<Acceptor, State>;
+	using	Connection = 	typename Reactor::Connection;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	Func		m_func;
+	SSL_CTX*	m_ctx;
+	mtime_t		m_timeout;			// the handshake timeout in milliseconds.
+	Metrics		m_metrics;
+	Reactor		m_reactor;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Get the monotonic time in microseconds.
+	static inline
+	ullong	now_h() {
+		struct timespec ts;
+		::clock_gettime(CLOCK_MONOTONIC, &ts);
+		return (ullong) ts.tv_sec * 1000000 + (ullong) ts.tv_nsec / 1000;
+	}
+
+	// Perform a handshake step.
+	// - SIGPIPE is blocked on this thread during the step, since a client that disconnects during the handshake would otherwise raise it.
+	static inline
+	int		accept_h(SSL* ssl) {
+		sigset_t pipe, old, pending;
+		sigemptyset(&pipe);
+		sigaddset(&pipe, SIGPIPE);
+		::pthread_sigmask(SIG_BLOCK, &pipe, &old);
+		::ERR_clear_error();
+		const int status = ::SSL_accept(ssl);
+		if (::sigpending(&pending) == 0 && sigismember(&pending, SIGPIPE)) {
+			struct timespec zero {0, 0};
+			::sigtimedwait(&pipe, nullptr, &zero);
+		}
+		::pthread_sigmask(SIG_SETMASK, &old, nullptr);
+		return status;
+	}
+
+	// Continue the handshake of a connection.
+	void	handshake_h(Reactor& reactor, Connection& conn) {
+		SSL* ssl = conn.state.ssl;
+		const int status = accept_h(ssl);
+		if (status != 1) {
+			switch (::SSL_get_error(ssl, status)) {
+				case SSL_ERROR_WANT_READ:
+				case SSL_ERROR_WANT_WRITE:
+					return ; // wait for the next readiness event.
+				default:
+					++m_metrics.failures;
+					reactor.close(conn);
+					return ;
+			}
+		}
+		if (::SSL_get_verify_result(ssl) != X509_V_OK) {
+			++m_metrics.failures;
+			reactor.close(conn);
+			return ;
+		}
+
+		// Finished.
+		m_metrics.add(now_h() - conn.state.start);
+		conn.state.ssl = nullptr;
+		reactor.release(conn);
+		m_func(ssl);
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Constructor.
+	/*  @docs
+	 *	@title: Constructor
+	 *	@description:
+	 *		Construct an acceptor object.
+	 *	@parameter:
+	 *		@name: ctx
+	 *		@description: The server context with the loaded certificates, for example `tls::Server::ctx()`.
+	 *	@parameter:
+	 *		@name: func
+	 *		@description: The handler of a finished handshake, a function like `void func(SSL* client)`.
+	 *	@parameter:
+	 *		@name: timeout
+	 *		@description: The handshake timeout in milliseconds.
+	 */
+	Acceptor(SSL_CTX* ctx, Func func, mtime_t timeout = 5 * 1000) :
+	m_func(move(func)),
+	m_ctx(ctx),
+	m_timeout(timeout),
+	m_reactor(*this) {}
+
+	// ---------------------------------------------------------
+	// Reactor handler functions.
+
+	// On accept.
+	void	on_accept(Reactor& reactor, Connection& conn) {
+		conn.state.start = now_h();
+		conn.state.ssl = ::SSL_new(m_ctx);
+		if (conn.state.ssl == nullptr || ::SSL_set_fd(conn.state.ssl, conn.fd) != 1) {
+			++m_metrics.failures;
+			reactor.close(conn);
+			return ;
+		}
+		reactor.timeout(conn, m_timeout);
+		handshake_h(reactor, conn);
+	}
+
+	// On ready.
+	void	on_ready(Reactor& reactor, Connection& conn, uint) {
+		handshake_h(reactor, conn);
+	}
+
+	// On timeout.
+	void	on_timeout(Reactor& reactor, Connection& conn) {
+		++m_metrics.timeouts;
+		reactor.close(conn);
+	}
+
+	// On close.
+	void	on_close(Reactor&, Connection& conn) {
+		if (conn.state.ssl != nullptr) {
+			::SSL_free(conn.state.ssl);
+			conn.state.ssl = nullptr;
+		}
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Listen.
+	/*  @docs
+	 *	@title: Listen
+	 *	@description:
+	 *		Accept connections from a bound and listening socket.
+	 */
+	This&	listen(const Int& fd) {
+		m_reactor.listen(fd);
+		return *this;
+	}
+
+	// Add a connection.
+	/*  @docs
+	 *	@title: Add
+	 *	@description:
+	 *		Start the handshake of an already accepted file descriptor.
+	 */
+	This&	add(const Int& fd) {
+		on_accept(m_reactor, m_reactor.add(fd));
+		return *this;
+	}
+
+	// Run.
+	/*  @docs
+	 *	@title: Run
+	 *	@description:
+	 *		Run the acceptor until `stop()` is called.
+	 *	@funcs: 2
+	 */
+	void	run() {
+		m_reactor.run();
+	}
+	ullong	run_once(int timeout = -1) {
+		return m_reactor.run_once(timeout);
+	}
+
+	// Stop.
+	/*  @docs
+	 *	@title: Stop
+	 *	@description:
+	 *		Stop the acceptor after the current iteration.
+	 */
+	constexpr
+	void	stop() {
+		m_reactor.stop();
+	}
+
+	// Pending.
+	/*  @docs
+	 *	@title: Pending
+	 *	@description:
+	 *		Get the number of handshakes in progress.
+	 */
+	constexpr
+	ullong	pending() const {
+		return m_reactor.len();
+	}
+
+	// Metrics.
+	/*  @docs
+	 *	@title: Metrics
+	 *	@description:
+	 *		Get the handshake metrics.
+	 *	@funcs: 2
+	 */
+	constexpr
+	Metrics&	metrics() {
+		return m_metrics;
+	}
+	constexpr
+	const Metrics&	metrics() const {
+		return m_metrics;
+	}
+
+};
+
+// ---------------------------------------------------------
+// End.
+
+}; 		// End namespace tls.
+}; 		// End namespace vlib.
+
+#endif 	// End linux.
+#endif 	// End header.
@@ -54,12 +54,31 @@ public:
 	// ---------------------------------------------------------
 	// Attributes.
 
+	// - The ssl handles are freed by the destructor, which runs once when the last link is destroyed.
 	struct attr {
 		Socket		sock;
 		SSL_CTX* 	ctx = nullptr;
 		SSL* 		ssl = nullptr;
+		constexpr
+		attr() = default;
+		attr(const attr&) = delete;
+		constexpr
+		attr(attr&& obj) :
+		sock(obj.sock),
+		ctx(obj.ctx),
+		ssl(obj.ssl)
+		{
+			obj.sock.fd() = -1;
+			obj.ctx = nullptr;
+			obj.ssl = nullptr;
+		}
+		constexpr
+		~attr() {
+			if (ssl) { SSL_free(ssl); }
+			if (ctx) { SSL_CTX_free(ctx); }
+		}
 	};
-	SPtr<attr> 	m_attr;
+	APtr<attr> 	m_attr;
 
 // Private.
 private:
@@ -155,7 +174,7 @@ public:
 	// Default constructor.
 	constexpr
 	Client () :
-	m_attr(attr{})
+	m_attr(attr())
 	{
 		wrapper::init_openssl();
 	}
@@ -163,7 +182,7 @@ public:
 	// Constructor from ip & port.
 	constexpr
 	Client (const String& ip, const Int& port) :
-	m_attr(attr{})
+	m_attr(attr())
 	{
 		wrapper::init_openssl();
         init_tcp(ip, port);
@@ -173,7 +192,7 @@ public:
 	// Constructor from host.
 	constexpr
 	Client (const String& host) :
-	m_attr(attr{})
+	m_attr(attr())
 	{
         wrapper::init_openssl();
         init_tcp_by_host(host);
@@ -183,7 +202,7 @@ public:
 	// Special constructor for http::ClientTemplate.
 	constexpr
 	Client (const String& host, const String& ip, const Int& port) :
-	m_attr(attr{})
+	m_attr(attr())
 	{
 		wrapper::init_openssl();
 		if (host.is_defined()) {
@@ -207,11 +226,8 @@ public:
 
 	// Destructor.
 	constexpr
-	~Client() {
-		if (m_attr.links() == 0) {
-			close();
-		}
-	}
+	// - The connection is closed by the destructor of the attributes once the last link is destroyed.
+	~Client() {}
 
 	// ---------------------------------------------------------
 	// Assignment operators.
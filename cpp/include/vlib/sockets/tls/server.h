@@ -17,6 +17,7 @@ namespace tls {
 // Notes:
 // - The socket is always non-blocking.
 // - The "client" parameters refer to the index of the client, not the clients SSL pointer.
+// - The handshake of "accept()" blocks the calling thread until it has finished, use "tls::Acceptor" to perform many handshakes concurrently.
 //
 template <
 	int				family = 		sockets::family::ipv4,
@@ -44,6 +45,7 @@ public:
 	// ---------------------------------------------------------
 	// Attributes.
 
+	// - The ssl context is freed by the destructor, which runs once when the last link is destroyed.
 	struct attr {
 		Socket		sock;
 		String		cert;
@@ -51,8 +53,33 @@ public:
 		String		pass;
 		String		ca_bundle;
 		SSL_CTX*	ctx = nullptr;
+		constexpr
+		attr() = default;
+		constexpr
+		attr(String cert, String key, String pass, String ca_bundle) :
+		cert(move(cert)),
+		key(move(key)),
+		pass(move(pass)),
+		ca_bundle(move(ca_bundle)) {}
+		attr(const attr&) = delete;
+		constexpr
+		attr(attr&& obj) :
+		sock(obj.sock),
+		cert(move(obj.cert)),
+		key(move(obj.key)),
+		pass(move(obj.pass)),
+		ca_bundle(move(obj.ca_bundle)),
+		ctx(obj.ctx)
+		{
+			obj.sock.fd() = -1;
+			obj.ctx = nullptr;
+		}
+		constexpr
+		~attr() {
+			if (ctx) { SSL_CTX_free(ctx); }
+		}
 	};
-	SPtr<attr>	m_attr;
+	APtr<attr>	m_attr;
 
 // Private.
 private:
@@ -121,9 +148,13 @@ private:
             int error = SSL_get_error(ssl, status);
             switch (error) {
                 case SSL_ERROR_WANT_READ:
-                case SSL_ERROR_WANT_WRITE:
-                    // SSL handshake would block, continue the loop
+                case SSL_ERROR_WANT_WRITE: {
+                    // SSL handshake would block, wait until the socket is ready.
+                    struct pollfd pfd = {fd, (short) (error == SSL_ERROR_WANT_READ ? POLLIN : POLLOUT), 0};
+                    const ullong now = Date::get_mseconds();
+                    ::poll(&pfd, 1, now < end_time ? (int) (end_time - now) : 0);
                     continue;
+                }
                 default: {
                     
                     // Try again.
@@ -301,7 +332,7 @@ public:
 	// Default constructor.
 	constexpr
 	Server () :
-	m_attr(attr{})
+	m_attr(attr())
 	{
 		wrapper::init_openssl();
 	}
@@ -316,7 +347,7 @@ public:
 		const String& 			pass = nullptr,
 		const String& 			ca_bundle = nullptr
 	) :
-	m_attr(attr { .cert = cert, .key = key, .pass = pass, .ca_bundle = ca_bundle })
+	m_attr(attr(cert, key, pass, ca_bundle))
 	{
 		wrapper::init_openssl();
         init_tcp(ip, port.value());
@@ -333,7 +364,7 @@ public:
 		const String& 			pass = nullptr,
 		const String& 			ca_bundle = nullptr
 	) :
-	m_attr(attr { .cert = cert, .key = key, .pass = pass, .ca_bundle = ca_bundle })
+	m_attr(attr(cert, key, pass, ca_bundle))
 	{
 		wrapper::init_openssl();
         init_tcp(port.value());
@@ -353,11 +384,8 @@ public:
 
 	// Destructor.
 	constexpr
-	~Server() {
-        if (m_attr.links() == 0) {
-            close();
-        }
-	}
+	// - The server is closed by the destructor of the attributes once the last link is destroyed.
+	~Server() {}
 
 	// ---------------------------------------------------------
 	// Assignment operators.
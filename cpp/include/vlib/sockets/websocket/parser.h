@@ -68,76 +68,41 @@ struct Parser {
     //     return size;
     // };
     
-    // Mask data.
-    SICE
-    void mask_data(char * dst, const char * src, ullong len, const char mask[4], const uint8_t mask_offset) {
+    // ---------------------------------------------------------
+    // Private functions.
+
+#if VLIB_SIMD_X86
+
+    // Mask blocks of 16 bytes, returns the number of masked bytes.
+    static inline
+    ullong mask_sse2_h(char* dst, const char* src, ullong len, uint mask) {
+        const __m128i m = _mm_set1_epi32((int) mask);
         ullong i = 0;
-        for(; i < len; i++) {
-            dst[i] = src[i] ^ mask[(i + mask_offset) % 4];
+        for (; i + 16 <= len; i += 16) {
+            _mm_storeu_si128((__m128i*) (dst + i), _mm_xor_si128(_mm_loadu_si128((const __m128i*) (src + i)), m));
         }
-        // return (uint8_t) ((i + mask_offset) % 4);
+        return i;
     }
-    
-    // Create frame.
-    SICE
-    String create_frame(websocket_flags flags, const char mask[4], const char * data, ullong data_len) {
-        String frame;
-        frame.resize(14 + data_len);
-        
-        // Header.
-        frame[0] = 0;
-        frame[1] = 0;
-        if (flags & FINAL_FRAME) {
-            frame[0] = (char) (1 << 7);
-        }
-        frame[0] |= flags & OP_MASK;
-        if (flags & HAS_MASK) {
-            frame[1] = (char) (1 << 7);
-        }
-        
-        // Payload length.
-        ullong body_offset = 0;
-        if (data_len < 126) {
-            frame[1] |= data_len;
-            body_offset = 2;
-        } else if (data_len <= 0xFFFF) {
-            frame[1] |= 126;
-            frame[2] = (char) (data_len >> 8);
-            frame[3] = (char) (data_len & 0xFF);
-            body_offset = 4;
-        } else {
-            frame[1] |= 127;
-            frame[2] = (char) ((data_len >> 56) & 0xFF);
-            frame[3] = (char) ((data_len >> 48) & 0xFF);
-            frame[4] = (char) ((data_len >> 40) & 0xFF);
-            frame[5] = (char) ((data_len >> 32) & 0xFF);
-            frame[6] = (char) ((data_len >> 24) & 0xFF);
-            frame[7] = (char) ((data_len >> 16) & 0xFF);
-            frame[8] = (char) ((data_len >>  8) & 0xFF);
-            frame[9] = (char) ((data_len)       & 0xFF);
-            body_offset = 10;
-        }
-        
-        // Mask.
-        if (flags & HAS_MASK) {
-            if (mask != NULL) {
-                memcpy(&frame[body_offset], mask, 4);
-            }
-            mask_data(&frame[body_offset + 4], data, data_len, mask, 0);
-            body_offset += 4;
-        } else {
-            memcpy(&frame[body_offset], data, data_len);
+
+    // Mask blocks of 64 bytes, returns the number of masked bytes.
+    __attribute__((target("avx2"))) static inline
+    ullong mask_avx2_h(char* dst, const char* src, ullong len, uint mask) {
+        const __m256i m = _mm256_set1_epi32((int) mask);
+        ullong i = 0;
+        for (; i + 64 <= len; i += 64) {
+            const __m256i a = _mm256_loadu_si256((const __m256i*) (src + i));
+            const __m256i b = _mm256_loadu_si256((const __m256i*) (src + i + 32));
+            _mm256_storeu_si256((__m256i*) (dst + i), _mm256_xor_si256(a, m));
+            _mm256_storeu_si256((__m256i*) (dst + i + 32), _mm256_xor_si256(b, m));
         }
-        
-        // Handler.
-        frame.len() = body_offset + data_len;
-        return frame;
-    };
-    
-    // Parse frame.
-    ullong parse_frame(String& received, const String& frame) {
-        const char* data = frame.data();
-        ullong len = frame.len();
+        return i;
+    }
+
+#endif
+
+    // Parse frames and emit the still masked payload parts with "emit(const char* data, ullong len)".
+    template <typename Emit>
+    ullong parse_h(const char* data, ullong len, Emit&& emit) {
         const char * p;
         const char * end = data + len;
         ullong frame_offset = 0;
@@ -229,13 +194,13 @@ struct Parser {
                     if(require) {
                         if(p + require <= end) {
                             // EMIT_DATA_CB(frame_body, p, require);
-                            received.concat_r(p, require);
+                            emit(p, require);
                             p += require;
                             require = 0;
                             frame_offset = p - data;
                         } else {
                             // EMIT_DATA_CB(frame_body, p, end - p);
-                            received.concat_r(p, require);
+                            emit(p, end - p);
                             require -= end - p;
                             p = end;
                             offset += p - data - frame_offset;
@@ -255,7 +220,159 @@ struct Parser {
         }
         return (p == end) ? len : (p - data);
     }
-    
+
+    // ---------------------------------------------------------
+    // Functions.
+
+    // Mask data.
+    // - The destination may be equal to the source to mask in place.
+    // - The mask is applied per 4 byte word, in blocks of 16 or 64 bytes with SSE2 or AVX2 depending on "vlib::encoding::simd()".
+    // - Returns the mask offset that continues after the masked data.
+    static inline
+    uint mask_data(char * dst, const char * src, ullong len, const char mask[4], const uint8_t mask_offset) {
+
+        // Rotate the mask so it starts at the offset.
+        uchar rotated[4];
+        for (uint i = 0; i < 4; ++i) {
+            rotated[i] = mask[(i + mask_offset) % 4];
+        }
+        uint word;
+        memcpy(&word, rotated, 4);
+        const ullong dword = (ullong) word << 32 | word;
+
+        // Mask.
+        ullong i = 0;
+#if VLIB_SIMD_X86
+        if (encoding::simd() >= encoding::avx2) {
+            i = mask_avx2_h(dst, src, len, word);
+        }
+        if (encoding::simd() >= encoding::sse2) {
+            i += mask_sse2_h(dst + i, src + i, len - i, word);
+        }
+#endif
+        for (; i + 8 <= len; i += 8) {
+            ullong x;
+            memcpy(&x, src + i, 8);
+            x ^= dword;
+            memcpy(dst + i, &x, 8);
+        }
+        for (; i < len; i++) {
+            dst[i] = src[i] ^ rotated[i % 4];
+        }
+        return (uint) ((len + mask_offset) % 4);
+    }
+
+    // Write a frame header.
+    // - The output requires 14 bytes, returns the header length.
+    SICE
+    ullong frame_header(char* header, websocket_flags flags, const char mask[4], ullong data_len) {
+
+        // Header.
+        header[0] = 0;
+        header[1] = 0;
+        if (flags & FINAL_FRAME) {
+            header[0] = (char) (1 << 7);
+        }
+        header[0] |= flags & OP_MASK;
+        if (flags & HAS_MASK) {
+            header[1] = (char) (1 << 7);
+        }
+
+        // Payload length.
+        ullong header_len = 0;
+        if (data_len < 126) {
+            header[1] |= data_len;
+            header_len = 2;
+        } else if (data_len <= 0xFFFF) {
+            header[1] |= 126;
+            header[2] = (char) (data_len >> 8);
+            header[3] = (char) (data_len & 0xFF);
+            header_len = 4;
+        } else {
+            header[1] |= 127;
+            header[2] = (char) ((data_len >> 56) & 0xFF);
+            header[3] = (char) ((data_len >> 48) & 0xFF);
+            header[4] = (char) ((data_len >> 40) & 0xFF);
+            header[5] = (char) ((data_len >> 32) & 0xFF);
+            header[6] = (char) ((data_len >> 24) & 0xFF);
+            header[7] = (char) ((data_len >> 16) & 0xFF);
+            header[8] = (char) ((data_len >>  8) & 0xFF);
+            header[9] = (char) ((data_len)       & 0xFF);
+            header_len = 10;
+        }
+
+        // Mask.
+        if (flags & HAS_MASK) {
+            memcpy(&header[header_len], mask, 4);
+            header_len += 4;
+        }
+        return header_len;
+    }
+
+    // Create frame.
+    // - The string version writes the frame into a reusable string, the payload is masked while it is copied.
+    // - The iovec version does not copy the payload, the header is written to "header" which requires 14 bytes and a masked payload is masked in place.
+    SICE
+    String create_frame(websocket_flags flags, const char mask[4], const char * data, ullong data_len) {
+        String frame;
+        create_frame(frame, flags, mask, data, data_len);
+        return frame;
+    }
+    static inline
+    String& create_frame(String& frame, websocket_flags flags, const char mask[4], const char * data, ullong data_len) {
+        frame.resize(14 + data_len);
+        const ullong header_len = frame_header(frame.data(), flags, mask, data_len);
+        if (flags & HAS_MASK) {
+            mask_data(frame.data() + header_len, data, data_len, mask, 0);
+        } else {
+            memcpy(frame.data() + header_len, data, data_len);
+        }
+        frame.len() = header_len + data_len;
+        return frame;
+    }
+    static inline
+    void create_frame(struct iovec iov[2], char* header, websocket_flags flags, const char mask[4], char * data, ullong data_len) {
+        iov[0].iov_base = header;
+        iov[0].iov_len = frame_header(header, flags, mask, data_len);
+        if (flags & HAS_MASK) {
+            mask_data(data, data, data_len, mask, 0);
+        }
+        iov[1].iov_base = data;
+        iov[1].iov_len = data_len;
+    }
+
+    // Parse frame.
+    // - The frame data can also be parsed in place from a receive buffer, returns the parsed length.
+    // - The payload of masked frames is unmasked while it is appended to "received".
+    ullong parse_frame(String& received, const String& frame) {
+        return parse_frame(received, frame.data(), frame.len());
+    }
+    ullong parse_frame(String& received, const char* data, ullong len) {
+        return parse_h(data, len, [&](const char* payload, ullong payload_len) {
+            if (flags & HAS_MASK) {
+                received.resize(received.len() + payload_len);
+                mask_offset = mask_data(received.data() + received.len(), payload, payload_len, mask, mask_offset);
+                received.len() += payload_len;
+            } else {
+                received.concat_r(payload, payload_len);
+            }
+        });
+    }
+
+    // Parse frame in place.
+    // - The payload of masked frames is unmasked inside the receive buffer, nothing is copied.
+    // - The payload parts are passed to "on_data(const char* data, ullong len)", a part ends at the end of the buffer or the end of a frame.
+    template <typename Func>
+    ullong parse_frame(char* data, ullong len, Func&& on_data) {
+        return parse_h(data, len, [&](const char* payload, ullong payload_len) {
+            if (flags & HAS_MASK) {
+                char* mutable_payload = data + (payload - data);
+                mask_offset = mask_data(mutable_payload, payload, payload_len, mask, mask_offset);
+            }
+            on_data(payload, payload_len);
+        });
+    }
+
 };
 }
 }
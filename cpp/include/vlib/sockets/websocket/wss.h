@@ -70,6 +70,7 @@ private:
     String      m_host;
     String      m_key;
     Parser      m_parser;
+    String      m_frame;
     Mutex       m_mutex;
     KeepAlive   m_keep_alive;
     
@@ -146,17 +147,18 @@ public:
     }
     
     // Request.
+    // - The frame is built in a reused buffer, the payload is masked while it is copied.
     constexpr
     void    send(const String& data) {
-        
-        String mask = "1234"; //String::random(4);
-        String frame = Parser::create_frame(
+        const char mask[4] = {'1', '2', '3', '4'}; //String::random(4);
+        Parser::create_frame(
+            m_frame,
             (Parser::websocket_flags) (Parser::OP_TEXT | Parser::FINAL_FRAME | Parser::HAS_MASK),
-            mask.data(),
+            mask,
             data.data(),
             data.len()
         );
-        m_sock.send(frame);
+        m_sock.send(m_frame);
     }
     constexpr
     void    send(const Json& data) {
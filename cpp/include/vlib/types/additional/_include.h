@@ -3,5 +3,8 @@
 
 // Includes.
 #include "dataframe.h"
+#include "dataframe_rolling.h"
+#include "dataframe_column.h"
+#include "dataframe_io.h"
 #include "javascript.h"
 // #include "regex.h"
@@ -56,6 +56,21 @@ String	strtype(short type) {
 ullong npos = NPos::npos;
 ullong zero_len = 0;
 
+// Columnar storage, defined in "dataframe_column.h".
+struct Column;
+struct Table;
+
+// Rolling window functions, the kernels are defined in "dataframe_rolling.h".
+namespace rolling { namespace funcs {
+enum funcs {
+	sum = 	0,
+	mean = 	1,
+	std = 	2,
+	min = 	3,
+	max = 	4,
+};
+}; };
+
 // End namespace df.
 };
 
@@ -83,6 +98,8 @@ ullong zero_len = 0;
 */
 // @TODO add docs for subscript.
 // @TODO add funcs like, round, fill, generate, and more, perhaps look at Numeric.
+// @TODO the values are still stored boxed, one "DataFrame" per cell, only "sort", "std" and the rolling functions compute over a temporary "df::Column".
+// @TODO move "mean", "merge" and the arithmetic operators onto "df::Column" / "df::Table", and eventually replace the boxed storage with a "df::Table".
 struct DataFrame {
 	
 	// ---------------------------------------------------------
@@ -605,6 +622,11 @@ private:
             func(i, x); \
         }
 
+	// Apply a rolling window function from enum "df::rolling::funcs" on a columnar copy of a 1D dataframe.
+	// - Defined in "dataframe_column.h".
+	inline
+	This	rolling_column_h(short func, ullong window) const;
+	
 // Public.
 public:
 	
@@ -728,6 +750,13 @@ public:
 	m_type(df::types::df)
 	{ assign(x); }
 
+	// Constructor from columnar storage.
+	// - Defined in "dataframe_column.h".
+	inline
+	DataFrame (const df::Column& x);
+	inline
+	DataFrame (const df::Table& x);
+
 // Public.
 public:
 	
@@ -1341,6 +1370,23 @@ public:
 	constexpr
 	bool	has_columns() const { return m_cols.is_defined() && m_cols->is_defined(); }
 	
+	// Columnar.
+    /*  @docs
+        @title: Columnar
+        @description:
+            Convert the dataframe into columnar storage.
+            
+            Function `column` converts a 1D dataframe into a `vlib::df::Column`, function `table` converts a 2D dataframe into a `vlib::df::Table`.
+            
+            Will throw a `TypeError` when the values of a column mix strings with other types.
+        @funcs: 2
+    */
+	// - Defined in "dataframe_column.h".
+	inline
+	df::Column	column() const;
+	inline
+	df::Table	table() const;
+	
 	// Shape.
     /*  @docs
         @title: Shape
@@ -2178,146 +2224,14 @@ public:
 			Load the dataframe.
 	 
 			The dataframe will always be treated as type `vlib::df::types::df`, regardless of the real type.
+	 
+			The file is memory mapped and parsed by multiple threads, see `vlib::df::io::load`. Unlike `vlib::df::io::load` every cell keeps its own type, so a column with mixed types is loaded as it was saved.
 		@funcs: 2
 	*/
-	SICE
-	This	load(const char* path) {
-		
-		// Expect df.
-		DataFrame df;
-		df.init(df::types::df);
-		
-		// Load data.
-		Code data = Code::load(path);
-		
-		// Funcs.
-		auto append_value = [&](DataFrame& df, const char* data, ullong start, ullong len) {
-			switch (len) {
-			case 0:
-				df.append(DataFrame());
-				return ;
-			default:
-				switch (data[start]) {
-				case 'n':
-					df.append(DataFrame());
-					return ;
-				case 't':
-					df.append(true);
-					return ;
-				case 'f':
-					df.append(false);
-					return ;
-				case '"':
-					df.append(String(data + start + 1, len - 2));
-					return ;
-				default:
-					bool floating = false;
-					for (auto& i: Range(start, start + len)) {
-						switch (data[i]) {
-						case '.': floating = true; break;
-						default: continue;
-						}
-						break;
-					}
-					if (floating) {
-						df.append(to_num<Float::value_type>(data + start, len));
-					} else {
-						df.append(to_num<Int::value_type>(data + start, len));
-					}
-					return ;
-				}
-			}
-		};
-		
-		// Get first and second newline pos.
-		ullong index = 0, first_newline = 0, second_newline = 0;
-		for (auto& i: data) {
-			switch (i) {
-			case '\n':
-				if (first_newline == 0) {
-					first_newline = index;
-				} else {
-					second_newline = index;
-					break;
-				}
-				++index;
-				continue;
-			default:
-				++index;
-				continue;
-			}
-			break;
-		}
-		
-		// Check dimension.
-		switch (data.first()) {
-		
-		// 1D.
-		case '1': {
-			df.m_dim = 1;
-			ullong start_index = first_newline + 1;
-			for (auto& i: data.iterate(first_newline + 1)) {
-				switch (i.character()) {
-				case '\n':
-					if (!i.is_str()) {
-						append_value(df, data.data(), start_index, i.index - 1 - start_index);
-						start_index = index + 1;
-					}
-					continue;
-				default:
-					continue;
-				}
-			}
-			break;
-		}
-			
-		// 2D.
-		case '2': {
-			df.m_dim = 2;
-			if (df.m_cols == null) { df.m_cols.init(); }
-			ullong start_index = first_newline + 1;
-			for (auto& i: data.iterate(first_newline + 1, second_newline + 1)) {
-				if (!i.is_str()) {
-					switch (i.character()) {
-					case ',':
-					case '\n':
-						df.m_cols->append(String(data.data() + start_index + 1, i.index - 1 - start_index - 1));
-						start_index = i.index + 1;
-						continue;
-					default:
-						continue;
-					}
-				}
-			}
-			df.fill(df.m_cols->len(), DataFrame().init(df::types::df, 1));
-			ullong column = 0;
-			start_index = second_newline + 1;
-			for (auto& i: data.iterate(second_newline + 1)) {
-				if (!i.is_str()) {
-					switch (i.character()) {
-					case ',':
-						append_value(df.m_vals->get(column), data.data(), start_index, i.index - start_index);
-						start_index = i.index + 1;
-						++column;
-						continue;
-					case '\n':
-						append_value(df.m_vals->get(column), data.data(), start_index, i.index - start_index);
-						start_index = i.index + 1;
-						column = 0;
-						continue;
-					}
-				}
-			}
-			break;
-		}
-			
-		// Error.
-		default:
-			throw ParseError(to_str("Unable to parse file \"", path, "\"."));
-		}
-		return df;
-	}
-	SICE
+	// - Defined in "dataframe_io.h".
+	static inline
+	This	load(const char* path);
+	static inline
 	This	load(const String& path) {
 		return load(path.c_str());
 	}
@@ -2444,38 +2358,14 @@ public:
 	 
 			Will throw a `TypeError` when the type is not `vlib::df::types::df`.
 			Will throw a `DimensionError` when the dataframe is not 2D.
+	 
+			The sort column is converted into a temporary `vlib::df::Column` on every call, which costs a copy of the column, the rows are then sorted stable with null values placed at the end.
+			When the column can not be converted, for example when it mixes strings with other types, the boxed values are compared instead.
 		@funcs: 2
 	*/
-	constexpr
-	This	sort(const String& column, bool reversed = false) const {
-		expect_2d(__FUNCTION__);
-		DataFrame& df = operator[](column);
-		Dict<ullong, DataFrame> dict;
-		ullong index = 0;
-		for (auto& i: *df.m_vals) {
-			dict.keys().append(index);
-			dict.values().append(i);
-			++index;
-		}
-		dict.sort_values_r(reversed);
-		DataFrame sorted;
-		sorted.init(vlib::df::types::df, 2);
-		sorted.fill(m_vals->len(), DataFrame().init(df::types::df));
-		sorted.set_columns(*m_cols);
-		ullong clen = m_vals->get(0).len();
-		for (auto& cindex: Range<ullong>(0, m_vals->len())) {
-			DataFrame& ncol = sorted[cindex];
-			DataFrame& ocol = m_vals->get(cindex);
-			ncol.resize(clen);
-			ncol.len() = clen;
-			ullong index = 0;
-			for (auto& rindex: dict.keys()) {
-				ncol[index] = ocol[rindex];
-				++index;
-			}
-		}
-		return sorted;
-	}
+	// - Defined in "dataframe_column.h".
+	inline
+	This	sort(const String& column, bool reversed = false) const;
 	constexpr
 	This&	sort_r(const String& column, bool reversed = false) {
 		DataFrame x = sort(column, reversed);
@@ -3178,21 +3068,8 @@ public:
         rolling.len() = m_vals->len();
         ullong min_index = window.value() - 1;
         switch (m_dim) {
-        case 1: {
-            if (m_vals->len() == 0) { return DataFrame(); }
-            for (auto& index: m_vals->indexes()) {
-                if (index >= min_index) {
-                    DataFrame val = m_vals->get(index - window.value() + 1);
-                    for (auto& lookback: Range(index - window.value() + 2, index + 1)) {
-                        if (m_vals->get(lookback) < val) {
-                            val = m_vals->get(lookback);
-                        }
-                    }
-                    rolling.m_vals->get(index) = val;
-                }
-            }
-            return rolling;
-        }
+        case 1:
+            return rolling_column_h(df::rolling::funcs::min, window.value());
         case 2: {
             if (m_vals->len() == 0) { return DataFrame(); }
             for (auto& index: m_vals->indexes()) {
@@ -3439,21 +3316,8 @@ public:
         rolling.len() = m_vals->len();
         ullong min_index = window.value() - 1;
         switch (m_dim) {
-        case 1: {
-            if (m_vals->len() == 0) { return DataFrame(); }
-            for (auto& index: m_vals->indexes()) {
-                if (index >= min_index) {
-                    DataFrame val = m_vals->get(index - window.value() + 1);
-                    for (auto& lookback: Range(index - window.value() + 2, index + 1)) {
-                        if (m_vals->get(lookback) > val) {
-                            val = m_vals->get(lookback);
-                        }
-                    }
-                    rolling.m_vals->get(index) = val;
-                }
-            }
-            return rolling;
-        }
+        case 1:
+            return rolling_column_h(df::rolling::funcs::max, window.value());
         case 2: {
             if (m_vals->len() == 0) { return DataFrame(); }
             for (auto& index: m_vals->indexes()) {
@@ -4465,21 +4329,7 @@ public:
 	constexpr
 	This	sum(ullong window) {
 		expect_1d(__FUNCTION__);
-		DataFrame df;
-		df.init(df::types::df);
-		df.resize(m_vals->len());
-		df.len() = m_vals->len();
-		ullong window_index = window - 1;
-		for (auto& index0: m_vals->indexes()) {
-			if (index0 >= window_index) {
-				auto& val = df.m_vals->get(index0);
-				val = m_vals->get(index0);
-				for (ullong index1 = index0 - window + 1; index1 < index0; ++index1) {
-					add_h(val, m_vals->get(index1));
-				}
-			}
-		}
-		return df;
+		return rolling_column_h(df::rolling::funcs::sum, window);
 	}
 	
 	// Mean.
@@ -4489,11 +4339,12 @@ public:
 	}
 	constexpr
 	This	mean(const Len& window) {
-		return sum(window).div_r(window);
+		return mean(window.value());
 	}
     constexpr
     This    mean(ullong window) {
-        return sum(window).div_r(window);
+		expect_1d(__FUNCTION__);
+		return rolling_column_h(df::rolling::funcs::mean, window);
     }
 	
 	// Moving average.
@@ -4534,11 +4385,11 @@ public:
     */
     constexpr
     This    ma(const Len& window) {
-        return sum(window).div_r(window);
+        return mean(window.value());
     }
 	constexpr
 	This	ma(ullong window) {
-		return sum(window).div_r(window);
+		return mean(window);
 	}
 	
 	// Exponentional moving average.
@@ -4843,22 +4694,17 @@ public:
 			Will throw a `TypeError` when the type is not `vlib::df::types::df`.
 			Will throw a `DimensionError` when the dataframe is not 1D.
 		@return:
-			Returns a `DataFrame` with type `vlib::df::types::integer` or `vlib::df::types::floating` with the standard deviation as value.
+			Returns a `DataFrame` with type `vlib::df::types::floating` with the standard deviation as value.
+		@note:
+			Null values are skipped.
+			The values are converted into a temporary `vlib::df::Column` on every call, which costs a copy of the dataframe.
 		@usage:
 			vlib::DataFrame x = {1.00, 0.23, 0.98};
-			vlib::DataFrame y = x.ma(); y ==> 0.736667
+			vlib::DataFrame y = x.std(); y ==> 0.438900
 	*/
-	constexpr
-	This	std() {
-		expect_1d(__FUNCTION__);
-		DataFrame val, mean;
-		val = 0.0;
-		mean = ma();
-		for (auto& i: *m_vals) {
-			val += (i - mean).abs_r().pow_r(2.0);
-		}
-		return val.div_r(m_vals->len() - 1).sqrt_r();
-	}
+	// - Defined in "dataframe_column.h".
+	inline
+	This	std();
 	/*  @docs
 		@title: Standard deviation
 		@description:
@@ -4868,14 +4714,15 @@ public:
 			Will throw a `DimensionError` when the dataframe is not 1D.
 		@return:
 			Returns a `DataFrame` with type `vlib::df::types::df`.
+		@note:
+			Values that can't apply a full window and windows that contain a null will have type `vlib::df::types::null`.
 		@parameter:
 			@name: window
 			@description: The window of the operation.
 		@usage:
 			vlib::DataFrame x = {1.00, 0.23, 0.98};
-			vlib::DataFrame y = x.ma(); y ==> 0.736667
+			vlib::DataFrame y = x.std(2); y ==> {null, 0.544472, 0.530330}
 	*/
-	// Source: https://www.programiz.com/cpp-programming/examples/standard-deviation.
 	constexpr
 	This	std(const Len& window) {
         return std(window.value());
@@ -4883,27 +4730,7 @@ public:
     constexpr
     This    std(ullong window) {
         expect_1d(__FUNCTION__);
-        DataFrame std;
-        std.init(df::types::df);
-        std.resize(m_vals->len());
-        std.len() = m_vals->len();
-        ullong min_index = window - 1;
-        DataFrame val, mean;
-        for (auto& index: indexes()) {
-            if (index >= min_index) {
-                val = 0.0;
-                mean = 0.0;
-                for (auto& windex: Range(index - min_index, index + 1)) {
-                    mean += m_vals->get(windex);
-                }
-                mean.div_r(window);
-                for (auto& windex: Range(index - min_index, index + 1)) {
-                    val += (m_vals->get(windex) - mean).abs_r().pow_r(2.0);
-                }
-                std[index] = val.div_r(window - 1).sqrt_r();
-            }
-        }
-        return std;
+		return rolling_column_h(df::rolling::funcs::std, window);
     }
 		
 	// ---------------------------------------------------------
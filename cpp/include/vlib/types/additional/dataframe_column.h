@@ -0,0 +1,1399 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_DF_COLUMN_T_H
+#define VLIB_DF_COLUMN_T_H
+
+// Includes.
+#include <math.h> // for sqrtl.
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace df.
+namespace df {
+
+// Binary column files, defined in "dataframe_io.h".
+namespace io { struct BinaryTable; };
+
+// ---------------------------------------------------------
+// Column.
+//
+// Notes:
+// - Every column is stored in a single contiguous buffer of its type instead of a boxed "DataFrame" per value.
+// - Strings are dictionary encoded, every distinct string is stored once and the rows only store a code.
+// - Nulls are stored in a bitmap, which is only allocated once the first null is appended.
+// - A short is stored as an integer, an integer column is promoted to a floating column when a float is appended.
+//
+/*  @docs
+	@chapter: Types
+	@title: Column
+	@description:
+		Columnar typed storage for dataframes.
+
+		A `vlib::DataFrame` still stores its values boxed, use `DataFrame::column()` and `DataFrame::table()` to convert it.
+
+		A column holds one of the types `vlib::df::types::boolean`, `vlib::df::types::integer`, `vlib::df::types::floating` or `vlib::df::types::str`, the type is `vlib::df::types::null` until the first non null value is appended.
+
+		All statistics skip null values, arithmetic propagates nulls.
+	@usage:
+		#include <vlib/types.h>
+		vlib::df::Column x;
+		x.append(1.5);
+		x.append(2);
+		x.append_null();
+		x.mean(); ==> 1.75
+		vlib::df::Column y = x * 2; ==> {3.0, 4.0, null}
+*/
+struct Column {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 		This = 			Column;
+	using 		Indexes = 		Array<ullong>;
+
+	// ---------------------------------------------------------
+	// Friends.
+
+	friend struct io::BinaryTable;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	short				m_type = types::null;	// the column type.
+	ullong				m_len = 0;				// the number of rows.
+	ullong				m_nulls_count = 0;		// the number of null rows.
+	Array<ullong>		m_nulls;				// the null bitmap, a set bit is a null row.
+	Array<bool>			m_bools;				// the boolean values.
+	Array<llong>		m_ints;					// the integer values.
+	Array<ldouble>		m_floats;				// the floating values.
+	Array<uint>			m_codes;				// the string codes.
+	Array<String>		m_dict;					// the distinct strings.
+	Dict<String, uint>	m_dict_index;			// the code of every distinct string.
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Expect a numeric type.
+	constexpr
+	void	expect_numeric_h(const char* func) const {
+		switch (m_type) {
+			case types::null:
+			case types::boolean:
+			case types::integer:
+			case types::floating:
+				return ;
+			default:
+				throw TypeError(to_str("Function \"", func, "\" is not supported for a column of type \"", strtype(m_type), "\"."));
+		}
+	}
+
+	// Expect an equal length.
+	constexpr
+	void	expect_len_h(const This& obj) const {
+		if (m_len != obj.m_len) {
+			throw InvalidUsageError(to_str("The column lengths \"", m_len, "\" and \"", obj.m_len, "\" do not match."));
+		}
+	}
+
+	// Append zeros to the buffer of a type.
+	constexpr
+	void	fill_zeros_h(short type, ullong len) {
+		switch (type) {
+			case types::boolean:
+				m_bools.expand(len);
+				for (ullong i = 0; i < len; ++i) { m_bools.m_arr[m_bools.m_len++] = false; }
+				break;
+			case types::integer:
+				m_ints.expand(len);
+				for (ullong i = 0; i < len; ++i) { m_ints.m_arr[m_ints.m_len++] = 0; }
+				break;
+			case types::floating:
+				m_floats.expand(len);
+				for (ullong i = 0; i < len; ++i) { m_floats.m_arr[m_floats.m_len++] = 0; }
+				break;
+			case types::str:
+				m_codes.expand(len);
+				for (ullong i = 0; i < len; ++i) { m_codes.m_arr[m_codes.m_len++] = 0; }
+				break;
+			default:
+				break;
+		}
+	}
+
+	// Set the type before a value of a type is appended.
+	// - Returns the type the value should be stored as.
+	constexpr
+	short	set_type_h(short type) {
+		if (m_type == type) {
+			return type;
+		}
+		switch (m_type) {
+			case types::null:
+				m_type = type;
+				if (type == types::str && m_dict.m_len == 0) {
+					m_dict_index.enable_index();
+					m_dict.append(String());
+					m_dict_index.append(String(), 0);
+				}
+				fill_zeros_h(type, m_len);
+				return type;
+			case types::integer:
+				if (type == types::floating) {
+					m_floats.resize(m_ints.m_len);
+					for (ullong i = 0; i < m_ints.m_len; ++i) {
+						m_floats.m_arr[i] = (ldouble) m_ints.m_arr[i];
+					}
+					m_floats.m_len = m_ints.m_len;
+					m_ints.reset();
+					m_type = types::floating;
+					return types::floating;
+				}
+				break;
+			case types::floating:
+				if (type == types::integer) {
+					return types::floating;
+				}
+				break;
+			default:
+				break;
+		}
+		throw TypeError(to_str("Unable to append a value of type \"", strtype(type), "\" to a column of type \"", strtype(m_type), "\"."));
+	}
+
+	// Set a bit of the null bitmap.
+	constexpr
+	void	set_null_h(ullong index) {
+		const ullong word = index / 64;
+		if (word >= m_nulls.m_len) {
+			m_nulls.expand(word + 1 - m_nulls.m_len);
+			while (m_nulls.m_len <= word) { m_nulls.m_arr[m_nulls.m_len++] = 0; }
+		}
+		const ullong bit = 1ULL << (index % 64);
+		if ((m_nulls.m_arr[word] & bit) == 0) {
+			m_nulls.m_arr[word] |= bit;
+			++m_nulls_count;
+		}
+	}
+
+	// Get the values as floats.
+	// - Returns a pointer to the own buffer when the column is floating, otherwise the values are converted into the buffer.
+	constexpr
+	const ldouble*	floats_h(Array<ldouble>& buffer) const {
+		switch (m_type) {
+			case types::floating:
+				return m_floats.m_arr;
+			case types::integer:
+				buffer.resize(m_len);
+				for (ullong i = 0; i < m_len; ++i) { buffer.m_arr[i] = (ldouble) m_ints.m_arr[i]; }
+				buffer.m_len = m_len;
+				return buffer.m_arr;
+			case types::boolean:
+				buffer.resize(m_len);
+				for (ullong i = 0; i < m_len; ++i) { buffer.m_arr[i] = m_bools.m_arr[i] ? 1 : 0; }
+				buffer.m_len = m_len;
+				return buffer.m_arr;
+			default:
+				buffer.resize(m_len);
+				for (ullong i = 0; i < m_len; ++i) { buffer.m_arr[i] = 0; }
+				buffer.m_len = m_len;
+				return buffer.m_arr;
+		}
+	}
+
+	// Get the values as integers.
+	constexpr
+	const llong*	ints_h(Array<llong>& buffer) const {
+		switch (m_type) {
+			case types::integer:
+				return m_ints.m_arr;
+			case types::boolean:
+				buffer.resize(m_len);
+				for (ullong i = 0; i < m_len; ++i) { buffer.m_arr[i] = m_bools.m_arr[i] ? 1 : 0; }
+				buffer.m_len = m_len;
+				return buffer.m_arr;
+			default:
+				buffer.resize(m_len);
+				for (ullong i = 0; i < m_len; ++i) { buffer.m_arr[i] = 0; }
+				buffer.m_len = m_len;
+				return buffer.m_arr;
+		}
+	}
+
+	// Is an integer result.
+	constexpr
+	bool	is_integer_h() const {
+		return m_type == types::integer || m_type == types::boolean || m_type == types::null;
+	}
+
+	// Combine the null bitmaps of two columns into a result.
+	constexpr
+	void	combine_nulls_h(This& result, const This& obj) const {
+		if (m_nulls_count == 0 && obj.m_nulls_count == 0) { return ; }
+		for (ullong i = 0; i < m_len; ++i) {
+			if (is_null(i) || obj.is_null(i)) { result.set_null_h(i); }
+		}
+	}
+
+	// Apply an arithmetic operation with another column.
+	template <typename Func> constexpr
+	This	arith_h(const This& obj, bool floating, Func&& func) const {
+		expect_numeric_h(__FUNCTION__);
+		obj.expect_numeric_h(__FUNCTION__);
+		expect_len_h(obj);
+		This result;
+		result.m_len = m_len;
+		if (!floating && is_integer_h() && obj.is_integer_h()) {
+			Array<llong> xbuff, ybuff;
+			const llong* x = ints_h(xbuff);
+			const llong* y = obj.ints_h(ybuff);
+			result.m_type = types::integer;
+			result.m_ints.resize(m_len);
+			for (ullong i = 0; i < m_len; ++i) { result.m_ints.m_arr[i] = func(x[i], y[i]); }
+			result.m_ints.m_len = m_len;
+		} else {
+			Array<ldouble> xbuff, ybuff;
+			const ldouble* x = floats_h(xbuff);
+			const ldouble* y = obj.floats_h(ybuff);
+			result.m_type = types::floating;
+			result.m_floats.resize(m_len);
+			for (ullong i = 0; i < m_len; ++i) { result.m_floats.m_arr[i] = func(x[i], y[i]); }
+			result.m_floats.m_len = m_len;
+		}
+		combine_nulls_h(result, obj);
+		return result;
+	}
+
+	// Apply an arithmetic operation with a scalar.
+	template <typename Type, typename Func> constexpr
+	This	arith_h(const Type& scalar, bool floating, Func&& func) const {
+		expect_numeric_h(__FUNCTION__);
+		This result;
+		result.m_len = m_len;
+		if (!floating && is_integer_h() && is_any_integer<Type>::value) {
+			Array<llong> xbuff;
+			const llong* x = ints_h(xbuff);
+			const llong y = (llong) scalar;
+			result.m_type = types::integer;
+			result.m_ints.resize(m_len);
+			for (ullong i = 0; i < m_len; ++i) { result.m_ints.m_arr[i] = func(x[i], y); }
+			result.m_ints.m_len = m_len;
+		} else {
+			Array<ldouble> xbuff;
+			const ldouble* x = floats_h(xbuff);
+			const ldouble y = (ldouble) scalar;
+			result.m_type = types::floating;
+			result.m_floats.resize(m_len);
+			for (ullong i = 0; i < m_len; ++i) { result.m_floats.m_arr[i] = func(x[i], y); }
+			result.m_floats.m_len = m_len;
+		}
+		result.m_nulls = m_nulls;
+		result.m_nulls_count = m_nulls_count;
+		return result;
+	}
+
+	// Apply a rolling window kernel.
+	// - The leading rows without a full window and the windows that contain a null are null.
+	// - An integer column keeps its type when "Floating" is false.
+	template <bool Floating, typename Func> constexpr
+	This	rolling_h(ullong window, Func&& kernel) const {
+		expect_numeric_h(__FUNCTION__);
+		if (window == 0) {
+			throw InvalidUsageError("The window must be greater than zero.");
+		}
+		This result;
+		result.m_len = m_len;
+		if (!Floating && is_integer_h()) {
+			if constexpr (!Floating) {
+				Array<llong> buffer;
+				const llong* values = ints_h(buffer);
+				result.m_type = types::integer;
+				result.fill_zeros_h(types::integer, m_len);
+				kernel(values, result.m_ints.m_arr);
+			}
+		} else {
+			Array<ldouble> buffer;
+			const ldouble* values = floats_h(buffer);
+			result.m_type = types::floating;
+			result.fill_zeros_h(types::floating, m_len);
+			kernel(values, result.m_floats.m_arr);
+		}
+		ullong nulls = 0;
+		for (ullong i = 0; i < m_len; ++i) {
+			if (m_nulls_count != 0) {
+				if (is_null(i)) { ++nulls; }
+				if (i >= window && is_null(i - window)) { --nulls; }
+			}
+			if (i + 1 < window || nulls != 0) {
+				result.set_null_h(i);
+			}
+		}
+		return result;
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Default constructor.
+	constexpr
+	Column() = default;
+
+	// Constructor from a type.
+	constexpr
+	Column(short type) {
+		set_type_h(type);
+	}
+
+	// Constructor from an array.
+	template <typename Type> requires (
+		is_bool<Type>::value || is_any_integer<Type>::value || is_floating<Type>::value ||
+		is_String<Type>::value
+	) constexpr
+	Column(const Array<Type>& arr) {
+		reserve(arr.len());
+		for (auto& i: arr) { append(i); }
+	}
+
+	// ---------------------------------------------------------
+	// Properties.
+
+	// Type.
+	/*  @docs
+		@title: Type
+		@description:
+			Get the type of the column from enum `vlib::df::types`.
+	*/
+	constexpr
+	short	type() const { return m_type; }
+
+	// Length.
+	/*  @docs
+		@title: Length
+		@description:
+			Get the number of rows.
+	*/
+	constexpr
+	ullong	len() const { return m_len; }
+
+	// Nulls count.
+	/*  @docs
+		@title: Nulls count
+		@description:
+			Get the number of null rows.
+	*/
+	constexpr
+	ullong	nulls() const { return m_nulls_count; }
+
+	// Count.
+	/*  @docs
+		@title: Count
+		@description:
+			Get the number of non null rows.
+	*/
+	constexpr
+	ullong	count() const { return m_len - m_nulls_count; }
+
+	// Is null.
+	/*  @docs
+		@title: Is null
+		@description:
+			Check if a row is null.
+	*/
+	constexpr
+	bool	is_null(ullong index) const {
+		if (m_nulls_count == 0) { return false; }
+		const ullong word = index / 64;
+		return word < m_nulls.m_len && (m_nulls.m_arr[word] & (1ULL << (index % 64))) != 0;
+	}
+
+	// Raw buffers.
+	/*  @docs
+		@title: Buffers
+		@description:
+			Get the underlying contiguous buffer of the column type.
+
+			Null rows hold a zero value.
+		@funcs: 5
+	*/
+	constexpr
+	auto&	bools() const { return m_bools; }
+	constexpr
+	auto&	ints() const { return m_ints; }
+	constexpr
+	auto&	floats() const { return m_floats; }
+	constexpr
+	auto&	codes() const { return m_codes; }
+	constexpr
+	auto&	dict() const { return m_dict; }
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Reserve.
+	/*  @docs
+		@title: Reserve
+		@description:
+			Reserve capacity for a number of rows.
+	*/
+	constexpr
+	This&	reserve(ullong len) {
+		switch (m_type) {
+			case types::boolean: m_bools.resize(len); break;
+			case types::integer: m_ints.resize(len); break;
+			case types::floating: m_floats.resize(len); break;
+			case types::str: m_codes.resize(len); break;
+			default: break;
+		}
+		return *this;
+	}
+
+	// Append.
+	/*  @docs
+		@title: Append
+		@description:
+			Append a row.
+
+			Will throw a `TypeError` when the value type does not match the column type.
+		@funcs: 7
+	*/
+	constexpr
+	This&	append_null() {
+		fill_zeros_h(m_type, 1);
+		set_null_h(m_len);
+		++m_len;
+		return *this;
+	}
+	template <typename Type> requires (is_bool<Type>::value || is_Bool<Type>::value) constexpr
+	This&	append(const Type& x) {
+		set_type_h(types::boolean);
+		m_bools.append((bool) x);
+		++m_len;
+		return *this;
+	}
+	template <typename Type> requires (is_any_integer<Type>::value || is_any_integer_Numeric<Type>::value) constexpr
+	This&	append(const Type& x) {
+		llong value;
+		if constexpr (is_any_integer<Type>::value) { value = (llong) x; }
+		else { value = (llong) x.value(); }
+		switch (set_type_h(types::integer)) {
+			case types::integer: m_ints.append(value); break;
+			default: m_floats.append((ldouble) value); break;
+		}
+		++m_len;
+		return *this;
+	}
+	template <typename Type> requires (is_floating<Type>::value || is_floating_Numeric<Type>::value) constexpr
+	This&	append(const Type& x) {
+		set_type_h(types::floating);
+		if constexpr (is_floating<Type>::value) { m_floats.append((ldouble) x); }
+		else { m_floats.append((ldouble) x.value()); }
+		++m_len;
+		return *this;
+	}
+	constexpr
+	This&	append(const char* data, ullong len) {
+		set_type_h(types::str);
+		const ullong index = m_dict_index.find(data, len);
+		if (index == NPos::npos) {
+			const uint code = (uint) m_dict.m_len;
+			m_dict.append(String(data, len));
+			m_dict_index.append(String(data, len), code);
+			m_codes.append(code);
+		} else {
+			m_codes.append(m_dict_index.values().m_arr[index]);
+		}
+		++m_len;
+		return *this;
+	}
+	constexpr
+	This&	append(const String& x) {
+		return append(x.data(), x.len());
+	}
+	constexpr
+	This&	append(const char* x) {
+		return append(x, vlib::len(x));
+	}
+
+	// Set null.
+	/*  @docs
+		@title: Set null
+		@description:
+			Mark a row as null, the stored value is kept.
+	*/
+	constexpr
+	This&	set_null(ullong index) {
+		if (index >= m_len) {
+			throw IndexError(to_str("Index \"", index, "\" is out of range, the column length is \"", m_len, "\"."));
+		}
+		set_null_h(index);
+		return *this;
+	}
+
+	// Concat.
+	/*  @docs
+		@title: Concatenate
+		@description:
+			Append all rows of another column.
+
+			Will throw a `TypeError` when the column types are not compatible.
+	*/
+	constexpr
+	This&	concat_r(const This& obj) {
+		if (obj.m_len == 0) {
+			return *this;
+		}
+		const ullong offset = m_len;
+		if (obj.m_type == types::null) {
+			fill_zeros_h(m_type, obj.m_len);
+		} else {
+			const short type = set_type_h(obj.m_type);
+			switch (obj.m_type) {
+				case types::boolean:
+					m_bools.concat_r(obj.m_bools);
+					break;
+				case types::integer:
+					if (type == types::floating) {
+						m_floats.expand(obj.m_len);
+						for (ullong i = 0; i < obj.m_len; ++i) {
+							m_floats.m_arr[m_floats.m_len++] = (ldouble) obj.m_ints.m_arr[i];
+						}
+					} else {
+						m_ints.concat_r(obj.m_ints);
+					}
+					break;
+				case types::floating:
+					m_floats.concat_r(obj.m_floats);
+					break;
+				case types::str: {
+					Array<uint> codes;
+					codes.resize(obj.m_dict.m_len);
+					for (ullong i = 0; i < obj.m_dict.m_len; ++i) {
+						const String& str = obj.m_dict.m_arr[i];
+						const ullong index = m_dict_index.find(str.m_arr, str.m_len);
+						if (index == NPos::npos) {
+							codes.m_arr[i] = (uint) m_dict.m_len;
+							m_dict_index.append(str, (uint) m_dict.m_len);
+							m_dict.append(str);
+						} else {
+							codes.m_arr[i] = m_dict_index.values().m_arr[index];
+						}
+					}
+					m_codes.expand(obj.m_len);
+					for (ullong i = 0; i < obj.m_len; ++i) {
+						m_codes.m_arr[m_codes.m_len++] = codes.m_arr[obj.m_codes.m_arr[i]];
+					}
+					break;
+				}
+				default:
+					break;
+			}
+		}
+		m_len += obj.m_len;
+		for (ullong i = 0; i < obj.m_len; ++i) {
+			if (obj.m_type == types::null || obj.is_null(i)) { set_null_h(offset + i); }
+		}
+		return *this;
+	}
+
+	// Convert to a string column.
+	/*  @docs
+		@title: To string
+		@description:
+			Convert the column to a string column, every non null value is replaced by its text.
+
+			Used when a value of an incompatible type is appended, for example a text cell in a numeric csv column.
+	*/
+	constexpr
+	This&	to_str_r() {
+		switch (m_type) {
+			case types::str:
+				return *this;
+			case types::null:
+				set_type_h(types::str);
+				return *this;
+			default:
+				break;
+		}
+		This obj;
+		obj.set_type_h(types::str);
+		obj.m_codes.resize(m_len);
+		for (ullong i = 0; i < m_len; ++i) {
+			if (is_null(i)) {
+				obj.append_null();
+				continue;
+			}
+			switch (m_type) {
+				case types::boolean:
+					obj.append(m_bools.m_arr[i] ? "true" : "false");
+					break;
+				case types::integer:
+					obj.append(to_str(m_ints.m_arr[i]));
+					break;
+				default: {
+					// 18 significant digits of a "ldouble", so a parsed "2.5" stays "2.5".
+					char buffer[64];
+					const int len = snprintf(buffer, sizeof(buffer), "%.18Lg", m_floats.m_arr[i]);
+					obj.append(buffer, (ullong) len);
+					break;
+				}
+			}
+		}
+		return *this = move(obj);
+	}
+
+	// Check if the rows of another column can be appended without a conversion.
+	constexpr
+	bool	is_compatible(const This& obj) const {
+		if (m_type == obj.m_type || m_type == types::null || obj.m_type == types::null) {
+			return true;
+		}
+		return (m_type == types::integer || m_type == types::floating) &&
+			(obj.m_type == types::integer || obj.m_type == types::floating);
+	}
+
+	// Get a value.
+	/*  @docs
+		@title: Get
+		@description:
+			Get a value of a row.
+
+			Function `as_float` converts integer and boolean rows, function `as_str` requires a string column.
+		@funcs: 4
+	*/
+	constexpr
+	ldouble	as_float(ullong index) const {
+		switch (m_type) {
+			case types::floating: return m_floats.m_arr[index];
+			case types::integer: return (ldouble) m_ints.m_arr[index];
+			case types::boolean: return m_bools.m_arr[index] ? 1 : 0;
+			default: throw TypeError(to_str("Unable to get a float from a column of type \"", strtype(m_type), "\"."));
+		}
+	}
+	constexpr
+	llong	as_int(ullong index) const {
+		switch (m_type) {
+			case types::floating: return (llong) m_floats.m_arr[index];
+			case types::integer: return m_ints.m_arr[index];
+			case types::boolean: return m_bools.m_arr[index] ? 1 : 0;
+			default: throw TypeError(to_str("Unable to get an integer from a column of type \"", strtype(m_type), "\"."));
+		}
+	}
+	constexpr
+	bool	as_bool(ullong index) const {
+		switch (m_type) {
+			case types::boolean: return m_bools.m_arr[index];
+			default: return as_float(index) != 0;
+		}
+	}
+	constexpr
+	const String&	as_str(ullong index) const {
+		if (m_type != types::str) {
+			throw TypeError(to_str("Unable to get a string from a column of type \"", strtype(m_type), "\"."));
+		}
+		return m_dict.m_arr[m_codes.m_arr[index]];
+	}
+
+	// Take.
+	/*  @docs
+		@title: Take
+		@description:
+			Create a new column from the rows of an array of indexes.
+	*/
+	constexpr
+	This	take(const Indexes& indexes) const {
+		This obj;
+		obj.m_type = m_type;
+		obj.m_len = indexes.m_len;
+		switch (m_type) {
+			case types::boolean:
+				obj.m_bools.resize(indexes.m_len);
+				for (ullong i = 0; i < indexes.m_len; ++i) { obj.m_bools.m_arr[i] = m_bools.m_arr[indexes.m_arr[i]]; }
+				obj.m_bools.m_len = indexes.m_len;
+				break;
+			case types::integer:
+				obj.m_ints.resize(indexes.m_len);
+				for (ullong i = 0; i < indexes.m_len; ++i) { obj.m_ints.m_arr[i] = m_ints.m_arr[indexes.m_arr[i]]; }
+				obj.m_ints.m_len = indexes.m_len;
+				break;
+			case types::floating:
+				obj.m_floats.resize(indexes.m_len);
+				for (ullong i = 0; i < indexes.m_len; ++i) { obj.m_floats.m_arr[i] = m_floats.m_arr[indexes.m_arr[i]]; }
+				obj.m_floats.m_len = indexes.m_len;
+				break;
+			case types::str:
+				obj.m_dict = m_dict;
+				obj.m_dict_index = m_dict_index;
+				obj.m_codes.resize(indexes.m_len);
+				for (ullong i = 0; i < indexes.m_len; ++i) { obj.m_codes.m_arr[i] = m_codes.m_arr[indexes.m_arr[i]]; }
+				obj.m_codes.m_len = indexes.m_len;
+				break;
+			default:
+				break;
+		}
+		if (m_nulls_count != 0) {
+			for (ullong i = 0; i < indexes.m_len; ++i) {
+				if (is_null(indexes.m_arr[i])) { obj.set_null_h(i); }
+			}
+		}
+		return obj;
+	}
+
+	// Argsort.
+	/*  @docs
+		@title: Argsort
+		@description:
+			Get the row indexes in sorted order.
+
+			The sort is stable and null rows are always placed at the end. Boolean and integer columns are sorted with a radix sort.
+	*/
+	This::Indexes	argsort(bool reversed = false) const {
+		Indexes indexes;
+		indexes.resize(m_len);
+		ullong nulls_index = m_len - m_nulls_count;
+		ullong pos = 0;
+		for (ullong i = 0; i < m_len; ++i) {
+			if (is_null(i)) { indexes.m_arr[nulls_index++] = i; }
+			else { indexes.m_arr[pos++] = i; }
+		}
+		indexes.m_len = m_len;
+		switch (m_type) {
+			case types::boolean:
+				sorting::radix(indexes.m_arr, pos, [&](ullong x) { return m_bools.m_arr[x]; }, reversed);
+				break;
+			case types::integer:
+				sorting::radix(indexes.m_arr, pos, [&](ullong x) { return m_ints.m_arr[x]; }, reversed);
+				break;
+			case types::floating:
+				sorting::merge(indexes.m_arr, pos, [&](ullong x, ullong y) {
+					return reversed ? m_floats.m_arr[x] > m_floats.m_arr[y] : m_floats.m_arr[x] < m_floats.m_arr[y];
+				});
+				break;
+			case types::str: {
+
+				// Rank the distinct strings once, rows are compared by the rank of their code.
+				Indexes order;
+				order.resize(m_dict.m_len);
+				for (ullong i = 0; i < m_dict.m_len; ++i) { order.m_arr[i] = i; }
+				order.m_len = m_dict.m_len;
+				sorting::merge(order.m_arr, order.m_len, [&](ullong x, ullong y) {
+					const String& a = m_dict.m_arr[x];
+					const String& b = m_dict.m_arr[y];
+					const ullong len = a.m_len < b.m_len ? a.m_len : b.m_len;
+					const int cmp = len == 0 ? 0 : memcmp(a.m_arr, b.m_arr, len);
+					return cmp < 0 || (cmp == 0 && a.m_len < b.m_len);
+				});
+				Array<uint> ranks;
+				ranks.resize(m_dict.m_len);
+				for (ullong i = 0; i < order.m_len; ++i) { ranks.m_arr[order.m_arr[i]] = (uint) i; }
+				sorting::merge(indexes.m_arr, pos, [&](ullong x, ullong y) {
+					const uint a = ranks.m_arr[m_codes.m_arr[x]];
+					const uint b = ranks.m_arr[m_codes.m_arr[y]];
+					return reversed ? a > b : a < b;
+				});
+				break;
+			}
+			default:
+				break;
+		}
+		return indexes;
+	}
+
+	// Sort.
+	/*  @docs
+		@title: Sort
+		@description:
+			Sort the column.
+
+			Function `sort_r` updates the current column, while `sort` creates a copy.
+		@funcs: 2
+	*/
+	This	sort(bool reversed = false) const {
+		return take(argsort(reversed));
+	}
+	This&	sort_r(bool reversed = false) {
+		This sorted = take(argsort(reversed));
+		return *this = move(sorted);
+	}
+
+	// ---------------------------------------------------------
+	// Statistics.
+
+	// Sum.
+	/*  @docs
+		@title: Sum
+		@description:
+			Calculate the sum of all non null values.
+	*/
+	constexpr
+	ldouble	sum() const {
+		expect_numeric_h(__FUNCTION__);
+		ldouble sum = 0;
+		switch (m_type) {
+			case types::floating:
+				if (m_nulls_count == 0) {
+					for (ullong i = 0; i < m_len; ++i) { sum += m_floats.m_arr[i]; }
+				} else {
+					for (ullong i = 0; i < m_len; ++i) { if (!is_null(i)) { sum += m_floats.m_arr[i]; } }
+				}
+				return sum;
+			case types::integer: {
+				llong isum = 0;
+				for (ullong i = 0; i < m_len; ++i) { isum += m_ints.m_arr[i]; } // nulls hold zero.
+				return (ldouble) isum;
+			}
+			case types::boolean:
+				for (ullong i = 0; i < m_len; ++i) { sum += m_bools.m_arr[i]; }
+				return sum;
+			default:
+				return sum;
+		}
+	}
+
+	// Mean.
+	/*  @docs
+		@title: Mean
+		@description:
+			Calculate the mean of all non null values.
+
+			Returns `NaN` when the column has no non null values.
+	*/
+	constexpr
+	ldouble	mean() const {
+		const ullong n = count();
+		if (n == 0) { return NAN; }
+		return sum() / (ldouble) n;
+	}
+
+	// Standard deviation.
+	/*  @docs
+		@title: Standard deviation
+		@description:
+			Calculate the standard deviation of all non null values.
+
+			The default `ddof` of 1 calculates the sample standard deviation, just like `DataFrame::std`.
+	*/
+	ldouble	std(ullong ddof = 1) const {
+		const ullong n = count();
+		if (n <= ddof) { return NAN; }
+		const ldouble avg = mean();
+		Array<ldouble> buffer;
+		const ldouble* values = floats_h(buffer);
+		ldouble sum = 0;
+		for (ullong i = 0; i < m_len; ++i) {
+			if (m_nulls_count != 0 && is_null(i)) { continue; }
+			const ldouble diff = values[i] - avg;
+			sum += diff * diff;
+		}
+		return sqrtl(sum / (ldouble) (n - ddof));
+	}
+
+	// Min and max.
+	/*  @docs
+		@title: Min and max
+		@description:
+			Get the min or max of all non null values.
+
+			Returns `NaN` when the column has no non null values.
+		@funcs: 2
+	*/
+	ldouble	min() const {
+		expect_numeric_h(__FUNCTION__);
+		Array<ldouble> buffer;
+		const ldouble* values = floats_h(buffer);
+		ldouble x = NAN;
+		bool set = false;
+		for (ullong i = 0; i < m_len; ++i) {
+			if (m_nulls_count != 0 && is_null(i)) { continue; }
+			if (!set || values[i] < x) { x = values[i]; set = true; }
+		}
+		return x;
+	}
+	ldouble	max() const {
+		expect_numeric_h(__FUNCTION__);
+		Array<ldouble> buffer;
+		const ldouble* values = floats_h(buffer);
+		ldouble x = NAN;
+		bool set = false;
+		for (ullong i = 0; i < m_len; ++i) {
+			if (m_nulls_count != 0 && is_null(i)) { continue; }
+			if (!set || values[i] > x) { x = values[i]; set = true; }
+		}
+		return x;
+	}
+
+	// Rolling statistics.
+	/*  @docs
+		@title: Rolling statistics
+		@description:
+			Calculate the sum, mean, standard deviation, min or max over a rolling window in O(n).
+
+			The first `window - 1` rows and every window that contains a null are null.
+
+			The sum, min and max of an integer column are integers, the mean and standard deviation are always floating.
+		@parameter:
+			@name: window
+			@description: The window of the operation.
+		@usage:
+			vlib::df::Column x (vlib::Array<vlib::ldouble>{1, 2, 3, 4});
+			x.rolling_mean(2); ==> {null, 1.5, 2.5, 3.5}
+		@funcs: 5
+	*/
+	This	rolling_sum(ullong window) const {
+		return rolling_h<false>(window, [&](const auto* data, auto* out) {
+			rolling::sum(data, m_len, window, out);
+		});
+	}
+	This	rolling_mean(ullong window) const {
+		return rolling_h<true>(window, [&](const auto* data, auto* out) {
+			rolling::mean(data, m_len, window, out);
+		});
+	}
+	This	rolling_std(ullong window, ullong ddof = 1) const {
+		return rolling_h<true>(window, [&](const auto* data, auto* out) {
+			rolling::std(data, m_len, window, out, ddof);
+		});
+	}
+	This	rolling_min(ullong window) const {
+		return rolling_h<false>(window, [&](const auto* data, auto* out) {
+			rolling::min(data, m_len, window, out);
+		});
+	}
+	This	rolling_max(ullong window) const {
+		return rolling_h<false>(window, [&](const auto* data, auto* out) {
+			rolling::max(data, m_len, window, out);
+		});
+	}
+
+	// ---------------------------------------------------------
+	// Arithmetic.
+
+	// Add, subtract, multiply and divide.
+	/*  @docs
+		@title: Arithmetic
+		@description:
+			Add, subtract, multiply or divide with another column of the same length or with a scalar.
+
+			Integer operands produce an integer column, except for a division which always produces a floating column.
+		@funcs: 8
+	*/
+	constexpr
+	This	add(const This& obj) const { return arith_h(obj, false, [](auto x, auto y) { return x + y; }); }
+	constexpr
+	This	sub(const This& obj) const { return arith_h(obj, false, [](auto x, auto y) { return x - y; }); }
+	constexpr
+	This	mult(const This& obj) const { return arith_h(obj, false, [](auto x, auto y) { return x * y; }); }
+	constexpr
+	This	div(const This& obj) const { return arith_h(obj, true, [](auto x, auto y) { return x / y; }); }
+	template <typename Type> requires (is_any_integer<Type>::value || is_floating<Type>::value) constexpr
+	This	add(const Type& x) const { return arith_h(x, false, [](auto x, auto y) { return x + y; }); }
+	template <typename Type> requires (is_any_integer<Type>::value || is_floating<Type>::value) constexpr
+	This	sub(const Type& x) const { return arith_h(x, false, [](auto x, auto y) { return x - y; }); }
+	template <typename Type> requires (is_any_integer<Type>::value || is_floating<Type>::value) constexpr
+	This	mult(const Type& x) const { return arith_h(x, false, [](auto x, auto y) { return x * y; }); }
+	template <typename Type> requires (is_any_integer<Type>::value || is_floating<Type>::value) constexpr
+	This	div(const Type& x) const { return arith_h(x, true, [](auto x, auto y) { return x / y; }); }
+
+	// Operators.
+	template <typename Type> constexpr friend
+	This	operator +(const This& x, const Type& y) { return x.add(y); }
+	template <typename Type> constexpr friend
+	This	operator -(const This& x, const Type& y) { return x.sub(y); }
+	template <typename Type> constexpr friend
+	This	operator *(const This& x, const Type& y) { return x.mult(y); }
+	template <typename Type> constexpr friend
+	This	operator /(const This& x, const Type& y) { return x.div(y); }
+
+	// ---------------------------------------------------------
+	// Casts.
+
+	// Get a row as a dataframe.
+	/*  @docs
+		@title: Get
+		@description:
+			Get a row as a boxed `DataFrame`.
+	*/
+	constexpr
+	DataFrame	get(ullong index) const {
+		if (is_null(index)) { return DataFrame(); }
+		switch (m_type) {
+			case types::boolean: return DataFrame(m_bools.m_arr[index]);
+			case types::integer: return DataFrame(m_ints.m_arr[index]);
+			case types::floating: return DataFrame(m_floats.m_arr[index]);
+			case types::str: return DataFrame(m_dict.m_arr[m_codes.m_arr[index]]);
+			default: return DataFrame();
+		}
+	}
+
+};
+
+// ---------------------------------------------------------
+// Table.
+//
+// Notes:
+// - A 2D columnar dataframe, every column is a "df::Column" of equal length.
+//
+/*  @docs
+	@chapter: Types
+	@title: Table
+	@description:
+		Columnar 2D dataframe.
+	@usage:
+		#include <vlib/types.h>
+		vlib::df::Table x;
+		x.insert("price", vlib::Array<vlib::ldouble>{1.5, 0.5, 1.0});
+		x.insert("name", vlib::Array<vlib::String>{"A", "B", "C"});
+		x.sort_r("price");
+		x["name"].as_str(0); ==> "B"
+*/
+struct Table {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 		This = 			Table;
+	using 		Columns = 		Array<String>;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	Columns			m_cols;
+	Array<Column>	m_data;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Find a column.
+	constexpr
+	ullong	find_h(const String& column) const {
+		for (ullong i = 0; i < m_cols.m_len; ++i) {
+			if (m_cols.m_arr[i] == column) { return i; }
+		}
+		return NPos::npos;
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Default constructor.
+	constexpr
+	Table() = default;
+
+	// ---------------------------------------------------------
+	// Properties.
+
+	// Length.
+	/*  @docs
+		@title: Length
+		@description:
+			Get the number of rows.
+	*/
+	constexpr
+	ullong	len() const {
+		return m_data.m_len == 0 ? 0 : m_data.m_arr[0].len();
+	}
+
+	// Columns.
+	/*  @docs
+		@title: Columns
+		@description:
+			Get the column names.
+	*/
+	constexpr
+	auto&	columns() const { return m_cols; }
+
+	// Has a column.
+	/*  @docs
+		@title: Contains
+		@description:
+			Check if the table has a column.
+	*/
+	constexpr
+	bool	contains(const String& column) const { return find_h(column) != NPos::npos; }
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Insert a column.
+	/*  @docs
+		@title: Insert
+		@description:
+			Insert a column, an existing column with the same name is replaced.
+
+			Will throw an `InvalidUsageError` when the column length does not match the table length.
+		@funcs: 2
+	*/
+	constexpr
+	This&	insert(const String& name, const Column& column) {
+		return insert(name, Column(column));
+	}
+	constexpr
+	This&	insert(const String& name, Column&& column) {
+		if (m_data.m_len != 0 && column.len() != len()) {
+			throw InvalidUsageError(to_str("The column length \"", column.len(), "\" does not match the table length \"", len(), "\"."));
+		}
+		const ullong index = find_h(name);
+		if (index == NPos::npos) {
+			m_cols.append(name);
+			m_data.append(move(column));
+		} else {
+			m_data.m_arr[index] = move(column);
+		}
+		return *this;
+	}
+
+	// Merge.
+	/*  @docs
+		@title: Merge
+		@description:
+			Merge the columns of another table, existing columns are replaced.
+
+			Function `merge_r` updates the current table, while `merge` creates a copy.
+		@funcs: 2
+	*/
+	constexpr
+	This&	merge_r(const This& obj) {
+		for (ullong i = 0; i < obj.m_cols.m_len; ++i) {
+			insert(obj.m_cols.m_arr[i], obj.m_data.m_arr[i]);
+		}
+		return *this;
+	}
+	constexpr
+	This	merge(const This& obj) const {
+		return This(*this).merge_r(obj);
+	}
+
+	// Sort.
+	/*  @docs
+		@title: Sort
+		@description:
+			Sort all rows by a column.
+
+			Function `sort_r` updates the current table, while `sort` creates a copy.
+		@funcs: 2
+	*/
+	This	sort(const String& column, bool reversed = false) const {
+		const Column::Indexes indexes = operator[](column).argsort(reversed);
+		This sorted;
+		sorted.m_cols = m_cols;
+		sorted.m_data.resize(m_data.m_len);
+		for (ullong i = 0; i < m_data.m_len; ++i) {
+			sorted.m_data.append(m_data.m_arr[i].take(indexes));
+		}
+		return sorted;
+	}
+	This&	sort_r(const String& column, bool reversed = false) {
+		This sorted = sort(column, reversed);
+		return *this = move(sorted);
+	}
+
+	// ---------------------------------------------------------
+	// Operators.
+
+	// Operator [] with column.
+	/*  @docs
+		@title: Operator []
+		@description:
+			Get a column by name or index.
+
+			Will throw a `KeyError` when the column does not exist.
+		@funcs: 4
+	*/
+	constexpr
+	Column&	operator [](const String& column) {
+		const ullong index = find_h(column);
+		if (index == NPos::npos) { throw KeyError(to_str("Column \"", column, "\" does not exist.")); }
+		return m_data.m_arr[index];
+	}
+	constexpr
+	const Column&	operator [](const String& column) const {
+		const ullong index = find_h(column);
+		if (index == NPos::npos) { throw KeyError(to_str("Column \"", column, "\" does not exist.")); }
+		return m_data.m_arr[index];
+	}
+	constexpr
+	Column&	operator [](ullong index) { return m_data.get(index); }
+	constexpr
+	const Column&	operator [](ullong index) const { return m_data.get(index); }
+
+};
+
+}; 		// End namespace df.
+
+// ---------------------------------------------------------
+// DataFrame columnar functions.
+//
+// Notes:
+// - The boxed "DataFrame" remains the storage, these functions convert it into a temporary column on every call.
+// - The memory of a dataframe is therefore not reduced, only "df::Column" and "df::Table" store the values in typed buffers.
+// - Functions "mean", "merge" and the arithmetic operators of "DataFrame" still run over the boxed values.
+//
+
+// Define the "DataFrame" columnar constructors.
+inline
+DataFrame::DataFrame(const df::Column& x) :
+DataFrame()
+{
+	init(df::types::df, 1);
+	m_vals->resize(x.len());
+	for (ullong i = 0; i < x.len(); ++i) {
+		m_vals->append(x.get(i));
+	}
+}
+inline
+DataFrame::DataFrame(const df::Table& x) :
+DataFrame()
+{
+	init(df::types::df, 2);
+	m_vals->resize(x.columns().len());
+	for (ullong i = 0; i < x.columns().len(); ++i) {
+		m_vals->append(DataFrame(x[i]));
+	}
+	*m_cols = x.columns();
+}
+
+// Define the "DataFrame::column" function.
+inline
+df::Column	DataFrame::column() const {
+	expect_1d(__FUNCTION__);
+	df::Column column;
+	for (auto& i: *m_vals) {
+		switch (i.m_type) {
+			case df::types::null:
+				column.append_null();
+				break;
+			case df::types::boolean:
+				column.append(*i.m_bool);
+				break;
+			case df::types::short_type:
+				column.append(*i.m_short);
+				break;
+			case df::types::integer:
+				column.append(*i.m_int);
+				break;
+			case df::types::floating:
+				column.append(*i.m_float);
+				break;
+			case df::types::str:
+				column.append(*i.m_str);
+				break;
+			default:
+				throw TypeError(to_str("Unable to convert a value of type \"", df::strtype(i.m_type), "\" into a column."));
+		}
+	}
+	return column;
+}
+
+// Define the "DataFrame::table" function.
+inline
+df::Table	DataFrame::table() const {
+	expect_2d(__FUNCTION__);
+	df::Table table;
+	for (auto& index: m_vals->indexes()) {
+		if (has_columns() && index < m_cols->len()) {
+			table.insert(m_cols->get(index), m_vals->get(index).column());
+		} else {
+			table.insert(to_str(index), m_vals->get(index).column());
+		}
+	}
+	return table;
+}
+
+// Define the "DataFrame::sort" function.
+inline
+DataFrame	DataFrame::sort(const String& column, bool reversed) const {
+	expect_2d(__FUNCTION__);
+	const DataFrame& values = operator[](column);
+	df::Column::Indexes indexes;
+	try {
+		indexes = values.column().argsort(reversed);
+	}
+
+	// Compare the boxed values when the column can not be converted.
+	// - Like "df::Column::argsort" the sort is stable, numbers are placed before strings and nulls at the end.
+	catch (TypeError&) {
+		const Array<DataFrame>& vals = *values.m_vals;
+		ullong nulls_index = vals.len();
+		for (auto& i: vals) {
+			if (i.m_type == df::types::null) { --nulls_index; }
+		}
+		ullong pos = 0;
+		indexes.resize(vals.len());
+		for (ullong i = 0; i < vals.len(); ++i) {
+			if (vals.m_arr[i].m_type == df::types::null) { indexes.m_arr[nulls_index++] = i; }
+			else { indexes.m_arr[pos++] = i; }
+		}
+		indexes.m_len = vals.len();
+		sorting::merge(indexes.m_arr, pos, [&](ullong x, ullong y) {
+			const DataFrame& a = vals.m_arr[x];
+			const DataFrame& b = vals.m_arr[y];
+			const bool a_str = a.m_type == df::types::str;
+			const bool b_str = b.m_type == df::types::str;
+			if (a_str != b_str) { return reversed ? a_str : b_str; }
+			if (a_str) {
+				const String& x_str = reversed ? *b.m_str : *a.m_str;
+				const String& y_str = reversed ? *a.m_str : *b.m_str;
+				const ullong len = x_str.len() < y_str.len() ? x_str.len() : y_str.len();
+				const int cmp = len == 0 ? 0 : memcmp(x_str.data(), y_str.data(), len);
+				return cmp < 0 || (cmp == 0 && x_str.len() < y_str.len());
+			}
+			return reversed ? (bool) (b < a) : (bool) (a < b);
+		});
+	}
+	DataFrame sorted;
+	sorted.init(vlib::df::types::df, 2);
+	sorted.fill(m_vals->len(), DataFrame().init(df::types::df));
+	sorted.set_columns(*m_cols);
+	for (auto& cindex: Range<ullong>(0, m_vals->len())) {
+		DataFrame& ncol = sorted[cindex];
+		DataFrame& ocol = m_vals->get(cindex);
+		ncol.resize(indexes.len());
+		for (auto& rindex: indexes) {
+			ncol.m_vals->append(ocol.m_vals->get(rindex));
+		}
+	}
+	return sorted;
+}
+
+// Define the "DataFrame::rolling_column_h" function.
+inline
+DataFrame	DataFrame::rolling_column_h(short func, ullong window) const {
+	const df::Column values = column();
+	switch (func) {
+		case df::rolling::funcs::sum: return DataFrame(values.rolling_sum(window));
+		case df::rolling::funcs::mean: return DataFrame(values.rolling_mean(window));
+		case df::rolling::funcs::std: return DataFrame(values.rolling_std(window));
+		case df::rolling::funcs::min: return DataFrame(values.rolling_min(window));
+		case df::rolling::funcs::max: return DataFrame(values.rolling_max(window));
+		default: throw InvalidUsageError(to_str("Unknown rolling function \"", func, "\"."));
+	}
+}
+
+// Define the "DataFrame::std" function.
+inline
+DataFrame	DataFrame::std() {
+	expect_1d(__FUNCTION__);
+	return DataFrame(column().std());
+}
+
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -0,0 +1,1028 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_DF_IO_T_H
+#define VLIB_DF_IO_T_H
+
+// Includes.
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdlib.h> // for strtold.
+#include <exception> // for exception_ptr.
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace df.
+namespace df {
+
+// Namespace io.
+namespace io {
+
+// ---------------------------------------------------------
+// Mapped file.
+
+using MappedFile = File::View;
+
+// ---------------------------------------------------------
+// CSV parser.
+//
+// Notes:
+// - Parses the text format of "DataFrame::save" (a "1" or "2" dimension line first) and plain csv with a header line.
+// - The data is split on row boundaries and every part is parsed by its own thread into its own columns, the columns are concatenated in order afterwards.
+// - A row boundary is a newline outside quotes, the quote parity at every split point is counted by the threads before the rows are parsed.
+// - Values are parsed directly from the mapped data, a string value only allocates the first time it occurs in a column.
+// - A column with mixed types is converted to a string column, unless the cell types are kept, then it falls back to a boxed "DataFrame" column.
+//
+struct Parser {
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	const char*			m_data;
+	ullong				m_len;
+	ullong				m_columns;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Parse a numeric value, returns "types::integer" or "types::floating" and "types::null" when the value is not numeric.
+	static
+	short	parse_number_h(const char* data, ullong len, llong& integer, ldouble& floating_value) {
+		bool floating = false;
+		for (ullong i = 0; i < len; ++i) {
+			switch (data[i]) {
+				case '0': case '1': case '2': case '3': case '4':
+				case '5': case '6': case '7': case '8': case '9':
+					continue;
+				case '-': case '+':
+					if (i == 0 || data[i - 1] == 'e' || data[i - 1] == 'E') { continue; }
+					return types::null;
+				case '.': case 'e': case 'E':
+					floating = true;
+					continue;
+				default:
+					return types::null;
+			}
+		}
+		if (!floating && len < 19) {
+			ullong i = data[0] == '-' || data[0] == '+' ? 1 : 0;
+			if (i == len) { return types::null; }
+			llong x = 0;
+			for (; i < len; ++i) { x = x * 10 + (data[i] - '0'); }
+			integer = data[0] == '-' ? -x : x;
+			return types::integer;
+		}
+		char buffer[64];
+		if (len >= sizeof(buffer)) { return types::null; }
+		memcpy(buffer, data, len);
+		buffer[len] = '\0';
+		char* end;
+		floating_value = strtold(buffer, &end);
+		if (end != buffer + len) { return types::null; }
+		return types::floating;
+	}
+
+	// Append a numeric value, returns false when the value is not numeric.
+	static
+	bool	append_number_h(Column& column, const char* data, ullong len) {
+		llong integer;
+		ldouble floating;
+		switch (parse_number_h(data, len, integer, floating)) {
+			case types::integer:
+				column.append(integer);
+				return true;
+			case types::floating:
+				column.append(floating);
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	// Get the type of a value when it is parsed on its own.
+	static
+	short	type_h(const char* data, ullong len) {
+		if (len == 0) {
+			return types::null;
+		}
+		switch (data[0]) {
+			case '"':
+				return types::str;
+			case 'n':
+				if (len == 4 && memcmp(data, "null", 4) == 0) { return types::null; }
+				break;
+			case 't':
+				if (len == 4 && memcmp(data, "true", 4) == 0) { return types::boolean; }
+				break;
+			case 'f':
+				if (len == 5 && memcmp(data, "false", 5) == 0) { return types::boolean; }
+				break;
+			default:
+				break;
+		}
+		llong integer;
+		ldouble floating;
+		const short type = parse_number_h(data, len, integer, floating);
+		return type == types::null ? types::str : type;
+	}
+
+	// Append a text value, the column is converted to a string column when it is not one yet.
+	static
+	void	append_text_h(Column& column, const char* data, ullong len) {
+		if (column.type() != types::str) {
+			column.to_str_r();
+		}
+		column.append(data, len);
+	}
+
+	// Append a value.
+	// - A value that does not match the column type converts the column to a string column.
+	static
+	void	append_value_h(Column& column, const char* data, ullong len, String& unescaped) {
+		if (len == 0) {
+			column.append_null();
+			return ;
+		}
+		switch (data[0]) {
+			case '"': {
+				const char* str = data + 1;
+				ullong str_len = len >= 2 && data[len - 1] == '"' ? len - 2 : len - 1;
+				if (memchr(str, '"', str_len) != nullptr) {
+					unescaped.reset();
+					for (ullong i = 0; i < str_len; ++i) {
+						unescaped.append(str[i]);
+						if (str[i] == '"' && i + 1 < str_len && str[i + 1] == '"') { ++i; }
+					}
+					append_text_h(column, unescaped.data(), unescaped.len());
+				} else {
+					append_text_h(column, str, str_len);
+				}
+				return ;
+			}
+			case 'n':
+				if (len == 4 && memcmp(data, "null", 4) == 0) {
+					column.append_null();
+					return ;
+				}
+				break;
+			case 't':
+				if (len == 4 && memcmp(data, "true", 4) == 0 && (column.type() == types::boolean || column.type() == types::null)) {
+					column.append(true);
+					return ;
+				}
+				break;
+			case 'f':
+				if (len == 5 && memcmp(data, "false", 5) == 0 && (column.type() == types::boolean || column.type() == types::null)) {
+					column.append(false);
+					return ;
+				}
+				break;
+			default:
+				switch (column.type()) {
+					case types::null:
+					case types::integer:
+					case types::floating:
+						if (append_number_h(column, data, len)) {
+							return ;
+						}
+						break;
+					default:
+						break;
+				}
+				break;
+		}
+		append_text_h(column, data, len);
+	}
+
+	// Append a value and keep its type.
+	// - A value that does not match the column type moves the column into a boxed dataframe, which receives all following values.
+	static
+	void	append_boxed_h(Column& column, DataFrame& boxed, const char* data, ullong len, String& unescaped) {
+		if (boxed.m_type == types::null) {
+			const short type = type_h(data, len);
+			if (type == types::null || column.type() == types::null || type == column.type()) {
+				append_value_h(column, data, len, unescaped);
+				return ;
+			}
+			boxed = DataFrame(column);
+			column = Column();
+		}
+		Column cell;
+		append_value_h(cell, data, len, unescaped);
+		boxed.append(cell.get(0));
+	}
+
+	// Append a value to a column of a part.
+	static
+	void	append_h(Array<Column>& columns, Array<DataFrame>* boxed, ullong index, const char* data, ullong len, String& unescaped) {
+		if (boxed == nullptr) {
+			append_value_h(columns.m_arr[index], data, len, unescaped);
+		} else {
+			append_boxed_h(columns.m_arr[index], boxed->m_arr[index], data, len, unescaped);
+		}
+	}
+
+	// Count the quotes of a part.
+	static
+	ullong	count_quotes_h(const char* data, ullong len) {
+		ullong count = 0;
+		const char* end = data + len;
+		while ((data = (const char*) memchr(data, '"', end - data)) != nullptr) {
+			++count;
+			++data;
+		}
+		return count;
+	}
+
+	// Find the first row start at or after an offset, given the quote parity at the offset.
+	constexpr
+	ullong	row_start_h(ullong offset, bool quoted) const {
+		for (ullong i = offset; i < m_len; ++i) {
+			switch (m_data[i]) {
+				case '"':
+					quoted = !quoted;
+					continue;
+				case '\n':
+					if (!quoted) { return i + 1; }
+					continue;
+				default:
+					continue;
+			}
+		}
+		return m_len;
+	}
+
+	// Parse the rows of a part into columns.
+	constexpr
+	void	parse_h(ullong start, ullong end, Array<Column>& columns, Array<DataFrame>* boxed) const {
+		String unescaped;
+		columns.resize(m_columns);
+		for (ullong i = 0; i < m_columns; ++i) { columns.append(Column()); }
+		if (boxed != nullptr) { boxed->fill_r(m_columns, DataFrame()); }
+		ullong column = 0;
+		ullong field = start;
+		bool quoted = false;
+		for (ullong i = start; i < end; ++i) {
+			switch (m_data[i]) {
+				case '"':
+					quoted = !quoted;
+					continue;
+				case ',':
+					if (quoted) { continue; }
+					if (column < m_columns) {
+						append_h(columns, boxed, column, m_data + field, i - field, unescaped);
+					}
+					++column;
+					field = i + 1;
+					continue;
+				case '\n': {
+					if (quoted) { continue; }
+					ullong len = i - field;
+					if (len > 0 && m_data[i - 1] == '\r') { --len; }
+					if (column == 0 && len == 0) { // skip empty lines.
+						field = i + 1;
+						continue;
+					}
+					if (column < m_columns) {
+						append_h(columns, boxed, column, m_data + field, len, unescaped);
+					}
+					for (++column; column < m_columns; ++column) {
+						append_h(columns, boxed, column, m_data, 0, unescaped);
+					}
+					column = 0;
+					field = i + 1;
+					continue;
+				}
+				default:
+					continue;
+			}
+		}
+
+		// Last row without a trailing newline.
+		if (field < end) {
+			ullong len = end - field;
+			if (m_data[end - 1] == '\r') { --len; }
+			if (column < m_columns) {
+				append_h(columns, boxed, column, m_data + field, len, unescaped);
+			}
+			for (++column; column < m_columns; ++column) {
+				append_h(columns, boxed, column, m_data, 0, unescaped);
+			}
+		}
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Constructor from data.
+	constexpr
+	Parser(const char* data, ullong len, ullong columns) :
+	m_data(data),
+	m_len(len),
+	m_columns(columns) {}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Parse the rows from an offset.
+	/*  @docs
+		@title: Parse
+		@description:
+			Parse all rows from an offset into columns.
+
+			When `threads` is zero the number of online processors is used, small inputs are always parsed by a single thread.
+
+			By default a column with mixed types is converted to a string column. When `boxed` is defined the cell types are kept instead, a column with mixed types is then stored as a boxed 1D `DataFrame` in `boxed` and its entry in the result is empty.
+	*/
+	Array<Column>	parse(ullong offset, ullong threads = 0, Array<DataFrame>* boxed = nullptr) const {
+
+		// Threads.
+		if (threads == 0) {
+			const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+			threads = cpus > 0 ? (ullong) cpus : 1;
+		}
+		const ullong min_part = 1024 * 1024;
+		if ((m_len - offset) / min_part < threads) {
+			threads = (m_len - offset) / min_part;
+		}
+		if (threads <= 1) {
+			Array<Column> columns;
+			parse_h(offset, m_len, columns, boxed);
+			return columns;
+		}
+
+		// Count the quotes per raw part.
+		const ullong part = (m_len - offset) / threads;
+		Array<ullong> quotes;
+		quotes.fill_r(threads, 0);
+		Array<FThread> workers;
+		workers.resize(threads);
+		for (ullong t = 0; t < threads; ++t) {
+			workers.append(FThread());
+			const ullong start = offset + t * part;
+			const ullong end = t + 1 == threads ? m_len : start + part;
+			workers.m_arr[t].start([](const char* data, ullong len, ullong* count) -> void* {
+				*count = count_quotes_h(data, len);
+				return nullptr;
+			}, m_data + start, end - start, &quotes.m_arr[t]);
+		}
+		for (auto& worker: workers) { worker.join(); }
+
+		// Find the row boundaries.
+		Array<ullong> bounds;
+		bounds.resize(threads + 1);
+		bounds.append(offset);
+		ullong parity = 0;
+		for (ullong t = 1; t < threads; ++t) {
+			parity += quotes.m_arr[t - 1];
+			ullong start = row_start_h(offset + t * part, parity % 2 == 1);
+			if (start < bounds.last()) { start = bounds.last(); }
+			bounds.append(start);
+		}
+		bounds.append(m_len);
+
+		// Parse the parts.
+		Array<Array<Column>> parts;
+		parts.fill_r(threads, Array<Column>());
+		Array<Array<DataFrame>> boxed_parts;
+		boxed_parts.fill_r(threads, Array<DataFrame>());
+		// An exception of a worker, including "std::bad_alloc", is rethrown on the calling thread.
+		Array<std::exception_ptr> errors;
+		errors.fill_r(threads, std::exception_ptr());
+		for (ullong t = 0; t < threads; ++t) {
+			const ullong start = bounds.m_arr[t];
+			const ullong end = bounds.m_arr[t + 1];
+			workers.m_arr[t] = FThread();
+			workers.m_arr[t].start([](const Parser* parser, ullong start, ullong end, Array<Column>* columns, Array<DataFrame>* boxed, std::exception_ptr* error) -> void* {
+				try {
+					parser->parse_h(start, end, *columns, boxed);
+				} catch (...) {
+					*error = std::current_exception();
+				}
+				return nullptr;
+			}, this, start, end, &parts.m_arr[t], boxed == nullptr ? nullptr : &boxed_parts.m_arr[t], &errors.m_arr[t]);
+		}
+		for (auto& worker: workers) { worker.join(); }
+		for (auto& error: errors) {
+			if (error) { std::rethrow_exception(error); }
+		}
+
+		// Concatenate.
+		// - When the cell types are kept, a column that is boxed in any part or has another type per part is concatenated as a boxed column.
+		Array<Column> columns = move(parts.m_arr[0]);
+		if (boxed != nullptr) {
+			*boxed = move(boxed_parts.m_arr[0]);
+		}
+		for (ullong t = 1; t < threads; ++t) {
+			for (ullong i = 0; i < m_columns; ++i) {
+				Column& column = columns.m_arr[i];
+				Column& part = parts.m_arr[t].m_arr[i];
+				if (boxed != nullptr) {
+					DataFrame& boxed_column = boxed->m_arr[i];
+					DataFrame& boxed_part = boxed_parts.m_arr[t].m_arr[i];
+					if (
+						boxed_column.m_type != types::null ||
+						boxed_part.m_type != types::null ||
+						(column.type() != part.type() && column.type() != types::null && part.type() != types::null)
+					) {
+						if (boxed_column.m_type == types::null) {
+							boxed_column = DataFrame(column);
+							column = Column();
+						}
+						if (boxed_part.m_type == types::null) {
+							boxed_part = DataFrame(part);
+						}
+						boxed_column.concat_r(move(boxed_part));
+						continue;
+					}
+				}
+				if (!column.is_compatible(part)) {
+					column.to_str_r();
+					part.to_str_r();
+				}
+				column.concat_r(part);
+			}
+		}
+		return columns;
+	}
+
+};
+
+// ---------------------------------------------------------
+// Load a csv file into columns.
+// - Assigns the dimension line of "DataFrame::save" to "dim", zero when the file is plain csv.
+// - Keeps the cell types when "boxed" is defined, see "Parser::parse".
+inline
+void	load_h(const char* path, ullong threads, short& dim, Array<String>& names, Array<Column>& columns, Array<DataFrame>* boxed = nullptr) {
+	MappedFile file (path);
+	file.advise(vlib::file::sequential);
+	const char* data = file.data();
+	const ullong len = file.len();
+	dim = 0;
+	if (len == 0) {
+		return ;
+	}
+
+	// Get the end and the length of a line.
+	auto line_end = [&](ullong start) {
+		const char* end = (const char*) memchr(data + start, '\n', len - start);
+		return end == nullptr ? len : (ullong) (end - data);
+	};
+	auto line_len = [&](ullong start, ullong end) {
+		return end > start && data[end - 1] == '\r' ? end - start - 1 : end - start;
+	};
+
+	// Dimension line of "DataFrame::save".
+	ullong end = line_end(0);
+	ullong offset = 0;
+	if (line_len(0, end) == 1 && (data[0] == '1' || data[0] == '2')) {
+		dim = data[0] - '0';
+		offset = end + 1;
+	}
+	if (dim == 1) {
+		names.append("0");
+	} else {
+
+		// Header.
+		if (offset > len) { offset = len; }
+		end = line_end(offset);
+		const ullong header_end = offset + line_len(offset, end);
+		ullong field = offset;
+		for (ullong i = offset; i <= header_end; ++i) {
+			if (i == header_end || data[i] == ',') {
+				ullong start = field, stop = i;
+				if (stop > start + 1 && data[start] == '"' && data[stop - 1] == '"') { ++start; --stop; }
+				names.append(String(data + start, stop - start));
+				field = i + 1;
+			}
+		}
+		offset = end + 1;
+	}
+
+	// Parse.
+	if (offset > len) { offset = len; }
+	Parser parser (data, len, names.len());
+	columns = parser.parse(offset, threads, boxed);
+}
+
+// Load a csv file.
+/*  @docs
+	@chapter: Types
+	@title: Load CSV
+	@description:
+		Load a csv file into a columnar table.
+
+		Supports the text format of `DataFrame::save` and plain csv files where the first line contains the column names.
+
+		A column of a `Table` has a single type, so a column with mixed types is converted to a string column, for example a text cell in a numeric column. Use `DataFrame::load` to keep the type of every cell.
+
+		The file is memory mapped and parsed by multiple threads, when `threads` is zero the number of online processors is used.
+	@usage:
+		#include <vlib/types.h>
+		vlib::df::Table x = vlib::df::io::load("/tmp/prices.csv");
+	@funcs: 2
+*/
+inline
+Table	load(const char* path, ullong threads = 0) {
+	short dim;
+	Array<String> names;
+	Array<Column> columns;
+	load_h(path, threads, dim, names, columns);
+	Table table;
+	for (auto& index: names.indexes()) {
+		table.insert(names[index], move(columns[index]));
+	}
+	return table;
+}
+inline
+Table	load(const String& path, ullong threads = 0) {
+	return load(path.c_str(), threads);
+}
+
+// ---------------------------------------------------------
+// Binary column format.
+//
+// Layout:
+// - Header: magic "VDFB", uint32 version, uint64 rows, uint64 columns.
+// - Per column a descriptor: int32 type, uint32 name length, uint64 data offset, uint64 data length, uint64 nulls offset, uint64 nulls length, uint64 dict offset, uint64 dict count, followed by the name.
+// - Per column the data: int64 integers, float64 floats, uint8 booleans or uint32 codes, the null bitmap words and for strings the dictionary as uint32 length + chars.
+// - All sections are aligned to 8 bytes, values are stored in the native byte order.
+// - Floats are stored as 64 bit doubles so the file is portable between platforms with a different "long double".
+//
+
+// Binary format definitions.
+namespace binary {
+inline constexpr char 	magic[4] = {'V', 'D', 'F', 'B'};
+inline constexpr uint 	version = 1;
+struct Header {
+	char		magic[4];
+	uint		version;
+	ullong		rows;
+	ullong		columns;
+};
+struct Descriptor {
+	int			type;
+	uint		name_len;
+	ullong		data_offset;
+	ullong		data_len;
+	ullong		nulls_offset;
+	ullong		nulls_len;
+	ullong		dict_offset;
+	ullong		dict_count;
+};
+};
+
+// ---------------------------------------------------------
+// Binary table.
+//
+// Notes:
+// - The file is memory mapped, a column is only decoded the first time it is accessed.
+// - The numeric data of a column can also be accessed directly from the mapping without decoding.
+//
+/*  @docs
+	@chapter: Types
+	@title: Binary Table
+	@description:
+		Lazily mapped table in the binary column format.
+	@usage:
+		#include <vlib/types.h>
+		vlib::df::io::save_binary(table, "/tmp/prices.vdf");
+		vlib::df::io::BinaryTable x ("/tmp/prices.vdf");
+		const double* close = x.floats("close"); // no copy.
+		const vlib::df::Column& volume = x["volume"]; // decoded on first access.
+*/
+struct BinaryTable {
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	MappedFile						m_file;
+	ullong							m_rows = 0;
+	Array<String>					m_cols;
+	Array<binary::Descriptor>		m_descriptors;
+	Array<Column>					m_cache;
+	Array<bool>						m_cached;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Find a column.
+	constexpr
+	ullong	find_h(const String& column) const {
+		for (ullong i = 0; i < m_cols.m_len; ++i) {
+			if (m_cols.m_arr[i] == column) { return i; }
+		}
+		throw KeyError(to_str("Column \"", column, "\" does not exist."));
+	}
+
+	// Check that a section is inside the file.
+	constexpr
+	void	check_range_h(ullong offset, ullong len) const {
+		if (offset > m_file.len() || len > m_file.len() - offset) {
+			throw ParseError("Invalid binary dataframe file, a section exceeds the file length.");
+		}
+	}
+
+	// Decode a column.
+	Column	decode_h(ullong index) const {
+		const binary::Descriptor& desc = m_descriptors.m_arr[index];
+		const char* data = m_file.data();
+		Column column;
+		column.m_type = (short) desc.type;
+		column.m_len = m_rows;
+		switch (desc.type) {
+			case types::boolean: {
+				const uchar* values = (const uchar*) (data + desc.data_offset);
+				column.m_bools.resize(m_rows);
+				for (ullong i = 0; i < m_rows; ++i) { column.m_bools.m_arr[i] = values[i] != 0; }
+				column.m_bools.m_len = m_rows;
+				break;
+			}
+			case types::integer:
+				column.m_ints.resize(m_rows);
+				memcpy(column.m_ints.m_arr, data + desc.data_offset, m_rows * sizeof(llong));
+				column.m_ints.m_len = m_rows;
+				break;
+			case types::floating: {
+				const double* values = (const double*) (data + desc.data_offset);
+				column.m_floats.resize(m_rows);
+				for (ullong i = 0; i < m_rows; ++i) { column.m_floats.m_arr[i] = (ldouble) values[i]; }
+				column.m_floats.m_len = m_rows;
+				break;
+			}
+			case types::str: {
+				column.m_codes.resize(m_rows);
+				memcpy(column.m_codes.m_arr, data + desc.data_offset, m_rows * sizeof(uint));
+				column.m_codes.m_len = m_rows;
+				column.m_dict_index.enable_index();
+				ullong offset = desc.dict_offset;
+				for (ullong i = 0; i < desc.dict_count; ++i) {
+					uint len;
+					check_range_h(offset, sizeof(uint));
+					memcpy(&len, data + offset, sizeof(uint));
+					offset += sizeof(uint);
+					check_range_h(offset, len);
+					String str (data + offset, len);
+					offset += len;
+					column.m_dict_index.append(str, (uint) i);
+					column.m_dict.append(move(str));
+				}
+				for (ullong i = 0; i < m_rows; ++i) {
+					if (column.m_codes.m_arr[i] >= desc.dict_count) {
+						throw ParseError("Invalid binary dataframe file, a string code exceeds the dictionary.");
+					}
+				}
+				break;
+			}
+			default:
+				break;
+		}
+		if (desc.nulls_len != 0) {
+			const ullong words = desc.nulls_len / sizeof(ullong);
+			column.m_nulls.resize(words);
+			memcpy(column.m_nulls.m_arr, data + desc.nulls_offset, desc.nulls_len);
+			column.m_nulls.m_len = words;
+			for (ullong i = 0; i < words; ++i) {
+				column.m_nulls_count += __builtin_popcountll(column.m_nulls.m_arr[i]);
+			}
+		}
+		return column;
+	}
+
+	// Get the mapped data of a numeric column.
+	template <typename Type> constexpr
+	const Type*	view_h(const String& column, short type) const {
+		const binary::Descriptor& desc = m_descriptors.m_arr[find_h(column)];
+		if (desc.type != type) {
+			throw TypeError(to_str("Column \"", column, "\" has type \"", strtype(desc.type), "\"."));
+		}
+		return (const Type*) (m_file.data() + desc.data_offset);
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Default constructor.
+	constexpr
+	BinaryTable() = default;
+
+	// Constructor from path.
+	BinaryTable(const char* path) {
+		open(path);
+	}
+	BinaryTable(const String& path) {
+		open(path.c_str());
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Open.
+	/*  @docs
+		@title: Open
+		@description:
+			Map a binary dataframe file and read the column descriptors.
+
+			Will throw a `ParseError` when the file is not a valid binary dataframe file.
+	*/
+	void	open(const char* path) {
+		m_file.open(path);
+		m_cols.reset();
+		m_descriptors.reset();
+		m_cache.reset();
+		m_cached.reset();
+		const char* data = m_file.data();
+		binary::Header header;
+		check_range_h(0, sizeof(header));
+		memcpy(&header, data, sizeof(header));
+		if (memcmp(header.magic, binary::magic, 4) != 0 || header.version != binary::version) {
+			throw ParseError(to_str("File \"", path, "\" is not a binary dataframe file."));
+		}
+		m_rows = header.rows;
+		ullong offset = sizeof(header);
+		for (ullong i = 0; i < header.columns; ++i) {
+			binary::Descriptor desc;
+			check_range_h(offset, sizeof(desc));
+			memcpy(&desc, data + offset, sizeof(desc));
+			offset += sizeof(desc);
+			check_range_h(offset, desc.name_len);
+			m_cols.append(String(data + offset, desc.name_len));
+			offset += (desc.name_len + 7) & ~7ULL;
+			ullong width;
+			switch (desc.type) {
+				case types::null: width = 0; break;
+				case types::boolean: width = 1; break;
+				case types::str: width = sizeof(uint); break;
+				default: width = 8; break;
+			}
+			if (desc.data_len != m_rows * width || desc.nulls_len % sizeof(ullong) != 0) {
+				throw ParseError(to_str("File \"", path, "\" has an invalid column descriptor."));
+			}
+			check_range_h(desc.data_offset, desc.data_len);
+			check_range_h(desc.nulls_offset, desc.nulls_len);
+			m_descriptors.append(desc);
+		}
+		m_cache.fill_r(header.columns, Column());
+		m_cached.fill_r(header.columns, false);
+	}
+
+	// Length.
+	/*  @docs
+		@title: Length
+		@description:
+			Get the number of rows.
+	*/
+	constexpr
+	ullong	len() const { return m_rows; }
+
+	// Columns.
+	/*  @docs
+		@title: Columns
+		@description:
+			Get the column names.
+	*/
+	constexpr
+	auto&	columns() const { return m_cols; }
+
+	// Views.
+	/*  @docs
+		@title: Views
+		@description:
+			Get the values of a numeric column directly from the mapping, without decoding.
+
+			Null rows hold a zero value, the pointer is valid as long as the table is alive.
+
+			Will throw a `TypeError` when the column has another type.
+		@funcs: 2
+	*/
+	constexpr
+	const double*	floats(const String& column) const {
+		return view_h<double>(column, types::floating);
+	}
+	constexpr
+	const llong*	ints(const String& column) const {
+		return view_h<llong>(column, types::integer);
+	}
+
+	// Get a column.
+	/*  @docs
+		@title: Operator []
+		@description:
+			Get a column, the column is decoded on the first access.
+
+			Will throw a `KeyError` when the column does not exist.
+	*/
+	const Column&	operator [](const String& column) {
+		const ullong index = find_h(column);
+		if (!m_cached.m_arr[index]) {
+			m_cache.m_arr[index] = decode_h(index);
+			m_cached.m_arr[index] = true;
+		}
+		return m_cache.m_arr[index];
+	}
+
+	// Table.
+	/*  @docs
+		@title: Table
+		@description:
+			Decode all columns into a table.
+	*/
+	Table	table() {
+		Table table;
+		for (auto& column: m_cols) {
+			table.insert(column, operator[](column));
+		}
+		return table;
+	}
+
+	// Save.
+	/*  @docs
+		@title: Save binary
+		@description:
+			Save a table in the binary column format.
+
+			The columns are streamed to the file with a `File::Writer`, the table is never copied into a single buffer.
+	*/
+	static
+	void	save(const Table& table, const char* path) {
+		Path file_path (path);
+		if (file_path.exists()) {
+			file_path.remove();
+		}
+		File file (file_path, vlib::file::mode::write);
+		File::Writer out = file.writer(1024 * 1024, 0);
+		auto align = [&]() {
+			static constexpr char zeros[8] = {0};
+			if (out.offset() % 8 != 0) { out.write(zeros, 8 - out.offset() % 8); }
+		};
+		auto write = [&](const void* data, ullong len) {
+			out.write((const char*) data, len);
+		};
+
+		// Header.
+		binary::Header header;
+		memcpy(header.magic, binary::magic, 4);
+		header.version = binary::version;
+		header.rows = table.len();
+		header.columns = table.columns().len();
+		write(&header, sizeof(header));
+
+		// Reserve the descriptors, they are written once the offsets are known.
+		Array<ullong> desc_offsets;
+		Array<binary::Descriptor> descs;
+		for (auto& name: table.columns()) {
+			desc_offsets.append(out.offset());
+			binary::Descriptor desc {};
+			write(&desc, sizeof(desc));
+			write(name.data(), name.len());
+			align();
+		}
+
+		// Data.
+		// - Converted values are written in blocks through a small buffer.
+		const ullong block = 4096;
+		Array<char> buffer;
+		buffer.resize(block * sizeof(double));
+		for (auto& index: table.columns().indexes()) {
+			const Column& column = table[index];
+			const String& name = table.columns()[index];
+			binary::Descriptor desc {};
+			desc.type = column.type();
+			desc.name_len = (uint) name.len();
+			desc.data_offset = out.offset();
+			switch (column.type()) {
+				case types::boolean: {
+					char* bytes = buffer.data();
+					for (ullong i = 0; i < column.len(); i += block) {
+						const ullong n = column.len() - i < block ? column.len() - i : block;
+						for (ullong j = 0; j < n; ++j) { bytes[j] = column.bools().m_arr[i + j] ? '\1' : '\0'; }
+						write(bytes, n);
+					}
+					break;
+				}
+				case types::integer:
+					write(column.ints().data(), column.len() * sizeof(llong));
+					break;
+				case types::floating: {
+					double* values = (double*) buffer.data();
+					for (ullong i = 0; i < column.len(); i += block) {
+						const ullong n = column.len() - i < block ? column.len() - i : block;
+						for (ullong j = 0; j < n; ++j) { values[j] = (double) column.floats().m_arr[i + j]; }
+						write(values, n * sizeof(double));
+					}
+					break;
+				}
+				case types::str:
+					write(column.codes().data(), column.len() * sizeof(uint));
+					break;
+				default:
+					break;
+			}
+			desc.data_len = out.offset() - desc.data_offset;
+			align();
+			desc.nulls_offset = out.offset();
+			if (column.nulls() != 0) {
+				for (ullong word = 0; word < (column.len() + 63) / 64; ++word) {
+					ullong bits = 0;
+					for (ullong bit = 0; bit < 64 && word * 64 + bit < column.len(); ++bit) {
+						if (column.is_null(word * 64 + bit)) { bits |= 1ULL << bit; }
+					}
+					write(&bits, sizeof(bits));
+				}
+			}
+			desc.nulls_len = out.offset() - desc.nulls_offset;
+			desc.dict_offset = out.offset();
+			if (column.type() == types::str) {
+				desc.dict_count = column.dict().len();
+				for (auto& str: column.dict()) {
+					const uint len = (uint) str.len();
+					write(&len, sizeof(len));
+					write(str.data(), str.len());
+				}
+				align();
+			}
+			descs.append(desc);
+		}
+		out.close();
+		for (auto& index: descs.indexes()) {
+			file.pwrite((const char*) &descs[index], sizeof(binary::Descriptor), desc_offsets[index]);
+		}
+		file.close();
+	}
+
+};
+
+// Save a table in the binary column format.
+/*  @docs
+	@chapter: Types
+	@title: Save binary
+	@description:
+		Save a table in the binary column format, see `vlib::df::io::BinaryTable`.
+*/
+inline
+void	save_binary(const Table& table, const char* path) {
+	BinaryTable::save(table, path);
+}
+inline
+void	save_binary(const Table& table, const String& path) {
+	BinaryTable::save(table, path.c_str());
+}
+
+}; 		// End namespace io.
+}; 		// End namespace df.
+
+// ---------------------------------------------------------
+// DataFrame load function.
+
+// Define the "DataFrame::load" function.
+inline
+DataFrame	DataFrame::load(const char* path) {
+	short dim;
+	Array<String> names;
+	Array<df::Column> columns;
+	Array<DataFrame> boxed;
+	df::io::load_h(path, 0, dim, names, columns, &boxed);
+
+	// A column with mixed types is already boxed.
+	auto column = [&](ullong index) {
+		if (boxed[index].m_type != df::types::null) {
+			return move(boxed[index]);
+		}
+		return DataFrame(columns[index]);
+	};
+	switch (dim) {
+		case 1:
+			return column(0);
+		case 2: {
+			DataFrame df;
+			df.init(df::types::df, 2);
+			df.m_vals->resize(names.len());
+			for (auto& index: names.indexes()) {
+				df.m_vals->append(column(index));
+			}
+			*df.m_cols = move(names);
+			return df;
+		}
+		default:
+			throw ParseError(to_str("Unable to parse file \"", path, "\"."));
+	}
+}
+
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -0,0 +1,185 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_DF_ROLLING_T_H
+#define VLIB_DF_ROLLING_T_H
+
+// Includes.
+#include <math.h> // for sqrt.
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace df.
+namespace df {
+
+// ---------------------------------------------------------
+// Rolling window kernels.
+//
+// Notes:
+// - Every kernel is O(n) regardless of the window, the window is updated with the value that enters and the value that leaves.
+// - The kernels only write "out[i]" for "i >= window - 1", the caller decides what the leading rows contain.
+// - Floating sums are compensated (Kahan) so the running sum does not drift over long series.
+// - The standard deviation uses the sliding window variant of Welford's algorithm.
+//
+/*  @docs
+	@chapter: Types
+	@title: Rolling
+	@description:
+		Rolling window kernels over contiguous numeric buffers.
+	@usage:
+		#include <vlib/types.h>
+		double data[5] = {1, 2, 3, 4, 5};
+		double out[5];
+		vlib::df::rolling::mean(data, 5, 2, out); // out ==> {?, 1.5, 2.5, 3.5, 4.5}
+*/
+namespace rolling {
+
+// Square root of any floating type.
+template <typename Type> inline
+Type	sqrt_h(Type x) {
+	if constexpr (std::is_same<Type, float>::value) { return sqrtf(x); }
+	else if constexpr (std::is_same<Type, double>::value) { return sqrt(x); }
+	else { return sqrtl(x); }
+}
+
+// Rolling sum.
+/*  @docs
+	@title: Sum
+	@description:
+		Calculate the rolling sum.
+*/
+template <typename Type> inline
+void	sum(const Type* data, ullong len, ullong window, Type* out) {
+	if (window == 0 || window > len) { return ; }
+	Type sum = 0, comp = 0;
+	for (ullong i = 0; i < window; ++i) {
+		if constexpr (is_floating<Type>::value) {
+			const Type y = data[i] - comp;
+			const Type t = sum + y;
+			comp = (t - sum) - y;
+			sum = t;
+		} else {
+			sum += data[i];
+		}
+	}
+	out[window - 1] = sum;
+	for (ullong i = window; i < len; ++i) {
+		const Type diff = data[i] - data[i - window];
+		if constexpr (is_floating<Type>::value) {
+			const Type y = diff - comp;
+			const Type t = sum + y;
+			comp = (t - sum) - y;
+			sum = t;
+		} else {
+			sum += diff;
+		}
+		out[i] = sum;
+	}
+}
+
+// Rolling mean.
+/*  @docs
+	@title: Mean
+	@description:
+		Calculate the rolling mean.
+*/
+template <typename Type> inline
+void	mean(const Type* data, ullong len, ullong window, Type* out) {
+	if (window == 0 || window > len) { return ; }
+	sum(data, len, window, out);
+	const Type inv = (Type) 1 / (Type) window;
+	for (ullong i = window - 1; i < len; ++i) {
+		out[i] *= inv;
+	}
+}
+
+// Rolling standard deviation.
+/*  @docs
+	@title: Standard deviation
+	@description:
+		Calculate the rolling standard deviation.
+
+		The default `ddof` of 1 calculates the sample standard deviation.
+*/
+template <typename Type> inline
+void	std(const Type* data, ullong len, ullong window, Type* out, ullong ddof = 1) {
+	if (window == 0 || window > len) { return ; }
+	if (window <= ddof) {
+		for (ullong i = window - 1; i < len; ++i) { out[i] = NAN; }
+		return ;
+	}
+
+	// First window.
+	Type mean = 0, m2 = 0;
+	for (ullong i = 0; i < window; ++i) {
+		const Type delta = data[i] - mean;
+		mean += delta / (Type) (i + 1);
+		m2 += delta * (data[i] - mean);
+	}
+	const Type inv = (Type) 1 / (Type) window;
+	const Type inv_ddof = (Type) 1 / (Type) (window - ddof);
+	out[window - 1] = sqrt_h<Type>(m2 * inv_ddof);
+
+	// Slide.
+	for (ullong i = window; i < len; ++i) {
+		const Type diff = data[i] - data[i - window];
+		const Type old_mean = mean;
+		mean += diff * inv;
+		m2 += diff * (data[i] + data[i - window] - mean - old_mean);
+		if (m2 < 0) { m2 = 0; }
+		out[i] = sqrt_h<Type>(m2 * inv_ddof);
+	}
+}
+
+// Rolling min and max.
+// - Uses a monotonic deque of indexes stored in a ring buffer with the size of the window.
+template <bool Max, typename Type> inline
+void	extreme_h(const Type* data, ullong len, ullong window, Type* out) {
+	if (window == 0 || window > len) { return ; }
+	Array<ullong> ring;
+	ring.resize(window);
+	ullong* deque = ring.data();
+	ullong head = 0, tail = 0; // the deque contains the ring positions "head" until "tail".
+	for (ullong i = 0; i < len; ++i) {
+		if (tail > head && deque[head % window] + window <= i) {
+			++head;
+		}
+		while (tail > head && (Max ? data[deque[(tail - 1) % window]] <= data[i] : data[deque[(tail - 1) % window]] >= data[i])) {
+			--tail;
+		}
+		deque[tail % window] = i;
+		++tail;
+		if (i + 1 >= window) {
+			out[i] = data[deque[head % window]];
+		}
+	}
+}
+
+// Rolling min.
+/*  @docs
+	@title: Min
+	@description:
+		Calculate the rolling min.
+*/
+template <typename Type> inline
+void	min(const Type* data, ullong len, ullong window, Type* out) {
+	extreme_h<false>(data, len, window, out);
+}
+
+// Rolling max.
+/*  @docs
+	@title: Max
+	@description:
+		Calculate the rolling max.
+*/
+template <typename Type> inline
+void	max(const Type* data, ullong len, ullong window, Type* out) {
+	extreme_h<true>(data, len, window, out);
+}
+
+}; 		// End namespace rolling.
+}; 		// End namespace df.
+}; 		// End namespace vlib.
+#endif 	// End header.
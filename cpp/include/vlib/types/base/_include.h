@@ -17,5 +17,8 @@
 #include "pair.h"
 #include "dict.h"
 #include "json.h"
+#include "json_parser.h"
+#include "json_reader.h"
+#include "json_writer.h"
 #include "stream.h"
 #include "pack.h"
@@ -61,6 +61,8 @@ static inline bool  zero_padding = 		true;
  *		Dynamic string.
  *
  *		`String` is a type definition of `Array<char>` so some documented functions may describe the `Array` object. These documented functions are exactly the same for `String`.
+ *
+ *		Strings of up to 27 characters are stored in an inline buffer without a heap allocation. Like `std::string`, moving such a string invalidates pointers to its data.
  *	@template:
  *		@name: Type
  *		@ignore: true
@@ -102,11 +104,99 @@ struct Array {
 	Type* 			m_arr;				// the array.
 	Length 			m_len; 				// the arrays length.
 	Length	 		m_capacity;		// the arrays allocated length.
-	uint			m_increaser = 4;	// the expand increaser.
+	float			m_increaser = array_h::growth;	// the expand growth factor.
+
+	// Small string optimization.
+	// - Strings up to "sso_len" chars are stored in an inline buffer, "m_arr" then points to "m_sso.arr".
+	// - The inline buffer fills the padding of the attributes above, so a String is 56 bytes.
+	// - Pointers to the data of an inline string are invalidated when the string is moved.
+	SICEBOOL		sso = is_char<Type>::value;
+	SICE Length 	sso_len = 27;
+	struct sso_t { Type arr[sso_len + 1]; };
+	struct no_sso_t {};
+	[[no_unique_address]]
+	typename std::conditional<sso, sso_t, no_sso_t>::type m_sso;
 
 	// ---------------------------------------------------------
 	// Wrappers.
 
+	// Is the data stored in the inline buffer.
+	constexpr
+	bool	is_inline_h() const {
+		if constexpr (sso) {
+			return m_arr == m_sso.arr;
+		} else {
+			return false;
+		}
+	}
+
+	// Allocate the data of an empty array, short strings use the inline buffer.
+	constexpr
+	void	alloc_h(const Length capacity) {
+		if constexpr (sso) {
+			if (capacity <= sso_len) {
+				m_arr = m_sso.arr;
+				m_capacity = sso_len;
+				return ;
+			}
+		}
+		array_h::alloc(m_arr, capacity);
+		m_capacity = capacity;
+	}
+
+	// Move the data of an inline string to the heap.
+	constexpr
+	void	move_to_heap_h(const Length capacity) {
+		Type* arr = array_h::alloc(capacity);
+		array_h::copy(arr, m_arr, m_len);
+		m_arr = arr;
+		m_capacity = capacity;
+	}
+
+	// Release the data.
+	constexpr
+	void	free_h() {
+		if (is_inline_h()) {
+			m_arr = nullptr;
+		} else {
+			array_h::destruct(m_arr);
+		}
+	}
+
+	// Take the data of another array, the other array is left empty.
+	constexpr
+	void	take_h(This& obj) {
+		if constexpr (sso) {
+			if (obj.is_inline_h()) {
+				m_arr = m_sso.arr;
+				array_h::copy(m_arr, obj.m_arr, obj.m_len + 1);
+			} else {
+				m_arr = obj.m_arr;
+			}
+		} else {
+			m_arr = obj.m_arr;
+		}
+		m_len = obj.m_len;
+		m_capacity = obj.m_capacity;
+		obj.m_arr = nullptr;
+		obj.m_len = 0;
+		obj.m_capacity = 0;
+	}
+
+	// Copy an array.
+	constexpr
+	void	copy_h(const Type* arr, const Length len, const Length capacity) {
+		if constexpr (sso) {
+			if (m_arr == arr) { return ; }
+			resize(len <= sso_len ? len : capacity);
+			m_len = len;
+			array_h::copy(m_arr, arr, m_len);
+			null_terminate_safe_h();
+		} else {
+			array_h::copy(m_arr, m_len, m_capacity, arr, len, capacity);
+		}
+	}
+
 	// Shift the array 1 pos to the right.
 	// DEPRECATED
 	constexpr
@@ -229,7 +319,7 @@ struct Array {
 	// - Mainly for `Path` etc.
 	constexpr
 	This& 	reconstruct(const This& obj) {
-		array_h::copy(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		copy_h(obj.m_arr, obj.m_len, obj.m_capacity);
 		return *this;
 	}
 
@@ -244,14 +334,14 @@ struct Array {
 	// Copy array.
 	constexpr
 	This& 	copy(const Type*& arr, const Length len, const Length capacity) {
-		array_h::copy(m_arr, m_len, m_capacity, arr, len, capacity);
+		copy_h(arr, len, capacity);
 		return *this;
 	}
 
 	// Copy.
 	constexpr
 	This& 	copy(const This& obj) {
-		array_h::copy(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		copy_h(obj.m_arr, obj.m_len, obj.m_capacity);
 		return *this;
 	}
 
@@ -266,25 +356,30 @@ struct Array {
 	}
 
 	// Swap array.
+	// - The array must be allocated with "array_h::alloc()".
 	constexpr
 	This& 	swap(Type*&	arr, const Length len, const Length capacity) {
-		array_h::swap(m_arr, m_len, m_capacity, arr, len, capacity);
+		free_h();
+		m_arr = arr;
+		m_len = len;
+		m_capacity = capacity;
+		arr = nullptr;
 		return *this;
 	}
 
 	// Swap.
 	constexpr
 	This& 	swap(This& obj) {
-		array_h::swap(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
-		obj.m_len = 0;
-		obj.m_capacity = 0;
+		if (this == &obj) { return *this; }
+		free_h();
+		take_h(obj);
 		return *this;
 	}
 
 	// Swap with CString / Pipe.
 	template <typename Array> requires (is_char<Type>::value && (is_Pipe<Array>::value || internal::is_BaseArray<Array>::value)) constexpr
 	This& 	swap(Array&	obj) {
-		delete[] m_arr;
+		free_h();
 		m_arr = obj.m_arr;
 		m_len = obj.m_len;
 		m_capacity = obj.m_capacity;
@@ -297,7 +392,7 @@ struct Array {
 	// Safely destruct the array.
 	constexpr
 	This& 	destruct() {
-		array_h::destruct(m_arr);
+		free_h();
 		m_len = 0;
 		m_capacity = 0;
 		return *this;
@@ -334,7 +429,7 @@ struct Array {
 	m_capacity(capacity)
 	{
 		if (arr) {
-			array_h::alloc(m_arr, capacity);
+			alloc_h(capacity);
 			array_h::copy(m_arr, arr, m_len);
 			null_terminate_safe_h();
 		}
@@ -348,7 +443,7 @@ struct Array {
 	m_capacity(len)
 	{
 		if (arr) {
-			array_h::alloc(m_arr, len);
+			alloc_h(len);
 			array_h::copy(m_arr, arr, m_len);
 			null_terminate_safe_h();
 		}
@@ -369,7 +464,7 @@ struct Array {
 	m_len(0),
 	m_capacity(x.size())
 	{
-		array_h::alloc(m_arr, x.size());
+		alloc_h(x.size());
 		for (auto& i: x) {
 			m_arr[m_len] = i;
 			++m_len;
@@ -382,7 +477,7 @@ struct Array {
 	m_len(0),
 	m_capacity(x.size())
 	{
-		array_h::alloc(m_arr, x.size());
+		alloc_h(x.size());
 		for (auto& i: x) {
 			m_arr[m_len] = move(i);
 			++m_len;
@@ -439,7 +534,7 @@ struct Array {
 	m_capacity(obj.m_capacity)
 	{
 		if (obj.m_arr) {
-			array_h::alloc(m_arr, m_capacity);
+			alloc_h(sso && m_len <= sso_len ? m_len : m_capacity);
 			array_h::copy(m_arr, obj.m_arr, m_len);
 			array_h::null_terminate(m_arr, m_len, m_capacity);
 		}
@@ -453,7 +548,7 @@ struct Array {
 	m_capacity(obj.capacity())
 	{
 		if (obj.data()) {
-			array_h::alloc(m_arr, m_len);
+			alloc_h(m_len);
 			array_h::copy(m_arr, obj.data(), m_len);
 			null_terminate_safe_h();
 		}
@@ -462,13 +557,11 @@ struct Array {
 	// Move constructor.
 	constexpr
 	Array (This&& obj) :
-	m_arr(obj.m_arr),
-	m_len(obj.m_len),
-	m_capacity(obj.m_capacity)
+	m_arr(nullptr),
+	m_len(0),
+	m_capacity(0)
 	{
-		obj.m_arr = nullptr;
-		obj.m_len = 0;
-		obj.m_capacity = 0;
+		take_h(obj);
 	}
 
 	// Move constructor from CString / Pipe.
@@ -487,7 +580,7 @@ struct Array {
 	// Destructor.
 	constexpr
 	~Array () {
-		delete[] m_arr;
+		free_h();
 	}
 
 	// ---------------------------------------------------------
@@ -575,6 +668,25 @@ struct Array {
 		return m_capacity;
 	}
 
+	// Growth factor.
+	/*  @docs
+		@title: Increaser
+		@type: float&
+		@description:
+			Get the growth factor of the capacity when the array expands, the default is `1.5`.
+		@usage:
+			String x;
+			x.increaser() = 2;
+	*/
+	constexpr
+	auto& 	increaser() {
+		return m_increaser;
+	}
+	constexpr
+	auto& 	increaser() const {
+		return m_increaser;
+	}
+
 	// Data.
 	// - Warning: the array's data may contain garbage items, use it in combiation with "len()" to avoid garbage items.
 	/*  @docs
@@ -821,6 +933,15 @@ struct Array {
 	*/
 	constexpr
 	This&	resize(const Length req_len = 1) {
+		if constexpr (sso) {
+			if (m_arr == nullptr) {
+				alloc_h(req_len);
+				return *this;
+			} else if (is_inline_h()) {
+				if (req_len > m_capacity) { move_to_heap_h(req_len); }
+				return *this;
+			}
+		}
 		if (array_h::resize(m_arr, m_len, m_capacity, req_len) < 0) {
 			throw AllocError("The allocated length has already reached the maximum size.");
 		}
@@ -841,6 +962,19 @@ struct Array {
 	*/
 	constexpr
 	This&	expand(const Length with_len) {
+		if constexpr (sso) {
+			if (m_arr == nullptr) {
+				alloc_h(with_len);
+				return *this;
+			} else if (is_inline_h()) {
+				if (m_len + with_len > m_capacity) {
+					Length capacity = (Length) ((double) m_capacity * m_increaser) + 1;
+					if (capacity < m_len + with_len) { capacity = m_len + with_len; }
+					move_to_heap_h(capacity);
+				}
+				return *this;
+			}
+		}
 		if (array_h::expand(m_arr, m_len, m_capacity, with_len, m_increaser) < 0) {
 			throw AllocError("The allocated length has already reached the maximum size.");
 		}
@@ -1378,6 +1512,13 @@ struct Array {
 	) constexpr
 	ullong 	find(const Type& to_find, Args&&... args) const {
 		if (m_len == 0) { return internal::npos; } // due to garbage items.
+		if constexpr (is_char<Type>::value && is_Forwards<Iter>::value) {
+			auto iter = indexes<Iter>(args...);
+			const Length eindex = iter.max() > m_len ? m_len : iter.max();
+			if (iter.min() >= eindex) { return internal::npos; }
+			const Type* pos = (const Type*) memchr(m_arr + iter.min(), to_find, eindex - iter.min());
+			return pos == nullptr ? internal::npos : pos - m_arr;
+		}
 		for (auto& i: indexes<Iter>(args...)) {
 			if (m_arr[i] == to_find) { return i; }
 		}
@@ -1436,10 +1577,11 @@ struct Array {
 	) const {
 		const Length len = vlib::len(to_find);
 		if (m_len == 0) { return internal::npos; } // due to garbage items.
+		if (len == 1) { return find<Iter>(to_find[0], args...); }
+		bool chars[256] = {false};
+		for (auto& i1: Range<Forwards>(0, len)) { chars[(uchar) to_find[i1]] = true; }
 		for (auto& i0: indexes<Iter>(args...)) {
-			for (auto& i1: Range<Forwards>(0, len)) {
-				if (m_arr[i0] == to_find[i1]) { return i0; }
-			}
+			if (chars[(uchar) m_arr[i0]]) { return i0; }
 		}
 		return internal::npos;
 	}
@@ -1481,7 +1623,6 @@ struct Array {
     }
 	
 	// Find the index of a substring.
-	// @TODO create a single func with len, and another func with len, sindex, eindex = internal::npos so you can provide a len for the to_find.
 	/*  @docs
 	 *	@parent: vlib::String
 	 *	@title: Find substring
@@ -1489,6 +1630,8 @@ struct Array {
 	 *		Find the index of the first occurence of substring.
 	 *
 	 *		Returns `NPos::npos` when the substring is not found.
+	 *
+	 *		The search is vectorized, see `vlib::searching::find`.
 	 *	@usage:
 	 *		String x = "12A3B4";
 	 *		x.find("A3");
@@ -1499,23 +1642,9 @@ struct Array {
 	) constexpr
 	auto 	find(
 		const char*			to_find,			// the substr to find.
-		// const Length		len, 				// the length of the array with chars to find.
 		Args&&... 			args 				// the arguments for "indexes()".
 	) const {
-		Length len = vlib::len(to_find);
-		if (len > m_len) { return internal::npos; } // due to garbage items.
-		const Type* str = m_arr;
-		auto iter = indexes<Iter>(args...);
-		str += iter.min();
-		// Length index = 0, max_index = m_len - len;
-		for (auto& i: iter) {
-			// if (index > max_index) { return NPos::npos; }
-			// else
-			if (eq(str, len, to_find, len)) { return i; }
-			++str;
-			// ++index;
-		}
-		return internal::npos;
+		return find_h<Iter>(to_find, vlib::len(to_find), args...);
 	}
 	template <typename Iter = Forwards, typename... Args> requires (
 		is_char<Type>::value &&
@@ -1525,19 +1654,37 @@ struct Array {
 		const This&			to_find,			// the substr to find.
 		Args&&... 			args 				// the arguments for "indexes()".
 	) const {
-		if (to_find.m_len > m_len) { return internal::npos; } // due to garbage items.
-		const Type* str = m_arr;
+		return find_h<Iter>(to_find.m_arr, to_find.m_len, args...);
+	}
+	template <typename Iter = Forwards, typename... Args> requires (
+		is_char<Type>::value &&
+		(is_Forwards<Iter>::value || is_Backwards<Iter>::value)
+	) constexpr
+	auto 	find(
+		const CString&		to_find,			// the substr to find.
+		Args&&... 			args 				// the arguments for "indexes()".
+	) const {
+		return find_h<Iter>(to_find.data(), to_find.len(), args...);
+	}
+
+	// Find a substring that starts inside the range of "indexes(args...)".
+	// - The match may end after the range but not after the array.
+	template <typename Iter, typename... Args> constexpr
+	ullong 	find_h(const Type* to_find, const Length nfind, Args&&... args) const requires (is_char<Type>::value) {
+		if (nfind > m_len) { return internal::npos; } // due to garbage items.
 		auto iter = indexes<Iter>(args...);
-		str += iter.min();
-		// Length index = 0, max_index = m_len - to_find.m_len;
-		for (auto& i: iter) {
-			// if (index > max_index) { return NPos::npos; }
-			// else
-			if (eq(str, to_find.m_len, to_find.m_arr, to_find.m_len)) { return i; }
-			++str;
-			// ++index;
+		const Length sindex = iter.min();
+		const Length eindex = iter.max() > m_len ? m_len : iter.max();
+		if (sindex >= eindex) { return internal::npos; }
+		if (nfind == 0) { return is_Forwards<Iter>::value ? sindex : eindex - 1; }
+		const Length end = eindex + nfind - 1 > m_len ? m_len : eindex + nfind - 1;
+		ullong pos;
+		if constexpr (is_Forwards<Iter>::value) {
+			pos = searching::find(m_arr + sindex, end - sindex, to_find, nfind);
+		} else {
+			pos = searching::rfind(m_arr + sindex, end - sindex, to_find, nfind);
 		}
-		return internal::npos;
+		return pos == internal::npos ? internal::npos : sindex + pos;
 	}
 
 	// Find the index of the first occurence of one of the CString's.
@@ -1548,6 +1695,8 @@ struct Array {
 	 *		Find the index of the first occurence of one of the substrings.
 	 *
 	 *		Returns `NPos::npos` when the substring is not found.
+	 *
+	 *		All substrings are searched in a single pass, see `vlib::searching::find_first`.
 	 *	@warning:
 	 *		the array must be initialized inside the function call, otherwise the CString's will be dangling.
 	 *	@usage:
@@ -1562,24 +1711,29 @@ struct Array {
 		const Array<const char*>& 	to_find, 	    // the array with substrings to find.
 		Args&&...						args		// the arguments for "indexes()".
 	) const {
-		const Type* str = m_arr;
 		auto iter0 = indexes<Iter>(args...);
-		str += iter0.min();
-		Length* lens = new Length [to_find.m_len];
-		for (auto& i1: to_find.indexes<Forwards>()) {
-			lens[i1] = vlib::len(to_find[i1]);
-		}
-		for (auto& i0: iter0) {
+		const Length sindex = iter0.min();
+		const Length eindex = iter0.max() > m_len ? m_len : iter0.max();
+		if (sindex >= eindex) { return internal::npos; }
+		if constexpr (is_Forwards<Iter>::value) {
+			Length max_len = 1;
 			for (auto& i1: to_find.indexes<Forwards>()) {
-				if (eq(str, lens[i1], to_find.m_arr[i1], lens[i1])) {
-					delete[] lens;
-					return i0;
+				const Length len = vlib::len(to_find.m_arr[i1]);
+				if (len > max_len) { max_len = len; }
+			}
+			const Length end = eindex + max_len - 1 > m_len ? m_len : eindex + max_len - 1;
+			const ullong pos = searching::find_first(m_arr + sindex, end - sindex, to_find.m_arr, to_find.m_len);
+			return pos == internal::npos || pos >= eindex - sindex ? internal::npos : sindex + pos;
+		} else {
+			for (auto& i0: iter0) {
+				for (auto& i1: to_find.indexes<Forwards>()) {
+					if (searching::internal::starts_with_h(m_arr + i0, m_len - i0, to_find.m_arr[i1])) {
+						return i0;
+					}
 				}
 			}
-			++str;
+			return internal::npos;
 		}
-		delete[] lens;
-		return internal::npos;
 	}
 	
 	// Contains an item.
@@ -1695,8 +1849,7 @@ struct Array {
 		if (from == to) { return *this; }
 		if (to == Type()) {
 			This obj;
-			obj.m_capacity = m_len;
-			array_h::alloc(obj.m_arr, m_len);
+			obj.alloc_h(m_len);
 			for (auto& i: iterate(args...)) {
 				if (i != from) { obj.set(obj.m_len, i); }
 			}
@@ -1758,7 +1911,8 @@ struct Array {
 	 *	@usage:
 	 *		String x = "Hello Universe!";
 	 *		x.replace_r("Universe", "World"); x ==> "Hello World!";
-	 *	@funcs: 4
+	 *		x.replace_r(CString("World"), CString("Earth")); x ==> "Hello Earth!";
+	 *	@funcs: 6
 	*/
 	constexpr
 	This& 	replace_r(
@@ -1775,6 +1929,25 @@ struct Array {
 			sindex,
 			eindex);
 	}
+	template <typename From, typename To> requires (
+		is_char<Type>::value &&
+		is_CString<From>::value &&
+		is_CString<To>::value
+	) constexpr
+	This& 	replace_r(
+		const From&			from,					// the from view.
+		const To&			to,						// the to view.
+		const Length 		sindex = 0,				// the start index.
+		const Length 		eindex = internal::npos	// the end index.
+	) {
+		return replace_r(
+			from.data(),
+			from.len(),
+			to.data(),
+			to.len(),
+			sindex,
+			eindex);
+	}
 	constexpr
 	This& 	replace_r(
 		const Type*			from,					// the from item.
@@ -1814,20 +1987,73 @@ struct Array {
 		}
 
 		// normal replace_r.
+		// - The occurences are located with "searching::find" in a single pass over the array.
+		// - When "to" does not contain "from" the search continues at the start of the inserted "to", so "//" is also replaced in "////".
+		//   Since "to" itself can not contain a match, only the matches that start in "to" and end in the remainder are checked.
+		// - The end index applies to the start of a match in the resulting array.
 		else {
-			String sto;
-			sto.data() = (char*) to;
-			sto.len() = nto;
-			bool add_nto = sto.contains(from, nfrom);
-			sto.data() = nullptr;
-			Length si = sindex;
-			while (si < eindex && (si = find(from, si, eindex)) != NPos::npos) {
-				replace_h(si, si + nfrom, to, nto);
+			if (nfrom == 0) { return *this; }
+			const Length end = eindex;
+			Length rpos = sindex > m_len ? m_len : sindex;
+			const ullong first = searching::find(m_arr + rpos, m_len - rpos, from, nfrom);
+			if (first == internal::npos || rpos + first >= end) { return *this; }
+			const bool add_nto = searching::find(to, nto, from, nfrom) != internal::npos;
+
+			// Overwrite in place when the length does not change and the arguments do not point into the array.
+			const bool aliased = (to + nto > m_arr && to < m_arr + m_len) || (from + nfrom > m_arr && from < m_arr + m_len);
+			if (nfrom == nto && !aliased) {
+				Length pos = rpos + first;
+				while (true) {
+					array_h::copy(m_arr + pos, to, nto);
+					rpos = add_nto ? pos + nfrom : pos;
+					if (rpos >= end || rpos >= m_len) { break; }
+					const ullong next = searching::find(m_arr + rpos, m_len - rpos, from, nfrom);
+					if (next == internal::npos || rpos + next >= end) { break; }
+					pos = rpos + next;
+				}
+				return *this;
+			}
+
+			// Build the result in a new buffer.
+			This x;
+			x.expand(nto > nfrom ? m_len + (nto - nfrom) * 4 : m_len);
+			x.concat_r(m_arr, rpos);
+			This joint;
+			Length resume = internal::npos;
+			ullong next = first;
+			while (true) {
+
+				// Matches that start in the last inserted "to" and end in the remainder.
+				if (resume != internal::npos) {
+					const Length keep = x.m_len - resume < nfrom - 1 ? x.m_len - resume : nfrom - 1;
+					const Length head = m_len - rpos < nfrom - 1 ? m_len - rpos : nfrom - 1;
+					joint.m_len = 0;
+					joint.concat_r(x.m_arr + x.m_len - keep, keep);
+					joint.concat_r(m_arr + rpos, head);
+					const ullong pos = searching::find(joint.m_arr, joint.m_len, from, nfrom);
+					if (pos != internal::npos && x.m_len - keep + pos < end) {
+						resume = x.m_len - keep + pos;
+						rpos += nfrom - (x.m_len - resume);
+						x.m_len = resume;
+						x.concat_r(to, nto);
+						continue;
+					}
+					resume = internal::npos;
+					next = rpos >= m_len ? internal::npos : searching::find(m_arr + rpos, m_len - rpos, from, nfrom);
+				}
+
+				// Matches in the remainder.
+				if (next == internal::npos || x.m_len + next >= end) { break; }
+				x.concat_r(m_arr + rpos, next);
+				rpos += next + nfrom;
+				if (!add_nto) { resume = x.m_len; }
+				x.concat_r(to, nto);
 				if (add_nto) {
-					si += nto;
+					next = rpos >= m_len ? internal::npos : searching::find(m_arr + rpos, m_len - rpos, from, nfrom);
 				}
 			}
-			return *this;
+			x.concat_r(m_arr + rpos, m_len - rpos);
+			return swap(x);
 		}
 	}
 	constexpr
@@ -1845,6 +2071,25 @@ struct Array {
 			sindex,
 			eindex);
 	}
+	template <typename From, typename To> requires (
+		is_char<Type>::value &&
+		is_CString<From>::value &&
+		is_CString<To>::value
+	) constexpr
+	This 	replace(
+		const From&			from,					// the from view.
+		const To&			to,						// the to view.
+		const Length 		sindex = 0,				// the start index.
+		const Length 		eindex = internal::npos	// the end index.
+	) const {
+		return copy().replace_r(
+			from.data(),
+			from.len(),
+			to.data(),
+			to.len(),
+			sindex,
+			eindex);
+	}
 	constexpr
 	This 	replace(
 		const Type*			from,					// the from item.
@@ -1988,8 +2233,7 @@ struct Array {
 			));
 		}
 		obj.m_len = (eindex - sindex);
-		obj.m_capacity = obj.m_len;
-		array_h::alloc(obj.m_arr, obj.m_len);
+		obj.alloc_h(obj.m_len);
 		array_h::copy(obj.m_arr, m_arr + sindex, obj.m_len);
 		return obj;
 	}
@@ -2105,95 +2349,205 @@ struct Array {
 	*/
 	constexpr
 	Array<String> 	split(const Type* delimiter) const requires (is_char<Type>::value) {
-		Length ndelimiter = vlib::len(delimiter);
+		const Length ndelimiter = vlib::len(delimiter);
 		Array<This> splitted;
-		Length pos = 0;
-		Length lpos = internal::npos;
-		bool run = true;
-		while (run) {
-			pos = find(delimiter, pos);
-			if (pos == internal::npos) {
-				pos = m_len;
-				run = false;
-			}
-			if (lpos == internal::npos) {
-				lpos = 0;
-			}
+		Length lpos = 0;
+		while (true) {
+			ullong pos = ndelimiter == 0 ? internal::npos : searching::find(m_arr + lpos, m_len - lpos, delimiter, ndelimiter);
+			pos = pos == internal::npos ? m_len : lpos + pos;
 			This str;
 			str.m_len = pos - lpos;
-			str.m_capacity = str.m_len;
-			array_h::alloc(str.m_arr, str.m_len);
+			str.alloc_h(str.m_len);
 			array_h::copy(str.m_arr, m_arr + lpos, pos - lpos);
 			splitted.append(move(str));
-			pos += ndelimiter;
-			lpos = pos;
+			if (pos == m_len) { break; }
+			lpos = pos + ndelimiter;
 		}
 		return splitted;
 	}
 
+	// View.
+	/*  @docs
+	 *	@parent: vlib::String
+	 *	@title: View
+	 *	@description:
+	 *		Get a non-owning `CString` view of the string or of a part of the string, nothing is copied.
+	 *	@warning:
+	 *		The view is invalidated when the string is modified or destructed.
+	 *	@usage:
+	 *		String x = "Hello World!";
+	 *		x.view(6, 11) ==> "World";
+	 *	@funcs: 2
+	*/
+	constexpr
+	CString 	view() const requires (is_char<Type>::value) {
+		return CString(m_arr, m_len);
+	}
+	constexpr
+	CString 	view(const Length sindex, const Length eindex = internal::npos) const requires (is_char<Type>::value) {
+		return CString(m_arr, m_len).slice(sindex, eindex);
+	}
+
+	// Split by delimiter without allocating.
+	/*  @docs
+	 *	@parent: vlib::String
+	 *	@title: Split view
+	 *	@description:
+	 *		Split the string lazily by a delimiter, each part is yielded as a `CString` view.
+	 *
+	 *		Yields the same parts as `split` without allocating an array or strings.
+	 *	@warning:
+	 *		The views are invalidated when the string is modified or destructed.
+	 *	@usage:
+	 *		String x = "a,b,,c";
+	 *		for (auto& part: x.split_view(',')) { ... } ==> "a", "b", "", "c"
+	 *	@funcs: 2
+	*/
+	constexpr
+	auto 	split_view(const Type delimiter) const requires (is_char<Type>::value) {
+		return view().split(delimiter);
+	}
+	constexpr
+	auto 	split_view(const CString& delimiter) const requires (is_char<Type>::value) {
+		return view().split(delimiter);
+	}
+
+	// Tokenize without allocating.
+	/*  @docs
+	 *	@parent: vlib::String
+	 *	@title: Tokenize
+	 *	@description:
+	 *		Iterate the tokens that are separated by one or more of the delimiter chars, each token is yielded as a `CString` view.
+	 *
+	 *		Empty tokens are skipped.
+	 *	@warning:
+	 *		The views are invalidated when the string is modified or destructed.
+	 *	@usage:
+	 *		String x = "GET  /index.html HTTP/1.1";
+	 *		for (auto& token: x.tokenize(" ")) { ... } ==> "GET", "/index.html", "HTTP/1.1"
+	*/
+	constexpr
+	auto 	tokenize(const CString& delimiters) const requires (is_char<Type>::value) {
+		return view().tokenize(delimiters);
+	}
+
 	// Sort the array.
 	/* 	@docs
 	 *	@title: Sort
 	 *	@description:
-	 *		Sort the array.
+	 *		Sort the array with pattern defeating quicksort, the sort is not stable.
+	 *
+	 *		Arrays of at least two million items are sorted on multiple threads with `parallel_sort_r`. An optional less than function can be passed.
 	 *
 	 *		Function `sort_r` updates the current array, while `sort` creates a copy.
 	 *	@usage:
 	 *		Array<int> x = {2, 1, 4, 3};
 	 *		x.sort_r(); x ==> {1, 2, 3, 4};
-	 *	@funcs: 2
+	 *		x.sort_r([](int a, int b) { return a > b; }); x ==> {4, 3, 2, 1};
+	 *	@funcs: 4
 	*/
 	constexpr
 	This& 	sort_r() {
-		This obj;
-		sort_h(obj);
-		return swap(obj);
+		sorting::sort(m_arr, m_len);
+		return *this;
 	}
-	constexpr
-	This 	sort() {
-		This obj;
-		sort_h(obj);
-		return obj;
+	template <typename Func> constexpr
+	This& 	sort_r(Func&& less) {
+		sorting::sort(m_arr, m_len, less);
+		return *this;
 	}
 	constexpr
-	void 	sort_h(This& obj) {
-
-		// Create a new temporary string.
-		obj.m_capacity = m_len;
-		array_h::alloc(obj.m_arr, m_len);
-
-		// Iterate "m_arr".
-		for (auto& i0: Range<Forwards>(0, m_len)) {
-
-			// Always add first item.
-			if (obj.m_len == 0) {
-				obj.set(obj.m_len, m_arr[i0]);
-			} else {
-
-				// Iterate "x" to find the insert index.
-				auto insert_index = internal::npos;
-				for (auto& i1: Range<Forwards>(0, obj.m_len)) {
-					if (m_arr[i0] <= obj.m_arr[i1]) {
-						insert_index = i1;
-						break;
-					}
-				}
-
-				// Add to end.
-				if (insert_index == npos) {
-					obj.set(obj.m_len, m_arr[i0]);
-				}
+	This 	sort() const {
+		return copy().sort_r();
+	}
+	template <typename Func> constexpr
+	This 	sort(Func&& less) const {
+		return copy().sort_r(less);
+	}
 
-				// Insert (automatically shifts the array).
-				else {
-					obj.insert(insert_index, m_arr[i0]);
-				}
+	// Stable sort the array.
+	/* 	@docs
+	 *	@title: Stable sort
+	 *	@description:
+	 *		Sort the array with a stable merge sort, equal items keep their order.
+	 *
+	 *		Function `stable_sort_r` updates the current array, while `stable_sort` creates a copy.
+	 *	@usage:
+	 *		Array<int> x = {2, 1, 4, 3};
+	 *		x.stable_sort_r(); x ==> {1, 2, 3, 4};
+	 *	@funcs: 4
+	*/
+	constexpr
+	This& 	stable_sort_r() {
+		sorting::merge(m_arr, m_len);
+		return *this;
+	}
+	template <typename Func> constexpr
+	This& 	stable_sort_r(Func&& less) {
+		sorting::merge(m_arr, m_len, less);
+		return *this;
+	}
+	constexpr
+	This 	stable_sort() const {
+		return copy().stable_sort_r();
+	}
+	template <typename Func> constexpr
+	This 	stable_sort(Func&& less) const {
+		return copy().stable_sort_r(less);
+	}
 
-				//
-			}
-		}
+	// Radix sort the array.
+	/* 	@docs
+	 *	@title: Radix sort
+	 *	@description:
+	 *		Sort an array of integral or floating numbers with a stable LSD radix sort.
+	 *
+	 *		Function `radix_sort_r` updates the current array, while `radix_sort` creates a copy.
+	 *	@usage:
+	 *		Array<double> x = {2.5, -1, 4, 3};
+	 *		x.radix_sort_r(); x ==> {-1, 2.5, 3, 4};
+	 *		x.radix_sort_r(true); x ==> {4, 3, 2.5, -1};
+	 *	@funcs: 2
+	*/
+	constexpr
+	This& 	radix_sort_r(bool reversed = false) requires (std::is_arithmetic<Type>::value && sizeof(Type) <= 8) {
+		sorting::radix(m_arr, m_len, reversed);
+		return *this;
+	}
+	constexpr
+	This 	radix_sort(bool reversed = false) const requires (std::is_arithmetic<Type>::value && sizeof(Type) <= 8) {
+		return copy().radix_sort_r(reversed);
+	}
 
-		//
+	// Parallel sort the array.
+	/* 	@docs
+	 *	@title: Parallel sort
+	 *	@description:
+	 *		Sort the array on multiple threads, every thread sorts at least one million items.
+	 *
+	 *		The chunks of the threads are sorted with pattern defeating quicksort, or with a merge sort when `stable` is `true`. The chunks are merged with a parallel merge.
+	 *	@parameter:
+	 *		@name: threads
+	 *		@description: The maximum number of threads, `0` for the number of online processors.
+	 *	}
+	 *	@parameter:
+	 *		@name: stable
+	 *		@description: Keep the order of equal items.
+	 *	}
+	 *	@usage:
+	 *		Array<int> x = ...;
+	 *		x.parallel_sort_r(8);
+	 *	@funcs: 2
+	*/
+	constexpr
+	This& 	parallel_sort_r(ullong threads = 0, bool stable = false) {
+		sorting::parallel(m_arr, m_len, sorting::Less(), threads, stable);
+		return *this;
+	}
+	template <typename Func> constexpr
+	This& 	parallel_sort_r(Func&& less, ullong threads = 0, bool stable = false) requires (std::is_invocable<Func, const Type&, const Type&>::value) {
+		sorting::parallel(m_arr, m_len, less, threads, stable);
+		return *this;
 	}
 
 	// Reverse the array.
@@ -2231,8 +2585,7 @@ struct Array {
 	constexpr
 	void 	reverse_h(This& obj) {
 		if (m_len == 0) { return ; }
-		obj.m_capacity = m_len;
-		array_h::alloc(obj.m_arr, m_len);
+		obj.alloc_h(m_len);
 		for (auto& i: Range<Backwards>(0, m_len)) {
 			obj.set(obj.m_len, m_arr[i]);
 		}
@@ -2270,8 +2623,7 @@ struct Array {
 	) {
 
 		// Create a new temporary string.
-		obj.m_capacity = m_len;
-		array_h::alloc(obj.m_arr, m_len);
+		obj.alloc_h(m_len);
 
 		// Iterate "m_arr".
 		for (auto& i: Range<Forwards>(0, m_len)) {
@@ -2320,8 +2672,7 @@ struct Array {
 	constexpr
 	void	multiply_h(This& obj, const Length x) const {
 		Length y = x;
-		obj.m_capacity = m_len * y;
-		array_h::alloc(obj.m_arr, m_len * y);
+		obj.alloc_h(m_len * y);
 		while (y-- > 0) {
 			for (Length i = 0; i < m_len; ++i) {
 				obj.set(obj.m_len, m_arr[i]);
@@ -2396,8 +2747,7 @@ struct Array {
 		This obj;
 		obj.m_len = m_len % x;
 		if (obj.m_len == 0) { return obj; }
-		obj.m_capacity = obj.m_len;
-		array_h::alloc(obj.m_arr, obj.m_len);
+		obj.alloc_h(obj.m_len);
 		array_h::copy(obj.m_arr, m_arr + (m_len - obj.m_len), obj.m_len);
 		obj.null_terminate_h();
 		return obj;
@@ -2431,7 +2781,7 @@ struct Array {
 			--len;
 		}
 		This obj(parse(data, len));
-		delete[] data;
+		vlib::array<char, ullong>::destruct(data);
         return obj;
 	}
 	SICE
@@ -2822,6 +3172,21 @@ struct Array {
 		return escaped;
 	}
 	
+	// Parse the four hex digits of a "\u" escape.
+	SICE
+	bool	parse_hex4_h(const char* data, ullong& code) {
+		code = 0;
+		for (int i = 0; i < 4; ++i) {
+			const char c = data[i];
+			code <<= 4;
+			if (c >= '0' && c <= '9') { code |= c - '0'; }
+			else if (c >= 'a' && c <= 'f') { code |= c - 'a' + 10; }
+			else if (c >= 'A' && c <= 'F') { code |= c - 'A' + 10; }
+			else { return false; }
+		}
+		return true;
+	}
+	
 	// Unescape.
 	/* 	@docs
 	 *	@parent: vlib::String
@@ -2871,6 +3236,36 @@ struct Array {
 						case 'f':
 							unescaped.append('\f');
 							break;
+						case '/':
+							unescaped.append('/');
+							break;
+						case 'u': {
+							ullong code;
+							if (i + 4 >= len || !parse_hex4_h(data + i + 1, code)) {
+								unescaped.append('\\', 'u');
+								break;
+							}
+							i += 4;
+							
+							// Surrogate pair.
+							ullong low;
+							if (code >= 0xD800 && code <= 0xDBFF && i + 6 < len && data[i + 1] == '\\' && data[i + 2] == 'u' && parse_hex4_h(data + i + 3, low) && low >= 0xDC00 && low <= 0xDFFF) {
+								code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+								i += 6;
+							}
+							
+							// Encode as utf-8.
+							if (code < 0x80) {
+								unescaped.append((char) code);
+							} else if (code < 0x800) {
+								unescaped.append((char) (0xC0 | (code >> 6)), (char) (0x80 | (code & 0x3F)));
+							} else if (code < 0x10000) {
+								unescaped.append((char) (0xE0 | (code >> 12)), (char) (0x80 | ((code >> 6) & 0x3F)), (char) (0x80 | (code & 0x3F)));
+							} else {
+								unescaped.append((char) (0xF0 | (code >> 18)), (char) (0x80 | ((code >> 12) & 0x3F)), (char) (0x80 | ((code >> 6) & 0x3F)), (char) (0x80 | (code & 0x3F)));
+							}
+							break;
+						}
 					}
 					break;
 				default:
@@ -3888,8 +4283,7 @@ struct Array {
 		if (m_len == 0) { return obj; }
 		const Length y = x;
 		if (y >= m_len) { return obj; }
-		obj.m_capacity = obj.m_len;
-		array_h::alloc(obj.m_arr, obj.m_len);
+		obj.alloc_h(m_len - y);
 		obj.m_len = m_len - y;
 		array_h::copy(obj.m_arr, m_arr + y, obj.m_len);
 		obj.null_terminate_h();
@@ -4282,10 +4676,14 @@ m_type_id(internal::npos),
 m_type(type),
 m_err_id(internal::npos)
 {
-    m_err.len() = err.len();
-    m_err.capacity() = err.capacity();
-    m_err.data() = err.data();
-    err.data() = nullptr;
+    if (err.is_inline_h()) {
+        m_err.concat_r(err.data(), err.len());
+    } else {
+        m_err.len() = err.len();
+        m_err.capacity() = err.capacity();
+        m_err.data() = err.data();
+        err.data() = nullptr;
+    }
 #if vlib_enable_trace == true
     m_trace.init();
 #endif
@@ -4302,10 +4700,14 @@ m_err_id(internal::npos)
 {
     String str;
     str.concats_r(arg1, arg2, args...);
-    m_err.len() = str.len();
-    m_err.capacity() = str.capacity();
-    m_err.data() = str.data();
-    str.data() = nullptr;
+    if (str.is_inline_h()) {
+        m_err.concat_r(str.data(), str.len());
+    } else {
+        m_err.len() = str.len();
+        m_err.capacity() = str.capacity();
+        m_err.data() = str.data();
+        str.data() = nullptr;
+    }
 #if vlib_enable_trace == true
     m_trace.init();
 #endif
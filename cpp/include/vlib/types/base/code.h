@@ -59,7 +59,7 @@ public:
 	constexpr
 	This& 	copy(const This& obj) {
 		if (this == &obj) { return *this; }
-		array_h::copy(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		String::copy(obj);
 		null_terminate_safe_h();
 		return *this;
 	}
@@ -68,7 +68,7 @@ public:
 	constexpr
 	This& 	swap(This& obj) {
 		if (this == &obj) { return *this; }
-		array_h::swap(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		String::swap(obj);
 		return *this;
 	}
 
@@ -699,8 +699,7 @@ public:
 			}
 			This str;
 			str.m_len = pos - lpos;
-			str.m_capacity = str.m_len;
-			array_h::alloc(str.m_arr, str.m_len);
+			str.alloc_h(str.m_len);
 			array_h::copy(str.m_arr, m_arr + lpos, pos - lpos);
 			splitted.append(move(str));
 			pos += ndelimiter;
@@ -14,11 +14,15 @@ namespace vlib {
 	@title: CString
 	@description:
 		CString type.
+
+		A non-owning view of a char array, also available as `StringView`.
+		Slicing, splitting and tokenizing a CString does not allocate, all results point into the original data.
 	@warning:
 		Causes undefined behaviour when the constructed pointer goes out of scope.
 	@usage:
         #include <vlib/types.h>
 		vlib::CString x ("Hello World!", 12);
+		for (auto& part: x.split(' ')) { ... }
 */
 struct CString {
 
@@ -202,12 +206,13 @@ struct CString {
 	}
 	
 	// Equals.
+	// - Both the length and the contents must be equal, a prefix does not match.
 	inline constexpr
 	bool 	eq(
 		const Type* 	arr,	// the second array of the comparison.
-		const Length 	len		// the length to check.
+		const Length 	len		// the length of the second array.
 	) const {
-		return array_h::eq(m_arr, len, arr, len);
+		return array_h::eq(m_arr, m_len, arr, len);
 	}
 
 	// Equals a char array.
@@ -215,7 +220,7 @@ struct CString {
 	bool 	eq(
 		const Type* 	arr				// the second array of the comparison.
 	) const {
-		return array_h::eq(m_arr, m_len, arr, vlib::len(m_arr));
+		return array_h::eq(m_arr, m_len, arr, vlib::len(arr));
 	}
 
 	// Equals a Array.
@@ -231,6 +236,84 @@ struct CString {
 	auto& 	data() const {
 		return m_arr;
 	}
+
+	// Slice.
+	/* @docs
+	  @title: Slice
+	  @description:
+			Get a view of a part of the array, nothing is copied.
+	  @usage:
+			CString x ("Hello World!");
+			x.slice(6, 11); ==> "World"
+	*/
+	inline constexpr
+	This 	slice(const Length sindex, const Length eindex = internal::npos) const {
+		const Length end = eindex == internal::npos || eindex > m_len ? m_len : eindex;
+		if (sindex >= end) { return This(m_arr + (sindex > m_len ? m_len : sindex), 0); }
+		return This(m_arr + sindex, end - sindex);
+	}
+
+	// Find a char.
+	/* @docs
+	  @title: Find
+	  @description:
+			Find the index of the first occurence of a char or substring.
+
+			Returns `npos` when the char or substring is not found.
+	  @usage:
+			CString x ("Hello World!");
+			x.find('o'); ==> 4
+			x.find("World"); ==> 6
+	*/
+	inline
+	Length 	find(const Type c, const Length sindex = 0) const {
+		if (sindex >= m_len) { return internal::npos; }
+		const Type* pos = (const Type*) memchr(m_arr + sindex, c, m_len - sindex);
+		return pos == nullptr ? internal::npos : pos - m_arr;
+	}
+
+	// Find a substring.
+	// - See "vlib::searching::find".
+	inline
+	Length 	find(const This& obj, const Length sindex = 0) const {
+		if (sindex >= m_len) { return internal::npos; }
+		const Length pos = searching::find(m_arr + sindex, m_len - sindex, obj.m_arr, obj.m_len);
+		return pos == internal::npos ? internal::npos : sindex + pos;
+	}
+
+	// Split lazily.
+	/* @docs
+	  @title: Split
+	  @description:
+			Split the array by a delimiter without allocating.
+
+			Returns a range that yields a CString for each part, empty parts are included just like `String::split`.
+	  @warning:
+			The parts point into the original data, the data must outlive the iteration.
+	  @usage:
+			CString x ("a,b,,c");
+			for (auto& part: x.split(',')) { ... } ==> "a", "b", "", "c"
+	*/
+	constexpr
+	auto 	split(const Type delimiter) const;
+	constexpr
+	auto 	split(const This& delimiter) const;
+
+	// Tokenize lazily.
+	/* @docs
+	  @title: Tokenize
+	  @description:
+			Iterate the tokens that are separated by one or more of the delimiter chars without allocating.
+
+			Empty tokens are skipped.
+	  @warning:
+			The tokens point into the original data, the data must outlive the iteration.
+	  @usage:
+			CString x ("GET  /index.html HTTP/1.1");
+			for (auto& token: x.tokenize(" ")) { ... } ==> "GET", "/index.html", "HTTP/1.1"
+	*/
+	constexpr
+	auto 	tokenize(const This& delimiters) const;
 	
 	// ---------------------------------------------------------
 	// Iterations.
@@ -469,6 +552,151 @@ struct CString {
 	//
 };
 
+// ---------------------------------------------------------
+// Lazy split and tokenize.
+
+namespace internal { namespace cstring {
+
+// Split range.
+struct Split {
+
+	// Attributes.
+	CString		m_str;
+	CString		m_delimiter;
+	char		m_char;			// the delimiter when its length is 1, stored by value since a char delimiter is a temporary.
+
+	// Iterator, yields the part from "m_pos" till "m_end".
+	struct Iterator {
+		const Split*	m_split;
+		ullong			m_pos;
+		ullong			m_end;
+		bool			m_done;
+		CString			m_part;
+
+		// Find the end of the part that starts at "m_pos".
+		inline
+		void	find_end() {
+			const CString& str = m_split->m_str;
+			m_end = m_split->m_delimiter.m_len == 1 ?
+				str.find(m_split->m_char, m_pos) :
+				str.find(m_split->m_delimiter, m_pos);
+			if (m_end == npos) { m_end = str.m_len; }
+			m_part.construct(str.m_arr + m_pos, m_end - m_pos);
+		}
+		inline
+		const CString& operator *() const {
+			return m_part;
+		}
+		inline
+		Iterator& operator ++() {
+			if (m_end == m_split->m_str.m_len) {
+				m_done = true;
+			} else {
+				m_pos = m_end + m_split->m_delimiter.m_len;
+				find_end();
+			}
+			return *this;
+		}
+		inline
+		bool	operator !=(const Iterator& obj) const {
+			return m_done != obj.m_done;
+		}
+	};
+
+	// Iterate.
+	inline
+	Iterator begin() const {
+		Iterator iter {this, 0, m_str.m_len, false, m_str};
+		if (m_delimiter.m_len != 0) { iter.find_end(); }
+		return iter;
+	}
+	inline
+	Iterator end() const {
+		return Iterator {this, 0, 0, true, CString()};
+	}
+};
+
+// Tokenize range.
+struct Tokenize {
+
+	// Attributes.
+	CString		m_str;
+	bool		m_delimiters[256];
+
+	// Constructor.
+	constexpr
+	Tokenize(const CString& str, const CString& delimiters)
+	: m_str(str), m_delimiters{} {
+		for (auto& c: delimiters.iterate()) { m_delimiters[(uchar) c] = true; }
+	}
+
+	// Iterator, yields the token from "m_pos" till "m_end".
+	struct Iterator {
+		const Tokenize*	m_tokenize;
+		ullong			m_pos;
+		ullong			m_end;
+		CString			m_token;
+
+		// Find the token that starts at or after "index".
+		constexpr
+		void	find_token(ullong index) {
+			const CString& str = m_tokenize->m_str;
+			while (index < str.m_len && m_tokenize->m_delimiters[(uchar) str.m_arr[index]]) { ++index; }
+			m_pos = index;
+			while (index < str.m_len && !m_tokenize->m_delimiters[(uchar) str.m_arr[index]]) { ++index; }
+			m_end = index;
+			m_token.construct(str.m_arr + m_pos, m_end - m_pos);
+		}
+		constexpr
+		const CString& operator *() const {
+			return m_token;
+		}
+		constexpr
+		Iterator& operator ++() {
+			find_token(m_end);
+			return *this;
+		}
+		constexpr
+		bool	operator !=(const Iterator& obj) const {
+			return m_pos != obj.m_pos;
+		}
+	};
+
+	// Iterate.
+	constexpr
+	Iterator begin() const {
+		Iterator iter {this, 0, 0, CString()};
+		iter.find_token(0);
+		return iter;
+	}
+	constexpr
+	Iterator end() const {
+		return Iterator {this, m_str.m_len, m_str.m_len, CString()};
+	}
+};
+
+}; 		// End namespace cstring.
+}; 		// End namespace internal.
+
+// Split.
+constexpr
+auto 	CString::split(const Type delimiter) const {
+	return internal::cstring::Split {*this, CString(nullptr, 1), delimiter};
+}
+constexpr
+auto 	CString::split(const This& delimiter) const {
+	return internal::cstring::Split {*this, delimiter, delimiter.m_len == 0 ? '\0' : delimiter.m_arr[0]};
+}
+
+// Tokenize.
+constexpr
+auto 	CString::tokenize(const This& delimiters) const {
+	return internal::cstring::Tokenize(*this, delimiters);
+}
+
+// String view alias.
+using StringView = CString;
+
 // ---------------------------------------------------------
 // Instances.
 
@@ -482,6 +710,7 @@ template<> 				struct is_CString<CString> 			{ SICEBOOL value = true;  };
 namespace types { namespace shortcuts {
 
 using CString =		vlib::CString;
+using StringView =	vlib::StringView;
 
 }; 		// End namespace sockets.
 }; 		// End namespace shortcuts.
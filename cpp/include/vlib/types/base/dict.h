@@ -8,6 +8,168 @@
 // Namespace vlib.
 namespace vlib {
 
+// Namespace internal.
+namespace internal {
+
+// Dict key index.
+// - Open addressing with linear probing, the capacity is always a power of two.
+// - Stores indexes into the keys array, so the insertion order of the dictionary is never affected.
+// - The indexed count tracks how many keys of the keys array have been hashed, so keys that
+//   are appended directly to the keys array are indexed lazily on the next lookup.
+template <typename Length>
+struct DictIndex {
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 		This = 			DictIndex;
+
+	// ---------------------------------------------------------
+	// Slot.
+
+	struct Slot {
+		Length	index;
+		ullong	hash;
+	};
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	SICE Length empty = (Length) -1;
+
+	Slot*	m_slots = nullptr;
+	Length	m_capacity = 0;			// the number of slots.
+	Length	m_count = 0;			// the number of occupied slots.
+	Length	m_indexed = 0;			// the number of keys that have been hashed.
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Default constructor.
+	constexpr
+	DictIndex () = default;
+
+	// Copy constructor.
+	constexpr
+	DictIndex (const This& obj) :
+	m_slots(obj.m_capacity == 0 ? nullptr : new Slot [obj.m_capacity]),
+	m_capacity(obj.m_capacity),
+	m_count(obj.m_count),
+	m_indexed(obj.m_indexed)
+	{
+		for (Length i = 0; i < m_capacity; ++i) { m_slots[i] = obj.m_slots[i]; }
+	}
+
+	// Move constructor.
+	constexpr
+	DictIndex (This&& obj) :
+	m_slots(obj.m_slots),
+	m_capacity(obj.m_capacity),
+	m_count(obj.m_count),
+	m_indexed(obj.m_indexed)
+	{
+		obj.m_slots = nullptr;
+		obj.m_capacity = 0;
+		obj.m_count = 0;
+		obj.m_indexed = 0;
+	}
+
+	// Destructor.
+	constexpr
+	~DictIndex () { delete[] m_slots; }
+
+	// Copy assignment operator.
+	constexpr
+	This& 	operator =(const This& obj) {
+		if (this == &obj) { return *this; }
+		This copy (obj);
+		return *this = move(copy);
+	}
+
+	// Move assignment operator.
+	constexpr
+	This& 	operator =(This&& obj) {
+		if (this == &obj) { return *this; }
+		delete[] m_slots;
+		m_slots = obj.m_slots;
+		m_capacity = obj.m_capacity;
+		m_count = obj.m_count;
+		m_indexed = obj.m_indexed;
+		obj.m_slots = nullptr;
+		obj.m_capacity = 0;
+		obj.m_count = 0;
+		obj.m_indexed = 0;
+		return *this;
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Clear all slots, keeps the capacity.
+	constexpr
+	void 	clear() {
+		for (Length i = 0; i < m_capacity; ++i) { m_slots[i].index = empty; }
+		m_count = 0;
+		m_indexed = 0;
+	}
+
+	// Make sure the index can hold a number of keys while the load factor stays below 0.5.
+	constexpr
+	void 	reserve(const Length keys) {
+		if (keys * 2 <= m_capacity) { return; }
+		Length capacity = m_capacity == 0 ? 16 : m_capacity;
+		while (capacity < keys * 2) { capacity *= 2; }
+		Slot* slots = new Slot [capacity];
+		for (Length i = 0; i < capacity; ++i) { slots[i].index = empty; }
+		const Length mask = capacity - 1;
+		for (Length i = 0; i < m_capacity; ++i) {
+			if (m_slots[i].index == empty) { continue; }
+			Length pos = (Length) m_slots[i].hash & mask;
+			while (slots[pos].index != empty) { pos = (pos + 1) & mask; }
+			slots[pos] = m_slots[i];
+		}
+		delete[] m_slots;
+		m_slots = slots;
+		m_capacity = capacity;
+	}
+
+	// Find the keys index of a hash, returns "npos" when not found.
+	// - Function "eq" checks if the key at a keys index equals the searched key.
+	template <typename Eq> constexpr
+	ullong 	find(const ullong hash, Eq&& eq) const {
+		if (m_capacity == 0) { return NPos::npos; }
+		const Length mask = m_capacity - 1;
+		Length pos = (Length) hash & mask;
+		while (m_slots[pos].index != empty) {
+			if (m_slots[pos].hash == hash && eq(m_slots[pos].index)) {
+				return m_slots[pos].index;
+			}
+			pos = (pos + 1) & mask;
+		}
+		return NPos::npos;
+	}
+
+	// Insert a keys index, the first occurrence of a key is kept for duplicates.
+	// - Function "eq" checks if the key at a keys index equals the inserted key.
+	// - Requires enough reserved capacity.
+	template <typename Eq> constexpr
+	void 	insert(const Length index, const ullong hash, Eq&& eq) {
+		const Length mask = m_capacity - 1;
+		Length pos = (Length) hash & mask;
+		while (m_slots[pos].index != empty) {
+			if (m_slots[pos].hash == hash && eq(m_slots[pos].index)) {
+				return ;
+			}
+			pos = (pos + 1) & mask;
+		}
+		m_slots[pos] = { index, hash };
+		++m_count;
+	}
+
+};
+
+}; 		// End namespace internal.
+
 // Dict requires clause.
 #define VLIB_DICT_REQUIRES_CLAUSE requires ( \
 (!is_CString<Key>::value && !is_CString<Value>::value) && \
@@ -45,6 +207,7 @@ struct Dict {
 	using 		PairType = 		vlib::Pair<Key, Value>;
 	using 		KeyArray = 		Array<Key, Length>;
 	using 		ValueArray = 	Array<Value, Length>;
+	using 		KeyIndex = 		internal::DictIndex<Length>;
 	typedef 	Key				key_type;
 	typedef 	Value			value_type;
 
@@ -53,6 +216,7 @@ struct Dict {
 
 	Ptr<KeyArray, Status> 	m_keys;
 	Ptr<ValueArray, Status>	m_values;
+	Ptr<KeyIndex, Status>	m_index;			// optional key index, undefined when not enabled.
 
 	// ---------------------------------------------------------
 	// Static attributes.
@@ -81,6 +245,7 @@ struct Dict {
 			m_keys->set(m_keys->len(), i.m_key);
 			m_values->set(m_values->len(), i.m_value);
 		}
+		index_rebuild_h();
 		return *this;
 	}
 
@@ -89,6 +254,7 @@ struct Dict {
 	auto& 	copy(const This& obj) {
 		m_keys.copy(obj.m_keys);
 		m_values.copy(obj.m_values);
+		m_index.copy(obj.m_index);
 		return *this;
 	}
 
@@ -109,6 +275,7 @@ struct Dict {
 		if (this == &obj) { return *this; }
 		m_keys.swap(obj.m_keys);
 		m_values.swap(obj.m_values);
+		m_index.swap(obj.m_index);
 		return *this;
 	}
 
@@ -117,6 +284,7 @@ struct Dict {
 	void 	destruct() {
 		m_keys.destruct();
 		m_values.destruct();
+		m_index.destruct();
 	}
 
 	// ---------------------------------------------------------
@@ -169,13 +337,15 @@ struct Dict {
 	constexpr
 	Dict (const This& obj) :
 	m_keys(obj.m_keys),
-	m_values(obj.m_values) {}
+	m_values(obj.m_values),
+	m_index(obj.m_index) {}
 
 	// Move constructor.
 	constexpr
 	Dict (This&& obj) :
 	m_keys(move(obj.m_keys)),
-	m_values(move(obj.m_values)) {}
+	m_values(move(obj.m_values)),
+	m_index(move(obj.m_index)) {}
 
 	// ---------------------------------------------------------
 	// Assignment operators.
@@ -229,6 +399,7 @@ struct Dict {
 	auto& 		reset() {
 		m_keys->reset();
 		m_values->reset();
+		index_rebuild_h();
 		return *this;
 	}
 	
@@ -266,6 +437,108 @@ struct Dict {
 		m_values->expand(with_len);
 		return *this;
 	}
+
+	// Enable the key index.
+	/*  @docs
+		@title: Enable index
+		@description:
+			Enable a hashed key index for constant time key lookups.
+	 
+			By default every lookup by key is a linear search, which is the fastest option for small dictionaries. Enable the index on larger dictionaries that are frequently queried by key, the insertion order of the dictionary is not affected.
+	 
+			The index is updated by the member functions that edit the dictionary, lookups never edit the index so a dictionary that is not edited can be read by multiple threads. Call `reindex()` after editing keys directly through `keys()`, until then lookups fall back to a linear search.
+		@usage:
+			Dict<String, int> x;
+			x.enable_index();
+			x.append("a", 1);
+			x.find("a"); ==> 0
+	*/
+	constexpr
+	This& 	enable_index() requires (is_hashable<Key>::value) {
+		if (!m_index) {
+			m_index.init();
+			index_sync_h();
+		}
+		return *this;
+	}
+
+	// Disable the key index.
+	/*  @docs
+		@title: Disable index
+		@description:
+			Disable the hashed key index and release its memory.
+	*/
+	constexpr
+	This& 	disable_index() {
+		m_index.destruct();
+		return *this;
+	}
+
+	// Is indexed.
+	/*  @docs
+		@title: Is indexed
+		@description:
+			Check if the hashed key index is enabled.
+	*/
+	constexpr
+	bool 	is_indexed() const {
+		return m_index.is_defined();
+	}
+
+	// Rebuild the key index.
+	/*  @docs
+		@title: Reindex
+		@description:
+			Rebuild the hashed key index.
+	 
+			Only required after editing existing keys directly through `keys()`.
+	*/
+	constexpr
+	This& 	reindex() {
+		index_rebuild_h();
+		return *this;
+	}
+
+	// Rebuild the key index after existing keys have been edited.
+	constexpr
+	void 	index_rebuild_h() {
+		if (m_index) {
+			m_index->clear();
+			index_sync_h();
+		}
+	}
+
+	// Hash all keys that are not yet indexed.
+	// - Called by the functions that edit the keys, lookups are const and never edit the index.
+	// - Rebuilds the index when keys have been removed.
+	constexpr
+	void 	index_sync_h() {
+		if constexpr (is_hashable<Key>::value) {
+			if (!m_index) { return ; }
+			KeyIndex& index = *m_index;
+			const Length len = m_keys->len();
+			if (index.m_indexed > len) {
+				index.clear();
+			}
+			if (index.m_indexed < len) {
+				const Key* keys = m_keys->m_arr;
+				index.reserve(len);
+				for (Length i = index.m_indexed; i < len; ++i) {
+					index.insert(i, hash_of(keys[i]), [&](const Length j) {
+						return keys[j] == keys[i];
+					});
+				}
+				index.m_indexed = len;
+			}
+		}
+	}
+
+	// Check if the key index can be used for a lookup.
+	// - False when keys have been edited directly through "keys()" without "reindex()".
+	constexpr
+	bool 	index_synced_h() const {
+		return m_index && m_index->m_indexed == m_keys->len();
+	}
 	
 	// Is undefined.
 	/* 	@docs
@@ -357,34 +630,42 @@ struct Dict {
 	*/
 	constexpr
 	Value& 	value(const Key& key) {
-		for (auto& i: indexes()) {
-			if (m_keys->get(i) == key) { return m_values->get(i); }
-		}
+		const ullong i = find(key);
+		if (i != NPos::npos) { return m_values->get(i); }
 		m_keys->append(key);
 		m_values->append(Value());
+		index_sync_h();
 		return m_values->last();
 	}
 	constexpr
 	Value& 	value(const char* key, const Length len) requires (is_CString<Key>::value || is_String<Key>::value) {
-		for (auto& i: indexes()) {
-			if (m_keys->get(i).eq(key, len)) { return m_values->get(i); }
-		}
+		const ullong i = find(key, len);
+		if (i != NPos::npos) { return m_values->get(i); }
 		m_keys->append(Key(key, len));
 		m_values->append(Value());
+		index_sync_h();
 		return m_values->last();
 	}
 	constexpr
 	Value& 	value(const Key& key) const {
-		for (auto& i: indexes()) {
-			if (m_keys->get(i) == key) { return m_values->get(i); }
-		}
+		const ullong i = find(key);
+		if (i != NPos::npos) { return m_values->get(i); }
         throw KeyError(to_str("Key \"", key, "\" does not exist."));
 	}
 	constexpr
 	const Value& 		value(const char* key, const Length len) const requires (is_CString<Key>::value || is_String<Key>::value) {
-		for (auto& i: indexes()) {
-			if (m_keys->get(i).eq(key, len)) { return m_values->get(i); }
-		}
+		const ullong i = find(key, len);
+		if (i != NPos::npos) { return m_values->get(i); }
+        throw KeyError(to_str("Key \"", key, "\" does not exist."));
+	}
+	template <typename View> requires (is_CString<View>::value && is_String<Key>::value) constexpr
+	Value& 	value(const View& key) {
+		return value(key.data(), key.len());
+	}
+	template <typename View> requires (is_CString<View>::value && is_String<Key>::value) constexpr
+	const Value& 		value(const View& key) const {
+		const ullong i = find(key.data(), key.len());
+		if (i != NPos::npos) { return m_values->get(i); }
         throw KeyError(to_str("Key \"", key, "\" does not exist."));
 	}
 
@@ -412,8 +693,10 @@ struct Dict {
 		const Key&			key,				// the key to assign.
 		const Value&		value				// the value to assign.
 	) {
+		const bool replaced = index < m_keys->len();
 		m_keys->set(index, key);
 		m_values->set(index, value);
+		if (replaced) { index_rebuild_h(); } else { index_sync_h(); }
 		return *this;
 	}
 	constexpr
@@ -422,8 +705,10 @@ struct Dict {
 		Key&&				key,				// the key to assign.
 		const Value&		value				// the value to assign.
 	) {
+		const bool replaced = index < m_keys->len();
 		m_keys->set(index, key);
 		m_values->set(index, value);
+		if (replaced) { index_rebuild_h(); } else { index_sync_h(); }
 		return *this;
 	}
 	constexpr
@@ -432,8 +717,10 @@ struct Dict {
 		const Key&			key,				// the key to assign.
 		Value&&				value				// the value to assign.
 	) {
+		const bool replaced = index < m_keys->len();
 		m_keys->set(index, key);
 		m_values->set(index, value);
+		if (replaced) { index_rebuild_h(); } else { index_sync_h(); }
 		return *this;
 	}
 	constexpr
@@ -442,8 +729,10 @@ struct Dict {
 		Key&&				key,				// the key to assign.
 		Value&&				value				// the value to assign.
 	) {
+		const bool replaced = index < m_keys->len();
 		m_keys->set(index, key);
 		m_values->set(index, value);
+		if (replaced) { index_rebuild_h(); } else { index_sync_h(); }
 		return *this;
 	}
 
@@ -497,6 +786,7 @@ struct Dict {
 	) {
 		m_keys->append(key);
 		m_values->append(value);
+		index_sync_h();
 		return *this;
 	}
 	constexpr
@@ -504,8 +794,9 @@ struct Dict {
 		Key&&	 		key,				// the key to append.
 		const Value& 	value			// the key to append.
 	) {
-		m_keys->append(key);
+		m_keys->append(vlib::move(key));
 		m_values->append(value);
+		index_sync_h();
 		return *this;
 	}
 	constexpr
@@ -514,7 +805,8 @@ struct Dict {
 		Value&&		 	value			// the key to append.
 	) {
 		m_keys->append(key);
-		m_values->append(value);
+		m_values->append(vlib::move(value));
+		index_sync_h();
 		return *this;
 	}
 	constexpr
@@ -522,8 +814,9 @@ struct Dict {
 		Key&&	 		key,				// the key to append.
 		Value&& 		value			// the key to append.
 	) {
-		m_keys->append(key);
-		m_values->append(value);
+		m_keys->append(vlib::move(key));
+		m_values->append(vlib::move(value));
+		index_sync_h();
 		return *this;
 	}
 	
@@ -568,12 +861,16 @@ struct Dict {
 	constexpr
 	Value 	pop(ullong index) requires (!is_ullong<Key>::value) {
 		m_keys->pop(index);
-		return m_values->pop(index);
+		Value value = m_values->pop(index);
+		index_rebuild_h();
+		return value;
 	}
 	constexpr
 	Value	pop(ullong index, const Value& def) requires (!is_ullong<Key>::value) {
 		m_keys->pop(index);
-		return m_values->pop(index, def);
+		Value value = m_values->pop(index, def);
+		index_rebuild_h();
+		return value;
 	}
 
 	// Remove a key`` & value by key.
@@ -589,7 +886,7 @@ struct Dict {
 	*/
 	constexpr
 	Value	pop(const Key& key) {
-		ullong i = m_keys->find(key);
+		ullong i = find(key);
 		if (i == NPos::npos) {
 			throw KeyError(to_str(
 				 "Index \"",
@@ -600,16 +897,20 @@ struct Dict {
 			));
 		}
 		m_keys->pop(i);
-		return m_values->pop(i);
+		Value value = m_values->pop(i);
+		index_rebuild_h();
+		return value;
 	}
 	constexpr
 	Value	pop(const Key& key, const Value& def) {
-		ullong i = m_keys->find(key);
+		ullong i = find(key);
 		if (i == NPos::npos) {
 			return def;
 		}
-		m_keys->pop(i, def);
-		return m_values->pop(i, def);
+		m_keys->pop(i);
+		Value value = m_values->pop(i, def);
+		index_rebuild_h();
+		return value;
 	}
 
 	// Find the index of a key.
@@ -617,18 +918,36 @@ struct Dict {
 		@title: Find
 		@description:
 			Find the index of a key.
+
+			Dictionaries with `String` keys can also be searched with a `CString` view, without constructing a key.
 	*/
 	constexpr
 	ullong	find(const Key& key) const {
+		if constexpr (is_hashable<Key>::value) {
+			if (index_synced_h()) {
+				return m_index->find(hash_of(key), [&](const Length i) {
+					return m_keys->m_arr[i] == key;
+				});
+			}
+		}
 		return m_keys->find(key);
 	}
 	constexpr
 	ullong 	find(const char* key, const Length len) const requires (is_CString<Key>::value || is_String<Key>::value) {
+		if (index_synced_h()) {
+			return m_index->find(hash_of(key, len), [&](const Length i) {
+				return m_keys->m_arr[i].eq(key, len);
+			});
+		}
 		for (auto& i: indexes()) {
 			if (m_keys->get(i).eq(key, len)) { return i; }
 		}
 		return NPos::npos;
 	}
+	template <typename View> requires (is_CString<View>::value && is_String<Key>::value) constexpr
+	ullong 	find(const View& key) const {
+		return find(key.data(), key.len());
+	}
 
 	// Find the index of a value.
 	/* 	@docs
@@ -663,12 +982,16 @@ struct Dict {
 	*/
 	constexpr
 	bool 	contains(const Key& key) const {
-		return m_keys->find(key) != NPos::npos;
+		return find(key) != NPos::npos;
 	}
 	constexpr
 	bool 	contains(const char* key, const Length len) const requires (is_CString<Key>::value || is_String<Key>::value) {
 		return find(key, len) != NPos::npos;
 	}
+	template <typename View> requires (is_CString<View>::value && is_String<Key>::value) constexpr
+	bool 	contains(const View& key) const {
+		return find(key.data(), key.len()) != NPos::npos;
+	}
 
 	// Find the index of a value.
 	/* @docs
@@ -707,6 +1030,7 @@ struct Dict {
 	This& 	slice_r(ullong sindex, ullong eindex = NPos::npos) {
 		m_keys->slice_r(sindex, eindex);
 		m_values->slice_r(sindex, eindex);
+		index_rebuild_h();
 		return *this;
 	}
 	constexpr
@@ -742,54 +1066,25 @@ struct Dict {
 	}
 
 	// Sort helper.
+	// - The indexes are sorted with a stable merge sort, the keys and values are copied in the sorted order.
 	template <bool by_keys> constexpr
 	void 		sort_h(This& obj, bool reversed = false) {
-
-		// Create a new temporary string.
-		obj.resize(m_keys->len());
-
-		// Iterate.
-		for (auto& i0: Range<Forwards>(0, m_keys->len())) {
-
-			// Always add first item.
-			if (obj.m_keys->len() == 0) {
-				obj.append(m_keys->get(i0), m_values->get(i0));
+		const ullong len = m_keys->len();
+		Array<ullong> order;
+		order.resize(len);
+		for (ullong i = 0; i < len; ++i) { order.append(i); }
+		auto less = [&](ullong x, ullong y) {
+			if constexpr (by_keys) {
+				return reversed ? m_keys->get(y) < m_keys->get(x) : m_keys->get(x) < m_keys->get(y);
 			} else {
-
-				// Iterate "x" to find the insert index.
-				auto insert_index = NPos::npos;
-				for (auto& i1: Range<Forwards>(0, obj.m_keys->len())) {
-					if (
-						(by_keys &&
-						 ((!reversed && m_keys->get(i0) <= obj.m_keys->get(i1)) ||
-						 (reversed && m_keys->get(i0) >= obj.m_keys->get(i1)))
-						) ||
-						(!by_keys &&
-						 ((!reversed && m_values->get(i0) <= obj.m_values->get(i1)) ||
-						 (reversed && m_values->get(i0) >= obj.m_values->get(i1)))
-						)
-					) {
-						insert_index = i1;
-						break;
-					}
-				}
-
-				// Add to end.
-				if (insert_index == npos) {
-					obj.append(m_keys->get(i0), m_values->get(i0));
-				}
-
-				// Insert (automatically shifts the array).
-				else {
-					obj.m_keys->insert(insert_index, m_keys->get(i0));
-					obj.m_values->insert(insert_index, m_values->get(i0));
-				}
-
-				//
+				return reversed ? m_values->get(y) < m_values->get(x) : m_values->get(x) < m_values->get(y);
 			}
+		};
+		sorting::merge(order.data(), len, less);
+		obj.resize(len);
+		for (auto& i: order) {
+			obj.append(m_keys->get(i), m_values->get(i));
 		}
-
-		//
 	}
 
 	// Sort by keys.
@@ -805,7 +1100,10 @@ struct Dict {
 	This& 	sort_r(bool reversed = false) {
 		This obj;
 		sort_h<true>(obj, reversed);
-		return swap(obj);
+		m_keys.swap(obj.m_keys);
+		m_values.swap(obj.m_values);
+		index_rebuild_h();
+		return *this;
 	}
 	constexpr
 	This 	sort(bool reversed = false) {
@@ -827,7 +1125,10 @@ struct Dict {
 	This& 	sort_values_r(bool reversed = false) {
 		This obj;
 		sort_h<false>(obj, reversed);
-		return swap(obj);
+		m_keys.swap(obj.m_keys);
+		m_values.swap(obj.m_values);
+		index_rebuild_h();
+		return *this;
 	}
 	constexpr
 	This 	sort_values(bool reversed = false) {
@@ -856,6 +1157,7 @@ struct Dict {
 	auto& 	reverse_r() {
 		m_keys->reverse_r();
 		m_values->reverse_r();
+		index_rebuild_h();
 		return *this;
 	}
 	auto 	reverse() {
@@ -884,6 +1186,7 @@ struct Dict {
 	This& 	mult_r(const Numeric& x) {
 		m_keys->mult_r(x);
 		m_values->mult_r(x);
+		index_rebuild_h();
 		return *this;
 	}
 	template <typename Numeric> requires (is_any_numeric<Numeric>::value || is_any_Numeric<Numeric>::value) constexpr
@@ -907,6 +1210,7 @@ struct Dict {
 	This&	div_r(const Numeric& x) {
 		m_keys->div_r(x);
 		m_values->div_r(x);
+		index_rebuild_h();
 		return *this;
 	}
 	template <typename Numeric> requires (is_any_numeric<Numeric>::value || is_any_Numeric<Numeric>::value) constexpr
@@ -930,6 +1234,7 @@ struct Dict {
 	This& 	mod_r(const Numeric& x) {
 		m_keys->mod_r(x);
 		m_values->mod_r(x);
+		index_rebuild_h();
 		return *this;
 	}
 	template <typename Numeric> requires (is_any_numeric<Numeric>::value || is_any_Numeric<Numeric>::value) constexpr
@@ -1242,7 +1547,7 @@ struct Dict {
 			--len;
 		}
 		This obj(parse(data, len));
-		delete[] data;
+		vlib::array<char, ullong>::destruct(data);
         return obj;
 	}
 	SICE
@@ -1519,6 +1824,7 @@ struct Dict {
 		if (m_keys->len() == 0) { return *this; }
 		++(*m_keys);
 		++(*m_values);
+		index_rebuild_h();
 		return *this;
 	}
 	constexpr
@@ -1526,6 +1832,7 @@ struct Dict {
 		if (m_keys->len() == 0) { return *this; }
 		++(*m_keys);
 		++(*m_values);
+		index_rebuild_h();
 		return *this;
 	}
 	template <typename Numeric> requires (
@@ -1547,6 +1854,7 @@ struct Dict {
 		if (m_keys->len() == 0) { return *this; }
 		(*m_keys) += x;
 		(*m_values) += x;
+		index_rebuild_h();
 		return *this;
 	}
 
@@ -1556,6 +1864,7 @@ struct Dict {
 		if (m_keys->len() == 0) { return *this; }
 		--(*m_keys);
 		--(*m_values);
+		index_rebuild_h();
 		return *this;
 	}
 	constexpr
@@ -1563,6 +1872,7 @@ struct Dict {
 		if (m_keys->len() == 0) { return *this; }
 		--(*m_keys);
 		--(*m_values);
+		index_rebuild_h();
 		return *this;
 	}
 	template <typename Numeric> requires (
@@ -1584,6 +1894,7 @@ struct Dict {
 		if (m_keys->len() == 0) { return *this; }
 		(*m_keys) -= x;
 		(*m_values) -= x;
+		index_rebuild_h();
 		return *this;
 	}
 
@@ -1676,20 +1987,22 @@ struct Dict {
 	*/
 	constexpr
 	auto& 	operator [](const Key& key) {
-		for (auto& i: indexes()) {
-			if (m_keys->get(i) == key) { return m_values->get(i); }
-		}
-		m_keys->append(key);
-		m_values->append(Value());
-		return m_values->last();
+		return value(key);
 	}
 	constexpr
 	auto& 	operator [](const Key& key) const {
-		for (auto& i: indexes()) {
-			if (m_keys->get(i) == key) { return m_values->get(i); }
-		}
+		const ullong i = find(key);
+		if (i != NPos::npos) { return m_values->get(i); }
 		throw KeyError(to_str("Key \"", key, "\" does not exist."));
 	}
+	template <typename View> requires (is_CString<View>::value && is_String<Key>::value) constexpr
+	auto& 	operator [](const View& key) {
+		return value(key);
+	}
+	template <typename View> requires (is_CString<View>::value && is_String<Key>::value) constexpr
+	auto& 	operator [](const View& key) const {
+		return value(key);
+	}
 	
 	// Dump to pipe.
 	constexpr friend
@@ -262,7 +262,7 @@ public:
 	}
 	template <typename Type> requires (is_String<Type>::value) constexpr
 	auto&   construct(Type&& x) {
-		m_str = x;
+		m_str = move(x);
 		m_type = types::string;
 		return *this;
 	}
@@ -288,7 +288,7 @@ public:
 	}
 	template <typename Type> requires (is_JArray_h<Type>() && !is_String<Type>::value) constexpr
 	auto&   construct(Type&& x) {
-		m_arr = x;
+		m_arr = move(x);
 		m_type = types::array;
 		return *this;
 	}
@@ -302,7 +302,7 @@ public:
 	}
 	constexpr
 	auto&   construct(Json&& x) {
-		m_json = x;
+		m_json = move(x);
 		m_type = types::json;
 		return *this;
 	}
@@ -881,29 +881,8 @@ public:
 	}
 
 	// As json formatted string.
-	constexpr
-	String	json() const {
-		switch (m_type) {
-		case types::null:
-			return vlib::null.json();
-		case types::boolean:
-			return m_bool->json();
-		case types::floating:
-			return m_double->json();
-		case types::integer:
-			return m_int->json();
-		case types::len:
-			return m_len->json();
-		case types::string:
-			return m_str->json();
-		case types::array:
-			return m_arr->json();
-		case types::json:
-			return m_json->json();
-		default:
-			throw TypeError(to_str("Unknown type: ", m_type, "."));
-		}
-	}
+	// - Defined in "json_writer.h".
+	String	json() const;
 
 	// ---------------------------------------------------------
 	// Operators.
@@ -1152,7 +1131,7 @@ public:
 	// Move constructor from base.
 	constexpr
 	Json (Base&& obj) :
-	Base(obj) {}
+	Base(move(obj)) {}
 
 	// Copy constructor.
 	constexpr
@@ -1162,7 +1141,7 @@ public:
 	// Move constructor.
 	constexpr
 	Json (This&& obj) :
-	Base(obj) {}
+	Base(move(obj)) {}
 
 	// ---------------------------------------------------------
 	// Assignment operators.
@@ -1221,7 +1200,7 @@ public:
 			--len;
 		}
 		This obj(parse(data, len));
-		delete[] data;
+		vlib::array<char, ullong>::destruct(data);
         return obj;
 	}
 	static inline
@@ -1247,133 +1226,21 @@ public:
 	}
     
     // Dump with indent.
-    SICE
-    String  dump(const JArray& json, const Int& indent = 4, const Int& start_indent = 0) {
-        
-        // Empty.
-        if (json.len() == 0) { return "[]"; }
-        
-        // Vars.
-        String indented;
-        indented.append('[');
-        if (indent != 0) {
-            indented.append('\n');
-        }
-        indented.fill_r(start_indent + indent, ' ');
-        ullong last_index = json.len() - 1;
-        
-        // Iterate.
-        for (auto& index: json.indexes()) {
-            
-            // Add value.
-            auto& value = json.get(index);
-            switch (value.type()) {
-                case types::array:
-                    indented << dump(value.asa(), indent, start_indent + indent);
-                    break;
-                case types::json:
-                    indented << dump(value.asj(), indent, start_indent + indent);
-                    break;
-                case types::string: {
-					indented << '"' << value.ass().escape() << '"';
-                    break;
-                }
-                default:
-                    indented << value.json();
-                    break;
-            }
-            
-            // Add post value.
-            if (index != last_index) {
-                indented << ',';
-                if (indent != 0) {
-                    indented << '\n';
-                }
-                indented.fill_r(start_indent + indent, ' ');
-            }
-            
-        }
-        
-        // Add last indent.
-        if (indent != 0) {
-            indented << '\n';
-        }
-        indented.fill_r(start_indent, ' ');
-        indented << ']';
-        return indented;
-    }
-    SICE
-    String  dump(const Json& json, const Int& indent = 4, const Int& start_indent = 0) {
-        
-        // Empty.
-        if (json.len() == 0) { return "{}"; }
-        
-        // Vars.
-        String indented;
-        indented.append('{');
-        if (indent != 0) {
-            indented.append('\n');
-        }
-        indented.fill_r(start_indent + indent, ' ');
-        ullong last_index = json.len() - 1;
-        
-        // Iterate.
-        for (auto& index: json.indexes()) {
-            
-            // Add key.
-            indented << json.key(index).json() << ": ";
-            
-            // Add value.
-            auto& value = json.value(index);
-            switch (value.type()) {
-                case types::array:
-                    indented << dump(value.asa(), indent, start_indent + indent);
-                    break;
-                case types::json:
-                    indented << dump(value.asj(), indent, start_indent + indent);
-                    break;
-                case types::string: {
-					indented << '"' << value.ass().escape() << '"';
-                    break;
-                }
-                default:
-                    indented << value.json();
-                    break;
-            }
-            
-            // Add post value.
-            if (index != last_index) {
-                indented << ',';
-                if (indent != 0) {
-                    indented << '\n';
-                }
-                indented.fill_r(start_indent + indent, ' ');
-            }
-            
-        }
-        
-        // Add last indent.
-        if (indent != 0) {
-            indented << '\n';
-        }
-        indented.fill_r(start_indent, ' ');
-        indented << '}';
-        return indented;
-        
-    }
-    constexpr
+    // - Defined in "json_writer.h".
+    static inline
+    String  dump(const JArray& json, const Int& indent = 4, const Int& start_indent = 0);
+    static inline
+    String  dump(const Json& json, const Int& indent = 4, const Int& start_indent = 0);
     String  dump(const Int& indent = 4) const {
         return dump(*this, indent);
     }
     
     // Convert to json string.
-    constexpr
     String  json() const {
         return dump(0);
     }
     
     // Convert to string.
-    constexpr
     String  str() const {
         return dump(0);
     }
@@ -1406,535 +1273,22 @@ public:
 
 	// Parse json from char*.
 	// - Only viable for a dictionary (curly brackets).
-	SICE
-	This	parse(const String& data) {
-		return parse_curly_brackets(data.data(), data.len());
-	}
-	SICE
-	This	parse(const char* data, ullong len) {
-		return parse_curly_brackets(data, len);
-	}
-	SICE
-	This	parse(const char* data) {
-		return parse_curly_brackets(data, vlib::len(data));
-	}
-
-	// Parse json from char* and ullong.
-	SICE
-	JArray	parse_brackets(const char* arr, ullong len) {
-
-		// Checks.
-        while (len > 0) {
-            switch (arr[len-1]) {
-                case '\n':
-                case ' ':
-                case '\t':
-                    --len;
-                    continue;
-                default:
-                    break;
-            }
-            break;
-        }
-		switch (len) {
-            case 0:
-            case 1:
-                throw ParseError("JSON string representation is too small.");
-            default: break;
-        }
-        switch (arr[0]) {
-            case '[': break;
-            default:
-                throw ParseError("JSON string representation of an array has an invalid start.");
-        }
-        switch (arr[len - 1]) {
-            case ']': break;
-            default:
-                throw ParseError("JSON string representation of an array has an invalid end.");
-		}
-
-		// Variables.
-		ullong 	value_start = 1; 			// start index of the new value.
-		ullong 	value_end = 0; 				// end index of the new value.
-		bool 	is_str = false; 			// is inside string.
-        bool    is_comment = false;         // is inside comment.
-		int 	depth = 0; 					// bracket depth.
-		ullong 	index = 1;					// skip first bracket.
-		ullong 	l_len = len - 1;			// skip last bracket.
-		JArray	json;
-		
-		// Funcs.
-		auto has_dot = [&]() {
-			for (auto& i: Range(value_start, value_end)) {
-				switch (arr[i]) {
-				case '.':
-					return true;
-				default:
-					continue;
-				}
-			}
-			return false;
-		};
-		auto append_value = [&]() {
-			switch (arr[value_start]) {
-				case '"': {
-					++value_start;
-					--value_end;
-					json.append(String::unescape(arr + value_start, value_end - value_start));
-					break;
-				}
-				case '{': {
-					json.append(parse_curly_brackets(arr + value_start, value_end - value_start));
-					break;
-				}
-				case '[': {
-					json.append(parse_brackets(arr + value_start, value_end - value_start));
-					break;
-				}
-				case 'N':
-				case 'n':
-					json.append(Null());
-					break;
-				case 'T':
-				case 't':
-					json.append(true);
-					break;
-				case 'F':
-				case 'f':
-					json.append(false);
-					break;
-				case '-': {
-					if (has_dot()) {
-						json.append(to_num<ldouble>(arr + value_start, value_end - value_start));
-					} else {
-						json.append(to_num<llong>(arr + value_start, value_end - value_start));
-					}
-					break;
-				}
-				default: {
-					if (has_dot()) {
-						json.append(to_num<ldouble>(arr + value_start, value_end - value_start));
-					} else {
-						auto num = to_num<ullong>(arr + value_start, value_end - value_start);
-						if (num >= limits<llong>::max) {
-							json.append(num);
-						} else {
-							json.append((llong) num);
-						}
-					}
-					break;
-				}
-
-			}
-		};
-
-		// Iterate, skip first curly bracket.
-		json.resize();
-		for (; index < l_len; ++index) {
-			if (is_str) {
-				switch (arr[index]) {
-					case '"': {
-						if (arr[index - 1] == '\\') {
-							break;
-						}
-						is_str = false;
-						break;
-					}
-					default: break;
-				}
-            } else if (is_comment && depth == 0) {
-                switch (arr[index]) {
-                    case '\n': {
-                        is_comment = false;
-                        value_start = index + 1;
-                        break;
-                    }
-                    default: break;
-                }
-			} else {
-				switch (arr[index]) {
-
-					// Skip spaces at the start of a key / value.
-					case '\n':
-					case '\t':
-					case ' ': {
-						if (index == value_start) { ++value_start; break; }
-						break;
-					}
-
-					// Found string start / end.
-					case '"': {
-						if (arr[index - 1] == '\\') {
-							break;
-						}
-						is_str = !is_str;
-						break;
-					}
-                        
-                    // Found comment start.
-                    case '/': {
-                        if (depth == 0 && !is_str && index > 0 && arr[index - 1] == '/') {
-                            is_comment = true;
-                        }
-                        break;
-                    }
-
-					// Found opening (curly) bracket.
-					case '{':
-					case '[': { ++depth; break; }
-
-					// Found closing (curly) bracket.
-					case '}':
-					case ']': { --depth; break; }
-
-					// Found end of value by delimiter.
-					case ',': {
-						switch (depth) {
-							case 0: {
-								value_end = index;
-								append_value();
-								value_start = index + 1;
-								break;
-							}
-							default: break;
-						}
-						break;
-					}
-				}
-			}
-            // if (depth < 0) {
-            //     throw ParseError("Detected multiple json's.");
-            // }
-		}
-
-		// Add last key & value.
-		if (len > 2 && value_start < l_len) {
-			value_end = l_len;
-            
-            // Remove comment behind last value.
-            // for (auto& index: Range<Backwards>(value_start, value_end)) {
-            //     switch (arr[index]) {
-            //         case '"':
-            //             break;
-            //         case '/':
-            //             if (arr[index - 1] == '/') {
-            //                 value_end = index - 1;
-            //                 break;
-            //             }
-            //             continue;
-            //         default:
-            //             continue;
-            //     }
-            //     break;
-            // }
-            
-            // Remove spaces at the end of the last value.
-			while (true) {
-				switch (arr[value_end - 1]) {
-					case ' ':
-					case '\t':
-					case '\n': { --value_end; continue; }
-					default: break;
-				}
-				break;
-			}
-            
-			append_value();
-		}
-		return json;
-	}
+	// - Defined in "json_parser.h".
+	static inline
+	This	parse(const String& data);
+	static inline
+	This	parse(const char* data, ullong len);
+	static inline
+	This	parse(const char* data);
 
-	// Parse json from char* and ullong.
-	SICE
-	This	parse_curly_brackets(const char* arr, ullong len, int limit = -1) {
-		
-		// Checks.
-        while (len > 0) {
-            switch (arr[len-1]) {
-                case '\n':
-                case ' ':
-                case '\t':
-                    --len;
-                    continue;
-                default:
-                    break;
-            }
-            break;
-        }
-		switch (len) {
-            case 0:
-            case 1:
-                throw ParseError("JSON string representation is too small.");
-            default: break;
-        }
-        switch (arr[0]) {
-            case '{': break;
-            default:
-                print("JSON string representation of a dictionary has an invalid start.");
-                throw ParseError("JSON string representation of a dictionary has an invalid start.");
-        }
-        switch (arr[len - 1]) {
-            case '}': break;
-            default:
-                print("JSON string representation of a dictionary has an invalid end [", arr[len-1], "].");
-                throw ParseError("JSON string representation of a dictionary has an invalid end.");
-		}
-		
-		// Variables.
-		ullong 	key_start = 1; 				// start index of the new key.
-		ullong 	key_end = 0; 				// end index of the new key.
-		ullong 	value_start = 0; 			// start index of the new value.
-		ullong 	value_end = 0; 				// end index of the new value.
-		bool 	is_str = false; 			// is inside string.
-        bool    is_comment = false;         // is inside comment.
-		int 	depth = 0; 					// (curly) bracket depth.
-		ullong 	index = 1;					// skip first curly bracket.
-		ullong 	l_len = len - 1;			// skip last bracket.
-		This 	json;
-		
-		auto has_dot = [&]() {
-			for (auto& i: Range(value_start, value_end)) {
-				switch (arr[i]) {
-				case '.':
-					return true;
-				default:
-					continue;
-				}
-			}
-			return false;
-		};
-		auto append_key_and_value = [&]() {
-			json.m_keys->append(String::unescape(arr + key_start, key_end - key_start));
-			switch (arr[value_start]) {
-				case '"': {
-					++value_start;
-					--value_end;
-					json.m_values->append(String::unescape(arr + value_start, value_end - value_start));
-					break;
-					/*
-                    // Manually add string so a value can also be created like this.
-                    // {"somekey": "Hello"
-                    // " World!"}
-                    // Which will have the value "Hello World!".
-                    String val;
-                    val.resize(value_end - value_start);
-                    bool val_is_str = true;
-					for (ullong i = value_start; i < value_end; ++i) {
-                        auto& c = arr[i];
-                        switch (c) {
-                            case '"': {
-                                if (arr[i - 1] == '\\') {
-                                    val.append(c);
-                                } else {
-                                    val_is_str = !val_is_str;
-                                }
-                                break;
-                            }
-                            default:
-                                if (val_is_str) {
-									val.append(c);
-									// switch (c) {
-									// 	case '\\':
-									// 		if (i + 1 == value_end) {
-									// 			val.append(c);
-									// 			break;
-									// 		}
-									// 		++i;
-									// 		switch (arr[i]) {
-									// 			case '\\':
-									// 				val.concat_r("\\\\", 2);
-									// 				break;
-									// 			case '\n':
-									// 				val.concat_r("\\n", 2);
-									// 				break;
-									// 			case '\r':
-									// 				val.concat_r("\\r", 2);
-									// 				break;
-									// 			case '\t':
-									// 				val.concat_r("\\t", 2);
-									// 				break;
-									// 			case '\b':
-									// 				val.concat_r("\\b", 2);
-									// 				break;
-									// 			case '\f':
-									// 				val.concat_r("\\f", 2);
-									// 				break;
-									// 			default:
-									// 				val.append(arr[i]);
-									// 				break;
-									// 		}
-									// 		break;
-									// 	default:
-									// 		val.append(c);
-									// 		break;
-									// }
-                                }
-                                break;
-                        }
-                    }
-					json.m_values->append(move(val));
-					break;
-					*/
-				}
-				case '{': {
-					json.m_values->append(parse_curly_brackets(arr + value_start, value_end - value_start));
-					break;
-				}
-				case '[': {
-					json.m_values->append(parse_brackets(arr + value_start, value_end - value_start));
-					break;
-				}
-				case 'N':
-				case 'n':
-					json.m_values->append(Null());
-					break;
-				case 'T':
-				case 't':
-					json.m_values->append(true);
-					break;
-				case 'F':
-				case 'f':
-					json.m_values->append(false);
-					break;
-				case '-': {
-					if (has_dot()) {
-						json.m_values->append(to_num<ldouble>(arr + value_start, value_end - value_start));
-					} else {
-						json.m_values->append(to_num<llong>(arr + value_start, value_end - value_start));
-					}
-					break;
-				}
-				default: {
-					if (has_dot()) {
-						json.m_values->append(to_num<ldouble>(arr + value_start, value_end - value_start));
-					} else {
-						auto num = to_num<ullong>(arr + value_start, value_end - value_start);
-						if (num >= limits<llong>::max) {
-							json.m_values->append(num);
-						} else {
-							json.m_values->append((llong) num);
-						}
-					}
-					break;
-				}
-
-			}
-		};
-
-		// Iterate, skip first curly bracket.
-		json.resize();
-		for (; index < l_len; ++index) {
-            if (is_str) {
-                switch (arr[index]) {
-                    case '"': {
-						if (arr[index - 1] == '\\') {
-							break;
-						}
-						is_str = false; break;
-					}
-                    default: break;
-                }
-            } else if (is_comment && depth == 0) {
-                switch (arr[index]) {
-                    case '\n': {
-                        is_comment = false;
-                        key_start = index + 1;
-                        break;
-                    }
-                    default: break;
-                }
-			} else {
-                switch (arr[index]) {
-                        
-                    // Skip spaces at the start of a key / value.
-                    case '\n':
-                    case '\t':
-                    case ' ': {
-                        if (index == key_start) { ++key_start; break; }
-                        if (index == value_start) { ++value_start; break; }
-                        break;
-                    }
-                        
-                    // Found string start / end.
-                    case '"': {
-						if (arr[index - 1] == '\\') {
-							break;
-						}
-						is_str = !is_str;
-						break;
-					}
-                        
-                    // Found comment start.
-                    case '/': {
-                        if (depth == 0 && !is_str && index > 0 && arr[index - 1] == '/') {
-                            is_comment = true;
-                        }
-                        break;
-                    }
-                        
-                    // Found opening (curly) bracket.
-                    case '{':
-                    case '[': { ++depth; break; }
-                        
-                    // Found closing (curly) bracket.
-                    case '}':
-                    case ']': { --depth; break; }
-                        
-                    // Found end of key.
-                    case ':':
-                        switch (depth) {
-                            case 0: {
-                                key_end = index;
-                                value_start = index + 1;
-                                break;
-                            }
-                            default: break;
-                        }
-                        break;
-                        
-                    // Found end of value by delimiter.
-                    case ',':
-                        switch (depth) {
-                            case 0: {
-                                ++key_start;
-                                --key_end;
-                                value_end = index;
-                                append_key_and_value();
-                                if (limit != -1 && json.len() >= (ullong) limit) {
-                                    return json;
-                                }
-                                key_start = index + 1;
-                                break;
-                            }
-                            default: break;
-                        }
-                        break;
-                }
-			}
-            // if (depth < 0) {
-            //     throw ParseError("Detected multiple json's.");
-            // }
-		}
+	// Parse a json array from char* and ullong.
+	static inline
+	JArray	parse_brackets(const char* arr, ullong len);
 
-		// Add last key & value.
-		if (key_end > key_start) {
-			++key_start;
-			--key_end;
-			value_end = l_len;
-            while (true) {
-                switch (arr[value_end - 1]) {
-                    case ' ':
-                    case '\t':
-                    case '\n':
-                    case ',': --value_end; continue;
-                    default: break;
-                }
-                break;
-            }
-			append_key_and_value();
-		}
-		return json;
-	}
+	// Parse a json dictionary from char* and ullong.
+	// - Optionally stop parsing after a limit of keys.
+	static inline
+	This	parse_curly_brackets(const char* arr, ullong len, int limit = -1);
 
 };
 }; 		// End namespace json.
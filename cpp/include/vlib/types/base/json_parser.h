@@ -0,0 +1,687 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_JSON_PARSER_T_H
+#define VLIB_JSON_PARSER_T_H
+
+// Includes.
+#include <stdlib.h> // for strtold.
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace json.
+namespace json {
+
+// ---------------------------------------------------------
+// Json parser.
+//
+// Notes:
+// - Parses in a single pass, every character is visited once regardless of the nesting depth.
+// - Uses an explicit stack instead of recursion, so the call stack is bounded for any input.
+// - The input may be fed in chunks, tokens that are split over two chunks are buffered.
+// - Accepts "//" comments and trailing commas, just like the previous parser.
+//
+/*  @docs
+	@chapter: Types
+	@title: JSON Parser
+	@description:
+		Single pass, incremental json parser.
+
+		The json data can be fed in multiple chunks, for example while the data is received from a socket.
+	@usage:
+        #include <vlib/types.h>
+		vlib::json::Parser parser;
+		parser.feed("{\"a\": [1, 2", 11);
+		parser.feed(", 3]}", 5);
+		vlib::Json x = parser.finish().json(); ==> {"a": [1, 2, 3]}
+*/
+struct Parser {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 		This = 			Parser;
+	using 		Value = 		JsonValue<Json>;
+	using 		JArray = 		Json::JArray;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Definitions.
+
+	// Parser states.
+	enum state : uchar {
+		expect_value = 0,		// expecting a value.
+		expect_key = 1,			// expecting a key or the end of a dictionary.
+		expect_colon = 2,		// expecting a colon.
+		expect_delimiter = 3,	// expecting a delimiter or the end of a dictionary / array.
+		string = 4,				// inside a string.
+		number = 5,				// inside a number.
+		literal = 6,			// inside a literal (null, true or false).
+		slash = 7,				// found the first slash of a comment.
+		comment = 8,			// inside a comment.
+		done = 9,				// parsed the root value.
+		stopped = 10,			// parsed the limit of root keys, all remaining data is ignored.
+	};
+
+	// Stack frame, either the dictionary or the array is defined.
+	struct Frame {
+		Json*		json;
+		JArray*		arr;
+	};
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	Array<Frame>	m_stack;
+	Value			m_root;
+	String			m_token;			// token that is split over multiple chunks.
+	ullong			m_offset = 0;		// offset of the current chunk in the total data.
+	ullong			m_max_depth = 1024;	// the maximum nesting depth.
+	llong			m_limit = -1;		// the maximum number of root keys, -1 for no limit.
+	uchar			m_state = state::expect_value;
+	uchar			m_comment_state = state::expect_value;	// the state to return to after a comment.
+	bool			m_is_key = false;	// the current string is a key.
+	bool			m_escaped = false;	// the previous string character was a backslash.
+	bool			m_has_escapes = false;	// the current string contains escape sequences.
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Throw a parse error.
+	[[noreturn]]
+	void 	error_h(const char* err, const char* data, const char* c) const {
+		throw ParseError(to_str("Invalid json: ", err, " [offset: ", m_offset + (c - data), "]."));
+	}
+
+	// Is number char.
+	SICE
+	bool 	is_number_h(const char c) {
+		switch (c) {
+			case '0': case '1': case '2': case '3': case '4':
+			case '5': case '6': case '7': case '8': case '9':
+			case '-': case '+': case '.': case 'e': case 'E':
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	// Is literal char.
+	SICE
+	bool 	is_literal_h(const char c) {
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+	}
+
+	// Create a new value in the current container and return a reference.
+	Value& 	slot_h() {
+		if (m_stack.len() == 0) {
+			return m_root;
+		}
+		Frame& frame = m_stack.last();
+		if (frame.json) {
+			frame.json->m_values->append(Value());
+			return frame.json->m_values->last();
+		} else {
+			frame.arr->append(Value());
+			return frame.arr->last();
+		}
+	}
+
+	// Set the state after a value has been completed.
+	void 	end_value_h() {
+		if (m_stack.len() == 0) {
+			m_state = state::done;
+		} else {
+			m_state = state::expect_delimiter;
+			if (
+				m_limit != -1 &&
+				m_stack.len() == 1 &&
+				m_stack.first().json &&
+				m_stack.first().json->len() >= (ullong) m_limit
+			) {
+				m_stack.reset();
+				m_state = state::stopped;
+			}
+		}
+	}
+
+	// Open a dictionary or array.
+	void 	open_h(const bool is_json, const char* data, const char* c) {
+		if (m_stack.len() >= m_max_depth) {
+			error_h("maximum depth exceeded", data, c);
+		}
+		Value& value = slot_h();
+		if (is_json) {
+			value.construct(Json());
+			m_stack.append(Frame { &value.asj(), nullptr });
+			m_state = state::expect_key;
+		} else {
+			value.construct(JArray());
+			m_stack.append(Frame { nullptr, &value.asa() });
+			m_state = state::expect_value;
+		}
+	}
+
+	// Close a dictionary or array.
+	void 	close_h(const bool is_json, const char* data, const char* c) {
+		if (m_stack.len() == 0 || (m_stack.last().json != nullptr) != is_json) {
+			error_h(is_json ? "unexpected \"}\"" : "unexpected \"]\"", data, c);
+		}
+		--m_stack.m_len;
+		end_value_h();
+	}
+
+	// Add a parsed string.
+	void 	add_string_h(const char* str, const ullong len) {
+		if (m_is_key) {
+			if (m_has_escapes) {
+				m_stack.last().json->m_keys->append(String::unescape(str, len));
+			} else {
+				m_stack.last().json->m_keys->append(String(str, len));
+			}
+			m_state = state::expect_colon;
+		} else {
+			if (m_has_escapes) {
+				slot_h().construct(String::unescape(str, len));
+			} else {
+				slot_h().construct(str, len);
+			}
+			end_value_h();
+		}
+	}
+
+	// Add a parsed number.
+	void 	add_number_h(const char* str, const ullong len, const char* data, const char* c) {
+		bool is_floating = false;
+		bool is_negative = str[0] == '-';
+		ullong x = 0;
+		for (ullong i = is_negative ? 1 : 0; i < len; ++i) {
+			switch (str[i]) {
+				case '.':
+				case 'e':
+				case 'E':
+					is_floating = true;
+					break;
+				case '-':
+				case '+':
+					if (!is_floating) { error_h("invalid number", data, c); }
+					break;
+				default:
+					if (!is_floating) {
+						const ullong digit = str[i] - '0';
+						if (x > (limits<ullong>::max - digit) / 10) {
+							is_floating = true; // too large for an integer.
+						} else {
+							x = x * 10 + digit;
+						}
+					}
+					break;
+			}
+		}
+		if (len == (ullong) is_negative) {
+			error_h("invalid number", data, c);
+		}
+		if (is_floating) {
+			char buff[64];
+			char* end = nullptr;
+			ldouble y;
+			if (len < 64) {
+				vlib::array<char, ullong>::copy(buff, str, len);
+				buff[len] = '\0';
+				y = ::strtold(buff, &end);
+				if (end != buff + len) { error_h("invalid number", data, c); }
+			} else {
+				String copy (str, len);
+				y = ::strtold(copy.c_str(), &end);
+				if (end != copy.data() + len) { error_h("invalid number", data, c); }
+			}
+			slot_h().construct(y);
+		} else if (is_negative) {
+			if (x > (ullong) limits<llong>::max + 1) {
+				slot_h().construct((ldouble) -((ldouble) x));
+			} else {
+				slot_h().construct((llong) (0 - x));
+			}
+		} else if (x >= (ullong) limits<llong>::max) {
+			slot_h().construct(x);
+		} else {
+			slot_h().construct((llong) x);
+		}
+		end_value_h();
+	}
+
+	// Add a parsed literal.
+	void 	add_literal_h(const char* str, const ullong len, const char* data, const char* c) {
+		switch (str[0]) {
+			case 'N':
+			case 'n':
+				if (len != 4) { break; }
+				slot_h().construct(Null());
+				end_value_h();
+				return ;
+			case 'T':
+			case 't':
+				if (len != 4) { break; }
+				slot_h().construct(true);
+				end_value_h();
+				return ;
+			case 'F':
+			case 'f':
+				if (len != 5) { break; }
+				slot_h().construct(false);
+				end_value_h();
+				return ;
+			default:
+				break;
+		}
+		error_h("invalid literal", data, c);
+	}
+
+	// Add a token that has been scanned until "c".
+	// - Uses the buffered token when the token started in a previous chunk.
+	template <typename Func>
+	void 	add_token_h(const char* start, const char* c, Func&& add) {
+		if (m_token.len() == 0) {
+			add(start, c - start);
+		} else {
+			m_token.concat_r(start, c - start);
+			add(m_token.data(), m_token.len());
+			m_token.reset();
+		}
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Default constructor.
+	Parser () = default;
+
+	// Constructor with a maximum depth and a limit of root keys.
+	Parser (const ullong max_depth, const llong limit = -1) :
+	m_max_depth(max_depth),
+	m_limit(limit) {}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Reset the parser.
+	/*  @docs
+		@title: Reset
+		@description: Reset the parser so it can be used for new data.
+	*/
+	This& 	reset() {
+		m_stack.reset();
+		m_root.reset();
+		m_token.reset();
+		m_offset = 0;
+		m_state = state::expect_value;
+		m_comment_state = state::expect_value;
+		m_is_key = false;
+		m_escaped = false;
+		m_has_escapes = false;
+		return *this;
+	}
+
+	// Is done.
+	/*  @docs
+		@title: Is done
+		@description: Check if the root value has been parsed completely.
+	*/
+	bool 	is_done() const {
+		return m_state == state::done || m_state == state::stopped;
+	}
+
+	// Feed a chunk of data.
+	/*  @docs
+		@title: Feed
+		@description:
+			Parse a chunk of json data.
+
+			Throws a `ParseError` when the data is invalid.
+		@parameter:
+			@name: data
+			@description: The chunk of data.
+		@parameter:
+			@name: len
+			@description: The length of the chunk.
+	*/
+	This& 	feed(const char* data, const ullong len) {
+		const char* c = data;
+		const char* end = data + len;
+		while (c < end) {
+			switch (m_state) {
+
+				// Expecting a value.
+				case state::expect_value:
+					switch (*c) {
+						case ' ': case '\t': case '\n': case '\r':
+							++c;
+							continue;
+						case '/':
+							m_comment_state = m_state;
+							m_state = state::slash;
+							++c;
+							continue;
+						case '{':
+							open_h(true, data, c);
+							++c;
+							continue;
+						case '[':
+							open_h(false, data, c);
+							++c;
+							continue;
+						case ']':
+							// Empty array or trailing comma.
+							close_h(false, data, c);
+							++c;
+							continue;
+						case '"':
+							m_is_key = false;
+							m_escaped = false;
+							m_has_escapes = false;
+							m_state = state::string;
+							++c;
+							continue;
+						default:
+							if ((*c >= '0' && *c <= '9') || *c == '-') {
+								m_state = state::number;
+							} else if (is_literal_h(*c)) {
+								m_state = state::literal;
+							} else {
+								error_h("expected a value", data, c);
+							}
+							continue;
+					}
+
+				// Expecting a key or the end of a dictionary.
+				case state::expect_key:
+					switch (*c) {
+						case ' ': case '\t': case '\n': case '\r':
+							++c;
+							continue;
+						case '/':
+							m_comment_state = m_state;
+							m_state = state::slash;
+							++c;
+							continue;
+						case '}':
+							// Empty dictionary or trailing comma.
+							close_h(true, data, c);
+							++c;
+							continue;
+						case '"':
+							m_is_key = true;
+							m_escaped = false;
+							m_has_escapes = false;
+							m_state = state::string;
+							++c;
+							continue;
+						default:
+							error_h("expected a key", data, c);
+					}
+
+				// Expecting a colon.
+				case state::expect_colon:
+					switch (*c) {
+						case ' ': case '\t': case '\n': case '\r':
+							++c;
+							continue;
+						case '/':
+							m_comment_state = m_state;
+							m_state = state::slash;
+							++c;
+							continue;
+						case ':':
+							m_state = state::expect_value;
+							++c;
+							continue;
+						default:
+							error_h("expected a colon", data, c);
+					}
+
+				// Expecting a delimiter or the end of a dictionary / array.
+				case state::expect_delimiter:
+					switch (*c) {
+						case ' ': case '\t': case '\n': case '\r':
+							++c;
+							continue;
+						case '/':
+							m_comment_state = m_state;
+							m_state = state::slash;
+							++c;
+							continue;
+						case ',':
+							m_state = m_stack.last().json ? state::expect_key : state::expect_value;
+							++c;
+							continue;
+						case '}':
+							close_h(true, data, c);
+							++c;
+							continue;
+						case ']':
+							close_h(false, data, c);
+							++c;
+							continue;
+						default:
+							error_h("expected a delimiter", data, c);
+					}
+
+				// Inside a string.
+				case state::string: {
+					const char* start = c;
+					while (c < end) {
+						if (m_escaped) {
+							m_escaped = false;
+						} else if (*c == '\\') {
+							m_escaped = true;
+							m_has_escapes = true;
+						} else if (*c == '"') {
+							break;
+						}
+						++c;
+					}
+					if (c == end) {
+						m_token.concat_r(start, c - start);
+						continue;
+					}
+					add_token_h(start, c, [&](const char* str, ullong str_len) {
+						add_string_h(str, str_len);
+					});
+					++c;
+					continue;
+				}
+
+				// Inside a number.
+				case state::number: {
+					const char* start = c;
+					while (c < end && is_number_h(*c)) { ++c; }
+					if (c == end) {
+						m_token.concat_r(start, c - start);
+						continue;
+					}
+					add_token_h(start, c, [&](const char* str, ullong str_len) {
+						add_number_h(str, str_len, data, c);
+					});
+					continue;
+				}
+
+				// Inside a literal.
+				case state::literal: {
+					const char* start = c;
+					while (c < end && is_literal_h(*c)) { ++c; }
+					if (c == end) {
+						m_token.concat_r(start, c - start);
+						continue;
+					}
+					add_token_h(start, c, [&](const char* str, ullong str_len) {
+						add_literal_h(str, str_len, data, c);
+					});
+					continue;
+				}
+
+				// Found the first slash of a comment.
+				case state::slash:
+					if (*c != '/') {
+						error_h("invalid comment", data, c);
+					}
+					m_state = state::comment;
+					++c;
+					continue;
+
+				// Inside a comment.
+				case state::comment:
+					while (c < end && *c != '\n') { ++c; }
+					if (c < end) {
+						m_state = m_comment_state;
+						++c;
+					}
+					continue;
+
+				// Parsed the root value.
+				case state::done:
+					switch (*c) {
+						case ' ': case '\t': case '\n': case '\r': case '\0':
+							++c;
+							continue;
+						case '/':
+							m_comment_state = m_state;
+							m_state = state::slash;
+							++c;
+							continue;
+						default:
+							error_h("unexpected data after the end", data, c);
+					}
+
+				// Ignore all remaining data.
+				case state::stopped:
+					m_offset += len;
+					return *this;
+
+			}
+		}
+		m_offset += len;
+		return *this;
+	}
+	This& 	feed(const String& data) {
+		return feed(data.data(), data.len());
+	}
+
+	// Finish.
+	/*  @docs
+		@title: Finish
+		@description:
+			Finish the parsing after all data has been fed.
+
+			Throws a `ParseError` when the json data is incomplete.
+	*/
+	This& 	finish() {
+		const char* data = m_token.data();
+		const char* c = data + m_token.len();
+		switch (m_state) {
+			case state::number:
+				add_token_h(c, c, [&](const char* str, ullong str_len) {
+					add_number_h(str, str_len, data, c);
+				});
+				break;
+			case state::literal:
+				add_token_h(c, c, [&](const char* str, ullong str_len) {
+					add_literal_h(str, str_len, data, c);
+				});
+				break;
+			case state::comment:
+				m_state = m_comment_state;
+				break;
+			default:
+				break;
+		}
+		if (!is_done()) {
+			throw ParseError(to_str("Invalid json: unexpected end of data [offset: ", m_offset, "]."));
+		}
+		return *this;
+	}
+
+	// Get the parsed value.
+	/*  @docs
+		@title: Value
+		@description: Get the parsed root value.
+	*/
+	Value& 	value() {
+		return m_root;
+	}
+
+	// Get the parsed dictionary.
+	/*  @docs
+		@title: Json
+		@description:
+			Move the parsed root dictionary out of the parser.
+
+			Throws a `ParseError` when the root value is not a dictionary.
+	*/
+	Json 	json() {
+		if (!m_root.isj()) {
+			throw ParseError("JSON string representation of a dictionary has an invalid start.");
+		}
+		return move(m_root.asj());
+	}
+
+	// Get the parsed array.
+	/*  @docs
+		@title: Array
+		@description:
+			Move the parsed root array out of the parser.
+
+			Throws a `ParseError` when the root value is not an array.
+	*/
+	JArray 	array() {
+		if (!m_root.isa()) {
+			throw ParseError("JSON string representation of an array has an invalid start.");
+		}
+		return move(m_root.asa());
+	}
+
+};
+
+// ---------------------------------------------------------
+// Json parse functions.
+
+// Define the "Json::parse" functions.
+inline
+Json	Json::parse(const String& data) {
+	return parse_curly_brackets(data.data(), data.len());
+}
+inline
+Json	Json::parse(const char* data, ullong len) {
+	return parse_curly_brackets(data, len);
+}
+inline
+Json	Json::parse(const char* data) {
+	return parse_curly_brackets(data, vlib::len(data));
+}
+
+// Define the "Json::parse_brackets" function.
+inline
+Json::JArray	Json::parse_brackets(const char* arr, ullong len) {
+	Parser parser;
+	return parser.feed(arr, len).finish().array();
+}
+
+// Define the "Json::parse_curly_brackets" function.
+inline
+Json	Json::parse_curly_brackets(const char* arr, ullong len, int limit) {
+	Parser parser (1024, limit);
+	return parser.feed(arr, len).finish().json();
+}
+
+}; 		// End namespace json.
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -0,0 +1,546 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_JSON_READER_T_H
+#define VLIB_JSON_READER_T_H
+
+// Includes.
+#include <stdlib.h> // for strtold.
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace json.
+namespace json {
+
+// Namespace events.
+namespace events {
+
+// Json reader events.
+/* 	@docs
+	@chapter: Types
+	@title: JSON Reader Events
+	@description:
+		The events of the json reader.
+	@show_code: true
+*/
+enum events {
+	none = 			0,
+	start_object = 	1,
+	end_object = 	2,
+	start_array = 	3,
+	end_array = 	4,
+	key = 			5,
+	string = 		6,
+	number = 		7,
+	boolean = 		8,
+	null = 			9,
+};
+
+}; 		// End namespace events.
+
+// ---------------------------------------------------------
+// Json reader.
+//
+// Notes:
+// - A pull reader that does not allocate a tree, all views point into the original data.
+// - The data must stay alive while the reader and its views are used.
+// - Uses an explicit stack so the call stack is bounded for any input.
+//
+/*  @docs
+	@chapter: Types
+	@title: JSON Reader
+	@description:
+		Pull style json reader.
+
+		Every call to `next()` advances to the next event and exposes its view into the original data, no `Json` tree is constructed.
+	@usage:
+        #include <vlib/types.h>
+		vlib::json::Reader reader ("{\"id\": 1, \"user\": {\"name\": \"Alice\"}}");
+		while (reader.next()) {
+			if (reader.event() == vlib::json::events::key && reader.view() == "name") {
+				reader.next();
+				reader.view(); ==> Alice
+			}
+		}
+		// Or search a key of the current object.
+		reader.reset();
+		reader.next(); // start_object.
+		if (reader.find("id", 2)) {
+			reader.next();
+			reader.as_int(); ==> 1
+		}
+*/
+struct Reader {
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 		This = 			Reader;
+
+	// ---------------------------------------------------------
+	// Definitions.
+
+	// Expected tokens.
+	enum expect : uchar {
+		expect_value = 0,
+		expect_key = 1,
+		expect_delimiter = 2,
+		expect_end = 3,
+	};
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	const char*		m_data = nullptr;
+	ullong			m_len = 0;
+	ullong			m_pos = 0;
+	Array<bool>		m_stack;				// true for an object, false for an array.
+	CString			m_view;
+	uchar			m_event = events::none;
+	uchar			m_expect = expect::expect_value;
+	bool			m_has_escapes = false;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Throw a parse error.
+	[[noreturn]]
+	void 	error_h(const char* err) const {
+		throw ParseError(to_str("Invalid json: ", err, " [offset: ", m_pos, "]."));
+	}
+
+	// Skip whitespace and comments.
+	void 	skip_space_h() {
+		while (m_pos < m_len) {
+			switch (m_data[m_pos]) {
+				case ' ':
+				case '\t':
+				case '\n':
+				case '\r':
+					++m_pos;
+					continue;
+				case '/':
+					if (m_pos + 1 >= m_len || m_data[m_pos + 1] != '/') {
+						error_h("invalid comment");
+					}
+					while (m_pos < m_len && m_data[m_pos] != '\n') { ++m_pos; }
+					continue;
+				default:
+					return ;
+			}
+		}
+	}
+
+	// Set the expected token after a value.
+	void 	end_value_h() {
+		m_expect = m_stack.len() == 0 ? expect::expect_end : expect::expect_delimiter;
+	}
+
+	// Scan a string, "m_pos" must be at the opening quote.
+	void 	scan_string_h() {
+		const ullong start = ++m_pos;
+		m_has_escapes = false;
+		while (m_pos < m_len) {
+			switch (m_data[m_pos]) {
+				case '\\':
+					m_has_escapes = true;
+					m_pos += 2;
+					continue;
+				case '"':
+					m_view.construct(m_data + start, m_pos - start);
+					++m_pos;
+					return ;
+				default:
+					++m_pos;
+					continue;
+			}
+		}
+		error_h("unterminated string");
+	}
+
+	// Open an object or array.
+	bool 	open_h(const bool is_object) {
+		++m_pos;
+		m_stack.append(is_object);
+		m_view.construct(m_data + m_pos - 1, 1);
+		if (is_object) {
+			m_event = events::start_object;
+			m_expect = expect::expect_key;
+		} else {
+			m_event = events::start_array;
+			m_expect = expect::expect_value;
+		}
+		return true;
+	}
+
+	// Close an object or array.
+	bool 	close_h(const bool is_object) {
+		if (m_stack.len() == 0 || m_stack.last() != is_object) {
+			error_h(is_object ? "unexpected \"}\"" : "unexpected \"]\"");
+		}
+		--m_stack.m_len;
+		m_view.construct(m_data + m_pos, 1);
+		++m_pos;
+		m_event = is_object ? events::end_object : events::end_array;
+		end_value_h();
+		return true;
+	}
+
+	// Read a value.
+	bool 	value_h() {
+		const char c = m_data[m_pos];
+		switch (c) {
+			case '{':
+				return open_h(true);
+			case '[':
+				return open_h(false);
+			case ']':
+				// Empty array or trailing comma.
+				return close_h(false);
+			case '"':
+				scan_string_h();
+				m_event = events::string;
+				end_value_h();
+				return true;
+			default:
+				break;
+		}
+		const ullong start = m_pos;
+		if ((c >= '0' && c <= '9') || c == '-') {
+			while (m_pos < m_len) {
+				switch (m_data[m_pos]) {
+					case '0': case '1': case '2': case '3': case '4':
+					case '5': case '6': case '7': case '8': case '9':
+					case '-': case '+': case '.': case 'e': case 'E':
+						++m_pos;
+						continue;
+					default:
+						break;
+				}
+				break;
+			}
+			m_event = events::number;
+		} else if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) {
+			while (m_pos < m_len && ((m_data[m_pos] >= 'a' && m_data[m_pos] <= 'z') || (m_data[m_pos] >= 'A' && m_data[m_pos] <= 'Z'))) {
+				++m_pos;
+			}
+			switch (m_pos - start == 4 || m_pos - start == 5 ? c : '\0') {
+				case 'n':
+				case 'N':
+					m_event = events::null;
+					break;
+				case 't':
+				case 'T':
+				case 'f':
+				case 'F':
+					m_event = events::boolean;
+					break;
+				default:
+					m_pos = start;
+					error_h("invalid literal");
+			}
+		} else {
+			error_h("expected a value");
+		}
+		m_view.construct(m_data + start, m_pos - start);
+		end_value_h();
+		return true;
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Default constructor.
+	Reader () = default;
+
+	// Constructor from a char array.
+	Reader (const char* data, const ullong len) :
+	m_data(data),
+	m_len(len) {}
+	Reader (const char* data) :
+	m_data(data),
+	m_len(vlib::len(data)) {}
+
+	// Constructor from a String.
+	// - The string must stay alive while the reader is used.
+	Reader (const String& data) :
+	m_data(data.data()),
+	m_len(data.len()) {}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Reset the reader to the start of the data.
+	/*  @docs
+		@title: Reset
+		@description: Reset the reader to the start of the data.
+	*/
+	This& 	reset() {
+		m_pos = 0;
+		m_stack.reset();
+		m_view.reset();
+		m_event = events::none;
+		m_expect = expect::expect_value;
+		m_has_escapes = false;
+		return *this;
+	}
+
+	// Advance to the next event.
+	/*  @docs
+		@title: Next
+		@description:
+			Advance to the next event.
+
+			Returns `false` at the end of the data, throws a `ParseError` when the data is invalid.
+	*/
+	bool 	next() {
+		while (true) {
+			skip_space_h();
+			if (m_pos >= m_len) {
+				if (m_expect != expect::expect_end) {
+					error_h("unexpected end of data");
+				}
+				m_event = events::none;
+				m_view.reset();
+				return false;
+			}
+			const char c = m_data[m_pos];
+			switch (m_expect) {
+				case expect::expect_value:
+					return value_h();
+				case expect::expect_key:
+					switch (c) {
+						case '"':
+							scan_string_h();
+							skip_space_h();
+							if (m_pos >= m_len || m_data[m_pos] != ':') {
+								error_h("expected a colon");
+							}
+							++m_pos;
+							m_event = events::key;
+							m_expect = expect::expect_value;
+							return true;
+						case '}':
+							// Empty object or trailing comma.
+							return close_h(true);
+						default:
+							error_h("expected a key");
+					}
+				case expect::expect_delimiter:
+					switch (c) {
+						case ',':
+							++m_pos;
+							m_expect = m_stack.last() ? expect::expect_key : expect::expect_value;
+							continue;
+						case '}':
+							return close_h(true);
+						case ']':
+							return close_h(false);
+						default:
+							error_h("expected a delimiter");
+					}
+				case expect::expect_end:
+				default:
+					if (c == '\0') {
+						m_pos = m_len;
+						continue;
+					}
+					error_h("unexpected data after the end");
+			}
+		}
+	}
+
+	// Skip the current value.
+	/*  @docs
+		@title: Skip
+		@description:
+			Skip the current object or array including all its children.
+
+			Does nothing when the current event is not `start_object` or `start_array`.
+	*/
+	This& 	skip() {
+		if (m_event != events::start_object && m_event != events::start_array) {
+			return *this;
+		}
+		const ullong depth = m_stack.len() - 1;
+		while (next()) {
+			if (m_stack.len() == depth && (m_event == events::end_object || m_event == events::end_array)) {
+				break;
+			}
+		}
+		return *this;
+	}
+
+	// Find a key in the current object.
+	/*  @docs
+		@title: Find
+		@description:
+			Advance to a key of the current object, nested objects are skipped.
+
+			Returns `false` when the end of the current object is reached, the next event will then be the event after the object.
+
+			The key is compared with the raw data, so escape sequences are not unescaped.
+		@usage:
+			vlib::json::Reader reader ("{\"a\": {\"b\": 1}, \"b\": 2}");
+			reader.next();
+			reader.find("b", 1); ==> true
+			reader.next();
+			reader.as_int(); ==> 2
+	*/
+	bool 	find(const char* key, const ullong len) {
+		const ullong depth = m_stack.len();
+		while (next()) {
+			if (m_stack.len() < depth) {
+				return false;
+			}
+			if (m_event == events::key) {
+				if (m_stack.len() == depth && m_view.eq(key, len)) {
+					return true;
+				}
+			} else {
+				skip();
+			}
+		}
+		return false;
+	}
+	bool 	find(const char* key) {
+		return find(key, vlib::len(key));
+	}
+
+	// ---------------------------------------------------------
+	// Attribute functions.
+
+	// The current event.
+	/*  @docs
+		@title: Event
+		@description: Get the current event, see `json::events`.
+	*/
+	auto 	event() const { return m_event; }
+
+	// The current view.
+	/*  @docs
+		@title: View
+		@description:
+			Get a view of the current event's data.
+
+			The quotes of keys and strings are excluded, but escape sequences are not unescaped.
+	*/
+	auto& 	view() const { return m_view; }
+
+	// Has escapes.
+	/*  @docs
+		@title: Has escapes
+		@description: Check if the current key or string contains escape sequences.
+	*/
+	bool 	has_escapes() const { return m_has_escapes; }
+
+	// The current nesting depth.
+	/*  @docs
+		@title: Depth
+		@description: Get the current nesting depth.
+	*/
+	ullong 	depth() const { return m_stack.len(); }
+
+	// The offset of the reader in the data.
+	/*  @docs
+		@title: Offset
+		@description: Get the offset of the reader in the data.
+	*/
+	ullong 	offset() const { return m_pos; }
+
+	// ---------------------------------------------------------
+	// Casts.
+
+	// As unescaped string.
+	/*  @docs
+		@title: String
+		@description: Get the current key or string as an unescaped `String`.
+	*/
+	String 	str() const {
+		if (m_has_escapes) {
+			return String::unescape(m_view.data(), m_view.len());
+		}
+		return String(m_view.data(), m_view.len());
+	}
+
+	// As boolean.
+	/*  @docs
+		@title: As bool
+		@description: Get the current boolean value.
+	*/
+	bool 	as_bool() const {
+		if (m_event != events::boolean) {
+			throw TypeError("The current event is not a boolean.");
+		}
+		return m_view.first() == 't' || m_view.first() == 'T';
+	}
+
+	// As integer.
+	/*  @docs
+		@title: As int
+		@description:
+			Get the current number as a signed integer.
+
+			Throws a `ParseError` when the number does not fit a `llong`.
+	*/
+	llong 	as_int() const {
+		if (m_event != events::number) {
+			throw TypeError("The current event is not a number.");
+		}
+		const char* data = m_view.data();
+		const ullong len = m_view.len();
+		const bool is_negative = data[0] == '-';
+		const ullong max = is_negative ? (ullong) limits<llong>::max + 1 : (ullong) limits<llong>::max;
+		ullong x = 0;
+		for (ullong i = is_negative ? 1 : 0; i < len; ++i) {
+			if (data[i] < '0' || data[i] > '9') {
+				const ldouble y = as_float();
+				if (y >= (ldouble) limits<llong>::max || y < (ldouble) limits<llong>::min) {
+					throw ParseError(to_str("Number \"", m_view, "\" does not fit a signed integer."));
+				}
+				return (llong) y;
+			}
+			const ullong digit = data[i] - '0';
+			if (x > (max - digit) / 10) {
+				throw ParseError(to_str("Number \"", m_view, "\" does not fit a signed integer."));
+			}
+			x = x * 10 + digit;
+		}
+		return is_negative ? (llong) (0 - x) : (llong) x;
+	}
+
+	// As floating.
+	/*  @docs
+		@title: As float
+		@description:
+			Get the current number as a floating.
+
+			Throws a `ParseError` when the number is longer than 63 chars.
+	*/
+	ldouble as_float() const {
+		if (m_event != events::number) {
+			throw TypeError("The current event is not a number.");
+		}
+		char buff[64];
+		const ullong len = m_view.len();
+		if (len > 63) {
+			throw ParseError(to_str("Number \"", m_view, "\" is too long to be parsed."));
+		}
+		vlib::array<char, ullong>::copy(buff, m_view.data(), len);
+		buff[len] = '\0';
+		return ::strtold(buff, nullptr);
+	}
+
+};
+
+}; 		// End namespace json.
+}; 		// End namespace vlib.
+#endif 	// End header.
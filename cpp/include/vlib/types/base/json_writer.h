@@ -0,0 +1,447 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_JSON_WRITER_T_H
+#define VLIB_JSON_WRITER_T_H
+
+// Includes.
+#include <charconv> // for std::to_chars.
+#include <string.h> // for memcpy.
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace json.
+namespace json {
+
+// ---------------------------------------------------------
+// Json writer.
+//
+// Notes:
+// - Writes the entire tree into a single buffer that grows geometrically, no intermediate strings are created.
+// - When a sink is assigned the buffer is flushed into the sink once it exceeds the flush size, the sink must have a "write(const char*, ullong)" function, for example a "vlib::File".
+// - Doubles are written with the shortest representation that parses back to the same double, NaN and infinity are written as "null".
+// - An indent of zero writes compact json without any whitespace.
+//
+/*  @docs
+	@chapter: Types
+	@title: JSON Writer
+	@description:
+		Single buffer json writer.
+
+		The buffer is reused between calls, so a single writer can serialize many json objects without reallocating.
+	@usage:
+        #include <vlib/types.h>
+		vlib::Json x = {{"a", 1}, {"b", 1.5}};
+		vlib::json::Writer writer;
+		writer.value(x);
+		writer.str(); ==> {"a":1,"b":1.5}
+		writer.reset().indent(4).value(x);
+		writer.str(); ==> {\n    "a": 1,\n    "b": 1.5\n}
+		// Or write directly into a file.
+		vlib::File file ("/tmp/file.json", vlib::file::mode::write);
+		file.open();
+		vlib::json::Writer<vlib::File> file_writer (file);
+		file_writer.value(x).flush();
+		file.close();
+*/
+template <typename Sink = Null>
+struct Writer {
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 		This = 			Writer;
+	using 		Value = 		JsonValue<Json>;
+	using 		JArray = 		Json::JArray;
+
+// Private.
+private:
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	String		m_buff;
+	Sink*		m_sink = nullptr;
+	ullong		m_flush = 64 * 1024;
+	int			m_indent = 0;
+	int			m_start_indent = 0;
+
+	// ---------------------------------------------------------
+	// Definitions.
+
+	// Characters that must be escaped inside a json string.
+	// - 0 means the character can be copied, otherwise the char after the backslash, "u" for "\u00XX".
+	static inline constexpr char m_escapes[256] = {
+		'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+		'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+		0, 0, '"', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, '\\', 0, 0, 0,
+	};
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Has sink.
+	SICEBOOL has_sink_h() { return !is_Null<Sink>::value; }
+
+	// Flush the buffer into the sink.
+	constexpr
+	void	flush_h() {
+		if constexpr (has_sink_h()) {
+			if (m_sink != nullptr && m_buff.m_len > 0) {
+				m_sink->write(m_buff.m_arr, m_buff.m_len);
+				m_buff.m_len = 0;
+			}
+		}
+	}
+
+	// Make sure the buffer has room for an additional length.
+	constexpr
+	void	reserve_h(ullong len) {
+		if constexpr (has_sink_h()) {
+			if (m_buff.m_len + len > m_flush) {
+				flush_h();
+			}
+		}
+		if (m_buff.m_len + len > m_buff.m_capacity) {
+			ullong capacity = m_buff.m_capacity * 2;
+			if (capacity < m_buff.m_len + len) { capacity = m_buff.m_len + len; }
+			if (capacity < 64) { capacity = 64; }
+			m_buff.resize(capacity);
+		}
+	}
+
+	// Write data.
+	constexpr
+	void	write_h(const char* data, ullong len) {
+		reserve_h(len);
+		memcpy(m_buff.m_arr + m_buff.m_len, data, len);
+		m_buff.m_len += len;
+	}
+	constexpr
+	void	write_h(char c) {
+		reserve_h(1);
+		m_buff.m_arr[m_buff.m_len++] = c;
+	}
+
+	// Write a newline followed by an indent.
+	constexpr
+	void	newline_h(int indent) {
+		reserve_h(indent + 1);
+		m_buff.m_arr[m_buff.m_len++] = '\n';
+		memset(m_buff.m_arr + m_buff.m_len, ' ', indent);
+		m_buff.m_len += indent;
+	}
+
+	// Write an unsigned integer.
+	constexpr
+	void	write_uint_h(ullong x) {
+		char digits[24];
+		int pos = 24;
+		do {
+			digits[--pos] = (char) ('0' + x % 10);
+			x /= 10;
+		} while (x != 0);
+		write_h(digits + pos, 24 - pos);
+	}
+
+	// Write a signed integer.
+	constexpr
+	void	write_int_h(llong x) {
+		if (x < 0) {
+			write_h('-');
+			write_uint_h(~((ullong) x) + 1);
+		} else {
+			write_uint_h((ullong) x);
+		}
+	}
+
+	// Write a double with the shortest representation that round trips.
+	void	write_double_h(double x) {
+		if (x != x || x - x != 0) {
+			write_h("null", 4);
+			return ;
+		}
+		char digits[32];
+		const int len = (int) (std::to_chars(digits, digits + sizeof(digits), x).ptr - digits);
+		write_h(digits, len);
+
+		// Keep the floating type when the json is parsed again.
+		for (int i = 0; i < len; ++i) {
+			switch (digits[i]) {
+				case '.':
+				case 'e':
+					return ;
+				default:
+					break;
+			}
+		}
+		write_h(".0", 2);
+	}
+
+	// Write a quoted and escaped string.
+	constexpr
+	void	write_string_h(const char* data, ullong len) {
+		reserve_h(len + 2);
+		m_buff.m_arr[m_buff.m_len++] = '"';
+		ullong start = 0;
+		for (ullong i = 0; i < len; ++i) {
+			const char escape = m_escapes[(uchar) data[i]];
+			if (escape == 0) { continue; }
+			write_h(data + start, i - start);
+			start = i + 1;
+			if (escape == 'u') {
+				constexpr const char* hex = "0123456789abcdef";
+				const char seq[6] = {'\\', 'u', '0', '0', hex[((uchar) data[i]) >> 4], hex[((uchar) data[i]) & 0xf]};
+				write_h(seq, 6);
+			} else {
+				const char seq[2] = {'\\', escape};
+				write_h(seq, 2);
+			}
+		}
+		write_h(data + start, len - start);
+		write_h('"');
+	}
+
+	// Write an array.
+	void	write_array_h(const JArray& arr, int indent) {
+		if (arr.m_len == 0) {
+			write_h("[]", 2);
+			return ;
+		}
+		write_h('[');
+		const int child_indent = indent + m_indent;
+		for (ullong i = 0; i < arr.m_len; ++i) {
+			if (i != 0) { write_h(','); }
+			if (m_indent != 0) { newline_h(child_indent); }
+			write_value_h(arr.m_arr[i], child_indent);
+		}
+		if (m_indent != 0) { newline_h(indent); }
+		write_h(']');
+	}
+
+	// Write a dictionary.
+	void	write_json_h(const Json& json, int indent) {
+		const auto& keys = json.keys();
+		const auto& values = json.values();
+		if (keys.m_len == 0) {
+			write_h("{}", 2);
+			return ;
+		}
+		write_h('{');
+		const int child_indent = indent + m_indent;
+		for (ullong i = 0; i < keys.m_len; ++i) {
+			if (i != 0) { write_h(','); }
+			if (m_indent != 0) { newline_h(child_indent); }
+			write_string_h(keys.m_arr[i].m_arr, keys.m_arr[i].m_len);
+			if (m_indent != 0) {
+				write_h(": ", 2);
+			} else {
+				write_h(':');
+			}
+			write_value_h(values.m_arr[i], child_indent);
+		}
+		if (m_indent != 0) { newline_h(indent); }
+		write_h('}');
+	}
+
+	// Write any value.
+	void	write_value_h(const Value& value, int indent) {
+		switch (value.type()) {
+			case types::null:
+				write_h("null", 4);
+				break;
+			case types::boolean:
+				if ((bool) value.asb()) {
+					write_h("true", 4);
+				} else {
+					write_h("false", 5);
+				}
+				break;
+			case types::floating:
+				write_double_h((double) value.asf().value());
+				break;
+			case types::integer:
+				write_int_h(value.asi().value());
+				break;
+			case types::len:
+				write_uint_h(value.asl().value());
+				break;
+			case types::string:
+				write_string_h(value.ass().m_arr, value.ass().m_len);
+				break;
+			case types::array:
+				write_array_h(value.asa(), indent);
+				break;
+			case types::json:
+				write_json_h(value.asj(), indent);
+				break;
+			default:
+				throw TypeError(to_str("Unknown type: ", value.type(), "."));
+		}
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructor.
+
+	// Default constructor.
+	constexpr
+	Writer() = default;
+
+	// Constructor from an indent.
+	constexpr
+	Writer(int indent, int start_indent = 0) :
+	m_indent(indent),
+	m_start_indent(start_indent) {}
+
+	// Constructor from a sink.
+	constexpr
+	Writer(Sink& sink, int indent = 0) requires (!is_Null<Sink>::value) :
+	m_sink(&sink),
+	m_indent(indent) {}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Set the indent.
+	/*  @docs
+		@title: Indent
+		@description:
+			Set the indent, zero writes compact json.
+	*/
+	constexpr
+	This&	indent(int indent) {
+		m_indent = indent;
+		return *this;
+	}
+
+	// Set the flush size.
+	/*  @docs
+		@title: Flush size
+		@description:
+			Set the size in bytes after which the buffer is flushed into the sink.
+	*/
+	constexpr
+	This&	flush_size(ullong size) {
+		m_flush = size;
+		return *this;
+	}
+
+	// Reserve the buffer.
+	/*  @docs
+		@title: Reserve
+		@description:
+			Reserve space in the buffer for an expected output length.
+	*/
+	constexpr
+	This&	reserve(ullong len) {
+		reserve_h(len);
+		return *this;
+	}
+
+	// Reset the buffer.
+	/*  @docs
+		@title: Reset
+		@description:
+			Clear the written data while keeping the allocated buffer.
+	*/
+	constexpr
+	This&	reset() {
+		m_buff.m_len = 0;
+		return *this;
+	}
+
+	// Write a value.
+	/*  @docs
+		@title: Value
+		@description:
+			Serialize a `Json`, `JArray` or `JsonValue` into the buffer.
+		@funcs: 3
+	*/
+	This&	value(const Json& json) {
+		write_json_h(json, m_start_indent);
+		return *this;
+	}
+	This&	value(const JArray& arr) {
+		write_array_h(arr, m_start_indent);
+		return *this;
+	}
+	This&	value(const Value& value) {
+		write_value_h(value, m_start_indent);
+		return *this;
+	}
+
+	// Flush into the sink.
+	/*  @docs
+		@title: Flush
+		@description:
+			Write all buffered data into the sink.
+	*/
+	constexpr
+	This&	flush() requires (!is_Null<Sink>::value) {
+		flush_h();
+		return *this;
+	}
+
+	// Get the written data.
+	/*  @docs
+		@title: String
+		@description:
+			Get the written data that is not yet flushed.
+	*/
+	constexpr
+	auto&	str() const {
+		return m_buff;
+	}
+
+	// Move the written data out.
+	/*  @docs
+		@title: Output
+		@description:
+			Move the written data out of the writer, the writer is empty afterwards.
+	*/
+	constexpr
+	String	output() {
+		return move(m_buff);
+	}
+
+	// Get the written length.
+	constexpr
+	auto&	len() const {
+		return m_buff.len();
+	}
+
+};
+
+// ---------------------------------------------------------
+// Json serialize functions.
+
+// Define the "JsonValue::json" function.
+template <typename Type> inline
+String	JsonValue<Type>::json() const {
+	return Writer<>().value(*this).output();
+}
+
+// Define the "Json::dump" functions.
+inline
+String	Json::dump(const JArray& json, const Int& indent, const Int& start_indent) {
+	return Writer<>(indent.value(), start_indent.value()).value(json).output();
+}
+inline
+String	Json::dump(const Json& json, const Int& indent, const Int& start_indent) {
+	return Writer<>(indent.value(), start_indent.value()).value(json).output();
+}
+
+}; 		// End namespace json.
+}; 		// End namespace vlib.
+#endif 	// End header.
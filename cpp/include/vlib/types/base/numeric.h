@@ -653,12 +653,16 @@ public:
 	/*  @docs
 		@title: Parse
 		@description:
-			Parse from a `const char*`.
+			Parse from a `const char*` or from a char array with `data()` and `len()`, such as a `CString` view.
 	*/
 	SICE
 	This	parse(const char* arr, ullong len) {
 		return to_num<Type>(arr, len);
 	}
+	template <typename View> requires (requires (const View& x) { static_cast<const char*>(x.data()); x.len(); }) SICE
+	This	parse(const View& view) {
+		return to_num<Type>(view.data(), view.len());
+	}
 
 	// As String
 	/*  @docs
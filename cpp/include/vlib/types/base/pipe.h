@@ -66,7 +66,7 @@ private:
 	// Attributes.
 
 	int 	m_fd;
-	uint 	m_increaser = 4;
+	float 	m_increaser = array_h::growth;
 
 // Public:
 public:
@@ -145,7 +145,7 @@ public:
 	// Destrcutor.
 	constexpr
 	~Pipe() {
-		delete[] m_arr;
+		array_h::destruct(m_arr);
 	}
 
 	// ---------------------------------------------------------
@@ -241,8 +241,7 @@ public:
 	// - This will delete the buffer in opposition to "String::reset()".
 	constexpr
 	auto&	reset(){
-		delete[] m_arr;
-		m_arr = nullptr;
+		array_h::destruct(m_arr);
 		m_len = 0;
 		m_capacity = 0;
 		return *this;
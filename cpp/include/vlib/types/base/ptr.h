@@ -8,6 +8,10 @@
 // Namespace vlib.
 namespace vlib {
 
+// Is a shared status with a separately allocated reference count.
+template <typename Status>
+struct is_Counted { SICEBOOL value = is_Shared<Status>::value || is_Atomic<Status>::value; };
+
 // Pointer type.
 /* 	@docs
  *	@chapter: Types
@@ -19,15 +23,16 @@ namespace vlib {
  *		@description: The type of the pointee.
  *	@template:
  *		@name: Status
- *		@description: The shared or unique status. Use `Shared` for a shared pointer and use `Unique` for a unique pointer.
+ *		@description: The shared or unique status. Use `Shared` for a shared pointer, `Atomic` for a thread-safe shared pointer, `Intrusive` for a thread-safe shared pointer with a single allocation and `Unique` for a unique pointer.
  *	@usage:
  *	    #include <vlib/types.h>
  *		vlib::Ptr<int> x(0);
+ *		vlib::Ptr<int, vlib::Atomic> y(0);
 */
 template <
 	typename Type,					// the pointee type.
 	typename Status = Shared		// the shared status.
-> requires (is_Unique<Status>::value || is_Shared<Status>::value)
+> requires (is_Unique<Status>::value || is_Shared<Status>::value || is_Atomic<Status>::value || is_Intrusive<Status>::value)
 struct Ptr {
 
 // Private:
@@ -45,6 +50,34 @@ private:
 	Type*			m_ptr;
 	Links*			m_links;
 
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Add a link.
+	// - Atomic increments are relaxed since a new link can only be created from an existing link.
+	constexpr
+	void	link_h() {
+		if constexpr (is_Atomic<Status>::value) {
+			__atomic_fetch_add(m_links, 1, __ATOMIC_RELAXED);
+		} else {
+			++(*m_links);
+		}
+	}
+
+	// Remove a link.
+	// - Returns true when this was the last link and the pointee should be deleted.
+	// - Atomic decrements use acquire / release ordering so all writes of other links happen before the delete.
+	constexpr
+	bool	unlink_h() {
+		if constexpr (is_Atomic<Status>::value) {
+			return __atomic_fetch_sub(m_links, 1, __ATOMIC_ACQ_REL) == 0;
+		} else {
+			if (*m_links == 0) { return true; }
+			--(*m_links);
+			return false;
+		}
+	}
+
 // Public:
 public:
 
@@ -56,7 +89,7 @@ public:
 	Ptr () requires (is_Unique<Status>::value) :
 	m_ptr(nullptr) {}
 	constexpr
-	Ptr () requires (is_Shared<Status>::value) :
+	Ptr () requires (is_Counted<Status>::value) :
 	m_ptr(nullptr),
 	m_links(new Links (0)) {}
 
@@ -70,11 +103,11 @@ public:
 	m_ptr(new Type(arg_0, arg_1, args...)) {}
 	//
 	template <typename Arg_0, typename Arg_1, typename... Args> constexpr
-	Ptr (const Arg_0& arg_0, const Arg_1& arg_1, Args&&... args) requires (is_Shared<Status>::value) :
+	Ptr (const Arg_0& arg_0, const Arg_1& arg_1, Args&&... args) requires (is_Counted<Status>::value) :
 	m_ptr(new Type(arg_0, arg_1, args...)),
 	m_links(new Links (0)) {}
 	template <typename Arg_0, typename Arg_1, typename... Args> constexpr
-	Ptr (Arg_0&& arg_0, Arg_1&& arg_1, Args&&... args) requires (is_Shared<Status>::value) :
+	Ptr (Arg_0&& arg_0, Arg_1&& arg_1, Args&&... args) requires (is_Counted<Status>::value) :
 	m_ptr(new Type(arg_0, arg_1, args...)),
 	m_links(new Links (0)) {}
 
@@ -83,7 +116,7 @@ public:
 	Ptr (Type x) requires (is_Unique<Status>::value) :
 	m_ptr(new Type (move(x))) {}
 	constexpr
-	Ptr (Type x) requires (is_Shared<Status>::value) :
+	Ptr (Type x) requires (is_Counted<Status>::value) :
 	m_ptr(new Type (move(x))),
 	m_links(new Links (0)) {}
 
@@ -92,11 +125,11 @@ public:
 	Ptr (const This& obj) requires (is_Unique<Status>::value) :
 	m_ptr(obj.m_ptr ? new Type (*obj.m_ptr) : nullptr) {}
 	constexpr
-	Ptr (const This& obj) requires (is_Shared<Status>::value) :
+	Ptr (const This& obj) requires (is_Counted<Status>::value) :
 	m_ptr(obj.m_ptr),
 	m_links(obj.m_links)
 	{
-		++(*m_links);
+		link_h();
 	}
 
 	// Swap constructor.
@@ -107,7 +140,7 @@ public:
 		obj.m_ptr = nullptr;
 	}
 	constexpr
-	Ptr (This&& obj) requires (is_Shared<Status>::value) :
+	Ptr (This&& obj) requires (is_Counted<Status>::value) :
 	m_ptr(obj.m_ptr),
 	m_links(obj.m_links)
 	{
@@ -121,12 +154,10 @@ public:
 		delete m_ptr;
 	}
 	constexpr
-	void 	final_destruct() requires (is_Shared<Status>::value) {
-		if (*m_links == 0) 	{
+	void 	final_destruct() requires (is_Counted<Status>::value) {
+		if (unlink_h()) {
 			delete m_ptr;
 			delete m_links;
-		} else {
-			--(*m_links);
 		}
 	}
 	constexpr
@@ -142,7 +173,7 @@ public:
 	}
 	constexpr
 	auto&	operator =(Type&& x) {
-		return reconstruct(x);
+		return reconstruct(move(x));
 	}
 
 	// Copy assignment operator.
@@ -195,13 +226,13 @@ public:
 	*/
 	template <typename... Args> constexpr
 	This& 	reconstruct_by_type_args(Args&&... args) requires (is_Unique<Status>::value) {
-		if (m_ptr)	{ *m_ptr = move(Type(args...)); }
+		if (m_ptr)	{ *m_ptr = Type(args...); }
 		else 		{ m_ptr = new Type (args...); }
 		return *this;
 	}
 	template <typename... Args> constexpr
-	This& 	reconstruct_by_type_args(Args&&... args) requires (is_Shared<Status>::value) {
-		if (m_ptr)	{ *m_ptr = move(Type(args...)); }
+	This& 	reconstruct_by_type_args(Args&&... args) requires (is_Counted<Status>::value) {
+		if (m_ptr)	{ *m_ptr = Type(args...); }
 		else 		{ m_ptr = new Type (args...); }
 		// if (*m_links != 0) {
 		// 	--(*m_links);
@@ -223,17 +254,15 @@ public:
 		return *this;
 	}
 	constexpr
-	This& 	copy(const This& obj) requires (is_Shared<Status>::value) {
+	This& 	copy(const This& obj) requires (is_Counted<Status>::value) {
 		if (this == &obj) { return *this; }
-		if (*m_links == 0) 	{
+		if (unlink_h()) {
 			delete m_ptr;
 			delete m_links;
-		} else {
-			--(*m_links);
 		}
 		m_ptr = obj.m_ptr;
 		m_links = obj.m_links;
-		++(*m_links);
+		link_h();
 		return *this;
 	}
 
@@ -247,13 +276,11 @@ public:
 		return *this;
 	}
 	constexpr
-	This& 	swap(This& obj) requires (is_Shared<Status>::value) {
+	This& 	swap(This& obj) requires (is_Counted<Status>::value) {
 		if (this == &obj) { return *this; }
-		if (*m_links == 0) 	{
+		if (unlink_h()) {
 			delete m_ptr;
 			delete m_links;
-		} else {
-			--(*m_links);
 		}
 		m_ptr = obj.m_ptr;
 		obj.m_ptr = nullptr;
@@ -279,17 +306,13 @@ public:
 		return *this;
 	}
 	constexpr
-	This& 	destruct() requires (is_Shared<Status>::value) {
-		if (*m_links == 0) 	{
+	This& 	destruct() requires (is_Counted<Status>::value) {
+		if (unlink_h()) {
 			delete m_ptr;
-			m_ptr = nullptr;
 			delete m_links;
-			m_links = new Links(0);
-		} else {
-			--(*m_links);
-			m_ptr = nullptr;
-			m_links = new Links(0);
 		}
+		m_ptr = nullptr;
+		m_links = new Links(0);
 		return *this;
 	}
 
@@ -330,7 +353,7 @@ public:
 			Check if the pointer is shared.
 	*/
 	constexpr
-	bool 	is_shared() const { return is_Shared<Status>::value; }
+	bool 	is_shared() const { return is_Counted<Status>::value; }
 
 	// Links.
 	/* 	@docs
@@ -346,6 +369,10 @@ public:
 	auto& 	links() const requires (is_Shared<Status>::value) {
 		return *m_links;
 	}
+	constexpr
+	Links 	links() const requires (is_Atomic<Status>::value) {
+		return __atomic_load_n(m_links, __ATOMIC_ACQUIRE);
+	}
 
 	// Copy memory.
 	/* 	@docs
@@ -362,7 +389,7 @@ public:
 		return *this;
 	}
 	constexpr
-	This 	copy() requires (is_Shared<Status>::value) {
+	This 	copy() requires (is_Counted<Status>::value) {
 		This obj;
 		if (m_ptr) {
 			obj.m_ptr = new Type (*m_ptr);
@@ -371,7 +398,7 @@ public:
 		return obj;
 	}
 	constexpr
-	This 	copy() const requires (is_Shared<Status>::value) {
+	This 	copy() const requires (is_Counted<Status>::value) {
 		This obj;
 		if (m_ptr) {
 			obj.m_ptr = new Type (*m_ptr);
@@ -508,6 +535,300 @@ public:
 	//
 };
 
+// Intrusive pointer type.
+// - The reference count and the pointee are allocated in a single block, so creating a pointer is a single allocation and the count shares the cache line of the pointee.
+// - The reference count is atomic, links may be copied and destroyed concurrently from different threads.
+// - An undefined pointer does not allocate.
+/* 	@docs
+ *	@chapter: Types
+ *	@title: Intrusive pointer
+ *	@description:
+ *		Thread-safe shared pointer type with a single allocation.
+ *	@usage:
+ *	    #include <vlib/types.h>
+ *		vlib::Ptr<int, vlib::Intrusive> x(0);
+*/
+template <typename Type>
+struct Ptr<Type, Intrusive> {
+
+// Private:
+private:
+
+	// ---------------------------------------------------------
+	// Aliases.
+
+	using 			This = 				Ptr;
+	using 			Links =				ullong;
+
+	// ---------------------------------------------------------
+	// Structs.
+
+	// The allocated block.
+	struct Block {
+		Links		links = 0;			// the number of links besides the first.
+		Type		value;
+		template <typename... Args> constexpr
+		Block(Args&&... args) : value(static_cast<Args&&>(args)...) {}
+	};
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	Block*			m_block = nullptr;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Add a link.
+	constexpr
+	void	link_h() {
+		if (m_block) { __atomic_fetch_add(&m_block->links, 1, __ATOMIC_RELAXED); }
+	}
+
+	// Remove a link and delete the block when it was the last link.
+	constexpr
+	void	unlink_h() {
+		if (m_block && __atomic_fetch_sub(&m_block->links, 1, __ATOMIC_ACQ_REL) == 0) {
+			delete m_block;
+		}
+		m_block = nullptr;
+	}
+
+// Public:
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Default constructor.
+	constexpr
+	Ptr () = default;
+
+	// Type args constructor.
+	template <typename Arg_0, typename Arg_1, typename... Args> constexpr
+	Ptr (const Arg_0& arg_0, const Arg_1& arg_1, Args&&... args) :
+	m_block(new Block(arg_0, arg_1, args...)) {}
+	template <typename Arg_0, typename Arg_1, typename... Args> constexpr
+	Ptr (Arg_0&& arg_0, Arg_1&& arg_1, Args&&... args) :
+	m_block(new Block(arg_0, arg_1, args...)) {}
+
+	// Type constructor.
+	constexpr
+	Ptr (Type x) :
+	m_block(new Block(move(x))) {}
+
+	// Copy constructor.
+	constexpr
+	Ptr (const This& obj) :
+	m_block(obj.m_block)
+	{
+		link_h();
+	}
+
+	// Swap constructor.
+	constexpr
+	Ptr (This&& obj) :
+	m_block(obj.m_block)
+	{
+		obj.m_block = nullptr;
+	}
+
+	// Destructor.
+	constexpr
+	~Ptr () { unlink_h(); }
+
+	// ---------------------------------------------------------
+	// Assignment operators.
+
+	// Assignment operator.
+	constexpr
+	auto&	operator =(const Type& x) {
+		return reconstruct(x);
+	}
+	constexpr
+	auto&	operator =(Type&& x) {
+		return reconstruct(move(x));
+	}
+
+	// Copy assignment operator.
+	constexpr
+	auto&	operator =(const This& x) {
+		return copy(x);
+	}
+
+	// Swap assignment operator.
+	constexpr
+	auto&	operator =(This&& x) {
+		return swap(x);
+	}
+
+	// ---------------------------------------------------------
+	// Utilities.
+
+	// Initialize.
+	constexpr
+	This&	init() {
+		unlink_h();
+		m_block = new Block();
+		return *this;
+	}
+
+	// Reconstructor from Type.
+	// - Assigns the pointee of all links when the pointer is defined.
+	constexpr
+	This& 	reconstruct(Type pointee) {
+		if (m_block)	{ m_block->value = move(pointee); }
+		else 			{ m_block = new Block(move(pointee)); }
+		return *this;
+	}
+
+	// Reconstruct by Type args.
+	template <typename... Args> constexpr
+	This& 	reconstruct_by_type_args(Args&&... args) {
+		if (m_block)	{ m_block->value = Type(args...); }
+		else 			{ m_block = new Block(args...); }
+		return *this;
+	}
+
+	// Copy.
+	constexpr
+	This& 	copy(const This& obj) {
+		if (this == &obj || m_block == obj.m_block) { return *this; }
+		unlink_h();
+		m_block = obj.m_block;
+		link_h();
+		return *this;
+	}
+
+	// Swap.
+	constexpr
+	This& 	swap(This& obj) {
+		if (this == &obj) { return *this; }
+		unlink_h();
+		m_block = obj.m_block;
+		obj.m_block = nullptr;
+		return *this;
+	}
+	constexpr
+	This& 	swap(This&& obj) {
+		return swap(obj);
+	}
+
+	// Destruct.
+	constexpr
+	This& 	destruct() {
+		unlink_h();
+		return *this;
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Is undefined.
+	constexpr
+	bool 	is_undefined() const { return m_block == nullptr; }
+
+	// Is defined.
+	constexpr
+	bool 	is_defined() const { return m_block != nullptr; }
+
+	// Is unique.
+	constexpr
+	bool 	is_unqiue() const { return false; }
+
+	// Is shared.
+	constexpr
+	bool 	is_shared() const { return true; }
+
+	// Links.
+	constexpr
+	Links 	links() const {
+		return m_block ? __atomic_load_n(&m_block->links, __ATOMIC_ACQUIRE) : 0;
+	}
+
+	// Copy memory.
+	constexpr
+	This 	copy() const {
+		This obj;
+		if (m_block) { obj.m_block = new Block(m_block->value); }
+		return obj;
+	}
+
+	// Reset.
+	constexpr
+	This& 	reset() {
+		unlink_h();
+		return *this;
+	}
+
+	// Length.
+	constexpr
+	uint 	len() {
+		return m_block ? 1 : 0;
+	}
+
+	// Get the pointer.
+	// - Can not be assigned, use "reconstruct()" instead.
+	constexpr
+	Type* 	ptr() const {
+		return m_block ? &m_block->value : nullptr;
+	}
+
+	// Get pointee as reference.
+	constexpr
+	Type& 	pointee() const {
+        if (m_block == nullptr) {
+            throw PointerError("Pointer is not allocated.");
+        }
+		return m_block->value;
+	}
+
+	// ---------------------------------------------------------
+	// Operators.
+
+	// Get pointee as reference.
+	constexpr
+	Type* 	operator->() const {
+		return &m_block->value;
+	}
+	constexpr
+	Type& 	operator*() const {
+		return pointee();
+	}
+
+	// Operators "==, !=".
+	constexpr friend
+	bool	operator ==(const This& obj, const Null&) {
+		return obj.m_block == nullptr;
+	}
+	constexpr friend
+	bool	operator !=(const This& obj, const Null&) {
+		return obj.m_block != nullptr;
+	}
+
+	// ---------------------------------------------------------
+	// Casts.
+
+	// As String.
+	constexpr
+	auto 	str() const {
+		return m_block->value.str();
+	}
+
+	// As json formatted String.
+	constexpr
+	auto 	json() const {
+		return m_block->value.json();
+	}
+
+	// Is allocated.
+	constexpr
+	operator bool() const {
+		return m_block;
+	}
+
+};
+
 // ---------------------------------------------------------
 // Aliases.
 
@@ -515,6 +836,10 @@ template <typename Type>
 using UPtr =		vlib::Ptr<Type, Unique>;
 template <typename Type>
 using SPtr =		vlib::Ptr<Type, Shared>;
+template <typename Type>
+using APtr =		vlib::Ptr<Type, Atomic>;
+template <typename Type>
+using IPtr =		vlib::Ptr<Type, Intrusive>;
 
 // ---------------------------------------------------------
 // Instances.
@@ -531,6 +856,8 @@ struct is_Ptr<Ptr<Type, Status>> 			{ SICEBOOL value = true;  };
 // Create pointers.
 template <class T, class... Args> auto unique_ptr(Args&&... args) { return Ptr<T, Unique>(args...); }
 template <class T, class... Args> auto shared_ptr(Args&&... args) { return Ptr<T, Shared>(args...); }
+template <class T, class... Args> auto atomic_ptr(Args&&... args) { return Ptr<T, Atomic>(args...); }
+template <class T, class... Args> auto intrusive_ptr(Args&&... args) { return Ptr<T, Intrusive>(args...); }
 
 // ---------------------------------------------------------
 // Shortcuts.
@@ -543,6 +870,10 @@ template <typename Type>
 using UPtr =		vlib::UPtr<Type>;
 template <typename Type>
 using SPtr =		vlib::SPtr<Type>;
+template <typename Type>
+using APtr =		vlib::APtr<Type>;
+template <typename Type>
+using IPtr =		vlib::IPtr<Type>;
 
 }; 		// End namespace sockets.
 }; 		// End namespace shortcuts.
@@ -34,7 +34,7 @@ private:
     Type*       m_arr;
     Length      m_len;
     Length      m_capacity;
-    uint        m_increaser = 4;
+    float       m_increaser = wrapper::growth;
 
 // Public:
 public:
@@ -92,7 +92,7 @@ public:
     // Destrcutor.
     constexpr
     ~Stream() {
-        delete[] m_arr;
+        wrapper::destruct(m_arr);
     }
 
     // ---------------------------------------------------------
@@ -188,8 +188,7 @@ public:
     // - This will delete the buffer in opposition to "String::reset()".
     constexpr
     auto&    reset(){
-        delete[] m_arr;
-        m_arr = nullptr;
+        wrapper::destruct(m_arr);
         m_len = 0;
         m_capacity = 0;
         return *this;
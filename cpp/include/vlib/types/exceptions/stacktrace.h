@@ -493,7 +493,7 @@ public:
     constexpr
     ~StackTrace() {
         if (m_stack != nullptr) {
-            delete[] m_stack;
+            vlib::array<void*, uint>::destruct(m_stack);
         }
     }
     
@@ -522,9 +522,9 @@ public:
     // Initialize the stacktrace.
     auto&   init() {
         if (m_stack != nullptr) {
-            delete[] m_stack;
+            vlib::array<void*, uint>::destruct(m_stack);
         }
-        m_stack = new void* [vlib_max_trace];
+        vlib::array<void*, uint>::alloc(m_stack, vlib_max_trace);
         m_len = ::backtrace(m_stack, vlib_max_trace);
         return *this;
     }
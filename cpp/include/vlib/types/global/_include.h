@@ -113,13 +113,17 @@
 #include "npos.h"
 #include "math.h"
 #include "len.h"
+#include "hash.h"
 #include "sleep.h"
 #include "range.h"
 #include "random.h"
 #include "colors.h"
-#include "file.h"
 #include "ptr.h"
 #include "array.h"
+#include "file.h"
+#include "sort.h"
+#include "simd.h"
+#include "search.h"
 #include "str.h"
 #include "cast.h"
 #include "backtrace.h"
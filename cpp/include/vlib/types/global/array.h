@@ -22,6 +22,11 @@ struct array {
     
     // Static attributes.
     SICE Length 	limit = limits<Length>::max - 1;
+    SICE double 	growth = 1.5; 	// the default capacity growth factor.
+    
+    // Trivial types are stored in raw memory from "malloc", their spare capacity is never constructed and they grow with "realloc".
+    // Other types are allocated with "new[]" since the array types assign into their spare capacity.
+    SICEBOOL		trivial = std::is_trivially_copyable<Type>::value && std::is_trivially_default_constructible<Type>::value;
     
     // Alloc.
 	SICE
@@ -29,7 +34,13 @@ struct array {
 		if (req_len + 1 > limit) {
 			throw std::overflow_error("Buffer overflow.");
 		}
-		return new Type [req_len + 1];
+		if constexpr (trivial) {
+			Type* arr = (Type*) ::malloc((req_len + 1) * sizeof(Type));
+			if (arr == nullptr) { throw std::bad_alloc(); }
+			return arr;
+		} else {
+			return new Type [req_len + 1];
+		}
 	}
     SICE
     void 	alloc(Type*& m_arr, Length req_len = 1) {
@@ -39,16 +50,29 @@ struct array {
     // Realloc.
     SICE
     void 	realloc(Type*& m_arr, Length& m_len, Length req_len) {
-        Type* arr = alloc(req_len);
-        move(arr, m_arr, m_len);
-        delete[] m_arr;
-        m_arr = arr;
+        if constexpr (trivial) {
+            if (req_len + 1 > limit) {
+                throw std::overflow_error("Buffer overflow.");
+            }
+            Type* arr = (Type*) ::realloc((void*) m_arr, (req_len + 1) * sizeof(Type));
+            if (arr == nullptr) { throw std::bad_alloc(); }
+            m_arr = arr;
+        } else {
+            Type* arr = alloc(req_len);
+            move(arr, m_arr, m_len);
+            delete[] m_arr;
+            m_arr = arr;
+        }
     }
     
     // Destruct.
     SICE
     void 	destruct(Type*& m_arr) {
-        delete[] m_arr;
+        if constexpr (trivial) {
+            ::free((void*) m_arr);
+        } else {
+            delete[] m_arr;
+        }
         m_arr = nullptr;
     }
     
@@ -63,21 +87,20 @@ struct array {
     // Copy array items.
     SICE
     void 	copy(Type* dest, const Type* src, Length len) {
-        while (len-- > 0) { dest[len] = src[len]; }
+        if constexpr (trivial) {
+            if (len != 0) { ::memmove((void*) dest, (const void*) src, len * sizeof(Type)); }
+        } else {
+            while (len-- > 0) { dest[len] = src[len]; }
+        }
     }
     
     // Move array items.
     SICE
-    void 	move(Type* dest, Type* src, Length len) requires (is_integral<Type>::value) {
-        if (dest < src) {
-            for (Length i = 0; i < len; ++i) { dest[i] = src[i]; }
-        } else {
-            while (len-- > 0) { dest[len] = src[len]; }
-            // for (Length i = len; i > 0; --i) { dest[i-1] = src[i-1]; }
-        }
+    void 	move(Type* dest, Type* src, Length len) requires (trivial) {
+        if (len != 0) { ::memmove((void*) dest, (const void*) src, len * sizeof(Type)); }
     }
     SICE
-    void 	move(Type* dest, Type* src, Length len) requires (!is_integral<Type>::value) {
+    void 	move(Type* dest, Type* src, Length len) requires (!trivial) {
         if (dest < src) {
             for (Length i = 0; i < len; ++i) { dest[i] = vlib::move(src[i]); }
         } else {
@@ -127,13 +150,16 @@ struct array {
     }
     
     // Expand the array.
+    // - Grows the capacity by the increaser factor, or to the required length when that is larger.
     SICE
-    int		expand(Type*& m_arr, Length& m_len, Length& m_capacity, Length with_len, uint increaser = 4) {
+    int		expand(Type*& m_arr, Length& m_len, Length& m_capacity, Length with_len, double increaser = growth) {
         if (m_arr == nullptr) {
             m_capacity = with_len;
             alloc(m_arr, m_capacity);
         } else if (m_len + with_len > m_capacity) {
-            m_capacity = (m_capacity + with_len) * increaser;
+            Length capacity = (Length) ((double) m_capacity * increaser) + 1;
+            if (capacity < m_len + with_len) { capacity = m_len + with_len; }
+            m_capacity = capacity;
             realloc(m_arr, m_len, m_capacity);
         }
         return 0;
@@ -141,17 +167,15 @@ struct array {
     
     // Concat to the array.
     SICE
-    int     concat(Type*& m_arr, Length& m_len, Length& m_capacity, const Type* arr, Length len, uint increaser = 4) {
+    int     concat(Type*& m_arr, Length& m_len, Length& m_capacity, const Type* arr, Length len, double increaser = growth) {
         int status;
         if (m_len + len > m_capacity) {
             if ((status = expand(m_arr, m_len, m_capacity, len, increaser)) != 0) {
                 return status;
             }
         }
-        for (Length i = 0; i < len; ++i) {
-            m_arr[m_len] = arr[i];
-            ++m_len;
-        }
+        copy(m_arr + m_len, arr, len);
+        m_len += len;
         return 0;
     }
     
@@ -175,13 +199,13 @@ struct array {
     
     // Append an item to the array.
     SICE
-    void	append(Type*& m_arr, Length& m_len, Length& m_capacity, const Type& x, uint increaser = 4) {
+    void	append(Type*& m_arr, Length& m_len, Length& m_capacity, const Type& x, double increaser = growth) {
         expand(m_arr, m_len, m_capacity, 1, increaser);
         m_arr[m_len] = x;
         ++m_len;
     }
     SICE
-    void	append(Type*& m_arr, Length& m_len, Length& m_capacity, Type&& x, uint increaser = 4) {
+    void	append(Type*& m_arr, Length& m_len, Length& m_capacity, Type&& x, double increaser = growth) {
         expand(m_arr, m_len, m_capacity, 1, increaser);
         m_arr[m_len] = x;
         ++m_len;
@@ -259,8 +283,7 @@ struct BaseArray {
     constexpr
     ~BaseArray() {
         if (m_arr != nullptr) {
-            delete[] m_arr;
-            m_arr = nullptr;
+            wrapper::destruct(m_arr);
         }
     }
     
@@ -19,6 +19,15 @@ enum mode {
 	write =		O_RDWR | O_CREAT | O_TRUNC,
 	append = 	O_RDWR | O_CREAT | O_APPEND,
 };
+// Access pattern advice.
+// Source: https://www.man7.org/linux/man-pages/man2/posix_fadvise.2.html
+enum advice {
+	normal =		0,
+	random =		1,
+	sequential =	2,
+	willneed =		3,
+	dontneed =		4,
+};
 };
 
 // Safely open file.
@@ -52,6 +61,7 @@ FILE*	open(const char* path, int mode, int permission = 0640) {
 // - Returns 0 on success, < 0 on failure.
 // - The data buffer will be deleted, so by default it should be initialized with "nullptr".
 // - The data buffer will always be deleted upon failure.
+// - The data buffer is allocated by "vlib::array<char, ullong>", release it with "vlib::array<char, ullong>::destruct()".
 // - Max size of "len" is the max of a "ulong".
 inline
 int 	load(
@@ -59,7 +69,7 @@ int 	load(
 	char*& 			data, 	// a reference to the data buffer, will be deleted before read (only for output).
 	ullong&			len		// a reference to the length of the data buffer (only for output).
 ) {
-	delete[] data;
+	array<char, ullong>::destruct(data);
 	FILE *f = open(path, file::read);
 	if (f == nullptr) {
 		data = nullptr;
@@ -68,10 +78,9 @@ int 	load(
 	fseek(f, 0, SEEK_END);
 	len = (ullong) ftell(f);
 	fseek(f, 0, SEEK_SET);
-	data = new char [len + 1];
+	array<char, ullong>::alloc(data, len);
 	if (fread(data, sizeof(char), len, f) != len) {
-		delete[] data;
-		data = nullptr;
+		array<char, ullong>::destruct(data);
 		fclose(f);
 		return file::error::read;
 	}
@@ -0,0 +1,134 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_HASH_H
+#define VLIB_HASH_H
+
+// Includes.
+#include <string.h> // for memcpy.
+
+// Namespace vlib.
+namespace vlib {
+
+// ---------------------------------------------------------
+// Non cryptographic hashing.
+//
+// Notes:
+// - Only used for in memory lookup tables, never use these for checksums or signatures.
+// - Equal values must always produce equal hashes, so a String and a "const char*, len" with the same chars hash equally.
+//
+
+// Namespace hash.
+namespace hash {
+
+// Mix a 64 bit integer (splitmix64 finalizer).
+inline constexpr
+ullong	mix(ullong x) {
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+// Hash a byte array.
+// - Processes eight bytes per round.
+inline
+ullong	bytes(const char* data, ullong len) {
+	ullong h = 0x9e3779b97f4a7c15ULL ^ (len * 0xff51afd7ed558ccdULL);
+	ullong chunk;
+	while (len >= 8) {
+		memcpy(&chunk, data, 8);
+		h = mix(h ^ chunk) * 0x9e3779b97f4a7c15ULL;
+		data += 8;
+		len -= 8;
+	}
+	chunk = 0;
+	for (ullong i = 0; i < len; ++i) {
+		chunk |= ((ullong) (uchar) data[i]) << (i * 8);
+	}
+	return mix(h ^ chunk);
+}
+
+};		// End namespace hash.
+
+// Hash any integral integer / char / bool.
+/*	@docs
+	@chapter: Global
+	@title: Hash
+	@description:
+		Get a non cryptographic hash of a value.
+
+		Supports integral types, floating types, `Numeric` types, char arrays with a `data()` and `len()` function and types that define a `hash()` function.
+	@usage:
+		#include <vlib/types.h>
+		ullong x = vlib::hash_of(String("Hello World!"));
+		ullong y = vlib::hash_of("Hello World!", 12); ==> x == y
+*/
+template <typename Type> requires (is_any_integer<Type>::value || is_char<Type>::value || is_uchar<Type>::value || is_bool<Type>::value) inline constexpr
+ullong	hash_of(const Type& x) {
+	return hash::mix((ullong) x);
+}
+
+// Hash any floating type.
+template <typename Type> requires (is_floating<Type>::value) inline
+ullong	hash_of(const Type& x) {
+	if (x == 0) { return hash::mix(0); } // -0.0 == 0.0.
+	double y = (double) x;
+	ullong bits;
+	memcpy(&bits, &y, sizeof(bits));
+	return hash::mix(bits);
+}
+
+// Hash a char array with length.
+inline
+ullong	hash_of(const char* data, ullong len) {
+	return hash::bytes(data, len);
+}
+
+// Hash a null terminated char array.
+inline
+ullong	hash_of(const char* data) {
+	return hash::bytes(data, vlib::len(data));
+}
+
+// Hash a char array type such as String, CString or Pipe.
+template <typename Type> requires (
+	!is_any_integer<Type>::value &&
+	requires (const Type& x) {
+		static_cast<const char*>(x.data());
+		x.len();
+	}
+) inline
+ullong	hash_of(const Type& x) {
+	return hash::bytes(x.data(), x.len());
+}
+
+// Hash a Numeric type.
+template <typename Type> requires (
+	!is_any_integer<Type>::value &&
+	!requires (const Type& x) { x.data(); } &&
+	requires (const Type& x) { x.value(); hash_of(x.value()); }
+) inline
+ullong	hash_of(const Type& x) {
+	return hash_of(x.value());
+}
+
+// Hash a type with a "hash()" member function.
+template <typename Type> requires (
+	!requires (const Type& x) { x.data(); } &&
+	!requires (const Type& x) { x.value(); } &&
+	requires (const Type& x) { (ullong) x.hash(); }
+) inline
+ullong	hash_of(const Type& x) {
+	return x.hash();
+}
+
+// Is hashable.
+template <typename Type>
+struct is_hashable { SICEBOOL value = requires (const Type& x) { hash_of(x); }; };
+
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -0,0 +1,366 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+//
+// Sources:
+// - http://0x80.pl/articles/simd-strfind.html
+// - https://www-igm.univ-mlv.fr/~mac/Articles-PDF/CP-1991-jacm.pdf
+//
+
+// Header.
+#ifndef VLIB_SEARCH_H
+#define VLIB_SEARCH_H
+
+// Includes.
+#include <string.h>
+#include "simd.h"
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace searching.
+namespace searching {
+
+// ---------------------------------------------------------
+// Substring search on contiguous char buffers.
+//
+// Notes:
+// - All functions return the offset of the match in the haystack, or "internal::npos" when there is no match.
+// - Single bytes are located with "memchr".
+// - Needles shorter than "twoway_threshold" are located by comparing the first and the last byte of the needle at 32 (AVX2) or 16 (SSE2) offsets at a time, the remaining bytes are only compared for the offsets where both match.
+// - Longer needles use the Two-Way algorithm with a Boyer-Moore bad character shift, this is linear in the length of the haystack.
+// - The kernels are chosen by the runtime detected level of "vlib::cpu::simd()".
+//
+/*  @docs
+	@chapter: Types
+	@title: Searching
+	@description:
+		Substring search on contiguous char buffers, used by `String` and `CString`.
+	@usage:
+		#include <vlib/types.h>
+		vlib::searching::find("Hello World!", 12, "World", 5) ==> 6;
+		vlib::searching::rfind("a,b,c", 5, ",", 1) ==> 3;
+		const char* needles[] = {"World", "Hello"};
+		vlib::searching::find_first("Hello World!", 12, needles, 2) ==> 0;
+*/
+
+// The needle length from which the Two-Way algorithm is used.
+inline constexpr ullong twoway_threshold = 32;
+
+// The SIMD level used by "find", shared with the other modules.
+using cpu::simd_level;
+using cpu::scalar;
+using cpu::sse2;
+using cpu::sse41;
+using cpu::avx2;
+using cpu::simd;
+
+// ---------------------------------------------------------
+// Private functions.
+
+namespace internal {
+
+// Find a needle of at least two bytes, starting at offset "pos".
+// - Locates the first byte with memchr and checks the last byte before comparing the rest.
+inline
+ullong	find_scalar_h(const char* haystack, ullong len, const char* needle, ullong nlen, ullong pos) {
+	const char* start = haystack + pos;
+	const char* last = haystack + len - nlen;
+	const char l = needle[nlen - 1];
+	while (start <= last) {
+		start = (const char*) memchr(start, needle[0], last - start + 1);
+		if (start == nullptr) { return vlib::internal::npos; }
+		if (start[nlen - 1] == l && memcmp(start + 1, needle + 1, nlen - 2) == 0) { return start - haystack; }
+		++start;
+	}
+	return vlib::internal::npos;
+}
+
+#if VLIB_SIMD_X86
+
+// Filter blocks of 16 offsets by the first and last byte of the needle.
+// Returns the match or npos, "pos" is set to the first offset that was not filtered.
+static inline
+ullong	find_sse2_h(const char* haystack, ullong len, const char* needle, ullong nlen, ullong& pos) {
+	const __m128i first = _mm_set1_epi8(needle[0]);
+	const __m128i last = _mm_set1_epi8(needle[nlen - 1]);
+	ullong i = 0;
+	for (; i + nlen - 1 + 16 <= len; i += 16) {
+		const __m128i bf = _mm_loadu_si128((const __m128i*) (haystack + i));
+		const __m128i bl = _mm_loadu_si128((const __m128i*) (haystack + i + nlen - 1));
+		uint mask = (uint) _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(first, bf), _mm_cmpeq_epi8(last, bl)));
+		while (mask != 0) {
+			const uint bit = __builtin_ctz(mask);
+			if (memcmp(haystack + i + bit + 1, needle + 1, nlen - 2) == 0) { return i + bit; }
+			mask &= mask - 1;
+		}
+	}
+	pos = i;
+	return vlib::internal::npos;
+}
+
+// Filter blocks of 32 offsets by the first and last byte of the needle.
+// Returns the match or npos, "pos" is set to the first offset that was not filtered.
+__attribute__((target("avx2"))) static inline
+ullong	find_avx2_h(const char* haystack, ullong len, const char* needle, ullong nlen, ullong& pos) {
+	const __m256i first = _mm256_set1_epi8(needle[0]);
+	const __m256i last = _mm256_set1_epi8(needle[nlen - 1]);
+	ullong i = 0;
+	for (; i + nlen - 1 + 32 <= len; i += 32) {
+		const __m256i bf = _mm256_loadu_si256((const __m256i*) (haystack + i));
+		const __m256i bl = _mm256_loadu_si256((const __m256i*) (haystack + i + nlen - 1));
+		uint mask = (uint) _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(first, bf), _mm256_cmpeq_epi8(last, bl)));
+		while (mask != 0) {
+			const uint bit = __builtin_ctz(mask);
+			if (memcmp(haystack + i + bit + 1, needle + 1, nlen - 2) == 0) { return i + bit; }
+			mask &= mask - 1;
+		}
+	}
+	pos = i;
+	return vlib::internal::npos;
+}
+
+// Find the first offset that holds one of up to four bytes.
+static inline
+ullong	find_bytes_sse2_h(const char* haystack, ullong len, const uchar* bytes, ullong nbytes, ullong pos) {
+	const __m128i b0 = _mm_set1_epi8((char) bytes[0]);
+	const __m128i b1 = _mm_set1_epi8((char) bytes[nbytes > 1 ? 1 : 0]);
+	const __m128i b2 = _mm_set1_epi8((char) bytes[nbytes > 2 ? 2 : 0]);
+	const __m128i b3 = _mm_set1_epi8((char) bytes[nbytes > 3 ? 3 : 0]);
+	for (; pos + 16 <= len; pos += 16) {
+		const __m128i block = _mm_loadu_si128((const __m128i*) (haystack + pos));
+		const __m128i eq = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(block, b0), _mm_cmpeq_epi8(block, b1)),
+			_mm_or_si128(_mm_cmpeq_epi8(block, b2), _mm_cmpeq_epi8(block, b3))
+		);
+		const uint mask = (uint) _mm_movemask_epi8(eq);
+		if (mask != 0) { return pos + __builtin_ctz(mask); }
+	}
+	for (; pos < len; ++pos) {
+		const uchar c = (uchar) haystack[pos];
+		for (ullong i = 0; i < nbytes; ++i) {
+			if (c == bytes[i]) { return pos; }
+		}
+	}
+	return vlib::internal::npos;
+}
+
+#endif
+
+// Find a needle with the Two-Way algorithm.
+// - The haystack is skipped by the Boyer-Moore shift of its byte at the last position of the needle.
+// - The critical factorization guarantees that the search is linear, also for periodic needles.
+inline
+ullong	find_twoway_h(const char* haystack, ullong len, const char* needle, ullong nlen) {
+	const uchar* h = (const uchar*) haystack;
+	const uchar* z = h + len;
+	const uchar* n = (const uchar*) needle;
+	ullong ip, jp, k, p, ms, p0, mem, mem0;
+
+	// Byte set and bad character shift table.
+	ullong byteset[256 / 64] = {0};
+	ullong shift[256];
+	for (ullong i = 0; i < nlen; ++i) {
+		byteset[n[i] / 64] |= (ullong) 1 << (n[i] % 64);
+		shift[n[i]] = i + 1;
+	}
+
+	// Maximal suffix.
+	ip = (ullong) -1; jp = 0; k = p = 1;
+	while (jp + k < nlen) {
+		if (n[ip + k] == n[jp + k]) {
+			if (k == p) { jp += p; k = 1; }
+			else { ++k; }
+		} else if (n[ip + k] > n[jp + k]) {
+			jp += k; k = 1; p = jp - ip;
+		} else {
+			ip = jp++; k = p = 1;
+		}
+	}
+	ms = ip;
+	p0 = p;
+
+	// Maximal suffix with the opposite ordering.
+	ip = (ullong) -1; jp = 0; k = p = 1;
+	while (jp + k < nlen) {
+		if (n[ip + k] == n[jp + k]) {
+			if (k == p) { jp += p; k = 1; }
+			else { ++k; }
+		} else if (n[ip + k] < n[jp + k]) {
+			jp += k; k = 1; p = jp - ip;
+		} else {
+			ip = jp++; k = p = 1;
+		}
+	}
+	if (ip + 1 > ms + 1) { ms = ip; }
+	else { p = p0; }
+
+	// Periodic needle.
+	if (memcmp(n, n + p, ms + 1) != 0) {
+		mem0 = 0;
+		p = (ms > nlen - ms - 1 ? ms : nlen - ms - 1) + 1;
+	} else {
+		mem0 = nlen - p;
+	}
+	mem = 0;
+
+	// Search.
+	while ((ullong) (z - h) >= nlen) {
+
+		// Shift by the last byte.
+		const uchar c = h[nlen - 1];
+		if ((byteset[c / 64] >> (c % 64)) & 1) {
+			k = nlen - shift[c];
+			if (k != 0) {
+				if (k < mem) { k = mem; }
+				h += k;
+				mem = 0;
+				continue;
+			}
+		} else {
+			h += nlen;
+			mem = 0;
+			continue;
+		}
+
+		// Compare the right half.
+		for (k = (ms + 1 > mem ? ms + 1 : mem); k < nlen && n[k] == h[k]; ++k) {}
+		if (k < nlen) {
+			h += k - ms;
+			mem = 0;
+			continue;
+		}
+
+		// Compare the left half.
+		for (k = ms + 1; k > mem && n[k - 1] == h[k - 1]; --k) {}
+		if (k <= mem) { return h - (const uchar*) haystack; }
+		h += p;
+		mem = mem0;
+	}
+	return vlib::internal::npos;
+}
+
+// Check if a null terminated needle occurs at the start of the haystack.
+inline
+bool	starts_with_h(const char* haystack, ullong len, const char* needle) {
+	for (ullong i = 0; needle[i] != '\0'; ++i) {
+		if (i == len || haystack[i] != needle[i]) { return false; }
+	}
+	return true;
+}
+
+}; 		// End namespace internal.
+
+// ---------------------------------------------------------
+// Functions.
+
+// Find the first occurence of a needle.
+inline
+ullong	find(const char* haystack, ullong len, const char* needle, ullong nlen) {
+	if (nlen == 0 || nlen > len) { return vlib::internal::npos; }
+	switch (nlen) {
+		case 1: {
+			const char* pos = (const char*) memchr(haystack, needle[0], len);
+			return pos == nullptr ? vlib::internal::npos : pos - haystack;
+		}
+		default: {
+			if (nlen >= twoway_threshold) {
+				return internal::find_twoway_h(haystack, len, needle, nlen);
+			}
+			ullong pos = 0;
+#if VLIB_SIMD_X86
+			ullong found;
+			if (simd() >= avx2) {
+				found = internal::find_avx2_h(haystack, len, needle, nlen, pos);
+				if (found != vlib::internal::npos) { return found; }
+			} else if (simd() >= sse2) {
+				found = internal::find_sse2_h(haystack, len, needle, nlen, pos);
+				if (found != vlib::internal::npos) { return found; }
+			}
+#endif
+			return internal::find_scalar_h(haystack, len, needle, nlen, pos);
+		}
+	}
+}
+
+// Find the last occurence of a needle.
+inline
+ullong	rfind(const char* haystack, ullong len, const char* needle, ullong nlen) {
+	if (nlen == 0 || nlen > len) { return vlib::internal::npos; }
+	const char f = needle[0];
+	const char l = needle[nlen - 1];
+	ullong pos = len - nlen + 1;
+	while (pos-- > 0) {
+		if (haystack[pos] == f && haystack[pos + nlen - 1] == l && memcmp(haystack + pos, needle, nlen) == 0) {
+			return pos;
+		}
+	}
+	return vlib::internal::npos;
+}
+
+// Find the first offset where one of the null terminated needles occurs.
+// - When multiple needles occur at the same offset, the first needle in the array wins, its index is stored in "matched".
+// - The candidate offsets are located by the first bytes of the needles, with SSE2 when there are at most four distinct first bytes.
+inline
+ullong	find_first(const char* haystack, ullong len, const char* const* needles, ullong count, ullong* matched = nullptr) {
+	if (len == 0 || count == 0) { return vlib::internal::npos; }
+
+	// Collect the distinct first bytes.
+	bool is_first[256] = {false};
+	uchar firsts[4];
+	ullong nfirsts = 0;
+	for (ullong i = 0; i < count; ++i) {
+		const uchar c = (uchar) needles[i][0];
+		if (c == '\0') {
+			if (matched != nullptr) { *matched = i; }
+			return 0;
+		}
+		if (!is_first[c]) {
+			is_first[c] = true;
+			if (nfirsts < 4) { firsts[nfirsts] = c; }
+			++nfirsts;
+		}
+	}
+
+	// Check the needles at a candidate offset.
+	auto check = [&](ullong pos) {
+		if (!is_first[(uchar) haystack[pos]]) { return false; }
+		for (ullong i = 0; i < count; ++i) {
+			if (internal::starts_with_h(haystack + pos, len - pos, needles[i])) {
+				if (matched != nullptr) { *matched = i; }
+				return true;
+			}
+		}
+		return false;
+	};
+
+	// Iterate the candidates.
+	ullong pos = 0;
+	if (nfirsts == 1) {
+		while (pos < len) {
+			const char* c = (const char*) memchr(haystack + pos, firsts[0], len - pos);
+			if (c == nullptr) { return vlib::internal::npos; }
+			pos = c - haystack;
+			if (check(pos)) { return pos; }
+			++pos;
+		}
+		return vlib::internal::npos;
+	}
+#if VLIB_SIMD_X86
+	if (nfirsts <= 4) {
+		while ((pos = internal::find_bytes_sse2_h(haystack, len, firsts, nfirsts, pos)) != vlib::internal::npos) {
+			if (check(pos)) { return pos; }
+			++pos;
+		}
+		return vlib::internal::npos;
+	}
+#endif
+	for (; pos < len; ++pos) {
+		if (check(pos)) { return pos; }
+	}
+	return vlib::internal::npos;
+}
+
+}; 		// End namespace searching.
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -0,0 +1,62 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_SIMD_H
+#define VLIB_SIMD_H
+
+// Includes.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define VLIB_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace cpu.
+namespace cpu {
+
+// ---------------------------------------------------------
+// Runtime SIMD dispatch.
+//
+// Notes:
+// - The vectorized kernels are compiled with a "target" attribute, so they do not require "-mavx2" and the binary still runs on older processors.
+// - The level is detected once and shared by all modules, the kernels above the current level are never called.
+//
+/*  @docs
+	@chapter: Types
+	@title: SIMD
+	@description:
+		The instruction set used by the vectorized kernels, detected at runtime.
+
+		The level can be lowered to force a slower path, for example in tests and benchmarks.
+	@usage:
+		#include <vlib/types.h>
+		if (vlib::cpu::simd() >= vlib::cpu::avx2) { ... }
+		vlib::cpu::simd() = vlib::cpu::scalar; // force the scalar path.
+*/
+enum simd_level {
+	scalar =	0,
+	sse2 =		1,
+	sse41 =		2,	// SSSE3 and SSE4.1.
+	avx2 =		3,
+};
+inline
+int&	simd() {
+#if VLIB_SIMD_X86
+	static int level = []() {
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2")) { return (int) avx2; }
+		if (__builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("ssse3")) { return (int) sse41; }
+		return (int) sse2;
+	}();
+#else
+	static int level = scalar;
+#endif
+	return level;
+}
+
+}; 		// End namespace cpu.
+}; 		// End namespace vlib.
+#endif 	// End header.
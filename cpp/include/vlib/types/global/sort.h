@@ -0,0 +1,577 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+//
+// Sources:
+// - https://github.com/orlp/pdqsort
+// - https://arxiv.org/abs/2106.05123
+//
+
+// Header.
+#ifndef VLIB_SORT_H
+#define VLIB_SORT_H
+
+// Includes.
+#include <pthread.h>
+#include <unistd.h>
+#include <string.h>
+#include <type_traits>
+
+// Namespace vlib.
+namespace vlib {
+
+// Namespace sorting.
+namespace sorting {
+
+// ---------------------------------------------------------
+// Sorting algorithms on contiguous buffers.
+//
+// Notes:
+// - The algorithms only require "less(x, y)" and move assignment, the buffered algorithms also require a default constructor.
+// - "pdq" is the default, it is not stable and runs in O(n log n) worst case time, sorted and reversed inputs take O(n).
+// - "merge" is stable and uses a buffer of "len" items.
+// - "radix" is stable and sorts by the bytes of an integral or floating key, a byte that is equal for all keys is skipped.
+// - "parallel" sorts chunks on multiple threads and merges them with a parallel merge, it falls back to a single thread below "parallel_threshold" items.
+//
+/*  @docs
+	@chapter: Types
+	@title: Sorting
+	@description:
+		Sorting algorithms on contiguous buffers, used by `Array` and `Dict`.
+	@usage:
+		#include <vlib/types.h>
+		int data[5] = {3, 1, 2, 5, 4};
+		vlib::sorting::pdq(data, 5);
+		vlib::sorting::merge(data, 5, [](int x, int y) { return x > y; });
+		vlib::sorting::radix(data, 5);
+*/
+
+// The number of items below which insertion sort is used.
+inline constexpr ullong insertion_threshold = 24;
+
+// The number of items below which pdq uses a median of three.
+inline constexpr ullong ninther_threshold = 128;
+
+// The minimum number of items per thread of a parallel sort.
+inline constexpr ullong parallel_threshold = 1024 * 1024;
+
+// The default less than function.
+struct Less {
+	template <typename Type> constexpr
+	bool operator()(const Type& x, const Type& y) const { return x < y; }
+};
+
+// ---------------------------------------------------------
+// Helpers.
+
+// Swap two items.
+template <typename Type> inline constexpr
+void	swap_h(Type& x, Type& y) {
+	Type tmp = vlib::move(x);
+	x = vlib::move(y);
+	y = vlib::move(tmp);
+}
+
+// Sort two and three items.
+template <typename Type, typename Func> inline constexpr
+void	sort2_h(Type* x, Type* y, Func& less) {
+	if (less(*y, *x)) { swap_h(*x, *y); }
+}
+template <typename Type, typename Func> inline constexpr
+void	sort3_h(Type* x, Type* y, Type* z, Func& less) {
+	sort2_h(x, y, less);
+	sort2_h(y, z, less);
+	sort2_h(x, y, less);
+}
+
+// Insertion sort, "unguarded" requires an item before "begin" that is not greater than any item.
+template <bool unguarded = false, typename Type, typename Func> inline constexpr
+void	insertion_h(Type* begin, Type* end, Func& less) {
+	if (begin == end) { return ; }
+	for (Type* cur = begin + 1; cur != end; ++cur) {
+		Type* sift = cur;
+		Type* sift_1 = cur - 1;
+		if (less(*sift, *sift_1)) {
+			Type tmp = vlib::move(*sift);
+			do {
+				*sift-- = vlib::move(*sift_1);
+			} while ((unguarded || sift != begin) && less(tmp, *--sift_1));
+			*sift = vlib::move(tmp);
+		}
+	}
+}
+
+// Insertion sort that gives up after 8 moves, returns true when the range is sorted.
+template <typename Type, typename Func> inline constexpr
+bool	partial_insertion_h(Type* begin, Type* end, Func& less) {
+	if (begin == end) { return true; }
+	ullong limit = 0;
+	for (Type* cur = begin + 1; cur != end; ++cur) {
+		Type* sift = cur;
+		Type* sift_1 = cur - 1;
+		if (less(*sift, *sift_1)) {
+			Type tmp = vlib::move(*sift);
+			do {
+				*sift-- = vlib::move(*sift_1);
+			} while (sift != begin && less(tmp, *--sift_1));
+			*sift = vlib::move(tmp);
+			limit += cur - sift;
+		}
+		if (limit > 8) { return false; }
+	}
+	return true;
+}
+
+// Heap sort, the worst case fallback of pdq.
+template <typename Type, typename Func> inline constexpr
+void	sift_down_h(Type* arr, ullong root, ullong len, Func& less) {
+	while (true) {
+		ullong child = 2 * root + 1;
+		if (child >= len) { return ; }
+		if (child + 1 < len && less(arr[child], arr[child + 1])) { ++child; }
+		if (!less(arr[root], arr[child])) { return ; }
+		swap_h(arr[root], arr[child]);
+		root = child;
+	}
+}
+template <typename Type, typename Func> inline constexpr
+void	heap_h(Type* arr, ullong len, Func& less) {
+	for (ullong i = len / 2; i-- > 0; ) { sift_down_h(arr, i, len, less); }
+	for (ullong i = len; i-- > 1; ) {
+		swap_h(arr[0], arr[i]);
+		sift_down_h(arr, 0, i, less);
+	}
+}
+
+// Partition around the pivot "*begin", items equal to the pivot go to the right.
+// - Returns the pivot position and sets "partitioned" when no items were swapped.
+template <typename Type, typename Func> inline constexpr
+Type*	partition_right_h(Type* begin, Type* end, Func& less, bool& partitioned) {
+	Type pivot = vlib::move(*begin);
+	Type* first = begin;
+	Type* last = end;
+	while (less(*++first, pivot));
+	if (first - 1 == begin) {
+		while (first < last && !less(*--last, pivot));
+	} else {
+		while (!less(*--last, pivot));
+	}
+	partitioned = first >= last;
+	while (first < last) {
+		swap_h(*first, *last);
+		while (less(*++first, pivot));
+		while (!less(*--last, pivot));
+	}
+	Type* pivot_pos = first - 1;
+	*begin = vlib::move(*pivot_pos);
+	*pivot_pos = vlib::move(pivot);
+	return pivot_pos;
+}
+
+// Partition around the pivot "*begin", items equal to the pivot go to the left.
+// - Used when the pivot equals the item before the range, so runs of equal items are handled in linear time.
+template <typename Type, typename Func> inline constexpr
+Type*	partition_left_h(Type* begin, Type* end, Func& less) {
+	Type pivot = vlib::move(*begin);
+	Type* first = begin;
+	Type* last = end;
+	while (less(pivot, *--last));
+	if (last + 1 == end) {
+		while (first < last && !less(pivot, *++first));
+	} else {
+		while (!less(pivot, *++first));
+	}
+	while (first < last) {
+		swap_h(*first, *last);
+		while (less(pivot, *--last));
+		while (!less(pivot, *++first));
+	}
+	Type* pivot_pos = last;
+	*begin = vlib::move(*pivot_pos);
+	*pivot_pos = vlib::move(pivot);
+	return pivot_pos;
+}
+
+// The pdq loop.
+template <typename Type, typename Func> inline constexpr
+void	pdq_h(Type* begin, Type* end, Func& less, int bad_allowed, bool leftmost) {
+	while (true) {
+		const ullong len = end - begin;
+		if (len < insertion_threshold) {
+			if (leftmost) { insertion_h<false>(begin, end, less); }
+			else { insertion_h<true>(begin, end, less); }
+			return ;
+		}
+
+		// Move the median of three or the pseudo median of nine to "begin".
+		const ullong half = len / 2;
+		if (len > ninther_threshold) {
+			sort3_h(begin, begin + half, end - 1, less);
+			sort3_h(begin + 1, begin + (half - 1), end - 2, less);
+			sort3_h(begin + 2, begin + (half + 1), end - 3, less);
+			sort3_h(begin + (half - 1), begin + half, begin + (half + 1), less);
+			swap_h(*begin, *(begin + half));
+		} else {
+			sort3_h(begin + half, begin, end - 1, less);
+		}
+
+		// The pivot equals the item before the range, so all items equal to the pivot are in place.
+		if (!leftmost && !less(*(begin - 1), *begin)) {
+			begin = partition_left_h(begin, end, less) + 1;
+			continue;
+		}
+
+		// Partition.
+		bool partitioned;
+		Type* pivot_pos = partition_right_h(begin, end, less, partitioned);
+		const ullong l_len = pivot_pos - begin;
+		const ullong r_len = end - (pivot_pos + 1);
+
+		// Break patterns of an unbalanced partition, fall back to heap sort after too many.
+		if (l_len < len / 8 || r_len < len / 8) {
+			if (--bad_allowed == 0) {
+				heap_h(begin, len, less);
+				return ;
+			}
+			if (l_len >= insertion_threshold) {
+				swap_h(*begin, *(begin + l_len / 4));
+				swap_h(*(pivot_pos - 1), *(pivot_pos - l_len / 4));
+				if (l_len > ninther_threshold) {
+					swap_h(*(begin + 1), *(begin + (l_len / 4 + 1)));
+					swap_h(*(begin + 2), *(begin + (l_len / 4 + 2)));
+					swap_h(*(pivot_pos - 2), *(pivot_pos - (l_len / 4 + 1)));
+					swap_h(*(pivot_pos - 3), *(pivot_pos - (l_len / 4 + 2)));
+				}
+			}
+			if (r_len >= insertion_threshold) {
+				swap_h(*(pivot_pos + 1), *(pivot_pos + (1 + r_len / 4)));
+				swap_h(*(end - 1), *(end - r_len / 4));
+				if (r_len > ninther_threshold) {
+					swap_h(*(pivot_pos + 2), *(pivot_pos + (2 + r_len / 4)));
+					swap_h(*(pivot_pos + 3), *(pivot_pos + (3 + r_len / 4)));
+					swap_h(*(end - 2), *(end - (1 + r_len / 4)));
+					swap_h(*(end - 3), *(end - (2 + r_len / 4)));
+				}
+			}
+		}
+
+		// A partition without swaps is probably sorted already.
+		else if (
+			partitioned &&
+			partial_insertion_h(begin, pivot_pos, less) &&
+			partial_insertion_h(pivot_pos + 1, end, less)
+		) {
+			return ;
+		}
+
+		// Recurse into the left side, loop on the right side.
+		pdq_h(begin, pivot_pos, less, bad_allowed, leftmost);
+		begin = pivot_pos + 1;
+		leftmost = false;
+	}
+}
+
+// Merge two sorted ranges into "out", equal items of "x" go first.
+template <typename Type, typename Func> inline constexpr
+void	merge_h(Type* x, ullong xlen, Type* y, ullong ylen, Type* out, Func& less) {
+	ullong i = 0, j = 0;
+	while (i < xlen && j < ylen) {
+		if (less(y[j], x[i])) { *out++ = vlib::move(y[j++]); }
+		else { *out++ = vlib::move(x[i++]); }
+	}
+	while (i < xlen) { *out++ = vlib::move(x[i++]); }
+	while (j < ylen) { *out++ = vlib::move(y[j++]); }
+}
+
+// The number of items of "x" in the first "k" items of the stable merge of "x" and "y".
+template <typename Type, typename Func> inline constexpr
+ullong	corank_h(ullong k, const Type* x, ullong xlen, const Type* y, ullong ylen, Func& less) {
+	ullong lo = k > ylen ? k - ylen : 0;
+	ullong hi = k < xlen ? k : xlen;
+	while (true) {
+		const ullong i = lo + (hi - lo) / 2;
+		const ullong j = k - i;
+		if (i < xlen && j > 0 && !less(y[j - 1], x[i])) { lo = i + 1; }
+		else if (i > 0 && j < ylen && less(y[j], x[i - 1])) { hi = i - 1; }
+		else { return i; }
+	}
+}
+
+// The number of online processors.
+inline
+ullong	processors_h() {
+	const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+	return cpus > 0 ? (ullong) cpus : 1;
+}
+
+// Run "func(index)" for "count" indexes on separate threads, the last index runs on the calling thread.
+template <typename Func> inline
+void	run_h(ullong count, Func& func) {
+	struct Task {
+		Func*		func;
+		ullong		index;
+		pthread_t	id;
+		static void* run(void* task) {
+			(*((Task*) task)->func)(((Task*) task)->index);
+			return nullptr;
+		}
+	};
+	if (count == 0) { return ; }
+	Task* tasks = new Task [count];
+	ullong started = 0;
+	for (ullong i = 0; i < count - 1; ++i) {
+		tasks[i].func = &func;
+		tasks[i].index = i;
+		if (pthread_create(&tasks[i].id, NULL, &Task::run, &tasks[i]) != 0) {
+			break;
+		}
+		++started;
+	}
+
+	// Tasks that could not be started run on the calling thread.
+	for (ullong i = started; i < count; ++i) { func(i); }
+	for (ullong i = 0; i < started; ++i) { pthread_join(tasks[i].id, NULL); }
+	delete[] tasks;
+}
+
+// The key of an item that is its own key.
+template <typename Type> inline constexpr
+const Type& identity_h(const Type& x) { return x; }
+
+// The unsigned integer of a key that sorts in the same order.
+template <typename Key> inline constexpr
+auto	radix_key_h(Key key) {
+	if constexpr (std::is_floating_point<Key>::value) {
+		static_assert(sizeof(Key) == 4 || sizeof(Key) == 8, "Radix sort does not support long doubles.");
+		using Bits = typename std::conditional<sizeof(Key) == 4, uint, ullong>::type;
+		Bits bits;
+		memcpy(&bits, &key, sizeof(Key));
+		constexpr Bits sign = (Bits) 1 << (sizeof(Key) * 8 - 1);
+		return (bits & sign) ? (Bits) ~bits : (Bits) (bits | sign);
+	} else if constexpr (std::is_same<Key, bool>::value) {
+		return (uchar) key;
+	} else if constexpr (std::is_signed<Key>::value) {
+		using Bits = typename std::make_unsigned<Key>::type;
+		return (Bits) ((Bits) key ^ ((Bits) 1 << (sizeof(Key) * 8 - 1)));
+	} else {
+		return key;
+	}
+}
+
+// ---------------------------------------------------------
+// Algorithms.
+
+// Pattern defeating quicksort.
+/*  @docs
+	@title: PDQ
+	@description:
+		Sort with pattern defeating quicksort, not stable.
+	@usage:
+		vlib::sorting::pdq(data, len);
+		vlib::sorting::pdq(data, len, [](int x, int y) { return x > y; });
+*/
+template <typename Type, typename Func = Less> inline constexpr
+void	pdq(Type* arr, ullong len, Func&& less = Func()) {
+	if (len < 2) { return ; }
+	int log = 0;
+	for (ullong i = len; i > 1; i >>= 1) { ++log; }
+	pdq_h(arr, arr + len, less, log, true);
+}
+
+// Stable merge sort.
+/*  @docs
+	@title: Merge
+	@description:
+		Stable bottom up merge sort, runs of 32 items are sorted with insertion sort first.
+
+		A buffer of `len` items may be passed to avoid an allocation.
+	@usage:
+		vlib::sorting::merge(data, len);
+*/
+template <typename Type, typename Func = Less> inline
+void	merge(Type* arr, ullong len, Func&& less = Func(), Type* buffer = nullptr) {
+	if (len < 2) { return ; }
+	constexpr ullong run = 32;
+	for (ullong start = 0; start < len; start += run) {
+		insertion_h<false>(arr + start, arr + (start + run < len ? start + run : len), less);
+	}
+	if (len <= run) { return ; }
+	Type* allocated = buffer == nullptr ? new Type [len] : nullptr;
+	Type* src = arr;
+	Type* dest = buffer == nullptr ? allocated : buffer;
+	for (ullong width = run; width < len; width *= 2) {
+		for (ullong start = 0; start < len; start += 2 * width) {
+			const ullong mid = start + width < len ? start + width : len;
+			const ullong end = start + 2 * width < len ? start + 2 * width : len;
+
+			// Runs that are already in order are only moved.
+			if (mid == end || !less(src[mid], src[mid - 1])) {
+				for (ullong i = start; i < end; ++i) { dest[i] = vlib::move(src[i]); }
+			} else {
+				merge_h(src + start, mid - start, src + mid, end - mid, dest + start, less);
+			}
+		}
+		Type* tmp = src;
+		src = dest;
+		dest = tmp;
+	}
+	if (src != arr) {
+		for (ullong i = 0; i < len; ++i) { arr[i] = vlib::move(src[i]); }
+	}
+	delete[] allocated;
+}
+
+// LSD radix sort.
+/*  @docs
+	@title: Radix
+	@description:
+		Stable least significant digit radix sort by an integral or floating key.
+
+		The key function returns the key of an item, by default the item itself. Negative floats are ordered before positive floats and NaN values are ordered by their sign.
+	@usage:
+		vlib::sorting::radix(data, len);
+		vlib::sorting::radix(indexes, len, [&](ullong i) { return prices[i]; });
+		vlib::sorting::radix(data, len, [](int x) { return x; }, true); // reversed.
+*/
+template <typename Type, typename Func> requires (std::is_invocable<Func, const Type&>::value) inline
+void	radix(Type* arr, ullong len, Func&& key, bool reversed = false, Type* buffer = nullptr) {
+	if (len < 2) { return ; }
+	using Bits = decltype(radix_key_h(key(arr[0])));
+	constexpr uint passes = sizeof(Bits);
+	auto bits = [&](const Type& item) {
+		const Bits x = radix_key_h(key(item));
+		return reversed ? (Bits) ~x : x;
+	};
+
+	// Count all digits in a single pass.
+	ullong* counts = new ullong [passes * 256];
+	memset(counts, 0, passes * 256 * sizeof(ullong));
+	for (ullong i = 0; i < len; ++i) {
+		const Bits x = bits(arr[i]);
+		for (uint p = 0; p < passes; ++p) {
+			++counts[p * 256 + ((x >> (p * 8)) & 0xFF)];
+		}
+	}
+
+	// Distribute per digit, digits that are equal for all keys are skipped.
+	Type* allocated = nullptr;
+	Type* src = arr;
+	Type* dest = buffer;
+	const Bits first = bits(arr[0]);
+	for (uint p = 0; p < passes; ++p) {
+		ullong* count = counts + p * 256;
+		if (count[(first >> (p * 8)) & 0xFF] == len) { continue; }
+		if (dest == nullptr) { dest = allocated = new Type [len]; }
+		ullong offset = 0;
+		for (uint b = 0; b < 256; ++b) {
+			const ullong c = count[b];
+			count[b] = offset;
+			offset += c;
+		}
+		for (ullong i = 0; i < len; ++i) {
+			dest[count[(bits(src[i]) >> (p * 8)) & 0xFF]++] = vlib::move(src[i]);
+		}
+		Type* tmp = src;
+		src = dest;
+		dest = tmp;
+	}
+	if (src != arr) {
+		for (ullong i = 0; i < len; ++i) { arr[i] = vlib::move(src[i]); }
+	}
+	delete[] counts;
+	delete[] allocated;
+}
+template <typename Type> requires (std::is_arithmetic<Type>::value) inline
+void	radix(Type* arr, ullong len, bool reversed = false) {
+	radix(arr, len, identity_h<Type>, reversed);
+}
+
+// Parallel sort.
+/*  @docs
+	@title: Parallel
+	@description:
+		Sort on multiple threads.
+
+		The array is divided into one chunk per thread, the chunks are sorted with `pdq` or with `merge` when `stable` is true. The sorted chunks are merged in rounds where every merge is divided over the threads by co-ranking, so the last merge is parallel as well.
+
+		Every thread sorts at least `parallel_threshold` items, smaller arrays are sorted on the calling thread.
+	@parameter:
+		@name: threads
+		@description: The maximum number of threads, `0` for the number of online processors.
+	}
+	@usage:
+		vlib::sorting::parallel(data, len);
+		vlib::sorting::parallel(data, len, vlib::sorting::Less(), 8, true);
+*/
+template <typename Type, typename Func = Less> inline
+void	parallel(Type* arr, ullong len, Func&& less = Func(), ullong threads = 0, bool stable = false) {
+	if (threads == 0) { threads = processors_h(); }
+	if (threads > len / parallel_threshold) { threads = len / parallel_threshold; }
+	if (threads < 2) {
+		if (stable) { merge(arr, len, less); }
+		else { pdq(arr, len, less); }
+		return ;
+	}
+
+	// Sort the chunks.
+	ullong* bounds = new ullong [threads + 1];
+	for (ullong i = 0; i <= threads; ++i) { bounds[i] = len * i / threads; }
+	auto sort_chunk = [&](ullong i) {
+		if (stable) { merge(arr + bounds[i], bounds[i + 1] - bounds[i], less); }
+		else { pdq(arr + bounds[i], bounds[i + 1] - bounds[i], less); }
+	};
+	run_h(threads, sort_chunk);
+
+	// Merge the chunks in rounds.
+	Type* buffer = new Type [len];
+	Type* src = arr;
+	Type* dest = buffer;
+	for (ullong width = 1; width < threads; width *= 2) {
+		const ullong pairs = (threads + 2 * width - 1) / (2 * width);
+		const ullong parts = threads / pairs > 0 ? threads / pairs : 1;
+		auto merge_part = [&](ullong task) {
+			const ullong pair = task / parts;
+			const ullong part = task % parts;
+			const ullong start = bounds[pair * 2 * width];
+			const ullong mid = bounds[(pair * 2 + 1) * width < threads ? (pair * 2 + 1) * width : threads];
+			const ullong end = bounds[(pair + 1) * 2 * width < threads ? (pair + 1) * 2 * width : threads];
+			Type* x = src + start;
+			Type* y = src + mid;
+			const ullong xlen = mid - start, ylen = end - mid, total = end - start;
+			const ullong k0 = total * part / parts, k1 = total * (part + 1) / parts;
+			const ullong i0 = corank_h(k0, x, xlen, y, ylen, less);
+			const ullong i1 = corank_h(k1, x, xlen, y, ylen, less);
+			merge_h(x + i0, i1 - i0, y + (k0 - i0), (k1 - i1) - (k0 - i0), dest + start + k0, less);
+		};
+		run_h(pairs * parts, merge_part);
+		Type* tmp = src;
+		src = dest;
+		dest = tmp;
+	}
+	if (src != arr) {
+		auto move_back = [&](ullong i) {
+			for (ullong j = bounds[i]; j < bounds[i + 1]; ++j) { arr[j] = vlib::move(src[j]); }
+		};
+		run_h(threads, move_back);
+	}
+	delete[] buffer;
+	delete[] bounds;
+}
+
+// Sort.
+/*  @docs
+	@title: Sort
+	@description:
+		Sort with `pdq`, or with `parallel` when the array holds at least two times `parallel_threshold` items.
+	@usage:
+		vlib::sorting::sort(data, len);
+*/
+template <typename Type, typename Func = Less> inline
+void	sort(Type* arr, ullong len, Func&& less = Func()) {
+	if (len >= 2 * parallel_threshold) { parallel(arr, len, less); }
+	else { pdq(arr, len, less); }
+}
+
+}; 		// End namespace sorting.
+}; 		// End namespace vlib.
+#endif 	// End header.
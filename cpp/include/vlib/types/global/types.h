@@ -301,6 +301,26 @@ struct 							Shared 										{ SICEBOOL value = false; };
 template<typename Type> 		struct is_Shared 								{ SICEBOOL value = false; };
 template<> 						struct is_Shared<Shared> 					{ SICEBOOL value = true;  };
 
+// ---------------------------------------------------------
+// Atomic type.
+// - Shared with an atomic reference count.
+
+struct 							Atomic 										{ SICEBOOL value = false; };
+
+// Is type.
+template<typename Type> 		struct is_Atomic 								{ SICEBOOL value = false; };
+template<> 						struct is_Atomic<Atomic> 					{ SICEBOOL value = true;  };
+
+// ---------------------------------------------------------
+// Intrusive type.
+// - Shared with an atomic reference count that is allocated together with the object.
+
+struct 							Intrusive 									{ SICEBOOL value = false; };
+
+// Is type.
+template<typename Type> 		struct is_Intrusive 							{ SICEBOOL value = false; };
+template<> 						struct is_Intrusive<Intrusive> 				{ SICEBOOL value = true;  };
+
 // ---------------------------------------------------------
 // Shortcuts.
 
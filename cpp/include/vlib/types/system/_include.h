@@ -14,6 +14,7 @@
 #include "sync.h"
 #include "file.h"
 #include "logger.h"
+#include "async_logger.h"
 #include "script.h"
 #include "proc.h"
 #include "daemon.h"
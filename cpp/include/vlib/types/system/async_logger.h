@@ -0,0 +1,417 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Header.
+#ifndef VLIB_ASYNC_LOGGER_H
+#define VLIB_ASYNC_LOGGER_H
+
+// Includes.
+#include <sys/uio.h>
+#include <sched.h>
+
+// Namespace vlib.
+namespace vlib {
+
+namespace logger {
+// Backpressure policies, used when the staging buffer of a thread is full.
+enum policy {
+	drop =		0,		// drop the message and increment the dropped counter.
+	block =		1,		// wait until the writer thread has made room.
+};
+};
+
+// ---------------------------------------------------------
+// Asynchronous logger type.
+//
+// Notes:
+// - Every logging thread gets its own single producer / single consumer staging buffer, logging only copies the message into this buffer without locks or syscalls.
+// - A background writer thread batches the staged messages of all threads into a single "writev" call, when a buffer reaches the flush length or every flush interval.
+// - The memory is bounded by the buffer length per logging thread, when a buffer is full the message is dropped or the thread waits depending on the policy.
+// - The messages of a single thread are written in order, messages of different threads are interleaved per batch.
+// - A message that is longer than the buffer length is written directly by the logging thread, after the staged messages have been flushed.
+// - The buffer of a thread is kept until the logger is destroyed, the logger may not be used while it is being destroyed.
+//
+/* 	@docs
+	@chapter: System
+	@title: Async Logger
+	@description:
+		Asynchronous logger that writes the messages of all threads in batches from a background thread.
+	@usage:
+        #include <vlib/types.h>
+		vlib::AsyncLogger logger("/tmp/logs/logs.txt");
+		logger.log("Hello World!\n");
+		logger.flush();
+*/
+class AsyncLogger {
+
+// Private.
+private:
+
+    // ---------------------------------------------------------
+    // Aliases.
+
+    using   This = AsyncLogger;
+
+	// ---------------------------------------------------------
+	// Structs.
+
+	// Staging buffer of a single thread.
+	// - The head and tail are the total written and consumed lengths, the used length is "head - tail".
+	struct Ring {
+		char*		data = nullptr;
+		ullong		mask = 0;				// the capacity minus one.
+		ullong		head = 0;				// only written by the logging thread.
+		ullong		tail = 0;				// only written by the writer thread.
+		ullong		batch = 0;				// the length in the current batch of the writer thread.
+	};
+
+	// Staging buffer of a logger in the thread local cache.
+	struct Local {
+		ullong		id;
+		Ring*		ring;
+	};
+
+	// ---------------------------------------------------------
+	// Attributes.
+
+	ullong				m_id;
+	int					m_fd = -1;
+	bool				m_owns_fd = false;
+	ullong				m_buffer_len;			// the staging buffer length per thread, a power of two.
+	ullong				m_flush_len;			// the staged length that wakes the writer.
+	mtime_t				m_interval;				// the flush interval in milliseconds.
+	int					m_policy;
+	ullong				m_dropped = 0;
+	bool				m_stop = false;
+	Array<Ring*>		m_rings;
+	pthread_mutex_t		m_mutex;				// guards the rings array and the stop flag.
+	pthread_mutex_t		m_flush_mutex;			// guards the ring tails.
+	pthread_cond_t		m_cond;
+	FThread				m_writer;
+
+	// ---------------------------------------------------------
+	// Static attributes.
+
+	// The max number of io vectors of a single write.
+	SICE ullong			max_iov = 1024;
+
+	// The logger ids.
+	static inline ullong		s_next_id = 1;
+
+	// The staging buffers of the current thread.
+	static inline thread_local Array<Local>	t_rings;
+
+	// ---------------------------------------------------------
+	// Private functions.
+
+	// Get the staging buffer of the current thread.
+	Ring*	ring_h() {
+		for (auto& local: t_rings) {
+			if (local.id == m_id) { return local.ring; }
+		}
+		Ring* ring = new Ring();
+		ring->data = new char [m_buffer_len];
+		ring->mask = m_buffer_len - 1;
+		pthread_mutex_lock(&m_mutex);
+		m_rings.append(ring);
+		pthread_mutex_unlock(&m_mutex);
+		t_rings.append(Local{m_id, ring});
+		return ring;
+	}
+
+	// Wake the writer thread.
+	void	wake_h() {
+		pthread_cond_signal(&m_cond);
+	}
+
+	// Write data directly, retrying on partial writes.
+	void	write_h(const char* data, ullong len) {
+		while (len > 0) {
+			const ssize_t bytes = ::write(m_fd, data, len);
+			if (bytes < 0) {
+				if (errno == EINTR) { continue; }
+				return ;
+			}
+			data += bytes;
+			len -= bytes;
+		}
+	}
+
+	// Write all staged data.
+	// - Must be called with the flush mutex locked.
+	// - Data that can not be written because of a write error is discarded.
+	void	flush_h() {
+		struct iovec iov[max_iov];
+		Ring* batch[max_iov / 2];
+		while (true) {
+
+			// Collect the staged data of all threads.
+			ullong count = 0, rings = 0, total = 0;
+			pthread_mutex_lock(&m_mutex);
+			for (auto& ring: m_rings) {
+				if (count + 2 > max_iov) { break; }
+				const ullong head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+				const ullong used = head - ring->tail;
+				if (used == 0) { continue; }
+				const ullong offset = ring->tail & ring->mask;
+				const ullong first = used < ring->mask + 1 - offset ? used : ring->mask + 1 - offset;
+				iov[count].iov_base = ring->data + offset;
+				iov[count].iov_len = first;
+				++count;
+				if (first < used) {
+					iov[count].iov_base = ring->data;
+					iov[count].iov_len = used - first;
+					++count;
+				}
+				ring->batch = used;
+				batch[rings++] = ring;
+				total += used;
+			}
+			pthread_mutex_unlock(&m_mutex);
+			if (rings == 0) { return ; }
+
+			// Write.
+			ssize_t bytes;
+			while ((bytes = ::writev(m_fd, iov, (int) count)) < 0 && errno == EINTR) {}
+			ullong written = bytes < 0 ? total : (ullong) bytes;
+
+			// Release the written data.
+			for (ullong i = 0; i < rings; ++i) {
+				const ullong len = written < batch[i]->batch ? written : batch[i]->batch;
+				__atomic_store_n(&batch[i]->tail, batch[i]->tail + len, __ATOMIC_RELEASE);
+				written -= len;
+			}
+			if (bytes >= 0 && (ullong) bytes == total && count + 2 <= max_iov) { return ; }
+		}
+	}
+
+	// Run the writer thread.
+	void	run_h() {
+		while (true) {
+			pthread_mutex_lock(&m_mutex);
+			if (!m_stop) {
+				struct timespec deadline;
+				clock_gettime(CLOCK_REALTIME, &deadline);
+				deadline.tv_sec += m_interval / 1000;
+				deadline.tv_nsec += (m_interval % 1000) * 1000000;
+				if (deadline.tv_nsec >= 1000000000) {
+					deadline.tv_sec += 1;
+					deadline.tv_nsec -= 1000000000;
+				}
+				pthread_cond_timedwait(&m_cond, &m_mutex, &deadline);
+			}
+			const bool stop = m_stop;
+			pthread_mutex_unlock(&m_mutex);
+			flush();
+			if (stop) { return ; }
+		}
+	}
+
+	// Initialize.
+	void	init_h(ullong buffer_len) {
+		m_id = __atomic_fetch_add(&s_next_id, 1, __ATOMIC_RELAXED);
+		m_buffer_len = 1024;
+		while (m_buffer_len < buffer_len) { m_buffer_len *= 2; }
+		if (m_flush_len > m_buffer_len) { m_flush_len = m_buffer_len; }
+		pthread_mutex_init(&m_mutex, NULL);
+		pthread_mutex_init(&m_flush_mutex, NULL);
+		pthread_cond_init(&m_cond, NULL);
+		m_writer.start([](This* logger) -> void* {
+			logger->run_h();
+			return nullptr;
+		}, this);
+	}
+
+// Public.
+public:
+
+	// ---------------------------------------------------------
+	// Constructors.
+
+	// Constructor from path.
+	/*  @docs
+		@title: Constructor
+		@description:
+			Construct a logger that appends to a file or writes to a file descriptor.
+		@parameter:
+			@name: path
+			@description: The path of the log file, or the file descriptor, which is not closed by the logger.
+		}
+		@parameter:
+			@name: buffer_len
+			@description: The staging buffer length per logging thread in bytes, rounded up to a power of two.
+		}
+		@parameter:
+			@name: flush_len
+			@description: The staged length in bytes of a single thread that wakes the writer thread before the interval has passed.
+		}
+		@parameter:
+			@name: interval
+			@description: The flush interval in milliseconds.
+		}
+		@parameter:
+			@name: policy
+			@description: The backpressure policy, `logger::drop` or `logger::block`.
+		}
+		@usage:
+			vlib::AsyncLogger logger("/tmp/logs/logs.txt", 256 * 1024, 64 * 1024, 50, vlib::logger::block);
+		@funcs: 2
+	*/
+	AsyncLogger(
+		const char*		path,
+		ullong			buffer_len = 64 * 1024,
+		ullong			flush_len = 16 * 1024,
+		mtime_t			interval = 100,
+		int				policy = logger::drop
+	) :
+	m_flush_len(flush_len),
+	m_interval(interval),
+	m_policy(policy)
+	{
+		m_fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0640);
+		if (m_fd == -1) {
+			throw OpenError(to_str("Unable to open file \"", path, "\" [", ::strerror(errno), "]."));
+		}
+		m_owns_fd = true;
+		init_h(buffer_len);
+	}
+	AsyncLogger(
+		int				fd,
+		ullong			buffer_len = 64 * 1024,
+		ullong			flush_len = 16 * 1024,
+		mtime_t			interval = 100,
+		int				policy = logger::drop
+	) :
+	m_fd(fd),
+	m_flush_len(flush_len),
+	m_interval(interval),
+	m_policy(policy)
+	{
+		init_h(buffer_len);
+	}
+
+	// No copy constructor.
+	AsyncLogger(const This&) = delete;
+
+	// Destructor.
+	// - Stops the writer thread after all staged messages have been written.
+	~AsyncLogger() {
+		pthread_mutex_lock(&m_mutex);
+		m_stop = true;
+		pthread_cond_signal(&m_cond);
+		pthread_mutex_unlock(&m_mutex);
+		m_writer.join();
+		for (auto& ring: m_rings) {
+			delete[] ring->data;
+			delete ring;
+		}
+		if (m_owns_fd) {
+			::close(m_fd);
+		}
+		pthread_mutex_destroy(&m_mutex);
+		pthread_mutex_destroy(&m_flush_mutex);
+		pthread_cond_destroy(&m_cond);
+	}
+
+	// ---------------------------------------------------------
+	// Functions.
+
+	// Log.
+	/*  @docs
+		@title: Log
+		@description:
+			Stage a message for writing.
+
+			Returns `false` when the message was dropped because the staging buffer of the thread is full.
+		@funcs: 2
+	*/
+    bool	log(const String& msg) {
+        return log(msg.data(), msg.len());
+    }
+	bool	log(const char* msg, ullong len) {
+		if (len > m_buffer_len) {
+
+			// Write the staged messages first so the messages of this thread stay in order.
+			pthread_mutex_lock(&m_flush_mutex);
+			flush_h();
+			write_h(msg, len);
+			pthread_mutex_unlock(&m_flush_mutex);
+			return true;
+		}
+		Ring* ring = ring_h();
+		const ullong head = ring->head;
+		ullong tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+		// Backpressure.
+		while (m_buffer_len - (head - tail) < len) {
+			if (m_policy == logger::drop) {
+				__atomic_fetch_add(&m_dropped, 1, __ATOMIC_RELAXED);
+				return false;
+			}
+			wake_h();
+			sched_yield();
+			tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+		}
+
+		// Copy.
+		const ullong offset = head & ring->mask;
+		const ullong first = len < m_buffer_len - offset ? len : m_buffer_len - offset;
+		memcpy(ring->data + offset, msg, first);
+		if (first < len) {
+			memcpy(ring->data, msg + first, len - first);
+		}
+		__atomic_store_n(&ring->head, head + len, __ATOMIC_RELEASE);
+
+		// Wake the writer when the flush length is reached.
+		if (head - tail < m_flush_len && head + len - tail >= m_flush_len) {
+			wake_h();
+		}
+		return true;
+	}
+
+	// Flush.
+	/*  @docs
+		@title: Flush
+		@description:
+			Write all staged messages from the calling thread.
+	*/
+	void	flush() {
+		pthread_mutex_lock(&m_flush_mutex);
+		flush_h();
+		pthread_mutex_unlock(&m_flush_mutex);
+	}
+
+	// Dropped.
+	/*  @docs
+		@title: Dropped
+		@description:
+			Get the number of dropped messages.
+	*/
+	ullong	dropped() const {
+		return __atomic_load_n(&m_dropped, __ATOMIC_RELAXED);
+	}
+
+};
+
+// ---------------------------------------------------------
+// Instances.
+
+// Is type.
+template<typename Type> struct is_AsyncLogger 					{ SICEBOOL value = false; };
+template<> 				struct is_AsyncLogger<AsyncLogger> 		{ SICEBOOL value = true;  };
+
+// ---------------------------------------------------------
+// Shortcuts.
+
+namespace types { namespace shortcuts {
+
+using AsyncLogger =		vlib::AsyncLogger;
+
+}; 		// End namespace types.
+}; 		// End namespace shortcuts.
+
+// ---------------------------------------------------------
+// End.
+
+}; 		// End namespace vlib.
+#endif 	// End header.
@@ -1404,6 +1404,10 @@ public:
 	This	parse(const char* unix) {
 		return to_num<long>(unix);
 	}
+	template <typename View> requires (requires (const View& x) { static_cast<const char*>(x.data()); x.len(); }) SICE
+	This	parse(const View& unix) {
+		return to_num<long>(unix.data(), unix.len());
+	}
 	
 	// Parse from a formatted date string.
 	/* 	@docs
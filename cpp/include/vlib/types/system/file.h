@@ -5,11 +5,20 @@
 #ifndef VLIB_FILE_T_H
 #define VLIB_FILE_T_H
 
+// Includes.
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 // Namespace vlib.
 namespace vlib {
 
 // ---------------------------------------------------------
 // File type.
+//
+// Notes:
+// - Functions "pread", "pwrite", "chunks" and "writer" use a second file descriptor that stays open until "close()", independent of the file mode and the "FILE*" of the stream functions.
+// - With direct I/O the buffers, offsets and lengths of "pread" and "pwrite" must be a multiple of "File::block_len", "chunks" and "writer" align their own buffers.
+//
 
 /* 	@docs
 	@chapter: System
@@ -23,9 +32,14 @@ namespace vlib {
 		- `vlib::file::r`.
 		- `vlib::file::w`.
 		- `vlib::file::a`.
+
+		Large files can be streamed in fixed chunks with `chunks()` and `writer()`, or mapped into memory with `view()`.
 	@usage:
         #include <vlib/types.h>
 		vlib::File file("/tmp/myfile.txt");
+		for (auto& chunk: file.chunks(1024 * 1024)) {
+			process(chunk.data, chunk.len);
+		}
 */
 struct File {
 
@@ -40,44 +54,489 @@ public:
 	using 		Length = 	    ullong;
 	
 	// ---------------------------------------------------------
-	// Structures.
-	
-	
-    
+	// Static attributes.
+
+	// The alignment of direct I/O.
+	SICE Length block_len = 4096;
+
 	// ---------------------------------------------------------
 	// Attributes.
 
+	// - The file is closed by the destructor, which runs once when the last link is destroyed.
 	struct attr {
 		Path	path;						// the file path.
 		FILE*	file =	nullptr;			// the file pointer.
 		int		mode =	vlib::file::append;	// the file mode.
+		int		fd = -1;					// the file descriptor of the positional functions.
+		bool	direct = false;				// use direct I/O on the file descriptor.
+		constexpr
+		attr() = default;
+		constexpr
+		attr(Path path, int mode) :
+		path(move(path)),
+		mode(mode) {}
+		attr(const attr&) = delete;
+		constexpr
+		attr(attr&& obj) :
+		path(move(obj.path)),
+		file(obj.file),
+		mode(obj.mode),
+		fd(obj.fd),
+		direct(obj.direct)
+		{
+			obj.file = nullptr;
+			obj.fd = -1;
+		}
+		constexpr
+		~attr() {
+			close_h();
+		}
+		constexpr
+		attr&	operator =(attr&& obj) {
+			if (this == &obj) { return *this; }
+			close_h();
+			path = move(obj.path);
+			file = obj.file;
+			mode = obj.mode;
+			fd = obj.fd;
+			direct = obj.direct;
+			obj.file = nullptr;
+			obj.fd = -1;
+			return *this;
+		}
+		constexpr
+		void	close_h() {
+			if (file != nullptr) {
+				::fclose(file);
+				file = nullptr;
+			}
+			if (fd != -1) {
+				::close(fd);
+				fd = -1;
+			}
+		}
 	};
-	SPtr<attr>	m_attr;
+	APtr<attr>	m_attr;
 
 // Private.
 private:
 
 	// ---------------------------------------------------------
 	// Private helpers.
+
+	// Set direct I/O on the file descriptor.
+	static inline
+	void	direct_h(attr& a, bool enable) {
+		#if defined(__APPLE__)
+			if (::fcntl(a.fd, F_NOCACHE, enable ? 1 : 0) == -1) {
+				throw OpenError(to_str("Unable to set direct I/O for file \"", a.path, "\" [", ::strerror(errno), "]."));
+			}
+		#elif defined(O_DIRECT)
+			int flags = ::fcntl(a.fd, F_GETFL);
+			if (flags != -1) {
+				flags = enable ? flags | O_DIRECT : flags & ~O_DIRECT;
+			}
+			if (flags == -1 || ::fcntl(a.fd, F_SETFL, flags) == -1) {
+				throw OpenError(to_str("Unable to set direct I/O for file \"", a.path, "\" [", ::strerror(errno), "]."));
+			}
+		#endif
+	}
+
+	// Get the file descriptor of the positional functions, opened on demand.
+	// - The stream buffer is flushed so both views of the file are equal.
+	// - Falls back to read only when the file is not writable.
+	static inline
+	int		fd_h(attr& a, bool create) {
+		if (a.file != nullptr) {
+			::fflush(a.file);
+		}
+		if (a.fd != -1) {
+			return a.fd;
+		}
+		if (a.path.is_undefined()) {
+            throw InvalidUsageError("Path is undefined.");
+		}
+		a.fd = ::open(a.path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0640);
+		if (a.fd == -1 && (errno == EACCES || errno == EROFS)) {
+			a.fd = ::open(a.path.c_str(), O_RDONLY | O_CLOEXEC);
+		}
+		if (a.fd == -1) {
+            throw OpenError(to_str("Unable to open file \"", a.path, "\" [", ::strerror(errno), "]."));
+		}
+		if (a.direct) {
+			direct_h(a, true);
+		}
+		return a.fd;
+	}
+
+	// Allocate a buffer aligned for direct I/O.
+	static inline
+	char*	alloc_h(Length& capacity) {
+		if (capacity < block_len) { capacity = block_len; }
+		capacity = (capacity + block_len - 1) / block_len * block_len;
+		void* buff;
+		if (::posix_memalign(&buff, block_len, capacity) != 0) {
+			throw AllocError("Unable to allocate a file buffer.");
+		}
+		return (char*) buff;
+	}
+
+	// Read positional data, until the length is read or the end of the file is reached.
+	static inline
+	Length	pread_h(attr& a, char* data, Length len, Length offset) {
+		const int fd = fd_h(a, false);
+		Length total = 0;
+		while (total < len) {
+			const ssize_t bytes = ::pread(fd, data + total, len - total, offset + total);
+			if (bytes < 0) {
+				if (errno == EINTR) { continue; }
+				throw ReadError(to_str("Unable to read file \"", a.path, "\" [", ::strerror(errno), "]."));
+			}
+			total += bytes;
+			if (bytes == 0 || (a.direct && total < len)) { break; }
+		}
+		return total;
+	}
+
+	// Write positional data.
+	static inline
+	void	pwrite_h(attr& a, const char* data, Length len, Length offset) {
+		const int fd = fd_h(a, true);
+		while (len > 0) {
+			const ssize_t bytes = ::pwrite(fd, data, len, offset);
+			if (bytes < 0) {
+				if (errno == EINTR) { continue; }
+				throw WriteError(to_str("Unable to write to file \"", a.path, "\" [", ::strerror(errno), "]."));
+			}
+			data += bytes;
+			len -= bytes;
+			offset += bytes;
+		}
+	}
 	
 	// Constructor from attr.
 	constexpr
-	File (const attr& a) :
-	m_attr(a) {}
-	constexpr
 	File (attr&& a) :
-	m_attr(a) {}
+	m_attr(move(a)) {}
 
 // Public.
 public:
 
+	// ---------------------------------------------------------
+	// Structures.
+
+	// A chunk of the file data.
+	struct Chunk {
+		const char*	data = nullptr;
+		Length		len = 0;
+		Length		offset = 0;				// the offset of the chunk in the file.
+	};
+
+	// Chunked reader.
+	// - The chunk data is only valid until the next chunk is read.
+	/*  @docs
+		@title: Chunks
+		@description:
+			Chunked reader, created with `File::chunks()`.
+
+			Reads the file in fixed chunks into a single reused buffer, the last chunk may be shorter.
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			vlib::File::Chunks chunks = file.chunks(1024 * 1024);
+			while (chunks.next()) {
+				process(chunks.chunk().data, chunks.chunk().len);
+			}
+	*/
+	struct Chunks {
+
+		// Iterator.
+		struct Iterator {
+			Chunks*		m_chunks;
+			Chunk&		operator *() const { return m_chunks->m_chunk; }
+			Chunk*		operator ->() const { return &m_chunks->m_chunk; }
+			Iterator&	operator ++() { m_chunks->next(); return *this; }
+			bool		operator !=(const Iterator&) const { return m_chunks->m_chunk.len != 0; }
+		};
+
+		APtr<attr>	m_attr;
+		char*		m_buff;
+		Length		m_capacity;
+		Length		m_offset;				// the offset of the next chunk.
+		Length		m_end;					// the end offset.
+		Chunk		m_chunk;
+
+		// Constructor.
+		Chunks(const APtr<attr>& a, Length chunk_len, Length offset, Length len) :
+		m_attr(a),
+		m_capacity(chunk_len),
+		m_offset(offset),
+		m_end(len == 0 || offset + len < offset ? limits<Length>::max : offset + len)
+		{
+			if (a->direct && offset % block_len != 0) {
+				throw InvalidUsageError("The offset of direct I/O must be a multiple of the block length.");
+			}
+			m_buff = alloc_h(m_capacity);
+		}
+
+		// Move constructor.
+		Chunks(Chunks&& obj) :
+		m_attr(obj.m_attr),
+		m_buff(obj.m_buff),
+		m_capacity(obj.m_capacity),
+		m_offset(obj.m_offset),
+		m_end(obj.m_end),
+		m_chunk(obj.m_chunk)
+		{
+			obj.m_buff = nullptr;
+		}
+
+		// No copy constructor.
+		Chunks(const Chunks&) = delete;
+
+		// Destructor.
+		~Chunks() {
+			::free(m_buff);
+		}
+
+		// Read the next chunk, returns false at the end of the file.
+		bool	next() {
+			Length len = m_end - m_offset < m_capacity ? m_end - m_offset : m_capacity;
+			m_chunk.len = len == 0 ? 0 : pread_h(*m_attr, m_buff, len, m_offset);
+			m_chunk.data = m_buff;
+			m_chunk.offset = m_offset;
+			m_offset += m_chunk.len;
+			return m_chunk.len != 0;
+		}
+
+		// The current chunk.
+		constexpr
+		Chunk&	chunk() { return m_chunk; }
+
+		// Iterate.
+		Iterator	begin() { next(); return Iterator{this}; }
+		Iterator	end() { return Iterator{this}; }
+
+	};
+
+	// Buffered writer.
+	/*  @docs
+		@title: Writer
+		@description:
+			Buffered sequential writer, created with `File::writer()`.
+
+			Data is collected in a fixed buffer and written with `pwrite` once the buffer is full, larger writes bypass the buffer. Call `close()` to write the remaining data, the destructor ignores write errors.
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			vlib::File::Writer writer = file.writer();
+			writer.write("Hello World!\n");
+			writer.close();
+	*/
+	struct Writer {
+
+		APtr<attr>	m_attr;
+		char*		m_buff;
+		Length		m_capacity;
+		Length		m_len = 0;				// the buffered length.
+		Length		m_offset;				// the file offset of the buffer.
+
+		// Constructor.
+		Writer(const APtr<attr>& a, Length buffer_len, Length offset) :
+		m_attr(a),
+		m_capacity(buffer_len),
+		m_offset(offset)
+		{
+			if (m_offset == limits<Length>::max) {
+				struct stat info;
+				if (::fstat(fd_h(*m_attr, true), &info) != 0) {
+					throw ReadError(to_str("Unable to read file \"", a->path, "\" [", ::strerror(errno), "]."));
+				}
+				m_offset = (Length) info.st_size;
+			}
+			if (a->direct && m_offset % block_len != 0) {
+				throw InvalidUsageError("The offset of direct I/O must be a multiple of the block length.");
+			}
+			m_buff = alloc_h(m_capacity);
+		}
+
+		// Move constructor.
+		Writer(Writer&& obj) :
+		m_attr(obj.m_attr),
+		m_buff(obj.m_buff),
+		m_capacity(obj.m_capacity),
+		m_len(obj.m_len),
+		m_offset(obj.m_offset)
+		{
+			obj.m_buff = nullptr;
+			obj.m_len = 0;
+		}
+
+		// No copy constructor.
+		Writer(const Writer&) = delete;
+
+		// Destructor.
+		~Writer() {
+			try { close(); }
+			catch (...) {}
+			::free(m_buff);
+		}
+
+		// Write data.
+		Writer&	write(const String& data) {
+			return write(data.data(), data.len());
+		}
+		Writer&	write(const char* data, Length len) {
+			if (m_len == 0 && len >= m_capacity && !m_attr->direct) {
+				pwrite_h(*m_attr, data, len, m_offset);
+				m_offset += len;
+				return *this;
+			}
+			while (len > 0) {
+				const Length n = m_capacity - m_len < len ? m_capacity - m_len : len;
+				memcpy(m_buff + m_len, data, n);
+				m_len += n;
+				data += n;
+				len -= n;
+				if (m_len == m_capacity) {
+					flush();
+				}
+			}
+			return *this;
+		}
+
+		// Write the buffered data.
+		// - With direct I/O only whole blocks are written, the remainder stays buffered until "close()".
+		Writer&	flush() {
+			const Length len = m_attr->direct ? m_len / block_len * block_len : m_len;
+			if (len == 0) { return *this; }
+			pwrite_h(*m_attr, m_buff, len, m_offset);
+			m_offset += len;
+			m_len -= len;
+			if (m_len != 0) {
+				memmove(m_buff, m_buff + len, m_len);
+			}
+			return *this;
+		}
+
+		// Write all remaining data.
+		void	close() {
+			if (m_buff == nullptr) { return ; }
+			flush();
+			if (m_len != 0) {
+				direct_h(*m_attr, false);
+				pwrite_h(*m_attr, m_buff, m_len, m_offset);
+				direct_h(*m_attr, true);
+				m_offset += m_len;
+				m_len = 0;
+			}
+		}
+
+		// The file offset of the next write.
+		constexpr
+		Length	offset() const { return m_offset + m_len; }
+
+	};
+
+	// Memory mapped view.
+	// - Maps a file read only, the mapping is released when the object is destructed.
+	// - An empty file is not mapped, "data()" is a null pointer then.
+	/*  @docs
+		@title: View
+		@description:
+			Read only memory mapped view of a file, created with `File::view()`.
+		@usage:
+			vlib::File::View view = vlib::File("/tmp/myfile.txt").view();
+			view.advise(vlib::file::sequential);
+			process(view.data(), view.len());
+	*/
+	struct View {
+
+		char*		m_data = nullptr;
+		Length		m_len = 0;
+
+		// Default constructor.
+		constexpr
+		View() = default;
+
+		// Constructor from path.
+		View(const char* path) {
+			open(path);
+		}
+
+		// Move constructor.
+		View(View&& obj) :
+		m_data(obj.m_data),
+		m_len(obj.m_len)
+		{
+			obj.m_data = nullptr;
+			obj.m_len = 0;
+		}
+
+		// No copy constructor.
+		View(const View&) = delete;
+
+		// Destructor.
+		~View() {
+			close();
+		}
+
+		// Open.
+		void	open(const char* path) {
+			close();
+			int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				throw OpenError(to_str("Unable to open file \"", path, "\" [", ::strerror(errno), "]."));
+			}
+			struct stat info;
+			if (::fstat(fd, &info) != 0) {
+				::close(fd);
+				throw ReadError(to_str("Unable to read file \"", path, "\" [", ::strerror(errno), "]."));
+			}
+			m_len = (Length) info.st_size;
+			if (m_len > 0) {
+				void* data = ::mmap(nullptr, m_len, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (data == MAP_FAILED) {
+					::close(fd);
+					m_len = 0;
+					throw ReadError(to_str("Unable to map file \"", path, "\" [", ::strerror(errno), "]."));
+				}
+				m_data = (char*) data;
+			}
+			::close(fd);
+		}
+
+		// Advise the access pattern, for example "file::sequential".
+		void	advise(int advice) const {
+			if (m_data != nullptr) {
+				::madvise(m_data, m_len, advice);
+			}
+		}
+
+		// Close.
+		void	close() {
+			if (m_data != nullptr) {
+				::munmap(m_data, m_len);
+				m_data = nullptr;
+			}
+			m_len = 0;
+		}
+
+		// Data.
+		constexpr
+		const char*	data() const { return m_data; }
+
+		// Length.
+		constexpr
+		Length	len() const { return m_len; }
+
+	};
+
 	// ---------------------------------------------------------
 	// Constructors.
 
 	// Default constructor.
 	constexpr
 	File () :
-	m_attr(attr{}) {}
+	m_attr(attr()) {}
 
 	// Constructor from path.
 	/*  @docs
@@ -98,10 +557,10 @@ public:
 	*/
 	constexpr
 	File (Path path, int mode = vlib::file::append) :
-	m_attr(attr{ .path = move(path), .mode = mode }) {}
+	m_attr(attr(move(path), mode)) {}
     constexpr
     File (const char* path, int mode = vlib::file::append) :
-    m_attr(attr{ .path = path, .mode = mode }) {}
+    m_attr(attr(path, mode)) {}
 
 	// Copy constructor.
 	constexpr
@@ -114,12 +573,9 @@ public:
 	m_attr(move(obj.m_attr)) {}
 
 	// Destructor.
+	// - The file is closed by the destructor of the attributes once the last link is destroyed.
 	constexpr
-	~File() {
-		if (m_attr.links() == 0 && m_attr->file != nullptr) {
-			::fclose(m_attr->file);
-		}
-	}
+	~File() {}
 
 	// ---------------------------------------------------------
 	// Assignment operators.
@@ -164,13 +620,13 @@ public:
 	constexpr
 	This&	reconstruct(const Path& path, int mode = vlib::file::append) {
 		close();
-		m_attr = attr{ .path = path, .mode = mode };
+		m_attr = attr(path, mode);
 		return *this;
 	}
 	constexpr
 	This&	reconstruct(Path& path, int mode = vlib::file::append) {
 		close();
-		m_attr = attr{ .path = move(path), .mode = mode };
+		m_attr = attr(move(path), mode);
 		return *this;
 	}
 
@@ -567,13 +1023,166 @@ public:
 		return fgets(line.data(), (int)line.capacity(), m_attr->file) != NULL;
 	}
 
+	// Positional read.
+	/*  @docs
+		@title: Positional read
+		@description:
+			Read data at an offset without moving the stream position.
+
+			Reads until the length is read or the end of the file is reached.
+		@return: Returns the amount of read bytes.
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			char data[4096];
+			ullong read = file.pread(data, 4096, 0);
+	*/
+	Length	pread(char* data, Length len, Length offset) {
+		return pread_h(*m_attr, data, len, offset);
+	}
+
+	// Positional write.
+	/*  @docs
+		@title: Positional write
+		@description:
+			Write data at an offset, the file is created when it does not exist.
+
+			The offset is also used when the file mode is `append`.
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			file.pwrite("Hello World!", 12, 0);
+		@funcs: 2
+	*/
+	void	pwrite(const String& data, Length offset) {
+		pwrite_h(*m_attr, data.data(), data.len(), offset);
+	}
+	void	pwrite(const char* data, Length len, Length offset) {
+		pwrite_h(*m_attr, data, len, offset);
+	}
+
+	// Advise.
+	/*  @docs
+		@title: Advise
+		@description:
+			Advise the kernel about the access pattern of the positional functions, for example `vlib::file::sequential` before streaming a large file.
+
+			The advice is a hint, it is ignored when unsupported.
+		@parameter:
+			@name: advice
+			@description: The access pattern, `vlib::file::advice`.
+		}
+		@parameter:
+			@name: offset
+			@description: The start offset of the advised range.
+		}
+		@parameter:
+			@name: len
+			@description: The length of the advised range, `0` for the end of the file.
+		}
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			file.advise(vlib::file::sequential);
+	*/
+	This&	advise(int advice, Length offset = 0, Length len = 0) {
+		#if defined(__linux__)
+			::posix_fadvise(fd_h(*m_attr, false), (off_t) offset, (off_t) len, advice);
+		#else
+			(void) advice; (void) offset; (void) len;
+		#endif
+		return *this;
+	}
+
+	// Direct I/O.
+	/*  @docs
+		@title: Direct
+		@description:
+			Enable or disable direct I/O for the positional functions, bypassing the page cache.
+
+			The buffers, offsets and lengths of `pread()` and `pwrite()` must be a multiple of `File::block_len`, the file system must support direct I/O.
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			file.direct(true);
+	*/
+	This&	direct(bool enable = true) {
+		m_attr->direct = enable;
+		if (m_attr->fd != -1) {
+			direct_h(*m_attr, enable);
+		}
+		return *this;
+	}
+
+	// Chunks.
+	/*  @docs
+		@title: Chunks
+		@description:
+			Create a chunked reader that reads the file in fixed chunks.
+		@parameter:
+			@name: chunk_len
+			@description: The chunk length, rounded up to a multiple of `File::block_len`.
+		}
+		@parameter:
+			@name: offset
+			@description: The start offset.
+		}
+		@parameter:
+			@name: len
+			@description: The length to read, `0` for the end of the file.
+		}
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			for (auto& chunk: file.chunks(1024 * 1024)) {
+				process(chunk.data, chunk.len);
+			}
+	*/
+	Chunks	chunks(Length chunk_len = 1024 * 1024, Length offset = 0, Length len = 0) {
+		return Chunks(m_attr, chunk_len, offset, len);
+	}
+
+	// Writer.
+	/*  @docs
+		@title: Writer
+		@description:
+			Create a buffered writer, the file is created when it does not exist.
+		@parameter:
+			@name: buffer_len
+			@description: The buffer length, rounded up to a multiple of `File::block_len`.
+		}
+		@parameter:
+			@name: offset
+			@description: The start offset, by default the end of the file.
+		}
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			vlib::File::Writer writer = file.writer(1024 * 1024, 0);
+			writer.write("Hello World!\n");
+			writer.close();
+	*/
+	Writer	writer(Length buffer_len = 1024 * 1024, Length offset = limits<Length>::max) {
+		return Writer(m_attr, buffer_len, offset);
+	}
+
+	// View.
+	/*  @docs
+		@title: View
+		@description:
+			Map the file read only into memory.
+		@usage:
+			vlib::File file("/tmp/myfile.txt");
+			vlib::File::View view = file.view();
+	*/
+	View	view() {
+		if (m_attr->path.is_undefined()) {
+            throw InvalidUsageError("Path is undefined.");
+		}
+		return View(m_attr->path.c_str());
+	}
+
 	// Close.
 	/*  @docs
 		@title: Close
 		@description:
 			Close the file.
 	 
-			Function `close()` is automatically called in the destructor.
+			Function `close()` is automatically called in the destructor, readers and writers created from the file may not be used after closing.
 		@return:
 			Returns `0` upon success, and the error code upon failure (`< 0`).
 		@usage:
@@ -582,10 +1191,7 @@ public:
 	*/
 	constexpr
 	void 	close() {
-		if (m_attr->file != nullptr) {
-			::fclose(m_attr->file);
-			m_attr->file = nullptr;
-		}
+		m_attr->close_h();
 	}
 
 };
@@ -40,7 +40,7 @@ private:
 	// ---------------------------------------------------------
 	// Attributes.
 
-	SPtr<pthread_mutex_t>		m_mutex;	// the mutex lock.
+	APtr<pthread_mutex_t>		m_mutex;	// the mutex lock.
 
 // Public.
 public:
@@ -197,7 +197,7 @@ public:
 	constexpr
 	This&	copy(const This& obj) {
 		if (this == &obj) { return *this; }
-		array_h::copy(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		String::copy(obj);
 		p_info.copy(obj.p_info);
 		return *this;
 	}
@@ -206,7 +206,7 @@ public:
 	constexpr
 	This&	swap(This& obj) {
 		if (this == &obj) { return *this; }
-		array_h::swap(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		String::swap(obj);
 		p_info.swap(obj.p_info);
 		return *this;
 	}
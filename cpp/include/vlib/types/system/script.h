@@ -97,7 +97,7 @@ public:
 	// Copy.
 	constexpr
 	This&	copy(const This& obj) {
-		vlib::array<char, ullong>::copy(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		String::copy(obj);
 		m_path.copy(obj.m_path);
 		m_permission = obj.m_permission;
 		return *this;
@@ -106,7 +106,7 @@ public:
 	// Swap.
 	constexpr
 	This&	swap(This& obj) {
-		vlib::array<char, ullong>::swap(m_arr, m_len, m_capacity, obj.m_arr, obj.m_len, obj.m_capacity);
+		String::swap(obj);
 		m_path.swap(obj.m_path);
 		m_permission = obj.m_permission;
 		return *this;
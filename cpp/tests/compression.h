@@ -25,11 +25,64 @@ int operator()() const {
 	using namespace vlib;
 
 	String input("Hello World!"), compressed, decompressed;
-    compressed = vlib::compression::compress(input.data(), input.len());
-	vtest::test("vlib::compression.is_compressed", "true", vlib::compression::is_compressed(compressed));
-    decompressed = vlib::compression::decompress(compressed.data(), compressed.len());
+    compressed = vlib::compress(input.data(), input.len());
+	vtest::test("vlib::compression.is_compressed", "true", vlib::is_compressed(compressed));
+    decompressed = vlib::decompress(compressed.data(), compressed.len());
 	vtest::test("vlib::compression. compress & decompress", "Hello World!", decompressed.c_str());
 
+	// Streaming.
+	vlib::compression::Deflater<> deflater;
+	deflater.write("Hello ").write("World!").finish();
+	deflater.write("Howdy!").finish();
+	vtest::test("vlib::compression::Deflater::finish", "true", vlib::is_compressed(deflater.output()));
+	vlib::compression::Inflater<> inflater;
+	for (ullong i = 0; i < deflater.output().len(); i += 3) {
+		const ullong len = deflater.output().len() - i < 3 ? deflater.output().len() - i : 3;
+		inflater.write(deflater.output().data() + i, len);
+	}
+	vtest::test("vlib::compression::Inflater::write", "Hello World!Howdy!", inflater.output().c_str());
+	vtest::test("vlib::compression::Inflater::finished", "true", inflater.finished());
+	vtest::test("vlib::compression::Inflater::reset", "0", inflater.reset().output().len());
+
+	// Streaming with a sink.
+	struct Sink {
+		String data;
+		void write(const char* arr, ullong len) { data.concat_r(arr, len); }
+	} compressed_sink, decompressed_sink;
+	{
+		vlib::compression::Deflater<Sink> sink_deflater (compressed_sink);
+		for (int i = 0; i < 1000; ++i) { sink_deflater.write("Hello World!"); }
+		sink_deflater.flush();
+		vlib::compression::Inflater<Sink> sink_inflater (decompressed_sink);
+		sink_inflater.write(compressed_sink.data);
+		vtest::test("vlib::compression::Deflater::flush", "12000", decompressed_sink.data.len());
+	}
+
+	// Parallel.
+	String large;
+	for (ullong i = 0; i < 100000; ++i) { large << "Hello World! " << i << '\n'; }
+	vtest::test("vlib::Compression::compress_parallel", "true", vlib::decompress(Compression().compress_parallel(large, 4, 32 * 1024)) == large);
+
+	// Zip writer and reader.
+	Path zip_source ("/tmp/vlib_zip_test");
+	zip_source.mkdir();
+	zip_source.join("small").save("Hello World!");
+	zip_source.join("large").save(large);
+	{
+		Zip::Writer writer ("/tmp/vlib_zip_test.zip", 4, Z_BEST_COMPRESSION, 1024 * 1024);
+		writer.add("small", zip_source.join("small"));
+		writer.add("dir/large", zip_source.join("large"));
+		writer.close();
+		vtest::test("vlib::Zip::Writer::entries", "2", writer.entries().len());
+	}
+	Zip::Reader reader ("/tmp/vlib_zip_test.zip");
+	vtest::test("vlib::Zip::Reader::contains", "true", reader.contains("dir/large"));
+	vtest::test("vlib::Zip::Reader::load", "Hello World!", reader.load(reader.find("small")).c_str());
+	vtest::test("vlib::Zip::Reader::load", "true", reader.load(reader.find("dir/large")) == large);
+	reader.extract("/tmp/vlib_zip_test/extracted", reader.find("dir/large"));
+	vtest::test("vlib::Zip::Reader::extract", "true", Path::load("/tmp/vlib_zip_test/extracted") == large);
+	vtest::test("vlib::Zip::read", "true", Zip().read("/tmp/vlib_zip_test.zip").extract()["small"] == "Hello World!");
+
 	// End.
 	return vtest::exit_status();
 
@@ -0,0 +1,52 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+#include "../../include/vlib/compression.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Main.
+// - Requires compiler flags: -lz
+// - Pass a file path to benchmark a real dump, by default 256MB of generated log lines is used.
+int main(int argc, char** argv) {
+
+	// Input.
+	String generated;
+	File::View view;
+	const char* data;
+	ullong len;
+	if (argc > 1) {
+		view.open(argv[1]);
+		data = view.data();
+		len = view.len();
+	} else {
+		for (ullong i = 0; generated.len() < 256 * 1024 * 1024; ++i) {
+			generated << "2022-01-01 00:00:" << i % 60 << " INFO request " << i << " from 10.0." << i % 256 << '.' << i * 7 % 256 << " took " << i * 7919 % 1000 << "ms\n";
+		}
+		data = generated.data();
+		len = generated.len();
+	}
+	const long cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+	print("Input: ", len / 1024 / 1024, "MB, ", cpus, " processors.");
+
+	// Single stream.
+	for (auto& level: Array<int>({compression::best_speed, compression::def, compression::best_compression})) {
+		Compression compression (level);
+		mtime_t start = Date::get_mseconds();
+		String output = compression.compress(data, len);
+		mtime_t elapsed = Date::get_mseconds() - start;
+		print("Level ", level, " single: ", (double) len / 1024 / 1024 / ((double) elapsed / 1000), "MB/s, ratio ", (double) output.len() / (double) len, ".");
+
+		// Parallel.
+		for (ullong threads = 1; threads <= (ullong) (cpus > 1 ? cpus * 2 : 2); threads *= 2) {
+			start = Date::get_mseconds();
+			output = compression.compress_parallel(data, len, threads);
+			elapsed = Date::get_mseconds() - start;
+			print("Level ", level, " parallel ", threads, " threads: ", (double) len / 1024 / 1024 / ((double) elapsed / 1000), "MB/s, ratio ", (double) output.len() / (double) len, ".");
+		}
+	}
+	return 0;
+}
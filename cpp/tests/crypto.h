@@ -33,6 +33,25 @@ int operator()() const {
 	String decrypted = aes.decrypt(encrypted);
 	vtest::test("vlib::AES::encrypt & decrypt", "12", decrypted.len());
 	vtest::test("vlib::AES::encrypt & decrypt", "Hello World!", decrypted.c_str());
+
+	// AEAD.
+	AES256_GCM gcm;
+	gcm.generate_key();
+	char sealed[AES256_GCM::sealed_len(12)], opened[AES256_GCM::sealed_len(12)];
+	ullong sealed_len = gcm.seal(sealed, data.data(), data.len(), "header", 6);
+	vtest::test("vlib::AES::seal", "40", sealed_len);
+	vtest::test("vlib::AES::open", "Hello World!", String(opened, gcm.open(opened, sealed, sealed_len, "header", 6)).c_str());
+	try {
+		gcm.open(opened, sealed, sealed_len, "other", 5);
+		vtest::test("vlib::AES::open", "DecryptError", "none");
+	} catch (DecryptError&) {
+		vtest::test("vlib::AES::open", "DecryptError", "DecryptError");
+	}
+	ChaCha20_Poly1305 chacha;
+	chacha.generate_key();
+	Array<String> records = {"Hello", "World", "!"}, sealed_records, opened_records;
+	chacha.open(opened_records, chacha.seal(sealed_records, records));
+	vtest::test("vlib::AES::seal batch", "true", opened_records == records);
 	
 	// ---------------------------------------------------------
 	// SHA.
@@ -43,6 +62,43 @@ int operator()() const {
 	sign = SHA512::sign(key, data);
 	vtest::test("vlib::SHA512::sign", "DBE6AA7C09AA8812FD43EE9213BAF9695D170BD95216A03232210222D91595067070275E48A4B6BC0B416AF2233C9CA9CFA0C3F326CA1E7BA925AF077F5E1134", sign.c_str());
 
+	// Incremental.
+	vlib::SHA256 sha;
+	sha.update("Hello ").update("World!");
+	vtest::test("vlib::SHA256::finalize", "true", sha.finalize() == SHA256::hash("Hello World!"));
+	vlib::SHA256 hmac (key);
+	for (auto& c: data) { hmac.update(&c, 1); }
+	vtest::test("vlib::SHA256::finalize hmac", "true", Hex::encode(hmac.finalize()) == SHA256::hmac(key, data));
+	Path("/tmp/vlib_sha_test").save(data);
+	vtest::test("vlib::SHA256::hash_file", "true", SHA256::hash_file("/tmp/vlib_sha_test") == SHA256::hash(data));
+
+	// Batch.
+	Array<String> messages;
+	for (int i = 0; i < 5000; ++i) { messages.append(to_str("Message ", i)); }
+	Array<String> digests = SHA512::hash(messages, 4), signatures = SHA512::hmac(key, messages, 4);
+	vtest::test("vlib::SHA512::hash batch", "true", digests[4321] == SHA512::hash(messages[4321]));
+	vtest::test("vlib::SHA512::hmac batch", "true", signatures[4999] == SHA512::hmac(key, messages[4999]));
+
+	// ---------------------------------------------------------
+	// Encoding.
+
+	String binary;
+	for (int i = 0; i < 1000; ++i) { binary.append((char) (i * 7)); }
+	vtest::test("vlib::Hex::encode", "48656C6C6F20576F726C6421", Hex::encode(data).c_str());
+	vtest::test("vlib::Hex::decode", "Hello World!", Hex::decode("48656c6c6f20576f726c6421").c_str());
+	vtest::test("vlib::Base64::encode", "SGVsbG8gV29ybGQh", Base64::encode(data).c_str());
+	vtest::test("vlib::Base64::decode", "Hello World!", Base64::decode("SGVsbG8gV29ybGQh").c_str());
+	for (int level = encoding::scalar; level <= encoding::simd(); ++level) {
+		const int detected = encoding::simd();
+		encoding::simd() = level;
+		const String hex = Hex::encode(binary), base64 = Base64::encode(binary);
+		vtest::test("vlib::Hex simd", "true", Hex::decode(hex) == binary);
+		vtest::test("vlib::Base64 simd", "true", Base64::decode(base64) == binary);
+		char decoded[1000];
+		vtest::test("vlib::Base64::decode buffer", "1000", Base64::decode(decoded, base64.data(), base64.len()));
+		encoding::simd() = detected;
+	}
+
 	// ---------------------------------------------------------
 	// End.
 	return vtest::exit_status();
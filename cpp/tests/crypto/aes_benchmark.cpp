@@ -0,0 +1,78 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+#include "../../include/vlib/crypto.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Throughput in MB/s.
+double throughput(ullong bytes, mtime_t msec) {
+	return (double) bytes / 1024 / 1024 / ((double) (msec == 0 ? 1 : msec) / 1000);
+}
+
+// Benchmark a cipher.
+template <typename Cipher>
+void benchmark(const char* name) {
+	Cipher aes;
+	aes.generate_key();
+	aes.encode() = false;
+
+	// Records of several sizes.
+	for (auto& record_len: Array<ullong>({64, 1024, 16 * 1024})) {
+		const ullong count = 64 * 1024 * 1024 / record_len / 4;
+		Array<String> records, sealed, opened;
+		for (ullong i = 0; i < count; ++i) {
+			records.append(String().fill_r(record_len, 'x'));
+		}
+
+		// A fresh output string per call.
+		mtime_t start = Date::get_mseconds();
+		for (auto& record: records) {
+			String encrypted = aes.encrypt(record);
+		}
+		const mtime_t strings = Date::get_mseconds() - start;
+
+		// Batch into reused outputs.
+		aes.seal(sealed, records);
+		start = Date::get_mseconds();
+		aes.seal(sealed, records);
+		const mtime_t batch = Date::get_mseconds() - start;
+		start = Date::get_mseconds();
+		aes.open(opened, sealed);
+		const mtime_t open = Date::get_mseconds() - start;
+		print(
+			name, " ", record_len, "B records: encrypt ", throughput(count * record_len, strings),
+			"MB/s, seal batch ", throughput(count * record_len, batch),
+			"MB/s, open batch ", throughput(count * record_len, open), "MB/s."
+		);
+	}
+
+	// Streaming in 1MB chunks.
+	const ullong chunk_len = 1024 * 1024, total = 512 * chunk_len;
+	String chunk, output;
+	chunk.fill_r(chunk_len, 'x');
+	output.resize(chunk_len + Cipher::block_size);
+	char iv[Cipher::iv_len] = {};
+	mtime_t start = Date::get_mseconds();
+	aes.init_encrypt(iv);
+	for (ullong i = 0; i < total / chunk_len; ++i) {
+		aes.update(output.data(), chunk.data(), chunk.len());
+	}
+	aes.finalize(output.data());
+	print(name, " streaming: ", throughput(total, Date::get_mseconds() - start), "MB/s.");
+}
+
+// Main.
+// - Requires compiler flags: -lcrypto -lssl
+int main() {
+	benchmark<AES128_CBC>("AES128_CBC");
+	benchmark<AES256_CBC>("AES256_CBC");
+	benchmark<AES256_CTR>("AES256_CTR");
+	benchmark<AES128_GCM>("AES128_GCM");
+	benchmark<AES256_GCM>("AES256_GCM");
+	benchmark<ChaCha20_Poly1305>("ChaCha20_Poly1305");
+	return 0;
+}
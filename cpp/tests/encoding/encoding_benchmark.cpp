@@ -0,0 +1,70 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+#include "../../include/vlib/encoding.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Throughput in GB/s.
+double throughput(ullong bytes, mtime_t msec) {
+	return (double) bytes / 1024 / 1024 / 1024 / ((double) (msec == 0 ? 1 : msec) / 1000);
+}
+
+// Benchmark a codec on every available SIMD level.
+template <typename Codec>
+void benchmark(const char* name, const String& input, ullong rounds) {
+	const int detected = encoding::simd();
+	String encoded, decoded;
+	encoded.resize(Codec::encoded_len(input.len()));
+	decoded.resize(Codec::decoded_len(encoded.capacity()));
+	for (int level = encoding::scalar; level <= detected; ++level) {
+		encoding::simd() = level;
+
+		// Into reused buffers.
+		mtime_t start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			Codec::encode(encoded.data(), input.data(), input.len());
+		}
+		const mtime_t encode = Date::get_mseconds() - start;
+		encoded.len() = Codec::encoded_len(input.len());
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			decoded.len() = Codec::decode(decoded.data(), encoded.data(), encoded.len());
+		}
+		const mtime_t decode = Date::get_mseconds() - start;
+		if (decoded != input) {
+			throw InvalidUsageError(to_str(name, " roundtrip failed on simd level ", level, "."));
+		}
+
+		// Allocating strings, the previous interface.
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			String output = Codec::decode(Codec::encode(input));
+		}
+		const mtime_t strings = Date::get_mseconds() - start;
+		print(
+			name, " simd level ", level, ": encode ", throughput(input.len() * rounds, encode),
+			"GB/s, decode ", throughput(input.len() * rounds, decode),
+			"GB/s, encode & decode strings ", throughput(input.len() * rounds, strings), "GB/s."
+		);
+	}
+	encoding::simd() = detected;
+}
+
+// Main.
+int main() {
+
+	// Small payloads such as tokens and large payloads such as websocket frames.
+	for (auto& len: Array<ullong>({64, 1024, 1024 * 1024})) {
+		String input;
+		for (ullong i = 0; i < len; ++i) { input.append((char) (i * 131 + 7)); }
+		const ullong rounds = 512 * 1024 * 1024 / len;
+		print(len, "B input:");
+		benchmark<Hex>("Hex", input, rounds);
+		benchmark<Base64>("Base64", input, rounds);
+	}
+	return 0;
+}
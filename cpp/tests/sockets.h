@@ -145,6 +145,29 @@ int operator()() const {
 	// 	print(" * ", body.key(i), ": ", body.value(i));
 	// }
 
+	// ---------------------------------------------------------
+	// Websocket frames.
+
+	using websocket::Parser;
+	const char mask[4] = {'a', 'b', 'c', 'd'};
+	const auto ws_flags = (Parser::websocket_flags) (Parser::OP_TEXT | Parser::FINAL_FRAME | Parser::HAS_MASK);
+	String payload;
+	for (int i = 0; i < 1000; ++i) { payload.append((char) ('A' + i % 26)); }
+	String frame = Parser::create_frame(ws_flags, mask, payload.data(), payload.len());
+	Parser ws_parser;
+	String ws_received;
+	ws_parser.parse_frame(ws_received, frame.data(), 100);
+	ws_parser.parse_frame(ws_received, frame.data() + 100, frame.len() - 100);
+	vtest::test("websocket::Parser::parse_frame", "true", ws_received == payload);
+	ws_received.reset();
+	ws_parser.parse_frame(frame.data(), frame.len(), [&](const char* data, ullong len) { ws_received.concat_r(data, len); });
+	vtest::test("websocket::Parser::parse_frame in place", "true", ws_received == payload);
+	String ws_body = payload;
+	char ws_header[14];
+	struct iovec iov[2];
+	Parser::create_frame(iov, ws_header, ws_flags, mask, ws_body.data(), ws_body.len());
+	vtest::test("websocket::Parser::create_frame iovec", "true", iov[1].iov_base == ws_body.data() && iov[0].iov_len + iov[1].iov_len == frame.len());
+
 	// ---------------------------------------------------------
 	// End.
 	return vtest::exit_status();
@@ -0,0 +1,65 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+//
+
+// Includes.
+#include "../../../include/vlib/sockets/http.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Upload sink.
+// - Receives the request body while it is being received.
+struct Upload {
+	String received;
+	void write(const char* data, ullong len) {
+		received.concat_r(data, len);
+	}
+};
+
+// Main.
+// - Sends two pipelined uploads over one keep-alive connection, every handler call should only see the body of its own request.
+int main() {
+
+	// The request handler.
+	auto handler = [](http::Request& request, Upload& upload) -> http::Response {
+		String body = String("Received \"") << upload.received << "\" on " << request.m_endpoint << ".";
+		return http::Response(http::version::v1_1, http::status::success, {}, body);
+	};
+
+	// Server.
+	Socket<> sock (9003);
+	sock.bind();
+	sock.listen(SOMAXCONN);
+	http::Server<decltype(handler), Upload> server (handler, 60 * 1000, 64 * 1024);
+	server.listen(sock.fd());
+
+	// Send both requests at once.
+	Socket<> client ("127.0.0.1", 9003);
+	client.connect();
+	const String requests =
+		"PUT /first HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length: 5\r\n\r\nHello"
+		"PUT /second HTTP/1.1\r\nHost: 127.0.0.1\r\nContent-Length: 6\r\n\r\nWorld!";
+	client.send(client.fd(), requests);
+
+	// Serve until both responses are received.
+	String received;
+	char buff[4096];
+	for (int i = 0; i < 100 && received.find("/second") == NPos::npos; ++i) {
+		server.run_once(100);
+		const llong len = ::recv(client.fd().value(), buff, sizeof(buff), MSG_DONTWAIT);
+		if (len > 0) { received.concat_r(buff, (ullong) len); }
+	}
+	client.close();
+
+	// Check.
+	if (
+		received.find("Received \"Hello\" on /first.") == NPos::npos ||
+		received.find("Received \"World!\" on /second.") == NPos::npos
+	) {
+		print("Pipelined uploads failed, received:\n", received);
+		return 1;
+	}
+	print("Pipelined uploads succeeded.");
+	return 0;
+}
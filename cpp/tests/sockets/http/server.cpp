@@ -0,0 +1,40 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+//
+
+// Includes.
+#include "../../../include/vlib/sockets/http.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Main.
+// - Test with for example "wrk -c 10000 -d 30 http://127.0.0.1:9001/".
+int main() {
+
+	// The request handler.
+	auto handler = [](http::Request& request) -> http::Response {
+		return http::Response(http::version::v1_1, http::status::success, {}, String("Hello ") << request.m_endpoint << "!");
+	};
+
+	using Handler = decltype(handler);
+
+	// Start one server per thread, every server has its own socket on the same port.
+	const ullong threads = 4;
+	Array<FThread> workers;
+	for (ullong i = 0; i < threads; ++i) {
+		workers.append(FThread());
+		workers.last().start([](Handler* handler) -> void* {
+			Socket<> sock (9001);
+			sock.bind();
+			sock.listen(SOMAXCONN);
+			http::Server<Handler> server (*handler, 60 * 1000);
+			server.listen(sock.fd());
+			server.run();
+			return nullptr;
+		}, &handler);
+	}
+	print("Serving on 127.0.0.1:9001.");
+	for (auto& worker: workers) { worker.join(); }
+	return 0;
+}
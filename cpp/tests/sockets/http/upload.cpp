@@ -0,0 +1,40 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+//
+
+// Includes.
+#include "../../../include/vlib/sockets/http.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Upload sink.
+// - Receives the request body while it is being received.
+struct Upload {
+	ullong received = 0;
+	void write(const char*, ullong len) {
+		received += len;
+	}
+};
+
+// Main.
+// - Test with for example "head -c 1G /dev/zero | curl -T - http://127.0.0.1:9002/".
+// - The memory usage of the server should remain constant during the upload.
+int main() {
+
+	// The request handler, called once the body has been streamed into the sink.
+	auto handler = [](http::Request& request, Upload& upload) -> http::Response {
+		String body = String("Received ") << upload.received << " bytes on " << request.m_endpoint << ".\n";
+		return http::Response(http::version::v1_1, http::status::success, {}, body);
+	};
+
+	// Serve.
+	Socket<> sock (9002);
+	sock.bind();
+	sock.listen(SOMAXCONN);
+	http::Server<decltype(handler), Upload> server (handler, 60 * 1000, 64 * 1024);
+	server.listen(sock.fd());
+	print("Serving on 127.0.0.1:9002.");
+	server.run();
+	return 0;
+}
@@ -0,0 +1,69 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+//
+
+// Includes.
+#include "../../../include/vlib/sockets/tls.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Aliases.
+using Server = tls::Server<>;
+
+// The handler of a finished handshake.
+void handler(SSL* client) {
+	try {
+		Server::send(client, "Hello World!");
+	} catch (Exception&) {}
+	Server::close(client);
+}
+using Handler = decltype(&handler);
+
+// Main.
+// - Requires compiler flags: -lcrypto -lssl
+// - Run from the "tests/sockets/tls/" directory.
+// - Test with for example "openssl s_time -connect 127.0.0.1:9003 -new -time 10".
+int main() {
+
+	// Create one server per thread, every server has its own socket on the same port.
+	const ullong threads = 4;
+	Array<Server*> servers;
+	for (ullong i = 0; i < threads; ++i) {
+		servers.append(new Server(9003, "certs/cert.pem", "certs/key.pem", "HelloWorld!"));
+		servers.last()->bind();
+		servers.last()->listen();
+	}
+
+	// Ignore broken pipes of clients that disconnect before the response is sent.
+	::signal(SIGPIPE, SIG_IGN);
+
+	// Start one acceptor per thread.
+	Array<FThread> workers;
+	for (ullong i = 0; i < threads; ++i) {
+		workers.append(FThread());
+		workers.last().start([](Server* server, ullong thread) -> void* {
+			tls::Acceptor<Handler> acceptor (server->ctx(), &handler, 5 * 1000);
+			acceptor.listen(server->sock().fd());
+
+			// Report the metrics every second.
+			mtime_t report = Date::get_mseconds() + 1000;
+			while (true) {
+				acceptor.run_once(1000);
+				if (Date::get_mseconds() >= report) {
+					tls::Metrics& metrics = acceptor.metrics();
+					print(
+						"Thread ", thread, ": ", metrics.per_sec(), " handshakes/sec, latency avg ", metrics.latency(),
+						"ms p99 ", metrics.percentile(0.99), "ms, failures ", metrics.failures, ", timeouts ", metrics.timeouts, "."
+					);
+					metrics.reset();
+					report = Date::get_mseconds() + 1000;
+				}
+			}
+			return nullptr;
+		}, servers[i], i);
+	}
+	print("Serving on 127.0.0.1:9003.");
+	for (auto& worker: workers) { worker.join(); }
+	return 0;
+}
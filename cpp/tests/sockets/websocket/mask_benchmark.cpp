@@ -0,0 +1,101 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../../include/vlib/types.h"
+#include "../../../include/vlib/sockets.h"
+
+// Namespaces.
+using namespace vlib;
+using websocket::Parser;
+
+// Throughput in GB/s.
+double throughput(ullong bytes, mtime_t msec) {
+	return (double) bytes / 1024 / 1024 / 1024 / ((double) (msec == 0 ? 1 : msec) / 1000);
+}
+
+// The previous byte per byte masking.
+void mask_bytes(char* dst, const char* src, ullong len, const char mask[4], const uint8_t mask_offset) {
+	for (ullong i = 0; i < len; i++) {
+		dst[i] = src[i] ^ mask[(i + mask_offset) % 4];
+	}
+}
+
+// Main.
+int main() {
+	const char mask[4] = {'1', '2', '3', '4'};
+	const auto flags = (Parser::websocket_flags) (Parser::OP_TEXT | Parser::FINAL_FRAME | Parser::HAS_MASK);
+	const int detected = encoding::simd();
+
+	// Market data messages and large frames.
+	for (auto& len: Array<ullong>({128, 4096, 1024 * 1024})) {
+		String payload, output;
+		payload.fill_r(len, 'x');
+		output.resize(len);
+		const ullong rounds = 2ull * 1024 * 1024 * 1024 / len;
+		print(len, "B payload:");
+
+		// Masking.
+		mtime_t start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			mask_bytes(output.data(), payload.data(), len, mask, 0);
+		}
+		print("  byte per byte mask: ", throughput(len * rounds, Date::get_mseconds() - start), "GB/s.");
+		for (int level = encoding::scalar; level <= detected; ++level) {
+			encoding::simd() = level;
+			start = Date::get_mseconds();
+			for (ullong i = 0; i < rounds; ++i) {
+				Parser::mask_data(output.data(), payload.data(), len, mask, 0);
+			}
+			print("  mask_data simd level ", level, ": ", throughput(len * rounds, Date::get_mseconds() - start), "GB/s.");
+		}
+		encoding::simd() = detected;
+
+		// Frames.
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			String frame = Parser::create_frame(flags, mask, payload.data(), len);
+		}
+		const mtime_t strings = Date::get_mseconds() - start;
+		String frame;
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			Parser::create_frame(frame, flags, mask, payload.data(), len);
+		}
+		const mtime_t reused = Date::get_mseconds() - start;
+		char header[14];
+		struct iovec iov[2];
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			Parser::create_frame(iov, header, flags, mask, payload.data(), len);
+		}
+		const mtime_t inplace = Date::get_mseconds() - start;
+		print(
+			"  create_frame: new string ", throughput(len * rounds, strings),
+			"GB/s, reused string ", throughput(len * rounds, reused),
+			"GB/s, iovec ", throughput(len * rounds, inplace), "GB/s."
+		);
+
+		// Parsing.
+		Parser::create_frame(frame, flags, mask, payload.data(), len);
+		Parser parser;
+		String received;
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			received.len() = 0;
+			parser.parse_frame(received, frame);
+		}
+		const mtime_t copied = Date::get_mseconds() - start;
+		ullong total = 0;
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < rounds; ++i) {
+			parser.parse_frame(frame.data(), frame.len(), [&](const char*, ullong l) { total += l; });
+		}
+		const mtime_t parsed = Date::get_mseconds() - start;
+		print(
+			"  parse_frame: unmask into string ", throughput(len * rounds, copied),
+			"GB/s, unmask in place ", throughput(len * rounds, parsed), "GB/s."
+		);
+	}
+	return 0;
+}
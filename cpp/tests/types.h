@@ -515,6 +515,28 @@ int operator()() const {
 
 	auto sptr2 = test_shared_ptr_str();
 	vtest::test("Ptr::shared::copy", "Hello World!", *sptr2);
+
+	// Atomic pointer.
+	Ptr<int, Atomic> aptr0 = 1;
+	Ptr<int, Atomic> aptr1;
+	aptr1 = aptr0;
+	aptr1 = 2;
+	vtest::test("Ptr::atomic::copy", "2", *aptr0);
+	vtest::test("Ptr::atomic::links", "1", aptr0.links());
+	aptr1.reset();
+	vtest::test("Ptr::atomic::links", "0", aptr0.links());
+
+	// Intrusive pointer.
+	Ptr<String, Intrusive> iptr0 = String("Hello World!");
+	Ptr<String, Intrusive> iptr1 = iptr0;
+	vtest::test("Ptr::intrusive::copy", "Hello World!", *iptr1);
+	vtest::test("Ptr::intrusive::links", "1", iptr0.links());
+	Ptr<String, Intrusive> iptr2 = move(iptr1);
+	vtest::test("Ptr::intrusive::move", "true", iptr1.is_undefined() && iptr0.ptr() == iptr2.ptr());
+	vtest::test("Ptr::intrusive::copy", "1", iptr0.copy().links() + iptr0.links());
+	iptr0.reset();
+	vtest::test("Ptr::intrusive::reset", "0", iptr2.links());
+	vtest::test("Ptr::intrusive::len", "12", iptr2->len());
 	
 	// ---------------------------------------------------------
 	// CString.
@@ -531,13 +553,18 @@ int operator()() const {
 	vtest::test("CString::get", "!", cstr0.get(11));
 	vtest::test("CString::eq", "true", cstr0.eq("Hello World!"));
 	vtest::test("CString::eq", "false", cstr0.eq("Hello!"));
-	vtest::test("CString::eq", "true", cstr0.eq("Hello", 5));
+	vtest::test("CString::eq", "false", cstr0.eq("Hello", 5));
+	vtest::test("CString::eq", "true", cstr0.eq("Hello World!", 12));
 	vtest::test("CString::eq", "\"Hello World!\"", cstr0.json().c_str());
 	// vtest::test("CString::parse", "Hello World!", CString::parse("Hello World!").c_str());
 	vtest::test("CString::[]", "!", cstr0.rget(1));
 	std::string iter_test = "";
 	for (auto i: cstr0) { iter_test += i; }
 	vtest::test("CString::iterate", "Hello World!", iter_test);
+	cstr0 = "Hello World!";
+	vtest::test("CString::slice", "true", cstr0.slice(6, 11).eq("World", 5));
+	vtest::test("CString::find", "4", cstr0.find('o'));
+	vtest::test("CString::find", "6", cstr0.find(CString("World")));
 
 	// ---------------------------------------------------------
 	// Array.
@@ -777,6 +804,20 @@ int operator()() const {
 	vtest::test("String::find", "6", str0.find("World!"));
 	vtest::test("String::find", "13", str0.find("World", 7));
 	vtest::test("String::find", std::to_string(NPos::npos), str0.find("World", 14));
+	vtest::test("String::find", "13", str0.find<Backwards>("World"));
+	vtest::test("String::find_first", "6", str0.find_first(Array<const char*>({"orld", "World"})));
+	String long_str = String("ab") * 100;
+	String long_needle = String("ab") * 20;
+	long_needle << 'c';
+	long_str << long_needle;
+	vtest::test("String::find", "200", long_str.find(long_needle));
+	for (auto& level: {searching::scalar, searching::sse2, searching::avx2}) {
+		if (level > searching::simd()) { continue; }
+		const int detected = searching::simd();
+		searching::simd() = level;
+		vtest::test("String::find", "247", (long_str + "Hello World!").find("World"));
+		searching::simd() = detected;
+	}
 
 	str0 = "Hello World! World!";
 	str0.replace_h(6, 11, "Universe");
@@ -800,6 +841,7 @@ int operator()() const {
 	vtest::test("String::replace", "/", String("//").replace_r("//", "/").c_str());
 	vtest::test("String::replace", "/", String("///").replace_r("//", "/").c_str());
 	vtest::test("String::replace", "/", String("////").replace_r("//", "/").c_str());
+	vtest::test("String::replace", "a<->b<->c", String("a-b-c").replace_r("-", "<->").c_str());
 	vtest::test("String::replace", "Hello Universe! Universe!", str0.copy().replace_r("World", "Universe").c_str());
 	str0 = "Hello World!";
 	str0.insert(5, '!');
@@ -808,6 +850,26 @@ int operator()() const {
 	vtest::test("String::sort", "ABC", str0.sort_r().c_str());
 	str0 = "YCBAXGGZ";
 	vtest::test("String::sort", "ABCGGXYZ", str0.sort_r().c_str());
+	vtest::test("String::sort", "ZYXGGCBA", str0.sort_r([](char x, char y) { return x > y; }).c_str());
+	vtest::test("Array::stable_sort", "[1, 2, 3, 4]", Array<int>({3, 1, 4, 2}).stable_sort_r().str().c_str());
+	vtest::test("Array::radix_sort", "[-3, 0, 1, 3]", Array<int>({3, -3, 1, 0}).radix_sort_r().str().c_str());
+	Array<llong> sort0;
+	for (llong i = 0; i < 3 * 1024 * 1024; ++i) { sort0.append((i * 7919) % 1000003); }
+	sort0.parallel_sort_r(3);
+	bool sorted = true;
+	for (ullong i = 1; i < sort0.len(); ++i) { sorted &= sort0[i - 1] <= sort0[i]; }
+	vtest::test("Array::parallel_sort", "true", sorted);
+	String grow0;
+	for (int i = 0; i < 1000; ++i) { grow0.append('x'); }
+	vtest::test("String::expand", "true", grow0.len() == 1000 && grow0.capacity() < 1600);
+	Array<String> grow1;
+	for (int i = 0; i < 1000; ++i) { grow1.append(to_str(i)); }
+	vtest::test("Array::expand", "999", grow1.last().c_str());
+	String sso0 = "short";
+	String sso1 = move(sso0);
+	vtest::test("String::sso", "true", sso1.is_inline_h() && sso1 == "short" && sso0.len() == 0);
+	sso1 << " and now longer than the inline buffer";
+	vtest::test("String::sso", "false", sso1.is_inline_h());
 
 	str0 = "Hello World!";
 	vtest::test("String::json", "\"Hello World!\"", str0.json().c_str());
@@ -842,6 +904,15 @@ int operator()() const {
 	str0 = "  ";
 	vtest::test("String::split", "", str0.split(" ")[0].c_str());
 	vtest::test("String::split", "", str0.split(" ")[1].c_str());
+	str0 = "a,b,,c";
+	String split_view;
+	for (auto& part: str0.split_view(',')) { split_view << '[' << String(part.data(), part.len()) << ']'; }
+	vtest::test("String::split_view", "[a][b][][c]", split_view.c_str());
+	str0 = "GET  /index.html HTTP/1.1 ";
+	String tokens;
+	for (auto& token: str0.tokenize(" ")) { tokens << '[' << String(token.data(), token.len()) << ']'; }
+	vtest::test("String::tokenize", "[GET][/index.html][HTTP/1.1]", tokens.c_str());
+	vtest::test("String::view", "true", str0.view(5, 16).eq("/index.html", 11));
 
 	vtest::test("String", "Length is 10 not 15. Understood? true", (String() << "Length is " << 10 << " not " << 15 << ". Understood? " << true).c_str());
 
@@ -939,12 +1010,64 @@ int operator()() const {
 	vtest::test("Dict::sort", "{\"a\": 2, \"b\": 1, \"c\": 0}", dict3.copy().sort_r().str().c_str());
 	vtest::test("Dict::sort_values", "{\"c\": 0, \"b\": 1, \"a\": 2}", dict3.copy().sort_values_r().str().c_str());
 
+	Dict<String, Int> dict4 = {{"a", 0}, {"b", 1}, {"c", 2}};
+	dict4.enable_index();
+	vtest::test("Dict::is_indexed", "true", dict4.is_indexed());
+	vtest::test("Dict::find", "1", dict4.find("b"));
+	vtest::test("Dict::find", "2", dict4.find("c", 1));
+	dict4.append("d", 3);
+	vtest::test("Dict::find", "3", dict4.find("d"));
+	vtest::test("Dict::contains", "false", dict4.contains("e"));
+	vtest::test("Dict::find", "3", dict4.find(CString("d")));
+	vtest::test("Dict::contains", "true", dict4.contains(StringView("ab", 1)));
+	dict4.pop(String("a"));
+	vtest::test("Dict::find", "0", dict4.find("b"));
+	vtest::test("Dict::find", "true", dict4.find("a") == NPos::npos);
+	vtest::test("Dict::sort", "{\"d\": 3, \"c\": 2, \"b\": 1}", dict4.sort_r(true).str().c_str());
+	vtest::test("Dict::value", "1", dict4.value("b").value());
+	dict4.keys().append("e");
+	dict4.values().append(4);
+	vtest::test("Dict::find", "3", dict4.find("e"));
+	dict4.reindex();
+	vtest::test("Dict::find", "3", dict4.find("e"));
+	dict4.disable_index();
+	vtest::test("Dict::is_indexed", "false", dict4.is_indexed());
+	vtest::test("Dict::find", "1", dict4.find("c"));
+
 	// ---------------------------------------------------------
 	// Json type.
 
 	int status;
 	Json json0("{\"success\": true,\"message\": \"Hello World!\",\"error\": null, \"data\": [0, 1, 2, 3]}");
 	vtest::test("Json::json", "{\"success\":true,\"message\":\"Hello World!\",\"error\":null,\"data\":[0,1,2,3]}", json0.json().c_str());
+	json0 = Json::parse("{\"a\": {\"b\": [1, -2, 1.5, {\"c\": \"x\\\"y\"}]}, // comment\n \"d\": [],}");
+	vtest::test("Json::parse", "{\"a\":{\"b\":[1,-2,1.5,{\"c\":\"x\\\"y\"}]},\"d\":[]}", json0.json().c_str());
+	json::Parser json_parser;
+	json_parser.feed("{\"a\": [tr", 9);
+	json_parser.feed("ue, 12", 6);
+	json_parser.feed("3], \"b\": \"Hel", 13);
+	json_parser.feed("lo\"}", 4);
+	vtest::test("Json::Parser::feed", "{\"a\":[true,123],\"b\":\"Hello\"}", json_parser.finish().json().json().c_str());
+	status = 0;
+	try { Json::parse("{\"a\": 1"); }
+	catch (ParseError&) { status = 1; }
+	vtest::test("Json::parse", "1", status);
+	json0 = Json::parse("{\"a\": [0.1, 1e+300, 2.0, \"\\n\\u0001\"], \"b\": {}}");
+	vtest::test("Json::dump", "{\n  \"a\": [\n    0.1,\n    1e+300,\n    2.0,\n    \"\\n\\u0001\"\n  ],\n  \"b\": {}\n}", json0.dump(2).c_str());
+	json::Writer json_writer;
+	json_writer.value(json0).reset().value(json0["b"]);
+	vtest::test("Json::Writer::value", "{}", json_writer.str().c_str());
+	json::Reader json_reader ("{\"id\": 1, \"user\": {\"name\": \"Alice\"}, \"name\": \"Bob\"}");
+	json_reader.next();
+	vtest::test("Json::Reader::event", "true", json_reader.event() == json::events::start_object);
+	vtest::test("Json::Reader::find", "true", json_reader.find("name", 4));
+	json_reader.next();
+	vtest::test("Json::Reader::str", "Bob", json_reader.str().c_str());
+	json_reader.reset();
+	json_reader.next();
+	json_reader.find("id", 2);
+	json_reader.next();
+	vtest::test("Json::Reader::as_int", "1", json_reader.as_int());
 
 	// ---------------------------------------------------------
 	// Response type.
@@ -1231,8 +1354,54 @@ int operator()() const {
 	vtest::test("File::read", "Hello World!", file.read().c_str());
     file.append(" Howdy!");
 	vtest::test("File::read", "Hello World! Howdy!", file.read().c_str());
+	file.pwrite("World", 5, 13);
+	char pdata[32];
+	vtest::test("File::pread", "World", String(pdata, file.pread(pdata, 5, 13)));
+	vtest::test("File::pread", "6", file.pread(pdata, 32, 13));
+	{
+		File::Writer writer = file.writer(File::block_len, 0);
+		for (int i = 0; i < 1000; ++i) { writer.write("0123456789"); }
+		writer.close();
+		vtest::test("File::writer", "10000", writer.offset());
+	}
+	{
+		ullong chunks = 0, total = 0;
+		for (auto& chunk: file.advise(file::sequential).chunks(File::block_len)) {
+			++chunks;
+			total += chunk.len;
+		}
+		vtest::test("File::chunks", "3 10000", to_str(chunks, " ", total));
+		File::View view = file.view();
+		vtest::test("File::view", "10000 789", to_str(view.len(), " ", String(view.data() + view.len() - 3, 3)));
+	}
     file.remove();
 
+	// ---------------------------------------------------------
+	// AsyncLogger type.
+
+	{
+		File log_file("/tmp/AsyncLogger");
+		if (log_file.exists()) { log_file.remove(); }
+		{
+			AsyncLogger logger("/tmp/AsyncLogger", 1024, 1024, 60 * 1000, logger::drop);
+			logger.log("Hello World!\n");
+			logger.flush();
+			vtest::test("AsyncLogger::flush", "Hello World!\n", log_file.read().c_str());
+			String line = String().fill_r(1000, ' ');
+			logger.log(line);
+			vtest::test("AsyncLogger::dropped", "2", (ullong) !logger.log(line) + logger.dropped());
+		}
+		vtest::test("AsyncLogger::destructor", "1013", log_file.read().len());
+		log_file.remove();
+		{
+			AsyncLogger logger("/tmp/AsyncLogger", 1024, 1024, 60 * 1000, logger::drop);
+			logger.log("first\n");
+			logger.log(String().fill_r(2000, 'x'));
+		}
+		vtest::test("AsyncLogger::log", "first", log_file.read().slice(0, 5).c_str());
+		log_file.remove();
+	}
+
 	// ---------------------------------------------------------
 	// Process type.
 	
@@ -1331,6 +1500,37 @@ int operator()() const {
 	df4.set_columns({"name", "price", "value"});
 	// print(df4);
 	DataFrame df41 = df4["value"];
+	vtest::test("DataFrame::sort", "Howdy!", df4.sort("value")["name"][0].str().c_str());
+	DataFrame df42 ({{"a", 3}, {"b", "x"}, {"c", 1.5}});
+	df42.set_columns({"name", "value"});
+	vtest::test("DataFrame::sort", "c", df42.sort("value")["name"][0].str().c_str());
+	vtest::test("DataFrame::std", "0.438900", df41.std().str().c_str());
+	df::Column col0 = df41.column();
+	col0.append_null();
+	vtest::test("df::Column::type", "true", col0.type() == df::types::floating);
+	vtest::test("df::Column::nulls", "1", col0.nulls());
+	vtest::test("df::Column::max", "true", col0.max() == 1.0);
+	vtest::test("df::Column::mult", "true", (col0 * 2).max() == 2.0 && (col0 * 2).is_null(3));
+	df::Table table0 = df4.table();
+	table0.sort_r("price", true);
+	vtest::test("df::Table::sort", "Hi!", table0["name"].as_str(0).c_str());
+	vtest::test("DataFrame::std", "0.544472", df41.std(2)[1].str().c_str());
+	vtest::test("DataFrame::mean", "0.605000", df41.mean(2)[2].str().c_str());
+	vtest::test("DataFrame::rolling_max", "4693", df4["price"].rolling_max(2)[2].str().c_str());
+	vtest::test("df::Column::rolling_min", "true", col0.rolling_min(2).min() == col0.as_float(1) && col0.rolling_min(2).nulls() == 2);
+	df4.save("/tmp/vlib_df4.csv");
+	vtest::test("DataFrame::load", "Hi!", DataFrame::load("/tmp/vlib_df4.csv")["name"][2].str().c_str());
+	vtest::test("df::io::load", "true", df::io::load("/tmp/vlib_df4.csv", 2)["price"].type() == df::types::integer);
+	df42.save("/tmp/vlib_df42.csv");
+	DataFrame df43 = DataFrame::load("/tmp/vlib_df42.csv");
+	vtest::test("DataFrame::load", "true", df43["value"][0].type() == df::types::integer && df43["value"][1].type() == df::types::str && df43["value"][2].type() == df::types::floating);
+	vtest::test("DataFrame::load", "x", df43["value"][1].str().c_str());
+	String("a\n1\n2.5\nN/A\n").save("/tmp/vlib_df5.csv");
+	vtest::test("df::io::load", "2.5", df::io::load("/tmp/vlib_df5.csv")["a"].as_str(1).c_str());
+	df::io::save_binary(table0, "/tmp/vlib_df4.vdf");
+	df::io::BinaryTable binary0 ("/tmp/vlib_df4.vdf");
+	vtest::test("df::io::BinaryTable::ints", "4693", binary0.ints("price")[0]);
+	vtest::test("df::io::BinaryTable::operator []", "Howdy!", binary0["name"].as_str(1).c_str());
 	// print(df41);
 	// df41.add_r(1);
 	// print(df41);
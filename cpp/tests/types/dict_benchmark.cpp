@@ -0,0 +1,67 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Lookup all keys a number of times and return the average nanoseconds per lookup.
+double bench_lookups(const Dict<String, ullong>& dict, const Array<String>& keys, ullong lookups) {
+	ullong found = 0;
+	mtime_t start = Date::get_mseconds();
+	for (ullong i = 0; i < lookups; ++i) {
+		found += dict.find(keys[(i * 104729) % keys.len()]); // spread the lookups over all keys.
+	}
+	mtime_t elapsed = Date::get_mseconds() - start;
+	if (found == 0) { print(""); } // prevent the lookups from being optimized away.
+	return (double) elapsed * 1000000.0 / (double) lookups;
+}
+
+int main() {
+
+	// Compare linear key lookups with indexed key lookups.
+	// The number of lookups is scaled down for the linear search on large dictionaries.
+	for (auto& size: Array<ullong>({10, 100, 10000, 1000000})) {
+
+		// Create the keys.
+		Array<String> keys;
+		keys.resize(size);
+		for (ullong i = 0; i < size; ++i) {
+			keys.append(String("key_") << i);
+		}
+
+		// Create the dictionaries.
+		Dict<String, ullong> linear;
+		Dict<String, ullong> indexed;
+		indexed.enable_index();
+		linear.resize(size);
+		indexed.resize(size);
+		mtime_t start = Date::get_mseconds();
+		for (ullong i = 0; i < size; ++i) {
+			linear.append(keys[i], i);
+		}
+		mtime_t linear_insert = Date::get_mseconds() - start;
+		start = Date::get_mseconds();
+		for (ullong i = 0; i < size; ++i) {
+			indexed.append(keys[i], i);
+		}
+		indexed.find(keys[0]); // build the index.
+		mtime_t indexed_insert = Date::get_mseconds() - start;
+
+		// Lookups.
+		ullong linear_lookups = size <= 100 ? 10000000 : 100000000 / size;
+		if (linear_lookups < 100) { linear_lookups = 100; }
+		double linear_ns = bench_lookups(linear, keys, linear_lookups);
+		double indexed_ns = bench_lookups(indexed, keys, 10000000);
+
+		// Dump.
+		print(
+			"Keys: ", size, "\n",
+			" * Linear  insert: ", linear_insert, "ms, lookup: ", linear_ns, "ns.\n",
+			" * Indexed insert: ", indexed_insert, "ms, lookup: ", indexed_ns, "ns."
+		);
+	}
+	return 0;
+}
@@ -0,0 +1,93 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+
+// Namespaces.
+using namespace vlib;
+
+// The previous serializer, every nested value was dumped into its own string and concatenated into the parent.
+String legacy_dump(const JsonValue& value);
+String legacy_dump(const JArray& arr) {
+	if (arr.len() == 0) { return "[]"; }
+	String dumped;
+	dumped.append('[');
+	for (auto& index: arr.indexes()) {
+		if (index != 0) { dumped << ','; }
+		dumped << legacy_dump(arr[index]);
+	}
+	dumped << ']';
+	return dumped;
+}
+String legacy_dump(const Json& json) {
+	if (json.len() == 0) { return "{}"; }
+	String dumped;
+	dumped.append('{');
+	for (auto& index: json.indexes()) {
+		if (index != 0) { dumped << ','; }
+		dumped << json.key(index).json() << ": " << legacy_dump(json.value(index));
+	}
+	dumped << '}';
+	return dumped;
+}
+String legacy_dump(const JsonValue& value) {
+	switch (value.type()) {
+		case json::types::array: return legacy_dump(value.asa());
+		case json::types::json: return legacy_dump(value.asj());
+		case json::types::string: return String('"') << value.ass().escape() << '"';
+		case json::types::floating: return value.asf().json();
+		case json::types::integer: return value.asi().json();
+		case json::types::boolean: return value.asb().json();
+		default: return "null";
+	}
+}
+
+// Serialize a number of times and return the throughput in MB/s.
+template <typename Func>
+double bench(ullong iterations, Func&& func) {
+	ullong bytes = 0;
+	mtime_t start = Date::get_mseconds();
+	for (ullong i = 0; i < iterations; ++i) {
+		bytes += func();
+	}
+	mtime_t elapsed = Date::get_mseconds() - start;
+	if (elapsed == 0) { elapsed = 1; }
+	return ((double) bytes / (1024.0 * 1024.0)) / ((double) elapsed / 1000.0);
+}
+
+int main() {
+
+	// Create a document of records with mixed value types.
+	Json json;
+	JArray records;
+	for (ullong i = 0; i < 20000; ++i) {
+		Json record;
+		record["id"] = (llong) i;
+		record["name"] = String("user_") << i;
+		record["bio"] = "Line one\nLine \"two\"\twith a tab.";
+		record["score"] = (ldouble) i / 7.0;
+		record["active"] = i % 2 == 0;
+		record["tags"] = JArray{"a", "b", "c"};
+		records.append(move(record));
+	}
+	json["records"] = move(records);
+
+	// Benchmark.
+	const ullong iterations = 10;
+	json::Writer writer;
+	double legacy = bench(iterations, [&]() { return legacy_dump(json).len(); });
+	double compact = bench(iterations, [&]() { return writer.reset().indent(0).value(json).len(); });
+	double pretty = bench(iterations, [&]() { return writer.reset().indent(4).value(json).len(); });
+	double fresh = bench(iterations, [&]() { return json.json().len(); });
+
+	// Dump.
+	print(
+		"Json size: ", writer.reset().indent(0).value(json).len() / 1024, "KB\n",
+		" * Legacy concatenation:  ", legacy, "MB/s.\n",
+		" * Writer compact:        ", compact, "MB/s.\n",
+		" * Writer pretty:         ", pretty, "MB/s.\n",
+		" * Json::json():          ", fresh, "MB/s."
+	);
+	return 0;
+}
@@ -0,0 +1,60 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+
+// Namespaces.
+using namespace vlib;
+
+// The number of copies per thread.
+constexpr ullong copies = 10000000;
+
+// Copy and destroy a shared pointer from a number of threads and return the average nanoseconds per copy.
+// - The non-atomic shared pointer is only measured on a single thread, since concurrent copies would corrupt its count.
+template <typename Pointer>
+double bench_copies(const Pointer& ptr, ullong threads) {
+	Array<FThread> workers;
+	mtime_t start = Date::get_mseconds();
+	for (ullong i = 0; i < threads; ++i) {
+		workers.append(FThread());
+		workers.last().start([](const Pointer* ptr) -> void* {
+			for (ullong i = 0; i < copies; ++i) {
+				Pointer copy = *ptr;
+				if (copy.is_undefined()) { print(""); } // prevent the copy from being optimized away.
+			}
+			return nullptr;
+		}, &ptr);
+	}
+	for (auto& worker: workers) { worker.join(); }
+	mtime_t elapsed = Date::get_mseconds() - start;
+	return (double) elapsed * 1000000.0 / (double) (copies * threads);
+}
+
+// Create and destroy pointers and return the average nanoseconds per pointer.
+template <typename Pointer>
+double bench_creates(ullong count) {
+	static const void* volatile last;
+	mtime_t start = Date::get_mseconds();
+	for (ullong i = 0; i < count; ++i) {
+		Pointer ptr ((ullong) i);
+		last = &(*ptr); // prevent the allocation from being optimized away.
+	}
+	mtime_t elapsed = Date::get_mseconds() - start;
+	return (double) elapsed * 1000000.0 / (double) count;
+}
+
+int main() {
+
+	// Creation.
+	print("Create: shared ", bench_creates<Ptr<ullong, Shared>>(copies), "ns, atomic ", bench_creates<Ptr<ullong, Atomic>>(copies), "ns, intrusive ", bench_creates<Ptr<ullong, Intrusive>>(copies), "ns.");
+
+	// Uncontended copies.
+	print("Copy 1 thread: shared ", bench_copies(Ptr<ullong, Shared>(0), 1), "ns, atomic ", bench_copies(Ptr<ullong, Atomic>(0), 1), "ns, intrusive ", bench_copies(Ptr<ullong, Intrusive>(0), 1), "ns.");
+
+	// Contended copies.
+	for (auto& threads: Array<ullong>({2, 4, 8})) {
+		print("Copy ", threads, " threads: atomic ", bench_copies(Ptr<ullong, Atomic>(0), threads), "ns, intrusive ", bench_copies(Ptr<ullong, Intrusive>(0), threads), "ns.");
+	}
+	return 0;
+}
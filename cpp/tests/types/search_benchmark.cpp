@@ -0,0 +1,45 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+
+// Namespaces.
+using namespace vlib;
+
+int main() {
+
+	// Build a 64MB haystack of log lines.
+	String data;
+	for (ullong i = 0; data.len() < 64 * 1024 * 1024; ++i) {
+		data << "2022-01-01T00:00:00 INFO request " << i << " served in " << (i % 97) << "ms\n";
+	}
+	ullong total = 0;
+
+	// Find a short needle that does not occur.
+	mtime_t start = Date::get_mseconds();
+	total += data.find("WARNING") == NPos::npos;
+	print("Find a short needle in ", data.len() / 1024 / 1024, "MB: ", Date::get_mseconds() - start, "ms.");
+
+	// Find a long needle that does not occur.
+	start = Date::get_mseconds();
+	total += data.find("2022-01-01T00:00:00 INFO request served in 0ms") == NPos::npos;
+	print("Find a long needle in ", data.len() / 1024 / 1024, "MB: ", Date::get_mseconds() - start, "ms.");
+
+	// Find one of multiple needles that do not occur.
+	start = Date::get_mseconds();
+	total += data.find_first(Array<const char*>({"WARNING", "ERROR", "DEBUG"})) == NPos::npos;
+	print("Find the first of three needles in ", data.len() / 1024 / 1024, "MB: ", Date::get_mseconds() - start, "ms.");
+
+	// Replace every occurence with a longer string.
+	start = Date::get_mseconds();
+	total += data.replace(" INFO ", " INFORMATION ").len();
+	print("Replace in ", data.len() / 1024 / 1024, "MB: ", Date::get_mseconds() - start, "ms.");
+
+	// Split into lines.
+	start = Date::get_mseconds();
+	total += data.split("\n").len();
+	print("Split ", data.len() / 1024 / 1024, "MB into lines: ", Date::get_mseconds() - start, "ms.");
+	if (total == 0) { print(""); } // prevent the calls from being optimized away.
+	return 0;
+}
@@ -0,0 +1,72 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+
+// Namespaces.
+using namespace vlib;
+
+// Random numbers, xorshift so every run sorts the same input.
+Array<llong> random_array(ullong len) {
+	Array<llong> arr;
+	arr.resize(len);
+	ullong state = 88172645463325252ULL;
+	for (ullong i = 0; i < len; ++i) {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		arr.append((llong) state);
+	}
+	return arr;
+}
+
+// The previous insertion sort, as a baseline for small arrays.
+void insertion_sort(Array<llong>& arr) {
+	for (ullong i = 1; i < arr.len(); ++i) {
+		llong key = arr[i];
+		ullong j = i;
+		while (j > 0 && arr[j - 1] > key) {
+			arr[j] = arr[j - 1];
+			--j;
+		}
+		arr[j] = key;
+	}
+}
+
+// Sort copies of the input and return the average milliseconds per sort.
+template <typename Func>
+double bench(const Array<llong>& input, ullong repeat, Func&& func) {
+	Array<Array<llong>> arrs;
+	for (ullong i = 0; i < repeat; ++i) { arrs.append(input.copy()); }
+	mtime_t start = Date::get_mseconds();
+	for (auto& arr: arrs) { func(arr); }
+	mtime_t elapsed = Date::get_mseconds() - start;
+	for (ullong i = 1; i < arrs[0].len(); ++i) {
+		if (arrs[0][i - 1] > arrs[0][i]) { print("Error: the array is not sorted."); break; }
+	}
+	return (double) elapsed / repeat;
+}
+
+// Usage: sort_benchmark [max items], the largest run needs around 2.4GB of memory.
+int main(int argc, char** argv) {
+	const ullong max_len = argc > 1 ? (ullong) atoll(argv[1]) : 100 * 1000 * 1000;
+	for (auto& len: Array<ullong>({1000, 10000, 100000, 1000000, 10000000, 100000000})) {
+		if (len > max_len) { break; }
+		const Array<llong> input = random_array(len);
+
+		// Repeat small arrays so the timings are measurable.
+		const ullong repeat = len >= 1000000 ? 1 : 1000000 / len;
+		String line;
+		line << len << " items: ";
+		if (len <= 10000) {
+			line << "insertion " << bench(input, repeat, [](Array<llong>& arr) { insertion_sort(arr); }) << "ms, ";
+		}
+		line << "sort " << bench(input, repeat, [](Array<llong>& arr) { arr.sort_r(); }) << "ms, ";
+		line << "stable_sort " << bench(input, repeat, [](Array<llong>& arr) { arr.stable_sort_r(); }) << "ms, ";
+		line << "radix_sort " << bench(input, repeat, [](Array<llong>& arr) { arr.radix_sort_r(); }) << "ms, ";
+		line << "parallel_sort " << bench(input, repeat, [](Array<llong>& arr) { arr.parallel_sort_r(); }) << "ms.";
+		print(line);
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+// Author: Daan van den Bergh
+// Copyright: © 2022 Daan van den Bergh.
+
+// Includes.
+#include "../../include/vlib/types.h"
+
+// Namespaces.
+using namespace vlib;
+
+int main() {
+
+	// Create, copy and move short strings, these fit the inline buffer.
+	const ullong count = 10 * 1000 * 1000;
+	mtime_t start = Date::get_mseconds();
+	ullong total = 0;
+	for (ullong i = 0; i < count; ++i) {
+		String key ("content-type");
+		String copy = key;
+		String moved = move(copy);
+		total += moved.len();
+	}
+	print("Create, copy and move ", count, " short strings: ", Date::get_mseconds() - start, "ms.");
+
+	// Long strings for comparison, these are allocated on the heap.
+	start = Date::get_mseconds();
+	for (ullong i = 0; i < count; ++i) {
+		String key ("a header value that does not fit the inline buffer");
+		String copy = key;
+		String moved = move(copy);
+		total += moved.len();
+	}
+	print("Create, copy and move ", count, " long strings: ", Date::get_mseconds() - start, "ms.");
+
+	// Build a dictionary with short keys.
+	start = Date::get_mseconds();
+	Dict<String, ullong> dict;
+	for (ullong i = 0; i < 1000000; ++i) {
+		dict.append(String("key_") << i, i);
+	}
+	print("Append 1000000 short keys to a dictionary: ", Date::get_mseconds() - start, "ms.");
+
+	// Split into short strings.
+	String csv;
+	for (ullong i = 0; i < 1000000; ++i) { csv << "field_" << i << ','; }
+	start = Date::get_mseconds();
+	Array<String> fields = csv.split(",");
+	print("Split ", fields.len(), " short fields: ", Date::get_mseconds() - start, "ms.");
+	if (total == 0) { print(""); } // prevent the loops from being optimized away.
+	return 0;
+}